@@ -34,15 +34,22 @@
 #include "utility.h"
 #include "contour_generator.h"
 #include "segment_merger.h"
+#include "tile_stitcher.h"
 
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 static CPLErr OGRPolygonContourWriter( double dfLevelMin, double dfLevelMax,
                                 const OGRMultiPolygon& multipoly,
                                 void *pInfo )
@@ -251,6 +258,183 @@ CPLErr OGRContourWriter( double dfLevel,
     return eErr == OGRERR_NONE ? CE_None : CE_Failure;
 }
 
+/************************************************************************/
+/*                        ContourGenerateTiled()                        */
+/************************************************************************/
+
+namespace marching_squares {
+
+// Generates the contour lines of a horizontal tile of the raster
+template <typename LevelGenerator>
+struct ContourTileJob
+{
+    const LevelGenerator* levels = nullptr;
+    size_t width = 0;
+    size_t height = 0;
+    bool hasNoData = false;
+    double noDataValue = 0.0;
+    bool polygonize = false;
+    // Index of the first line of the tile, and number of lines
+    size_t firstLine = 0;
+    size_t lineCount = 0;
+    // Values of line firstLine - 1, or nullptr for the first line
+    const double* previousLine = nullptr;
+    // Values of the lines of the tile
+    const double* data = nullptr;
+
+    TileLineCollector collector{};
+    std::string errorMsg{};
+
+    static void Process( void* pData )
+    {
+        ContourTileJob* job = static_cast<ContourTileJob*>(pData);
+        try
+        {
+            LevelGenerator levels( *(job->levels) );
+            SegmentMerger<TileLineCollector, LevelGenerator> merger(
+                job->collector, levels, job->polygonize, /* tile */ true );
+            ContourGenerator<decltype(merger), LevelGenerator> cg(
+                job->width, job->height, job->hasNoData, job->noDataValue,
+                merger, levels );
+            cg.seekLine( job->firstLine, job->previousLine );
+            for ( size_t i = 0; i < job->lineCount; i++ )
+                cg.feedLine( job->data + i * job->width );
+        }
+        catch (const std::exception & e)
+        {
+            job->errorMsg = e.what();
+        }
+    }
+};
+
+}
+
+// Splits the raster in horizontal tiles processed in parallel, and stitches
+// the lines crossing the seams between tiles, in order, before they are
+// written. The resulting geometries are the same as the ones of the
+// sequential processing.
+template <typename LineWriter, typename LevelGenerator>
+static bool ContourGenerateTiled( GDALRasterBandH hBand,
+                                  bool useNoData, double noDataValue,
+                                  LineWriter& appender,
+                                  const LevelGenerator& levels,
+                                  bool polygonize,
+                                  CPLWorkerThreadPool* poThreadPool,
+                                  GDALProgressFunc pfnProgress,
+                                  void *pProgressArg )
+{
+    using namespace marching_squares;
+
+    const size_t width = GDALGetRasterBandXSize( hBand );
+    const size_t height = GDALGetRasterBandYSize( hBand );
+    const int nThreads = poThreadPool->GetThreadCount();
+
+    // Tiles of at least 16 lines, and about 1 MB of data.
+    const size_t tileLines = std::max<size_t>( 16,
+        1024 * 1024 / ( width * sizeof(double) ) );
+    const size_t chunkLines = tileLines * nThreads;
+
+    // Values of the lines of the current chunk, preceded by the last line
+    // of the previous chunk.
+    std::vector<double> buffer( ( chunkLines + 1 ) * width );
+    std::vector<ContourTileJob<LevelGenerator>> jobs( nThreads );
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    TileStitcher<LineWriter> stitcher( appender );
+
+    for ( size_t chunkStart = 0; chunkStart < height; chunkStart += chunkLines )
+    {
+        if ( !pfnProgress( double(chunkStart) / height, "Processing line", pProgressArg ) )
+            return false;
+
+        const size_t lineCount = std::min( chunkLines, height - chunkStart );
+        if ( chunkStart > 0 )
+        {
+            std::copy( buffer.begin() + chunkLines * width,
+                       buffer.begin() + ( chunkLines + 1 ) * width,
+                       buffer.begin() );
+        }
+        if ( GDALRasterIO( hBand, GF_Read, 0, int(chunkStart), int(width),
+                           int(lineCount), &buffer[width], int(width),
+                           int(lineCount), GDT_Float64, 0, 0 ) != CE_None )
+        {
+            CPLDebug( "CONTOUR", "failed fetch %d %d", int(chunkStart), int(width) );
+            return false;
+        }
+
+        const size_t linesPerTile = ( lineCount + nThreads - 1 ) / nThreads;
+        for ( size_t i = 0; i < jobs.size(); i++ )
+        {
+            auto& job = jobs[i];
+            const size_t tileStart = std::min( lineCount, i * linesPerTile );
+            job.levels = &levels;
+            job.width = width;
+            job.height = height;
+            job.hasNoData = useNoData;
+            job.noDataValue = noDataValue;
+            job.polygonize = polygonize;
+            job.firstLine = chunkStart + tileStart;
+            job.lineCount = std::min( lineCount, tileStart + linesPerTile ) - tileStart;
+            job.previousLine = job.firstLine == 0 ? nullptr : &buffer[tileStart * width];
+            job.data = &buffer[( tileStart + 1 ) * width];
+            job.collector.lines.clear();
+            job.errorMsg.clear();
+            if ( job.lineCount > 0 )
+                poJobQueue->SubmitJob( ContourTileJob<LevelGenerator>::Process, &job );
+        }
+        poJobQueue->WaitCompletion();
+
+        for ( auto& job: jobs )
+        {
+            if ( job.lineCount == 0 )
+                continue;
+            if ( !job.errorMsg.empty() )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined, "%s", job.errorMsg.c_str() );
+                return false;
+            }
+            const size_t nextLine = job.firstLine + job.lineCount;
+            stitcher.addTile( std::move( job.collector.lines ),
+                              nextLine == height ? NaN : nextLine - .5 );
+        }
+    }
+
+    pfnProgress( 1.0, "", pProgressArg );
+    return true;
+}
+
+/************************************************************************/
+/*                          ContourGenerate()                           */
+/************************************************************************/
+
+template <typename LineWriter, typename LevelGenerator>
+static bool ContourGenerate( GDALRasterBandH hBand,
+                             bool useNoData, double noDataValue,
+                             LineWriter& appender,
+                             LevelGenerator& levels,
+                             bool polygonize,
+                             int nThreads,
+                             GDALProgressFunc pfnProgress,
+                             void *pProgressArg )
+{
+    using namespace marching_squares;
+
+    if ( nThreads > 1 && GDALGetRasterBandYSize( hBand ) > 1 )
+    {
+        CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool( nThreads );
+        if ( poThreadPool )
+        {
+            return ContourGenerateTiled( hBand, useNoData, noDataValue,
+                                         appender, levels, polygonize,
+                                         poThreadPool,
+                                         pfnProgress, pProgressArg );
+        }
+    }
+
+    SegmentMerger<LineWriter, LevelGenerator> writer( appender, levels, polygonize );
+    ContourGeneratorFromRaster<decltype(writer), LevelGenerator> cg( hBand, useNoData, noDataValue, writer, levels );
+    return cg.process( pfnProgress, pProgressArg );
+}
+
 /************************************************************************/
 /*                        GDALContourGenerate()                         */
 /************************************************************************/
@@ -517,6 +701,14 @@ an averaged value from the two nearby points (in this case (12+3+5)/3).
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=n|ALL_CPUS
+ *
+ * (GDAL >= 3.7) Number of threads used to generate contours. When greater
+ * than 1, the raster is split into horizontal tiles processed in parallel,
+ * and contours crossing tile borders are joined before being written, so
+ * that the output geometries are the same as with a single thread.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -600,6 +792,12 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool( options, "POLYGONIZE", false );
 
+    opt = CSLFetchNameValue( options, "NUM_THREADS" );
+    if ( opt == nullptr )
+        opt = CPLGetConfigOption( "GDAL_NUM_THREADS", "1" );
+    const int nThreads = std::max( 1, std::min( 128,
+        EQUAL( opt, "ALL_CPUS" ) ? CPLGetNumCPUs() : atoi( opt ) ) );
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -630,21 +828,18 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
             RingAppender appender( w );
             if ( ! fixedLevels.empty() ) {
                 FixedLevelRangeIterator levels( &fixedLevels[0], fixedLevels.size(), GDALGetRasterMaximum( hBand, &bSuccess ) );
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), FixedLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourGenerate( hBand, useNoData, noDataValue, appender, levels,
+                                      /* polygonize */ true, nThreads, pfnProgress, pProgressArg );
             }
             else if ( expBase > 0.0 ) {
                 ExponentialLevelRangeIterator levels( expBase );
-                SegmentMerger<RingAppender, ExponentialLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), ExponentialLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourGenerate( hBand, useNoData, noDataValue, appender, levels,
+                                      /* polygonize */ true, nThreads, pfnProgress, pProgressArg );
             }
             else {
                 IntervalLevelRangeIterator levels( contourBase, contourInterval );
-                SegmentMerger<RingAppender, IntervalLevelRangeIterator> writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer), IntervalLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourGenerate( hBand, useNoData, noDataValue, appender, levels,
+                                      /* polygonize */ true, nThreads, pfnProgress, pProgressArg );
             }
         }
         else
@@ -652,21 +847,18 @@ CPLErr GDALContourGenerateEx( GDALRasterBandH hBand, void *hLayer,
             GDALRingAppender appender(OGRContourWriter, &oCWI);
             if ( ! fixedLevels.empty() ) {
                 FixedLevelRangeIterator levels( &fixedLevels[0], fixedLevels.size() );
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), FixedLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourGenerate( hBand, useNoData, noDataValue, appender, levels,
+                                      /* polygonize */ false, nThreads, pfnProgress, pProgressArg );
             }
             else if ( expBase > 0.0 ) {
                 ExponentialLevelRangeIterator levels( expBase );
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), ExponentialLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourGenerate( hBand, useNoData, noDataValue, appender, levels,
+                                      /* polygonize */ false, nThreads, pfnProgress, pProgressArg );
             }
             else {
                 IntervalLevelRangeIterator levels( contourBase, contourInterval );
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator> writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer), IntervalLevelRangeIterator> cg( hBand, useNoData, noDataValue, writer, levels );
-                ok = cg.process( pfnProgress, pProgressArg );
+                ok = ContourGenerate( hBand, useNoData, noDataValue, appender, levels,
+                                      /* polygonize */ false, nThreads, pfnProgress, pProgressArg );
             }
         }
     }
@@ -398,6 +398,22 @@ GDALViewshedGenerate(GDALRasterBandH hBand,
                      GDALProgressFunc pfnProgress, void *pProgressArg,
                      GDALViewshedOutputType heightMode, CSLConstList papszExtraOptions);
 
+GDALDatasetH CPL_DLL
+GDALViewshedGenerateMulti(GDALRasterBandH hBand,
+                          const char* pszDriverName,
+                          const char* pszTargetRasterName,
+                          CSLConstList papszCreationOptions,
+                          int nObserverCount,
+                          const double* padfObserverX,
+                          const double* padfObserverY,
+                          const double* padfObserverHeight,
+                          double dfTargetHeight, double dfVisibleVal,
+                          double dfInvisibleVal, double dfOutOfRangeVal,
+                          double dfNoDataVal, double dfCurvCoeff,
+                          GDALViewshedMode eMode, double dfMaxDistance,
+                          GDALProgressFunc pfnProgress, void *pProgressArg,
+                          CSLConstList papszOptions);
+
 /************************************************************************/
 /*      Rasterizer API - geometries burned into GDAL raster.            */
 /************************************************************************/
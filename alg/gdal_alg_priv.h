@@ -166,6 +166,7 @@ void CPL_DLL *GDALRegisterTransformDeserializer(const char* pszTransformName,
 void CPL_DLL GDALUnregisterTransformDeserializer(void* pData);
 
 void GDALCleanupTransformDeserializerMutex();
+void GDALCleanupTransformGridCache();
 
 /* Transformer cloning */
 
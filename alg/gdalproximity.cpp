@@ -34,13 +34,18 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -50,6 +55,440 @@ ProcessProximityLine( GInt32 *panSrcScanline, int *panNearX, int *panNearY,
                       float *pafProximity, double *pdfSrcNoDataValue,
                       int nTargetValues, int *panTargetValues );
 
+/************************************************************************/
+/*                       Exact distance transform                       */
+/************************************************************************/
+
+// Implementation of the ALGORITHM=EDT mode of GDALComputeProximity(), based
+// on the separable exact Euclidean distance transform of
+// P. Felzenszwalb and D. Huttenlocher, "Distance Transforms of Sampled
+// Functions", Theory of Computing, 2012.
+//
+// The first pass computes, for each pixel, the distance to the nearest
+// target pixel in the same column. It processes the raster by chunks of
+// lines, and columns are split among threads. The second pass computes, for
+// each line independently, the lower envelope of the parabolas centered on
+// each pixel of the line, which gives the squared distance to the nearest
+// target pixel. Lines are split among threads.
+
+namespace {
+
+constexpr GUInt32 EDT_INFINITY = std::numeric_limits<GUInt32>::max();
+
+struct GDALProximityEDTContext
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    double dfMaxDist = 0;
+    double dfDistMult = 1.0;
+    const double *pdfSrcNoDataValue = nullptr;
+    float fNoDataValue = 0;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+    int nTargetValues = 0;
+    const int *panTargetValues = nullptr;
+
+    // Distance to the nearest target pixel in the same column, for the
+    // whole raster.
+    GUInt32 *panColDist = nullptr;
+};
+
+struct GDALProximityEDTJob
+{
+    const GDALProximityEDTContext *psCtxt = nullptr;
+
+    // Area processed by the job. For the column pass, iXStart..iXEnd are
+    // the columns. For the other steps, iYStart..iYEnd are lines of the
+    // current chunk, and panSrcBuf / pafProximity point to the chunk.
+    int iXStart = 0;
+    int iXEnd = 0;
+    int iYStart = 0;
+    int iYEnd = 0;
+    int iChunkYOff = 0;
+    const GInt32 *panSrcBuf = nullptr;
+    float *pafProximity = nullptr;
+
+    // Working buffers of the line pass.
+    std::vector<double> adfF{};
+    std::vector<int> anV{};
+    std::vector<double> adfZ{};
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                         EDTInitTargets()                             */
+/************************************************************************/
+
+// Initializes the column distances of the lines of a chunk to 0 for target
+// pixels, and EDT_INFINITY for others.
+static void EDTInitTargets( void *pData )
+{
+    const GDALProximityEDTJob *psJob =
+        static_cast<const GDALProximityEDTJob *>(pData);
+    const GDALProximityEDTContext *psCtxt = psJob->psCtxt;
+    const int nXSize = psCtxt->nXSize;
+
+    for( int iLine = psJob->iYStart; iLine < psJob->iYEnd; iLine++ )
+    {
+        const GInt32 *panSrcScanline =
+            psJob->panSrcBuf +
+            static_cast<size_t>(iLine - psJob->iChunkYOff) * nXSize;
+        GUInt32 *panDist =
+            psCtxt->panColDist + static_cast<size_t>(iLine) * nXSize;
+        for( int iPixel = 0; iPixel < nXSize; iPixel++ )
+        {
+            bool bIsTarget = false;
+            if( psCtxt->nTargetValues == 0 )
+            {
+                bIsTarget = panSrcScanline[iPixel] != 0;
+            }
+            else
+            {
+                for( int i = 0; i < psCtxt->nTargetValues; i++ )
+                {
+                    if( panSrcScanline[iPixel] == psCtxt->panTargetValues[i] )
+                        bIsTarget = true;
+                }
+            }
+            panDist[iPixel] = bIsTarget ? 0 : EDT_INFINITY;
+        }
+    }
+}
+
+/************************************************************************/
+/*                         EDTColumnPass()                              */
+/************************************************************************/
+
+// Computes the distance to the nearest target pixel of the same column with
+// a downward and an upward sweep. Distances larger than MAXDIST are set to
+// EDT_INFINITY, since such pixels cannot contribute.
+static void EDTColumnPass( void *pData )
+{
+    const GDALProximityEDTJob *psJob =
+        static_cast<const GDALProximityEDTJob *>(pData);
+    const GDALProximityEDTContext *psCtxt = psJob->psCtxt;
+    const size_t nXSize = psCtxt->nXSize;
+    const int nYSize = psCtxt->nYSize;
+    const double dfMaxDist = psCtxt->dfMaxDist;
+    GUInt32 *panColDist = psCtxt->panColDist;
+
+    const auto Propagate = [dfMaxDist](GUInt32 nPrev, GUInt32 nCur)
+    {
+        if( nCur == 0 || nPrev == EDT_INFINITY ||
+            nPrev + 1.0 > dfMaxDist )
+            return nCur;
+        return std::min(nCur, nPrev + 1);
+    };
+
+    for( int iLine = 1; iLine < nYSize; iLine++ )
+    {
+        const GUInt32 *panPrev = panColDist + (iLine - 1) * nXSize;
+        GUInt32 *panCur = panColDist + iLine * nXSize;
+        for( int iPixel = psJob->iXStart; iPixel < psJob->iXEnd; iPixel++ )
+            panCur[iPixel] = Propagate(panPrev[iPixel], panCur[iPixel]);
+    }
+
+    for( int iLine = nYSize - 2; iLine >= 0; iLine-- )
+    {
+        const GUInt32 *panPrev = panColDist + (iLine + 1) * nXSize;
+        GUInt32 *panCur = panColDist + iLine * nXSize;
+        for( int iPixel = psJob->iXStart; iPixel < psJob->iXEnd; iPixel++ )
+            panCur[iPixel] = Propagate(panPrev[iPixel], panCur[iPixel]);
+    }
+}
+
+/************************************************************************/
+/*                          EDTLinePass()                               */
+/************************************************************************/
+
+// Computes the final proximity values of the lines of a chunk.
+static void EDTLinePass( void *pData )
+{
+    GDALProximityEDTJob *psJob = static_cast<GDALProximityEDTJob *>(pData);
+    const GDALProximityEDTContext *psCtxt = psJob->psCtxt;
+    const int nXSize = psCtxt->nXSize;
+    const double dfMaxDistSq = psCtxt->dfMaxDist * psCtxt->dfMaxDist;
+    double *padfF = psJob->adfF.data();
+    int *panV = psJob->anV.data();
+    double *padfZ = psJob->adfZ.data();
+
+    for( int iLine = psJob->iYStart; iLine < psJob->iYEnd; iLine++ )
+    {
+        const GUInt32 *panDist =
+            psCtxt->panColDist + static_cast<size_t>(iLine) * nXSize;
+        const size_t nChunkOffset =
+            static_cast<size_t>(iLine - psJob->iChunkYOff) * nXSize;
+        float *pafProximity = psJob->pafProximity + nChunkOffset;
+
+/* -------------------------------------------------------------------- */
+/*      Build the lower envelope of the parabolas x -> (x-q)^2 + f(q),  */
+/*      where f(q) is the squared column distance at q. Pixels without  */
+/*      target within MAXDIST in their column are skipped.             */
+/* -------------------------------------------------------------------- */
+        int k = -1;
+        for( int q = 0; q < nXSize; q++ )
+        {
+            if( panDist[q] == EDT_INFINITY )
+                continue;
+            const double dfQ = q;
+            padfF[q] = static_cast<double>(panDist[q]) * panDist[q];
+            if( k < 0 )
+            {
+                k = 0;
+                panV[0] = q;
+                padfZ[0] = -std::numeric_limits<double>::infinity();
+                padfZ[1] = std::numeric_limits<double>::infinity();
+                continue;
+            }
+            double dfS = 0;
+            while( true )
+            {
+                const double dfV = panV[k];
+                dfS = ((padfF[q] + dfQ * dfQ) -
+                       (padfF[panV[k]] + dfV * dfV)) / (2 * (dfQ - dfV));
+                if( dfS > padfZ[k] )
+                    break;
+                k--;
+            }
+            k++;
+            panV[k] = q;
+            padfZ[k] = dfS;
+            padfZ[k+1] = std::numeric_limits<double>::infinity();
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Compute proximity values.                                       */
+/* -------------------------------------------------------------------- */
+        if( k < 0 )
+        {
+            // No target pixel within MAXDIST of this line.
+            for( int iPixel = 0; iPixel < nXSize; iPixel++ )
+                pafProximity[iPixel] = psCtxt->fNoDataValue;
+            continue;
+        }
+
+        const GInt32 *panSrcScanline =
+            psJob->panSrcBuf ? psJob->panSrcBuf + nChunkOffset : nullptr;
+        k = 0;
+        for( int iPixel = 0; iPixel < nXSize; iPixel++ )
+        {
+            while( padfZ[k+1] < iPixel )
+                k++;
+            const double dfDX = iPixel - panV[k];
+            const double dfDistSq = dfDX * dfDX + padfF[panV[k]];
+
+            if( dfDistSq == 0 )
+            {
+                pafProximity[iPixel] = 0.0f;
+            }
+            else if( dfDistSq > dfMaxDistSq ||
+                     (panSrcScanline != nullptr &&
+                      panSrcScanline[iPixel] == *psCtxt->pdfSrcNoDataValue) )
+            {
+                pafProximity[iPixel] = psCtxt->fNoDataValue;
+            }
+            else if( psCtxt->bFixedBufVal )
+            {
+                pafProximity[iPixel] =
+                    static_cast<float>(psCtxt->dfFixedBufVal);
+            }
+            else
+            {
+                pafProximity[iPixel] = static_cast<float>(
+                    static_cast<float>(sqrt(dfDistSq)) * psCtxt->dfDistMult);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GDALComputeProximityEDT()                         */
+/************************************************************************/
+
+static CPLErr
+GDALComputeProximityEDT( GDALRasterBandH hSrcBand,
+                         GDALRasterBandH hProximityBand,
+                         const GDALProximityEDTContext &sCtxtIn,
+                         int nThreads,
+                         GDALProgressFunc pfnProgress,
+                         void *pProgressArg )
+{
+    GDALProximityEDTContext sCtxt(sCtxtIn);
+    const int nXSize = sCtxt.nXSize;
+    const int nYSize = sCtxt.nYSize;
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if( poThreadPool == nullptr )
+        nThreads = 1;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poThreadPool )
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    // Lines processed at once: about 16 MB of source and output values.
+    const int nChunkLines = static_cast<int>(std::min<GIntBig>(nYSize,
+        std::max<GIntBig>(4 * nThreads,
+                          16 * 1024 * 1024 / (static_cast<GIntBig>(nXSize) *
+                                    (sizeof(GInt32) + sizeof(float))))));
+
+    sCtxt.panColDist = static_cast<GUInt32 *>(
+        VSI_MALLOC3_VERBOSE(sizeof(GUInt32), nXSize, nYSize));
+    GInt32 *panSrcBuf = static_cast<GInt32 *>(
+        VSI_MALLOC3_VERBOSE(sizeof(GInt32), nXSize, nChunkLines));
+    float *pafProximity = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(sizeof(float), nXSize, nChunkLines));
+    std::vector<GDALProximityEDTJob> asJobs;
+    try
+    {
+        asJobs.resize(nThreads);
+        for( auto &sJob : asJobs )
+        {
+            sJob.psCtxt = &sCtxt;
+            sJob.adfF.resize(nXSize);
+            sJob.anV.resize(nXSize);
+            sJob.adfZ.resize(nXSize + 1);
+        }
+    }
+    catch( const std::exception & )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALComputeProximity()");
+        asJobs.clear();
+    }
+
+    const auto RunJobs = [&asJobs, &poJobQueue](CPLThreadFunc pfnFunc)
+    {
+        for( auto &sJob : asJobs )
+        {
+            if( sJob.iXStart >= sJob.iXEnd || sJob.iYStart >= sJob.iYEnd )
+                continue;
+            if( poJobQueue )
+                poJobQueue->SubmitJob(pfnFunc, &sJob);
+            else
+                pfnFunc(&sJob);
+        }
+        if( poJobQueue )
+            poJobQueue->WaitCompletion();
+    };
+
+    // Split lines iChunkYOff..iChunkYOff+nLines-1 among jobs.
+    const auto SplitLines = [&asJobs, nXSize, panSrcBuf,
+                             pafProximity](int iChunkYOff, int nLines,
+                                           bool bWithSrc)
+    {
+        const int nJobs = static_cast<int>(asJobs.size());
+        const int nLinesPerJob = (nLines + nJobs - 1) / nJobs;
+        for( int iJob = 0; iJob < nJobs; iJob++ )
+        {
+            auto &sJob = asJobs[iJob];
+            sJob.iXStart = 0;
+            sJob.iXEnd = nXSize;
+            sJob.iChunkYOff = iChunkYOff;
+            sJob.iYStart = iChunkYOff + std::min(nLines, iJob * nLinesPerJob);
+            sJob.iYEnd =
+                iChunkYOff + std::min(nLines, (iJob + 1) * nLinesPerJob);
+            sJob.panSrcBuf = bWithSrc ? panSrcBuf : nullptr;
+            sJob.pafProximity = pafProximity;
+        }
+    };
+
+    CPLErr eErr = CE_None;
+    if( sCtxt.panColDist == nullptr || panSrcBuf == nullptr ||
+        pafProximity == nullptr || asJobs.empty() )
+    {
+        eErr = CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read the source raster and identify target pixels.              */
+/* -------------------------------------------------------------------- */
+    for( int iChunkYOff = 0; eErr == CE_None && iChunkYOff < nYSize;
+         iChunkYOff += nChunkLines )
+    {
+        const int nLines = std::min(nChunkLines, nYSize - iChunkYOff);
+        eErr = GDALRasterIO( hSrcBand, GF_Read, 0, iChunkYOff, nXSize, nLines,
+                             panSrcBuf, nXSize, nLines, GDT_Int32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        SplitLines(iChunkYOff, nLines, true);
+        RunJobs(EDTInitTargets);
+
+        if( !pfnProgress( 0.25 * (iChunkYOff + nLines) / nYSize,
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Compute distances along columns.                                */
+/* -------------------------------------------------------------------- */
+    if( eErr == CE_None )
+    {
+        const int nJobs = static_cast<int>(asJobs.size());
+        const int nColsPerJob = (nXSize + nJobs - 1) / nJobs;
+        for( int iJob = 0; iJob < nJobs; iJob++ )
+        {
+            auto &sJob = asJobs[iJob];
+            sJob.iXStart = std::min(nXSize, iJob * nColsPerJob);
+            sJob.iXEnd = std::min(nXSize, (iJob + 1) * nColsPerJob);
+            sJob.iYStart = 0;
+            sJob.iYEnd = nYSize;
+        }
+        RunJobs(EDTColumnPass);
+
+        if( !pfnProgress( 0.5, "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Compute distances along lines, and write the result.            */
+/* -------------------------------------------------------------------- */
+    const bool bUseSrcNoData = sCtxt.pdfSrcNoDataValue != nullptr;
+    for( int iChunkYOff = 0; eErr == CE_None && iChunkYOff < nYSize;
+         iChunkYOff += nChunkLines )
+    {
+        const int nLines = std::min(nChunkLines, nYSize - iChunkYOff);
+        if( bUseSrcNoData )
+        {
+            // Reread source values to identify nodata pixels.
+            eErr = GDALRasterIO( hSrcBand, GF_Read,
+                                 0, iChunkYOff, nXSize, nLines,
+                                 panSrcBuf, nXSize, nLines, GDT_Int32, 0, 0 );
+            if( eErr != CE_None )
+                break;
+        }
+
+        SplitLines(iChunkYOff, nLines, bUseSrcNoData);
+        RunJobs(EDTLinePass);
+
+        eErr = GDALRasterIO( hProximityBand, GF_Write,
+                             0, iChunkYOff, nXSize, nLines,
+                             pafProximity, nXSize, nLines, GDT_Float32, 0, 0 );
+        if( eErr != CE_None )
+            break;
+
+        if( !pfnProgress( 0.5 + 0.5 * (iChunkYOff + nLines) / nYSize,
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    CPLFree(sCtxt.panColDist);
+    CPLFree(panSrcBuf);
+    CPLFree(pafProximity);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -106,6 +545,19 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[SWEEP]/EDT
+
+(GDAL >= 3.7) Algorithm used to compute distances. SWEEP, the default, uses
+two sweeps over the raster propagating the nearest target pixel found so
+far, which is fast but may slightly overestimate some distances. EDT computes
+an exact Euclidean distance transform, and can use several threads. It needs
+to hold 4 bytes per pixel of the raster in memory.
+
+  NUM_THREADS=n|ALL_CPUS
+
+(GDAL >= 3.7) Number of threads to use with ALGORITHM=EDT. Defaults to the
+value of the GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL
@@ -155,6 +607,25 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         }
     }
 
+/* -------------------------------------------------------------------- */
+/*      Which algorithm should be used?                                 */
+/* -------------------------------------------------------------------- */
+    bool bUseEDT = false;
+    pszOpt = CSLFetchNameValue( papszOptions, "ALGORITHM" );
+    if( pszOpt )
+    {
+        if( EQUAL(pszOpt, "EDT") )
+            bUseEDT = true;
+        else if( !EQUAL(pszOpt, "SWEEP") )
+        {
+            CPLError(
+                CE_Failure, CPLE_NotSupported,
+                "Unrecognized ALGORITHM value '%s', should be SWEEP or EDT.",
+                pszOpt );
+            return CE_Failure;
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      What is our maxdist value?                                      */
 /* -------------------------------------------------------------------- */
@@ -253,6 +724,36 @@ GDALComputeProximity( GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Use the exact distance transform if requested.                  */
+/* -------------------------------------------------------------------- */
+    if( bUseEDT )
+    {
+        const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+        if( pszThreads == nullptr )
+            pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads = std::max(1, std::min(128,
+            EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+
+        GDALProximityEDTContext sCtxt;
+        sCtxt.nXSize = nXSize;
+        sCtxt.nYSize = nYSize;
+        sCtxt.dfMaxDist = dfMaxDist;
+        sCtxt.dfDistMult = dfDistMult;
+        sCtxt.pdfSrcNoDataValue = pdfSrcNoData;
+        sCtxt.fNoDataValue = fNoDataValue;
+        sCtxt.bFixedBufVal = bFixedBufVal;
+        sCtxt.dfFixedBufVal = dfFixedBufVal;
+        sCtxt.nTargetValues = nTargetValues;
+        sCtxt.panTargetValues = panTargetValues;
+
+        const CPLErr eErr =
+            GDALComputeProximityEDT( hSrcBand, hProximityBand, sCtxt, nThreads,
+                                     pfnProgress, pProgressArg );
+        CPLFree(panTargetValues);
+        return eErr;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      We need a signed type for the working proximity values kept     */
 /*      on disk.  If our proximity band is not signed, then create a    */
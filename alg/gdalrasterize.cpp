@@ -31,12 +31,16 @@
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 
+#include <atomic>
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
 #include <limits>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -45,9 +49,11 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -481,23 +487,34 @@ static void GDALCollectRingsFromGeometry(
 }
 
 /************************************************************************/
-/*                       gv_rasterize_one_shape()                       */
+/*                      GDALRasterizePreparedPart                       */
+/*                                                                      */
+/*      Rings of a geometry (or of a part of a geometry collection      */
+/*      in replace mode), already transformed to pixel/line space.      */
+/************************************************************************/
+
+namespace {
+struct GDALRasterizePreparedPart
+{
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    std::vector<double> aPointX{};
+    std::vector<double> aPointY{};
+    std::vector<double> aPointVariant{};
+    std::vector<int> aPartSize{};
+};
+} // namespace
+
+/************************************************************************/
+/*                     GDALRasterizePrepareShape()                      */
 /************************************************************************/
-static void
-gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
-                        int nXSize, int nYSize,
-                        int nBands, GDALDataType eType,
-                        int nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
-                        int bAllTouched,
-                        const OGRGeometry *poShape,
-                        GDALDataType eBurnValueType,
-                        const double *padfBurnValues,
-                        const int64_t *panBurnValues,
-                        GDALBurnValueSrc eBurnValueSrc,
-                        GDALRasterMergeAlg eMergeAlg,
-                        GDALTransformerFunc pfnTransformer,
-                        void *pTransformArg )
 
+static void
+GDALRasterizePrepareShape( const OGRGeometry *poShape,
+                           GDALBurnValueSrc eBurnValueSrc,
+                           GDALRasterMergeAlg eMergeAlg,
+                           GDALTransformerFunc pfnTransformer,
+                           void *pTransformArg,
+                           std::vector<GDALRasterizePreparedPart>& aoParts )
 {
     if( poShape == nullptr || poShape->IsEmpty() )
         return;
@@ -513,90 +530,61 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
         const auto poGC = poShape->toGeometryCollection();
         for( const auto poPart: *poGC )
         {
-            gv_rasterize_one_shape(pabyChunkBuf, nXOff, nYOff,
-                                   nXSize, nYSize,
-                                   nBands, eType,
-                                   nPixelSpace, nLineSpace, nBandSpace,
-                                   bAllTouched,
-                                   poPart,
-                                   eBurnValueType,
-                                   padfBurnValues,
-                                   panBurnValues,
-                                   eBurnValueSrc,
-                                   eMergeAlg,
-                                   pfnTransformer,
-                                   pTransformArg);
+            GDALRasterizePrepareShape(poPart, eBurnValueSrc, eMergeAlg,
+                                      pfnTransformer, pTransformArg,
+                                      aoParts);
         }
         return;
     }
 
-    if(nPixelSpace == 0)
-    {
-        nPixelSpace = GDALGetDataTypeSizeBytes(eType);
-    }
-    if(nLineSpace == 0)
-    {
-        nLineSpace = static_cast<GSpacing>(nXSize) * nPixelSpace;
-    }
-    if(nBandSpace == 0)
-    {
-        nBandSpace = nYSize * nLineSpace;
-    }
-
-    GDALRasterizeInfo sInfo;
-    sInfo.nXSize = nXSize;
-    sInfo.nYSize = nYSize;
-    sInfo.nBands = nBands;
-    sInfo.pabyChunkBuf = pabyChunkBuf;
-    sInfo.eType = eType;
-    sInfo.nPixelSpace = nPixelSpace;
-    sInfo.nLineSpace = nLineSpace;
-    sInfo.nBandSpace = nBandSpace;
-    sInfo.eBurnValueType = eBurnValueType;
-    if( eBurnValueType == GDT_Float64 )
-        sInfo.burnValues.double_values = padfBurnValues;
-    else if( eBurnValueType == GDT_Int64 )
-        sInfo.burnValues.int64_values = panBurnValues;
-    else
-    {
-        CPLAssert(false);
-    }
-    sInfo.eBurnValueSource = eBurnValueSrc;
-    sInfo.eMergeAlg = eMergeAlg;
+    aoParts.emplace_back();
+    GDALRasterizePreparedPart& oPart = aoParts.back();
+    oPart.eGeomType = eGeomType;
 
 /* -------------------------------------------------------------------- */
 /*      Transform polygon geometries into a set of rings and a part     */
 /*      size list.                                                      */
 /* -------------------------------------------------------------------- */
-    std::vector<double> aPointX;
-    std::vector<double> aPointY;
-    std::vector<double> aPointVariant;
-    std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry( poShape, aPointX, aPointY, aPointVariant,
-                                  aPartSize, eBurnValueSrc );
+    GDALCollectRingsFromGeometry( poShape, oPart.aPointX, oPart.aPointY,
+                                  oPart.aPointVariant,
+                                  oPart.aPartSize, eBurnValueSrc );
 
 /* -------------------------------------------------------------------- */
 /*      Transform points if needed.                                     */
 /* -------------------------------------------------------------------- */
-    if( pfnTransformer != nullptr )
+    if( pfnTransformer != nullptr && !oPart.aPointX.empty() )
     {
         int *panSuccess =
-            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
+            static_cast<int *>(CPLCalloc(sizeof(int), oPart.aPointX.size()));
 
         // TODO: We need to add all appropriate error checking at some point.
-        pfnTransformer( pTransformArg, FALSE, static_cast<int>(aPointX.size()),
-                        aPointX.data(), aPointY.data(), nullptr, panSuccess );
+        pfnTransformer( pTransformArg, FALSE,
+                        static_cast<int>(oPart.aPointX.size()),
+                        oPart.aPointX.data(), oPart.aPointY.data(),
+                        nullptr, panSuccess );
         CPLFree( panSuccess );
     }
+}
 
-/* -------------------------------------------------------------------- */
-/*      Shift to account for the buffer offset of this buffer.          */
-/* -------------------------------------------------------------------- */
-    for( unsigned int i = 0; i < aPointX.size(); i++ )
-        aPointX[i] -= nXOff;
-    for( unsigned int i = 0; i < aPointY.size(); i++ )
-        aPointY[i] -= nYOff;
+/************************************************************************/
+/*                       gv_rasterize_one_part()                        */
+/*                                                                      */
+/*      Burn a prepared part, whose coordinates have already been       */
+/*      shifted to account for the offset of the chunk buffer.          */
+/************************************************************************/
+
+static void
+gv_rasterize_one_part( GDALRasterizeInfo *psInfo,
+                       OGRwkbGeometryType eGeomType,
+                       int bAllTouched,
+                       std::vector<double> &aPointX,
+                       std::vector<double> &aPointY,
+                       std::vector<double> &aPointVariant,
+                       const std::vector<int> &aPartSize )
+{
+    const GDALBurnValueSrc eBurnValueSrc = psInfo->eBurnValueSource;
+    const GDALRasterMergeAlg eMergeAlg = psInfo->eMergeAlg;
+    const int nYSize = psInfo->nYSize;
 
 /* -------------------------------------------------------------------- */
 /*      Perform the rasterization.                                      */
@@ -608,46 +596,46 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
     {
       case wkbPoint:
       case wkbMultiPoint:
-        GDALdllImagePoint( sInfo.nXSize, nYSize,
+        GDALdllImagePoint( psInfo->nXSize, nYSize,
                            static_cast<int>(aPartSize.size()), aPartSize.data(),
                            aPointX.data(), aPointY.data(),
                            (eBurnValueSrc == GBV_UserBurnValue)?
                            nullptr : aPointVariant.data(),
-                           gvBurnPoint, &sInfo );
+                           gvBurnPoint, psInfo );
         break;
       case wkbLineString:
       case wkbMultiLineString:
       {
           if( bAllTouched )
-              GDALdllImageLineAllTouched( sInfo.nXSize, nYSize,
+              GDALdllImageLineAllTouched( psInfo->nXSize, nYSize,
                                           static_cast<int>(aPartSize.size()),
                                           aPartSize.data(),
                                           aPointX.data(), aPointY.data(),
                                           (eBurnValueSrc == GBV_UserBurnValue)?
                                           nullptr : aPointVariant.data(),
-                                          gvBurnPoint, &sInfo,
+                                          gvBurnPoint, psInfo,
                                           eMergeAlg == GRMA_Add,
                                           false);
           else
-              GDALdllImageLine( sInfo.nXSize, nYSize,
+              GDALdllImageLine( psInfo->nXSize, nYSize,
                                 static_cast<int>(aPartSize.size()),
                                 aPartSize.data(),
                                 aPointX.data(), aPointY.data(),
                                 (eBurnValueSrc == GBV_UserBurnValue)?
                                 nullptr : aPointVariant.data(),
-                                gvBurnPoint, &sInfo );
+                                gvBurnPoint, psInfo );
       }
       break;
 
       default:
       {
           GDALdllImageFilledPolygon(
-              sInfo.nXSize, nYSize,
+              psInfo->nXSize, nYSize,
               static_cast<int>(aPartSize.size()), aPartSize.data(),
               aPointX.data(), aPointY.data(),
               (eBurnValueSrc == GBV_UserBurnValue)?
               nullptr : aPointVariant.data(),
-              gvBurnScanline, &sInfo );
+              gvBurnScanline, psInfo );
           if( bAllTouched )
           {
               // Reverting the variants to the first value because the
@@ -657,11 +645,11 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
               if( eBurnValueSrc == GBV_UserBurnValue )
               {
                   GDALdllImageLineAllTouched(
-                      sInfo.nXSize, nYSize,
+                      psInfo->nXSize, nYSize,
                       static_cast<int>(aPartSize.size()), aPartSize.data(),
                       aPointX.data(), aPointY.data(),
                       nullptr,
-                      gvBurnPoint, &sInfo,
+                      gvBurnPoint, psInfo,
                       eMergeAlg == GRMA_Add,
                       true );
               }
@@ -676,11 +664,11 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
                   }
 
                   GDALdllImageLineAllTouched(
-                      sInfo.nXSize, nYSize,
+                      psInfo->nXSize, nYSize,
                       static_cast<int>(aPartSize.size()), aPartSize.data(),
                       aPointX.data(), aPointY.data(),
                       aPointVariant.data(),
-                      gvBurnPoint, &sInfo,
+                      gvBurnPoint, psInfo,
                       eMergeAlg == GRMA_Add,
                       true );
               }
@@ -690,6 +678,106 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
     }
 }
 
+/************************************************************************/
+/*                       GDALRasterizeInitInfo()                        */
+/************************************************************************/
+
+static void
+GDALRasterizeInitInfo( GDALRasterizeInfo *psInfo,
+                       unsigned char *pabyChunkBuf,
+                       int nXSize, int nYSize,
+                       int nBands, GDALDataType eType,
+                       int nPixelSpace, GSpacing nLineSpace,
+                       GSpacing nBandSpace,
+                       GDALDataType eBurnValueType,
+                       const double *padfBurnValues,
+                       const int64_t *panBurnValues,
+                       GDALBurnValueSrc eBurnValueSrc,
+                       GDALRasterMergeAlg eMergeAlg )
+{
+    if(nPixelSpace == 0)
+    {
+        nPixelSpace = GDALGetDataTypeSizeBytes(eType);
+    }
+    if(nLineSpace == 0)
+    {
+        nLineSpace = static_cast<GSpacing>(nXSize) * nPixelSpace;
+    }
+    if(nBandSpace == 0)
+    {
+        nBandSpace = nYSize * nLineSpace;
+    }
+
+    psInfo->nXSize = nXSize;
+    psInfo->nYSize = nYSize;
+    psInfo->nBands = nBands;
+    psInfo->pabyChunkBuf = pabyChunkBuf;
+    psInfo->eType = eType;
+    psInfo->nPixelSpace = nPixelSpace;
+    psInfo->nLineSpace = nLineSpace;
+    psInfo->nBandSpace = nBandSpace;
+    psInfo->eBurnValueType = eBurnValueType;
+    if( eBurnValueType == GDT_Float64 )
+        psInfo->burnValues.double_values = padfBurnValues;
+    else if( eBurnValueType == GDT_Int64 )
+        psInfo->burnValues.int64_values = panBurnValues;
+    else
+    {
+        CPLAssert(false);
+    }
+    psInfo->eBurnValueSource = eBurnValueSrc;
+    psInfo->eMergeAlg = eMergeAlg;
+}
+
+/************************************************************************/
+/*                       gv_rasterize_one_shape()                       */
+/************************************************************************/
+static void
+gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
+                        int nXSize, int nYSize,
+                        int nBands, GDALDataType eType,
+                        int nPixelSpace, GSpacing nLineSpace, GSpacing nBandSpace,
+                        int bAllTouched,
+                        const OGRGeometry *poShape,
+                        GDALDataType eBurnValueType,
+                        const double *padfBurnValues,
+                        const int64_t *panBurnValues,
+                        GDALBurnValueSrc eBurnValueSrc,
+                        GDALRasterMergeAlg eMergeAlg,
+                        GDALTransformerFunc pfnTransformer,
+                        void *pTransformArg )
+
+{
+    if( poShape == nullptr || poShape->IsEmpty() )
+        return;
+
+    GDALRasterizeInfo sInfo;
+    GDALRasterizeInitInfo( &sInfo, pabyChunkBuf, nXSize, nYSize,
+                           nBands, eType,
+                           nPixelSpace, nLineSpace, nBandSpace,
+                           eBurnValueType, padfBurnValues, panBurnValues,
+                           eBurnValueSrc, eMergeAlg );
+
+    std::vector<GDALRasterizePreparedPart> aoParts;
+    GDALRasterizePrepareShape( poShape, eBurnValueSrc, eMergeAlg,
+                               pfnTransformer, pTransformArg, aoParts );
+
+    for( auto& oPart: aoParts )
+    {
+/* -------------------------------------------------------------------- */
+/*      Shift to account for the buffer offset of this buffer.          */
+/* -------------------------------------------------------------------- */
+        for( unsigned int i = 0; i < oPart.aPointX.size(); i++ )
+            oPart.aPointX[i] -= nXOff;
+        for( unsigned int i = 0; i < oPart.aPointY.size(); i++ )
+            oPart.aPointY[i] -= nYOff;
+
+        gv_rasterize_one_part( &sInfo, oPart.eGeomType, bAllTouched,
+                               oPart.aPointX, oPart.aPointY,
+                               oPart.aPointVariant, oPart.aPartSize );
+    }
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -779,6 +867,420 @@ static CPLErr GDALRasterizeOptions( CSLConstList papszOptions,
     return CE_None;
 }
 
+/************************************************************************/
+/*                   GDALRasterizeGetNumThreads()                       */
+/************************************************************************/
+
+static int GDALRasterizeGetNumThreads( CSLConstList papszOptions )
+{
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if( pszThreads == nullptr )
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ?
+                                        CPLGetNumCPUs() : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                    GDALRasterizePreparedShape                        */
+/************************************************************************/
+
+namespace {
+struct GDALRasterizePreparedShape
+{
+    std::vector<GDALRasterizePreparedPart> aoParts{};
+    const double *padfBurnValues = nullptr;
+    const int64_t *panBurnValues = nullptr;
+    // Extent in pixel/line space. bBounded is false if one of the
+    // transformed coordinates is not finite, in which case the shape is
+    // submitted to all chunks.
+    bool bBounded = false;
+    double dfMinX = 0;
+    double dfMinY = 0;
+    double dfMaxX = 0;
+    double dfMaxY = 0;
+};
+
+struct GDALRasterizeChunkedContext
+{
+    GDALDataset *poDS = nullptr;
+    int nBandCount = 0;
+    int *panBandList = nullptr;
+    GDALDataType eType = GDT_Unknown;
+    int bAllTouched = FALSE;
+    GDALDataType eBurnValueType = GDT_Float64;
+    GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+    const std::vector<GDALRasterizePreparedShape> *paoShapes = nullptr;
+    // Indices of the jobs whose burning is done, and whose swath must be
+    // written by the calling thread.
+    std::mutex oFinishedMutex{};
+    std::vector<int> anFinishedJobs{};
+    std::atomic<bool> bError{false};
+};
+
+struct GDALRasterizeChunkJob
+{
+    GDALRasterizeChunkedContext *psCtxt = nullptr;
+    int iJob = 0;
+    int nYOff = 0;
+    int nYSize = 0;
+    unsigned char *pabyChunkBuf = nullptr;
+    // Indices in *paoShapes of the shapes that may intersect the chunk,
+    // in increasing order so that the burning order is preserved.
+    std::vector<int> anShapes{};
+};
+} // namespace
+
+/************************************************************************/
+/*                   GDALRasterizeComputeExtent()                       */
+/************************************************************************/
+
+static void GDALRasterizeComputeExtent( GDALRasterizePreparedShape& oShape )
+{
+    bool bFirst = true;
+    for( const auto& oPart: oShape.aoParts )
+    {
+        for( size_t i = 0; i < oPart.aPointX.size(); i++ )
+        {
+            const double dfX = oPart.aPointX[i];
+            const double dfY = oPart.aPointY[i];
+            if( !std::isfinite(dfX) || !std::isfinite(dfY) )
+            {
+                oShape.bBounded = false;
+                return;
+            }
+            if( bFirst )
+            {
+                oShape.dfMinX = oShape.dfMaxX = dfX;
+                oShape.dfMinY = oShape.dfMaxY = dfY;
+                bFirst = false;
+            }
+            else
+            {
+                oShape.dfMinX = std::min(oShape.dfMinX, dfX);
+                oShape.dfMaxX = std::max(oShape.dfMaxX, dfX);
+                oShape.dfMinY = std::min(oShape.dfMinY, dfY);
+                oShape.dfMaxY = std::max(oShape.dfMaxY, dfY);
+            }
+        }
+    }
+    // A shape without any point has nothing to burn: leave it bounded with
+    // an extent that does not intersect any chunk.
+    oShape.bBounded = true;
+    if( bFirst )
+        oShape.dfMinX = oShape.dfMinY = oShape.dfMaxX = oShape.dfMaxY = -2;
+}
+
+/************************************************************************/
+/*                     GDALRasterizeAddPreparedShape()                  */
+/************************************************************************/
+
+static void
+GDALRasterizeAddPreparedShape( std::vector<GDALRasterizePreparedShape>& aoShapes,
+                               const OGRGeometry *poShape,
+                               const double *padfBurnValues,
+                               const int64_t *panBurnValues,
+                               GDALBurnValueSrc eBurnValueSrc,
+                               GDALRasterMergeAlg eMergeAlg,
+                               GDALTransformerFunc pfnTransformer,
+                               void *pTransformArg )
+{
+    if( poShape == nullptr || poShape->IsEmpty() )
+        return;
+    aoShapes.emplace_back();
+    GDALRasterizePreparedShape& oShape = aoShapes.back();
+    oShape.padfBurnValues = padfBurnValues;
+    oShape.panBurnValues = panBurnValues;
+    GDALRasterizePrepareShape( poShape, eBurnValueSrc, eMergeAlg,
+                               pfnTransformer, pTransformArg, oShape.aoParts );
+    GDALRasterizeComputeExtent( oShape );
+}
+
+/************************************************************************/
+/*                        GDALRasterizeChunkRead()                      */
+/*                                                                      */
+/*      Read the swath of a job. Called by the calling thread only,     */
+/*      so that the I/O never runs in a job of the thread pool.         */
+/************************************************************************/
+
+static bool GDALRasterizeChunkRead( GDALRasterizeChunkJob *psJob )
+{
+    GDALRasterizeChunkedContext *psCtxt = psJob->psCtxt;
+    GDALDataset *poDS = psCtxt->poDS;
+    const int nXSize = poDS->GetRasterXSize();
+    const int nScanlineBytes = psCtxt->nBandCount * nXSize *
+                               GDALGetDataTypeSizeBytes(psCtxt->eType);
+    psJob->pabyChunkBuf = static_cast<unsigned char *>(
+        VSI_MALLOC2_VERBOSE(psJob->nYSize, nScanlineBytes));
+    if( psJob->pabyChunkBuf == nullptr )
+        return false;
+
+    if( poDS->RasterIO( GF_Read, 0, psJob->nYOff, nXSize, psJob->nYSize,
+                        psJob->pabyChunkBuf, nXSize, psJob->nYSize,
+                        psCtxt->eType,
+                        psCtxt->nBandCount, psCtxt->panBandList,
+                        0, 0, 0, nullptr ) != CE_None )
+    {
+        VSIFree( psJob->pabyChunkBuf );
+        psJob->pabyChunkBuf = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALRasterizeChunkWrite()                      */
+/*                                                                      */
+/*      Write back the swath of a job and free its buffer. Called by    */
+/*      the calling thread only.                                        */
+/************************************************************************/
+
+static bool GDALRasterizeChunkWrite( GDALRasterizeChunkJob *psJob )
+{
+    GDALRasterizeChunkedContext *psCtxt = psJob->psCtxt;
+    GDALDataset *poDS = psCtxt->poDS;
+    const int nXSize = poDS->GetRasterXSize();
+    const bool bRet =
+        poDS->RasterIO( GF_Write, 0, psJob->nYOff, nXSize, psJob->nYSize,
+                        psJob->pabyChunkBuf, nXSize, psJob->nYSize,
+                        psCtxt->eType,
+                        psCtxt->nBandCount, psCtxt->panBandList,
+                        0, 0, 0, nullptr ) == CE_None;
+    VSIFree( psJob->pabyChunkBuf );
+    psJob->pabyChunkBuf = nullptr;
+    return bRet;
+}
+
+/************************************************************************/
+/*                      GDALRasterizeChunkJobFunc()                     */
+/*                                                                      */
+/*      Burn the shapes of a job into its swath, which has already      */
+/*      been read.                                                      */
+/************************************************************************/
+
+static void GDALRasterizeChunkJobFunc( void *pData )
+{
+    GDALRasterizeChunkJob *psJob = static_cast<GDALRasterizeChunkJob *>(pData);
+    GDALRasterizeChunkedContext *psCtxt = psJob->psCtxt;
+    const int nXSize = psCtxt->poDS->GetRasterXSize();
+
+    GDALRasterizeInfo sInfo;
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    for( const int iShape: psJob->anShapes )
+    {
+        if( psCtxt->bError )
+            break;
+        const auto& oShape = (*psCtxt->paoShapes)[iShape];
+        GDALRasterizeInitInfo( &sInfo, psJob->pabyChunkBuf,
+                               nXSize, psJob->nYSize,
+                               psCtxt->nBandCount, psCtxt->eType,
+                               0, 0, 0,
+                               psCtxt->eBurnValueType,
+                               oShape.padfBurnValues, oShape.panBurnValues,
+                               psCtxt->eBurnValueSource, psCtxt->eMergeAlg );
+        for( const auto& oPart: oShape.aoParts )
+        {
+            // The prepared coordinates are shared between chunks, so shift
+            // a copy of them.
+            aPointX.assign(oPart.aPointX.begin(), oPart.aPointX.end());
+            aPointY.resize(oPart.aPointY.size());
+            for( size_t i = 0; i < oPart.aPointY.size(); i++ )
+                aPointY[i] = oPart.aPointY[i] - psJob->nYOff;
+            aPointVariant.assign(oPart.aPointVariant.begin(),
+                                 oPart.aPointVariant.end());
+            gv_rasterize_one_part( &sInfo, oPart.eGeomType,
+                                   psCtxt->bAllTouched,
+                                   aPointX, aPointY, aPointVariant,
+                                   oPart.aPartSize );
+        }
+    }
+
+    std::lock_guard<std::mutex> oLock(psCtxt->oFinishedMutex);
+    psCtxt->anFinishedJobs.push_back(psJob->iJob);
+}
+
+/************************************************************************/
+/*                    GDALRasterizeChunksMultiThreaded()                */
+/*                                                                      */
+/*      Burn prepared shapes by swaths of nYChunkSize lines, each       */
+/*      swath being burnt by a job of the global thread pool. The       */
+/*      swaths are read and written by the calling thread, so that      */
+/*      jobs never wait for I/O that may itself need the pool. The      */
+/*      shapes are binned by swath from their pixel extent, so each     */
+/*      job only visits the shapes that may intersect it.               */
+/************************************************************************/
+
+static CPLErr
+GDALRasterizeChunksMultiThreaded( GDALDataset *poDS,
+                                  int nBandCount, int *panBandList,
+                                  GDALDataType eType, int nYChunkSize,
+                                  int bAllTouched,
+                                  GDALDataType eBurnValueType,
+                                  GDALBurnValueSrc eBurnValueSource,
+                                  GDALRasterMergeAlg eMergeAlg,
+                                  const std::vector<GDALRasterizePreparedShape>& aoShapes,
+                                  int nThreads,
+                                  GDALProgressFunc pfnProgress,
+                                  void *pProgressArg )
+{
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    if( nYSize == 0 )
+        return CE_None;
+    if( nYChunkSize < 1 )
+        nYChunkSize = 1;
+    if( nYChunkSize > nYSize )
+        nYChunkSize = nYSize;
+    const int nChunks = (nYSize + nYChunkSize - 1) / nYChunkSize;
+
+    GDALRasterizeChunkedContext sCtxt;
+    sCtxt.poDS = poDS;
+    sCtxt.nBandCount = nBandCount;
+    sCtxt.panBandList = panBandList;
+    sCtxt.eType = eType;
+    sCtxt.bAllTouched = bAllTouched;
+    sCtxt.eBurnValueType = eBurnValueType;
+    sCtxt.eBurnValueSource = eBurnValueSource;
+    sCtxt.eMergeAlg = eMergeAlg;
+    sCtxt.paoShapes = &aoShapes;
+
+    std::vector<GDALRasterizeChunkJob> asJobs;
+    try
+    {
+        asJobs.resize(nChunks);
+        for( int i = 0; i < nChunks; i++ )
+        {
+            asJobs[i].psCtxt = &sCtxt;
+            asJobs[i].iJob = i;
+            asJobs[i].nYOff = i * nYChunkSize;
+            asJobs[i].nYSize = std::min(nYChunkSize, nYSize - i * nYChunkSize);
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Bin the shapes by swath. A margin of one pixel is taken to      */
+/*      account for the ALL_TOUCHED mode.                               */
+/* -------------------------------------------------------------------- */
+        for( int iShape = 0; iShape < static_cast<int>(aoShapes.size());
+             iShape++ )
+        {
+            const auto& oShape = aoShapes[iShape];
+            int iFirstChunk = 0;
+            int iLastChunk = nChunks - 1;
+            if( oShape.bBounded )
+            {
+                if( oShape.dfMaxX < -1 || oShape.dfMinX > nXSize + 1 ||
+                    oShape.dfMaxY < -1 || oShape.dfMinY > nYSize + 1 )
+                {
+                    continue;
+                }
+                const int nMinLine = std::max(0,
+                    static_cast<int>(std::floor(oShape.dfMinY)) - 1);
+                const int nMaxLine = std::min(nYSize - 1,
+                    static_cast<int>(std::floor(oShape.dfMaxY)) + 1);
+                iFirstChunk = nMinLine / nYChunkSize;
+                iLastChunk = nMaxLine / nYChunkSize;
+            }
+            for( int iChunk = iFirstChunk; iChunk <= iLastChunk; iChunk++ )
+                asJobs[iChunk].anShapes.push_back(iShape);
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate rasterization jobs");
+        return CE_Failure;
+    }
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    // Bound the number of swaths in memory at the same time.
+    const int nMaxJobsInFlight = poJobQueue ? nThreads : 1;
+
+    int nSubmitted = 0;
+    int nDone = 0;
+    std::vector<int> anFinishedJobs;
+    while( nDone < nChunks )
+    {
+        while( !sCtxt.bError && nSubmitted < nChunks &&
+               nSubmitted - nDone < nMaxJobsInFlight )
+        {
+            GDALRasterizeChunkJob *psJob = &asJobs[nSubmitted];
+            if( !GDALRasterizeChunkRead(psJob) )
+            {
+                sCtxt.bError = true;
+                break;
+            }
+            ++nSubmitted;
+            if( !poJobQueue || !poJobQueue->SubmitJob(GDALRasterizeChunkJobFunc, psJob) )
+                GDALRasterizeChunkJobFunc(psJob);
+        }
+        if( nDone == nSubmitted )
+            break;
+
+        if( poJobQueue )
+            poJobQueue->WaitCompletion(nSubmitted - nDone - 1);
+        {
+            std::lock_guard<std::mutex> oLock(sCtxt.oFinishedMutex);
+            std::swap(anFinishedJobs, sCtxt.anFinishedJobs);
+        }
+        for( const int iJob: anFinishedJobs )
+        {
+            ++nDone;
+            if( sCtxt.bError )
+            {
+                VSIFree(asJobs[iJob].pabyChunkBuf);
+                asJobs[iJob].pabyChunkBuf = nullptr;
+            }
+            else if( !GDALRasterizeChunkWrite(&asJobs[iJob]) )
+            {
+                sCtxt.bError = true;
+            }
+            else if( !pfnProgress( nDone / static_cast<double>(nChunks), "",
+                                   pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                sCtxt.bError = true;
+            }
+        }
+        anFinishedJobs.clear();
+    }
+
+    return sCtxt.bError ? CE_Failure : CE_None;
+}
+
+/************************************************************************/
+/*                 GDALRasterizeGetMultiThreadedChunkSize()             */
+/*                                                                      */
+/*      Height of the swaths in multi-threaded mode: nThreads swaths    */
+/*      are in memory at the same time, and we want several swaths      */
+/*      per thread for load balancing.                                  */
+/************************************************************************/
+
+static int GDALRasterizeGetMultiThreadedChunkSize( CSLConstList papszOptions,
+                                                   int nScanlineBytes,
+                                                   int nYSize, int nThreads )
+{
+    const char *pszYChunkSize = CSLFetchNameValue(papszOptions, "CHUNKYSIZE");
+    int nYChunkSize = 0;
+    if( pszYChunkSize != nullptr &&
+        ((nYChunkSize = atoi(pszYChunkSize))) > 0 )
+    {
+        return nYChunkSize;
+    }
+
+    const GIntBig nYChunkSize64 =
+        GDALGetCacheMax64() / nScanlineBytes / nThreads;
+    const int knIntMax = std::numeric_limits<int>::max();
+    nYChunkSize = nYChunkSize64 > knIntMax ? knIntMax
+                  : static_cast<int>(nYChunkSize64);
+    const int nBalancedChunkSize = std::max(16,
+        static_cast<int>((static_cast<GIntBig>(nYSize) + 4 * nThreads - 1) /
+                         (4 * nThreads)));
+    return std::max(1, std::min(nYChunkSize, nBalancedChunkSize));
+}
+
 /************************************************************************/
 /*                      GDALRasterizeGeometries()                       */
 /************************************************************************/
@@ -844,6 +1346,12 @@ CPLErr GDALRasterizeGeometriesInternal( GDALDatasetH hDS,
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.7) Number of worker threads, or ALL_CPUS.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * When greater than 1, the geometries are transformed to pixel/line
+ * coordinates once, and are then burnt by swaths of lines in parallel, each
+ * swath only visiting the geometries whose extent intersects it. The OPTIM
+ * option is ignored in that mode.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1053,6 +1561,58 @@ CPLErr GDALRasterizeGeometriesInternal( GDALDatasetH hDS,
         }
     }
 
+/* -------------------------------------------------------------------- */
+/*      Multi-threaded mode: transform all the geometries once, and     */
+/*      burn them by swaths in parallel.                                */
+/* -------------------------------------------------------------------- */
+    const int nThreads = GDALRasterizeGetNumThreads(papszOptions);
+    if( nThreads > 1 )
+    {
+        const GDALDataType eType =
+            GDALGetNonComplexDataType(poBand->GetRasterDataType());
+        const int nScanlineBytes =
+            nBandCount * poDS->GetRasterXSize() * GDALGetDataTypeSizeBytes(eType);
+
+        std::vector<GDALRasterizePreparedShape> aoShapes;
+        CPLErr eErr = CE_None;
+        try
+        {
+            aoShapes.reserve(nGeomCount);
+            for( int iShape = 0; iShape < nGeomCount; iShape++ )
+            {
+                GDALRasterizeAddPreparedShape(
+                    aoShapes,
+                    OGRGeometry::FromHandle(pahGeometries[iShape]),
+                    padfGeomBurnValues ? padfGeomBurnValues + iShape*nBandCount : nullptr,
+                    panGeomBurnValues ? panGeomBurnValues + iShape*nBandCount : nullptr,
+                    eBurnValueSource, eMergeAlg,
+                    pfnTransformer, pTransformArg );
+            }
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for prepared geometries");
+            eErr = CE_Failure;
+        }
+
+        if( bNeedToFreeTransformer )
+            GDALDestroyTransformer( pTransformArg );
+
+        if( eErr == CE_None )
+        {
+            pfnProgress( 0.0, nullptr, pProgressArg );
+            eErr = GDALRasterizeChunksMultiThreaded(
+                poDS, nBandCount, const_cast<int*>(panBandList), eType,
+                GDALRasterizeGetMultiThreadedChunkSize(
+                    papszOptions, nScanlineBytes,
+                    poDS->GetRasterYSize(), nThreads),
+                bAllTouched, eBurnValueType, eBurnValueSource, eMergeAlg,
+                aoShapes, nThreads, pfnProgress, pProgressArg);
+        }
+        return eErr;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Choice of optimisation in auto mode. Use vector optim :         */
 /*      1) if output is tiled                                           */
@@ -1335,6 +1895,68 @@ CPLErr GDALRasterizeGeometriesInternal( GDALDatasetH hDS,
     return eErr;
 }
 
+/************************************************************************/
+/*                  GDALRasterizeLayerMultiThreaded()                   */
+/*                                                                      */
+/*      Read and transform all the geometries of a layer, and burn      */
+/*      them with GDALRasterizeChunksMultiThreaded().                   */
+/************************************************************************/
+
+static CPLErr
+GDALRasterizeLayerMultiThreaded( GDALDataset *poDS,
+                                 int nBandCount, int *panBandList,
+                                 GDALDataType eType,
+                                 OGRLayer *poLayer, int iBurnField,
+                                 const double *padfBurnValues,
+                                 int bAllTouched,
+                                 GDALBurnValueSrc eBurnValueSource,
+                                 GDALRasterMergeAlg eMergeAlg,
+                                 GDALTransformerFunc pfnTransformer,
+                                 void *pTransformArg,
+                                 int nYChunkSize, int nThreads,
+                                 GDALProgressFunc pfnProgress,
+                                 void *pProgressArg )
+{
+    std::vector<GDALRasterizePreparedShape> aoShapes;
+    std::vector<double> adfAttrValues;
+    try
+    {
+        for( auto& poFeat: poLayer )
+        {
+            const size_t nShapesBefore = aoShapes.size();
+            GDALRasterizeAddPreparedShape( aoShapes, poFeat->GetGeometryRef(),
+                                           padfBurnValues, nullptr,
+                                           eBurnValueSource, eMergeAlg,
+                                           pfnTransformer, pTransformArg );
+            if( iBurnField >= 0 && aoShapes.size() != nShapesBefore )
+            {
+                adfAttrValues.resize(adfAttrValues.size() + nBandCount,
+                                     poFeat->GetFieldAsDouble(iBurnField));
+            }
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for prepared geometries");
+        return CE_Failure;
+    }
+    poLayer->ResetReading();
+
+    // Now that adfAttrValues will no longer be reallocated.
+    if( iBurnField >= 0 )
+    {
+        for( size_t i = 0; i < aoShapes.size(); i++ )
+            aoShapes[i].padfBurnValues = adfAttrValues.data() + i * nBandCount;
+    }
+
+    return GDALRasterizeChunksMultiThreaded( poDS, nBandCount, panBandList,
+                                             eType, nYChunkSize, bAllTouched,
+                                             GDT_Float64, eBurnValueSource,
+                                             eMergeAlg, aoShapes, nThreads,
+                                             pfnProgress, pProgressArg );
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1389,6 +2011,11 @@ CPLErr GDALRasterizeGeometriesInternal( GDALDatasetH hDS,
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.7) Number of worker threads, or ALL_CPUS.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * When greater than 1, the geometries of each layer are read and
+ * transformed to pixel/line coordinates once, and kept in memory while they
+ * are burnt by swaths of lines in parallel.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1439,6 +2066,8 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
         return CE_Failure;
     }
 
+    const int nThreads = GDALRasterizeGetNumThreads(papszOptions);
+
 /* -------------------------------------------------------------------- */
 /*      Establish a chunksize to operate on.  The larger the chunk      */
 /*      size the less times we need to make a pass through all the      */
@@ -1468,21 +2097,33 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
     if( nYChunkSize > poDS->GetRasterYSize() )
         nYChunkSize = poDS->GetRasterYSize();
 
+    // In multi-threaded mode, the swaths are allocated by each job.
+    unsigned char *pabyChunkBuf = nullptr;
+    if( nThreads > 1 )
+    {
+        nYChunkSize = GDALRasterizeGetMultiThreadedChunkSize(
+            papszOptions, nScanlineBytes, poDS->GetRasterYSize(), nThreads);
+        nYChunkSize = std::min(nYChunkSize, poDS->GetRasterYSize());
+    }
+
     CPLDebug( "GDAL", "Rasterizer operating on %d swaths of %d scanlines.",
               (poDS->GetRasterYSize() + nYChunkSize - 1) / nYChunkSize,
               nYChunkSize );
-    unsigned char *pabyChunkBuf = static_cast<unsigned char *>(
-        VSI_MALLOC2_VERBOSE(nYChunkSize, nScanlineBytes));
-    if( pabyChunkBuf == nullptr )
+    if( nThreads == 1 )
     {
-        return CE_Failure;
+        pabyChunkBuf = static_cast<unsigned char *>(
+            VSI_MALLOC2_VERBOSE(nYChunkSize, nScanlineBytes));
+        if( pabyChunkBuf == nullptr )
+        {
+            return CE_Failure;
+        }
     }
 
 /* -------------------------------------------------------------------- */
 /*      Read the image once for all layers if user requested to render  */
 /*      the whole raster in single chunk.                               */
 /* -------------------------------------------------------------------- */
-    if( nYChunkSize == poDS->GetRasterYSize() )
+    if( nThreads == 1 && nYChunkSize == poDS->GetRasterYSize() )
     {
         if( poDS->RasterIO( GF_Read, 0, 0, poDS->GetRasterXSize(),
                             nYChunkSize, pabyChunkBuf,
@@ -1599,6 +2240,30 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
 
         poLayer->ResetReading();
 
+        if( nThreads > 1 )
+        {
+            void *pScaledProgress = GDALCreateScaledProgress(
+                iLayer / static_cast<double>(nLayerCount),
+                (iLayer + 1) / static_cast<double>(nLayerCount),
+                pfnProgress, pProgressArg );
+            eErr = GDALRasterizeLayerMultiThreaded(
+                poDS, nBandCount, panBandList, eType, poLayer, iBurnField,
+                padfBurnValues, bAllTouched, eBurnValueSource, eMergeAlg,
+                pfnTransformer, pTransformArg, nYChunkSize, nThreads,
+                GDALScaledProgress, pScaledProgress );
+            GDALDestroyScaledProgress( pScaledProgress );
+
+            if( bNeedToFreeTransformer )
+            {
+                GDALDestroyTransformer( pTransformArg );
+                pTransformArg = nullptr;
+                pfnTransformer = nullptr;
+            }
+            if( eErr != CE_None )
+                break;
+            continue;
+        }
+
 /* -------------------------------------------------------------------- */
 /*      Loop over image in designated chunks.                           */
 /* -------------------------------------------------------------------- */
@@ -1694,7 +2359,8 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
 /*      Write out the image once for all layers if user requested       */
 /*      to render the whole raster in single chunk.                     */
 /* -------------------------------------------------------------------- */
-    if( eErr == CE_None && nYChunkSize == poDS->GetRasterYSize() )
+    if( eErr == CE_None && nThreads == 1 &&
+        nYChunkSize == poDS->GetRasterYSize() )
     {
         eErr = poDS->RasterIO( GF_Write, 0, 0,
                                 poDS->GetRasterXSize(), nYChunkSize,
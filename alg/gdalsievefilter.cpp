@@ -30,17 +30,24 @@
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
+#include <cmath>
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
 
@@ -146,6 +153,1132 @@ static inline void CompareNeighbour( int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*      Tiled, multi-threaded implementation.                           */
+/* ==================================================================== */
+/************************************************************************/
+
+/*
+ * The result of the sieve only depends on the size of each polygon, and on
+ * its largest neighbour, which is the first one encountered, in the order of
+ * the second pass above, among the neighbours of maximum size.  The tiled
+ * implementation computes the same information with a memory use that
+ * depends on the tile size and on the number of polygons crossing tile
+ * borders, rather than on the total number of polygons:
+ *
+ * 1) Label each tile with a union-find.  Polygons touching the side of a
+ *    neighbouring tile ("border polygons") are recorded, as well as the
+ *    labels of the tile edges.
+ *
+ * 2) Merge border polygons of adjacent tiles with a global union-find over
+ *    the tile edges, which gives their total size.
+ *
+ * 3) Label each tile again, and find the largest neighbour of its polygons
+ *    from the tile pixels and the edges of the neighbouring tiles.  Chains of
+ *    small polygons are followed inside the tile, until reaching a polygon
+ *    large enough or a border polygon.  Candidates for the largest neighbour
+ *    of border polygons are recorded.
+ *
+ * 4) Resolve the chains going through border polygons.
+ *
+ * 5) Label each tile again, and write the remapped pixel values.
+ *
+ * Tiles are processed in parallel in steps 1, 3 and 5.
+ */
+
+constexpr int SIEVE_MIN_TILE_SIZE = 64;
+constexpr int SIEVE_MAX_TILE_SIZE = 4096;
+
+// Upper bound of the working memory needed per pixel of a tile.
+constexpr int SIEVE_BYTES_PER_PIXEL = 80;
+
+constexpr size_t SIEVE_INTERIOR = std::numeric_limits<size_t>::max();
+
+namespace {
+
+// What the pixels of a polygon must be replaced with.
+enum
+{
+    SIEVE_UNCHANGED,
+    SIEVE_VALUE,
+    // The same as a border polygon, not yet resolved.
+    SIEVE_BORDER
+};
+
+struct GDALSieveResolution
+{
+    int eType = SIEVE_UNCHANGED;
+    std::int64_t nValue = 0;
+    size_t nBorderComp = 0;
+};
+
+// Largest neighbour of a border polygon found in one tile.
+struct GDALSieveCandidate
+{
+    GIntBig nSize = -1;
+    // Position of the first encounter of the neighbour.
+    GUIntBig nKey = 0;
+    GDALSieveResolution sTarget{};
+};
+
+struct GDALSieveTile
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+
+    // Index of the first border polygon of the tile in the global arrays.
+    size_t nFirstBorderComp = 0;
+    std::vector<std::int64_t> anBorderValue{};
+    std::vector<GIntBig> anBorderSize{};
+
+    // Border polygon of the pixels of the sides of the tile that have a
+    // neighbouring tile (relative to nFirstBorderComp), or -1 for nodata.
+    std::vector<GInt32> anTopEdge{};
+    std::vector<GInt32> anBottomEdge{};
+    std::vector<GInt32> anLeftEdge{};
+    std::vector<GInt32> anRightEdge{};
+
+    std::vector<std::pair<size_t, GDALSieveCandidate>> asCandidates{};
+};
+
+struct GDALSieveTiledContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hDstBand = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nConnectedness = 4;
+    int nSizeThreshold = 0;
+    int nXTiles = 0;
+    int nYTiles = 0;
+    std::vector<GDALSieveTile> asTiles{};
+
+    // Border polygons, indexed by nFirstBorderComp + index in the tile.
+    std::vector<size_t> anBorderParent{};
+    std::vector<std::int64_t> anBorderValue{};
+    std::vector<GIntBig> anBorderSize{};
+    std::vector<GDALSieveResolution> asBorderResolution{};
+
+    // Protects all the raster I/O.
+    std::mutex oIOMutex{};
+    std::atomic<bool> bError{false};
+};
+
+struct GDALSieveTileJob
+{
+    GDALSieveTiledContext* psCtxt = nullptr;
+    int iTile = 0;
+};
+
+// Pixels of a tile and their polygon labels.
+struct GDALSieveTileData
+{
+    std::vector<std::int64_t> anValue{};
+    std::vector<GByte> abyMask{};
+    std::vector<GInt32> anLabel{};
+    std::vector<GIntBig> anSize{};
+    std::vector<std::int64_t> anLabelValue{};
+    // Index among the border polygons of the tile, or -1.
+    std::vector<GInt32> anBorderIdx{};
+};
+
+struct GDALSieveNode
+{
+    GIntBig nSize = 0;
+    std::int64_t nValue = 0;
+    // Root border polygon, or SIEVE_INTERIOR.
+    size_t nBorderComp = SIEVE_INTERIOR;
+    GIntBig nBestSize = -1;
+    GUIntBig nBestKey = 0;
+    int iBest = -1;
+};
+
+// Polygons of a tile and of the edges of its neighbours, with their
+// largest neighbour.
+struct GDALSieveTileGraph
+{
+    GDALSieveTileData sData{};
+    std::vector<GDALSieveNode> asNodes{};
+    std::vector<int> anLabelNode{};
+    std::unordered_map<size_t, int> oMapBorderNode{};
+    // Resolution of the interior nodes.
+    std::vector<GDALSieveResolution> asResolution{};
+};
+
+} // namespace
+
+/************************************************************************/
+/*                         GDALSieveLabelTile()                         */
+/*                                                                      */
+/*      Two pass union-find labelling of the pixels of a tile.  Labels  */
+/*      are numbered in the order of their first pixel, and nodata      */
+/*      pixels get -1.  Returns the number of labels.                   */
+/************************************************************************/
+
+static int GDALSieveLabelTile( const std::int64_t* panValue,
+                               const GByte* pabyMask,
+                               int nXSize, int nYSize, int nConnectedness,
+                               GInt32* panLabel )
+{
+    std::vector<GInt32> anParent;
+    const auto Find = [&anParent](GInt32 i)
+    {
+        while( anParent[i] != i )
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const size_t i = static_cast<size_t>(iY) * nXSize + iX;
+            if( (pabyMask && pabyMask[i] == 0) ||
+                panValue[i] == GP_NODATA_MARKER )
+            {
+                panLabel[i] = -1;
+                continue;
+            }
+
+            GInt32 nLabel = -1;
+            const auto Join = [&](size_t j)
+            {
+                if( panLabel[j] < 0 || panValue[j] != panValue[i] )
+                    return;
+                const GInt32 nOther = Find(panLabel[j]);
+                if( nLabel < 0 )
+                    nLabel = nOther;
+                else if( nOther < nLabel )
+                {
+                    anParent[nLabel] = nOther;
+                    nLabel = nOther;
+                }
+                else if( nOther > nLabel )
+                    anParent[nOther] = nLabel;
+            };
+
+            if( iX > 0 )
+                Join(i - 1);
+            if( iY > 0 )
+            {
+                Join(i - nXSize);
+                if( nConnectedness == 8 && iX > 0 )
+                    Join(i - nXSize - 1);
+                if( nConnectedness == 8 && iX < nXSize - 1 )
+                    Join(i - nXSize + 1);
+            }
+
+            if( nLabel < 0 )
+            {
+                nLabel = static_cast<GInt32>(anParent.size());
+                anParent.push_back(nLabel);
+            }
+            panLabel[i] = nLabel;
+        }
+    }
+
+    std::vector<GInt32> anCompact(anParent.size(), -1);
+    GInt32 nLabels = 0;
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+    for( size_t i = 0; i < nPixels; i++ )
+    {
+        if( panLabel[i] < 0 )
+            continue;
+        const GInt32 nRoot = Find(panLabel[i]);
+        if( anCompact[nRoot] < 0 )
+            anCompact[nRoot] = nLabels++;
+        panLabel[i] = anCompact[nRoot];
+    }
+
+    return nLabels;
+}
+
+/************************************************************************/
+/*                       GDALSieveReadAndLabelTile()                    */
+/************************************************************************/
+
+static bool GDALSieveReadAndLabelTile( GDALSieveTiledContext& sCtxt,
+                                       int iTile, GDALSieveTileData& sData )
+{
+    const GDALSieveTile& sTile = sCtxt.asTiles[iTile];
+    const int nXSize = sTile.nXSize;
+    const int nYSize = sTile.nYSize;
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+
+    sData.anValue.resize(nPixels);
+    sData.anLabel.resize(nPixels);
+    if( sCtxt.hMaskBand )
+        sData.abyMask.resize(nPixels);
+
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+        if( GDALRasterIO( sCtxt.hSrcBand, GF_Read,
+                          sTile.nXOff, sTile.nYOff, nXSize, nYSize,
+                          sData.anValue.data(), nXSize, nYSize,
+                          GDT_Int64, 0, 0 ) != CE_None ||
+            (sCtxt.hMaskBand &&
+             GDALRasterIO( sCtxt.hMaskBand, GF_Read,
+                           sTile.nXOff, sTile.nYOff, nXSize, nYSize,
+                           sData.abyMask.data(), nXSize, nYSize,
+                           GDT_Byte, 0, 0 ) != CE_None) )
+        {
+            return false;
+        }
+    }
+
+    const int nLabels = GDALSieveLabelTile(
+        sData.anValue.data(),
+        sCtxt.hMaskBand ? sData.abyMask.data() : nullptr,
+        nXSize, nYSize, sCtxt.nConnectedness, sData.anLabel.data() );
+
+    sData.anSize.assign(nLabels, 0);
+    sData.anLabelValue.resize(nLabels);
+    for( size_t i = 0; i < nPixels; i++ )
+    {
+        const GInt32 nLabel = sData.anLabel[i];
+        if( nLabel >= 0 )
+        {
+            sData.anSize[nLabel]++;
+            sData.anLabelValue[nLabel] = sData.anValue[i];
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Find the polygons touching a side with a neighbouring tile.     */
+/* -------------------------------------------------------------------- */
+    sData.anBorderIdx.assign(nLabels, -1);
+    const int iTileX = iTile % sCtxt.nXTiles;
+    const int iTileY = iTile / sCtxt.nXTiles;
+    const auto MarkBorder = [&sData](size_t i)
+    {
+        if( sData.anLabel[i] >= 0 )
+            sData.anBorderIdx[sData.anLabel[i]] = 0;
+    };
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        if( iTileY > 0 )
+            MarkBorder(iX);
+        if( iTileY < sCtxt.nYTiles - 1 )
+            MarkBorder(static_cast<size_t>(nYSize - 1) * nXSize + iX);
+    }
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        if( iTileX > 0 )
+            MarkBorder(static_cast<size_t>(iY) * nXSize);
+        if( iTileX < sCtxt.nXTiles - 1 )
+            MarkBorder(static_cast<size_t>(iY) * nXSize + nXSize - 1);
+    }
+    GInt32 nBorderComps = 0;
+    for( int iLabel = 0; iLabel < nLabels; iLabel++ )
+    {
+        if( sData.anBorderIdx[iLabel] == 0 )
+            sData.anBorderIdx[iLabel] = nBorderComps++;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALSieveLabelTileJobFunc()                    */
+/*                                                                      */
+/*      Step 1: record the border polygons and tile edges.              */
+/************************************************************************/
+
+static void GDALSieveLabelTileJobFunc( void* pData )
+{
+    const GDALSieveTileJob* psJob = static_cast<const GDALSieveTileJob*>(pData);
+    GDALSieveTiledContext& sCtxt = *(psJob->psCtxt);
+    if( sCtxt.bError )
+        return;
+
+    GDALSieveTile& sTile = sCtxt.asTiles[psJob->iTile];
+    const int iTileX = psJob->iTile % sCtxt.nXTiles;
+    const int iTileY = psJob->iTile / sCtxt.nXTiles;
+    const int nXSize = sTile.nXSize;
+    const int nYSize = sTile.nYSize;
+    try
+    {
+        GDALSieveTileData sData;
+        if( !GDALSieveReadAndLabelTile(sCtxt, psJob->iTile, sData) )
+        {
+            sCtxt.bError = true;
+            return;
+        }
+
+        for( size_t iLabel = 0; iLabel < sData.anBorderIdx.size(); iLabel++ )
+        {
+            if( sData.anBorderIdx[iLabel] >= 0 )
+            {
+                sTile.anBorderValue.push_back(sData.anLabelValue[iLabel]);
+                sTile.anBorderSize.push_back(sData.anSize[iLabel]);
+            }
+        }
+
+        const auto EdgeValue = [&sData](size_t i)
+        {
+            const GInt32 nLabel = sData.anLabel[i];
+            return nLabel < 0 ? -1 : sData.anBorderIdx[nLabel];
+        };
+        if( iTileY > 0 )
+        {
+            sTile.anTopEdge.resize(nXSize);
+            for( int iX = 0; iX < nXSize; iX++ )
+                sTile.anTopEdge[iX] = EdgeValue(iX);
+        }
+        if( iTileY < sCtxt.nYTiles - 1 )
+        {
+            sTile.anBottomEdge.resize(nXSize);
+            for( int iX = 0; iX < nXSize; iX++ )
+                sTile.anBottomEdge[iX] = EdgeValue(
+                    static_cast<size_t>(nYSize - 1) * nXSize + iX);
+        }
+        if( iTileX > 0 )
+        {
+            sTile.anLeftEdge.resize(nYSize);
+            for( int iY = 0; iY < nYSize; iY++ )
+                sTile.anLeftEdge[iY] = EdgeValue(
+                    static_cast<size_t>(iY) * nXSize);
+        }
+        if( iTileX < sCtxt.nXTiles - 1 )
+        {
+            sTile.anRightEdge.resize(nYSize);
+            for( int iY = 0; iY < nYSize; iY++ )
+                sTile.anRightEdge[iY] = EdgeValue(
+                    static_cast<size_t>(iY) * nXSize + nXSize - 1);
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALSieveFilter()");
+        sCtxt.bError = true;
+    }
+}
+
+/************************************************************************/
+/*                       GDALSieveMergeBorderComps()                    */
+/*                                                                      */
+/*      Step 2: merge the border polygons of adjacent tiles.            */
+/************************************************************************/
+
+static void GDALSieveMergeBorderComps( GDALSieveTiledContext& sCtxt )
+{
+    size_t nBorderComps = 0;
+    for( auto& sTile : sCtxt.asTiles )
+    {
+        sTile.nFirstBorderComp = nBorderComps;
+        nBorderComps += sTile.anBorderValue.size();
+    }
+
+    sCtxt.anBorderParent.resize(nBorderComps);
+    sCtxt.anBorderValue.resize(nBorderComps);
+    sCtxt.anBorderSize.resize(nBorderComps);
+    for( auto& sTile : sCtxt.asTiles )
+    {
+        std::copy(sTile.anBorderValue.begin(), sTile.anBorderValue.end(),
+                  sCtxt.anBorderValue.begin() + sTile.nFirstBorderComp);
+        std::copy(sTile.anBorderSize.begin(), sTile.anBorderSize.end(),
+                  sCtxt.anBorderSize.begin() + sTile.nFirstBorderComp);
+        std::vector<std::int64_t>().swap(sTile.anBorderValue);
+        std::vector<GIntBig>().swap(sTile.anBorderSize);
+    }
+    for( size_t i = 0; i < nBorderComps; i++ )
+        sCtxt.anBorderParent[i] = i;
+
+    std::vector<size_t>& anParent = sCtxt.anBorderParent;
+    const auto Find = [&anParent](size_t i)
+    {
+        while( anParent[i] != i )
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+    const auto Union = [&sCtxt, &Find](const GDALSieveTile& sTile1,
+                                       GInt32 nEdge1,
+                                       const GDALSieveTile& sTile2,
+                                       GInt32 nEdge2)
+    {
+        if( nEdge1 < 0 || nEdge2 < 0 )
+            return;
+        const size_t i1 = sTile1.nFirstBorderComp + nEdge1;
+        const size_t i2 = sTile2.nFirstBorderComp + nEdge2;
+        if( sCtxt.anBorderValue[i1] != sCtxt.anBorderValue[i2] )
+            return;
+        const size_t nRoot1 = Find(i1);
+        const size_t nRoot2 = Find(i2);
+        if( nRoot1 < nRoot2 )
+            sCtxt.anBorderParent[nRoot2] = nRoot1;
+        else if( nRoot2 < nRoot1 )
+            sCtxt.anBorderParent[nRoot1] = nRoot2;
+    };
+
+    const bool b8 = sCtxt.nConnectedness == 8;
+    for( int iTileY = 0; iTileY < sCtxt.nYTiles; iTileY++ )
+    {
+        for( int iTileX = 0; iTileX < sCtxt.nXTiles; iTileX++ )
+        {
+            const GDALSieveTile& sTile =
+                sCtxt.asTiles[iTileY * sCtxt.nXTiles + iTileX];
+            if( iTileX < sCtxt.nXTiles - 1 )
+            {
+                const GDALSieveTile& sRight =
+                    sCtxt.asTiles[iTileY * sCtxt.nXTiles + iTileX + 1];
+                for( int iY = 0; iY < sTile.nYSize; iY++ )
+                {
+                    const GInt32 nEdge = sTile.anRightEdge[iY];
+                    Union(sTile, nEdge, sRight, sRight.anLeftEdge[iY]);
+                    if( b8 && iY > 0 )
+                        Union(sTile, nEdge, sRight, sRight.anLeftEdge[iY - 1]);
+                    if( b8 && iY < sTile.nYSize - 1 )
+                        Union(sTile, nEdge, sRight, sRight.anLeftEdge[iY + 1]);
+                }
+            }
+            if( iTileY < sCtxt.nYTiles - 1 )
+            {
+                const GDALSieveTile& sBelow =
+                    sCtxt.asTiles[(iTileY + 1) * sCtxt.nXTiles + iTileX];
+                for( int iX = 0; iX < sTile.nXSize; iX++ )
+                {
+                    const GInt32 nEdge = sTile.anBottomEdge[iX];
+                    Union(sTile, nEdge, sBelow, sBelow.anTopEdge[iX]);
+                    if( b8 && iX > 0 )
+                        Union(sTile, nEdge, sBelow, sBelow.anTopEdge[iX - 1]);
+                    if( b8 && iX < sTile.nXSize - 1 )
+                        Union(sTile, nEdge, sBelow, sBelow.anTopEdge[iX + 1]);
+                }
+                if( b8 && iTileX < sCtxt.nXTiles - 1 )
+                {
+                    const GDALSieveTile& sBelowRight =
+                        sCtxt.asTiles[(iTileY + 1) * sCtxt.nXTiles + iTileX + 1];
+                    Union(sTile, sTile.anBottomEdge[sTile.nXSize - 1],
+                          sBelowRight, sBelowRight.anTopEdge[0]);
+                }
+                if( b8 && iTileX > 0 )
+                {
+                    const GDALSieveTile& sBelowLeft =
+                        sCtxt.asTiles[(iTileY + 1) * sCtxt.nXTiles + iTileX - 1];
+                    Union(sTile, sTile.anBottomEdge[0],
+                          sBelowLeft, sBelowLeft.anTopEdge[sBelowLeft.nXSize - 1]);
+                }
+            }
+        }
+    }
+
+    // Make every border polygon point to its root, and accumulate sizes.
+    for( size_t i = 0; i < nBorderComps; i++ )
+    {
+        const size_t nRoot = Find(i);
+        if( nRoot != i )
+        {
+            sCtxt.anBorderSize[nRoot] += sCtxt.anBorderSize[i];
+            sCtxt.anBorderSize[i] = 0;
+        }
+    }
+    for( size_t i = 0; i < nBorderComps; i++ )
+    {
+        if( sCtxt.anBorderSize[i] > MY_MAX_INT )
+            sCtxt.anBorderSize[i] = MY_MAX_INT;
+    }
+}
+
+/************************************************************************/
+/*                        GDALSieveBuildTileGraph()                     */
+/*                                                                      */
+/*      Label a tile and find the largest neighbour of its polygons,    */
+/*      and of the border polygons of the edges of neighbouring tiles   */
+/*      that it touches.  Then follow the chains of small interior      */
+/*      polygons.                                                       */
+/************************************************************************/
+
+static bool GDALSieveBuildTileGraph( GDALSieveTiledContext& sCtxt, int iTile,
+                                     GDALSieveTileGraph& sGraph )
+{
+    if( !GDALSieveReadAndLabelTile(sCtxt, iTile, sGraph.sData) )
+        return false;
+
+    const GDALSieveTileData& sData = sGraph.sData;
+    const GDALSieveTile& sTile = sCtxt.asTiles[iTile];
+    const int iTileX = iTile % sCtxt.nXTiles;
+    const int iTileY = iTile / sCtxt.nXTiles;
+    const int nXSize = sTile.nXSize;
+    const int nYSize = sTile.nYSize;
+    auto& asNodes = sGraph.asNodes;
+
+    const auto GetBorderNode = [&sCtxt, &sGraph](size_t iComp)
+    {
+        const size_t nRoot = sCtxt.anBorderParent[iComp];
+        const auto oIter = sGraph.oMapBorderNode.find(nRoot);
+        if( oIter != sGraph.oMapBorderNode.end() )
+            return oIter->second;
+        const int iNode = static_cast<int>(sGraph.asNodes.size());
+        GDALSieveNode sNode;
+        sNode.nSize = sCtxt.anBorderSize[nRoot];
+        sNode.nValue = sCtxt.anBorderValue[nRoot];
+        sNode.nBorderComp = nRoot;
+        sGraph.asNodes.push_back(sNode);
+        sGraph.oMapBorderNode[nRoot] = iNode;
+        return iNode;
+    };
+
+    const int nLabels = static_cast<int>(sData.anSize.size());
+    sGraph.anLabelNode.resize(nLabels);
+    asNodes.reserve(nLabels);
+    for( int iLabel = 0; iLabel < nLabels; iLabel++ )
+    {
+        if( sData.anBorderIdx[iLabel] >= 0 )
+        {
+            sGraph.anLabelNode[iLabel] = GetBorderNode(
+                sTile.nFirstBorderComp + sData.anBorderIdx[iLabel]);
+        }
+        else
+        {
+            sGraph.anLabelNode[iLabel] = static_cast<int>(asNodes.size());
+            GDALSieveNode sNode;
+            sNode.nSize = std::min<GIntBig>(sData.anSize[iLabel], MY_MAX_INT);
+            sNode.nValue = sData.anLabelValue[iLabel];
+            asNodes.push_back(sNode);
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Nodes of the pixels above, on the left and on the right of      */
+/*      the tile, from the edges of the neighbouring tiles.             */
+/* -------------------------------------------------------------------- */
+    const auto GetEdgeNode = [&sCtxt, &GetBorderNode](int iNeighbourTile,
+                                                      const std::vector<GInt32>& anEdge,
+                                                      int i)
+    {
+        const GInt32 nEdge = anEdge[i];
+        if( nEdge < 0 )
+            return -1;
+        return GetBorderNode(
+            sCtxt.asTiles[iNeighbourTile].nFirstBorderComp + nEdge);
+    };
+
+    std::vector<int> anAboveNode(nXSize + 2, -1);
+    std::vector<int> anLeftNode(nYSize, -1);
+    std::vector<int> anRightNode(nYSize, -1);
+    if( iTileY > 0 )
+    {
+        const int iAbove = iTile - sCtxt.nXTiles;
+        for( int iX = 0; iX < nXSize; iX++ )
+            anAboveNode[iX + 1] =
+                GetEdgeNode(iAbove, sCtxt.asTiles[iAbove].anBottomEdge, iX);
+        if( iTileX > 0 )
+        {
+            const auto& anEdge = sCtxt.asTiles[iAbove - 1].anBottomEdge;
+            anAboveNode[0] = GetEdgeNode(iAbove - 1, anEdge,
+                                         static_cast<int>(anEdge.size()) - 1);
+        }
+        if( iTileX < sCtxt.nXTiles - 1 )
+            anAboveNode[nXSize + 1] =
+                GetEdgeNode(iAbove + 1, sCtxt.asTiles[iAbove + 1].anBottomEdge, 0);
+    }
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        if( iTileX > 0 )
+            anLeftNode[iY] =
+                GetEdgeNode(iTile - 1, sCtxt.asTiles[iTile - 1].anRightEdge, iY);
+        if( iTileX < sCtxt.nXTiles - 1 )
+            anRightNode[iY] =
+                GetEdgeNode(iTile + 1, sCtxt.asTiles[iTile + 1].anLeftEdge, iY);
+    }
+
+    // iX in [-1, nXSize], iY in [-1, nYSize - 1]
+    const auto GetNode = [&](int iX, int iY)
+    {
+        if( iY < 0 )
+            return anAboveNode[iX + 1];
+        if( iX < 0 )
+            return anLeftNode[iY];
+        if( iX == nXSize )
+            return anRightNode[iY];
+        const GInt32 nLabel =
+            sData.anLabel[static_cast<size_t>(iY) * nXSize + iX];
+        return nLabel < 0 ? -1 : sGraph.anLabelNode[nLabel];
+    };
+
+/* -------------------------------------------------------------------- */
+/*      Compare neighbours, as CompareNeighbour() does, but keeping     */
+/*      the position of the first encounter so that the result does    */
+/*      not depend on the processing order.                             */
+/* -------------------------------------------------------------------- */
+    const auto Update = [&asNodes](int iNode, int iOther, GUIntBig nKey)
+    {
+        GDALSieveNode& sNode = asNodes[iNode];
+        const GIntBig nOtherSize = asNodes[iOther].nSize;
+        if( nOtherSize > sNode.nBestSize ||
+            (nOtherSize == sNode.nBestSize && nKey < sNode.nBestKey) )
+        {
+            sNode.nBestSize = nOtherSize;
+            sNode.nBestKey = nKey;
+            sNode.iBest = iOther;
+        }
+    };
+    const auto Compare = [&Update](int iNode1, int iNode2, GUIntBig nKey)
+    {
+        if( iNode1 < 0 || iNode2 < 0 || iNode1 == iNode2 )
+            return;
+        Update(iNode1, iNode2, nKey);
+        Update(iNode2, iNode1, nKey);
+    };
+
+    const bool b8 = sCtxt.nConnectedness == 8;
+    for( int iY = 0; iY < nYSize; iY++ )
+    {
+        const int iGlobalY = sTile.nYOff + iY;
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            const int iNode = GetNode(iX, iY);
+            if( iNode < 0 )
+                continue;
+            const int iGlobalX = sTile.nXOff + iX;
+            const GUIntBig nKey =
+                (static_cast<GUIntBig>(iGlobalY) * sCtxt.nXSize + iGlobalX) * 4;
+            if( iGlobalY > 0 )
+            {
+                Compare(iNode, GetNode(iX, iY - 1), nKey);
+                if( b8 && iGlobalX > 0 )
+                    Compare(iNode, GetNode(iX - 1, iY - 1), nKey + 1);
+                if( b8 && iGlobalX < sCtxt.nXSize - 1 )
+                    Compare(iNode, GetNode(iX + 1, iY - 1), nKey + 2);
+            }
+            if( iGlobalX > 0 )
+                Compare(iNode, GetNode(iX - 1, iY), nKey + 3);
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Follow the chains of small interior polygons.                   */
+/* -------------------------------------------------------------------- */
+    const int nNodes = static_cast<int>(asNodes.size());
+    sGraph.asResolution.resize(nNodes);
+    std::vector<GByte> abyState(nNodes, 0);  // 0: todo, 1: in chain, 2: done
+    std::vector<int> anChain;
+    for( int iStart = 0; iStart < nNodes; iStart++ )
+    {
+        if( abyState[iStart] != 0 ||
+            asNodes[iStart].nBorderComp != SIEVE_INTERIOR ||
+            asNodes[iStart].nSize >= sCtxt.nSizeThreshold ||
+            asNodes[iStart].iBest < 0 )
+        {
+            continue;
+        }
+
+        GDALSieveResolution sRes;
+        anChain.clear();
+        int iNode = iStart;
+        while( true )
+        {
+            abyState[iNode] = 1;
+            anChain.push_back(iNode);
+            const int iNext = asNodes[iNode].iBest;
+            const GDALSieveNode& sNext = asNodes[iNext];
+            if( sNext.nSize >= sCtxt.nSizeThreshold )
+            {
+                sRes.eType = SIEVE_VALUE;
+                sRes.nValue = sNext.nValue;
+                break;
+            }
+            if( sNext.nBorderComp != SIEVE_INTERIOR )
+            {
+                sRes.eType = SIEVE_BORDER;
+                sRes.nBorderComp = sNext.nBorderComp;
+                break;
+            }
+            if( abyState[iNext] == 2 )
+            {
+                sRes = sGraph.asResolution[iNext];
+                break;
+            }
+            if( abyState[iNext] == 1 )
+            {
+                // Cycle of small polygons: cannot merge.
+                break;
+            }
+            iNode = iNext;
+        }
+        for( int iChainNode : anChain )
+        {
+            abyState[iChainNode] = 2;
+            sGraph.asResolution[iChainNode] = sRes;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                     GDALSieveNeighbourTileJobFunc()                  */
+/*                                                                      */
+/*      Step 3: record the candidate largest neighbours of the border   */
+/*      polygons.                                                       */
+/************************************************************************/
+
+static void GDALSieveNeighbourTileJobFunc( void* pData )
+{
+    const GDALSieveTileJob* psJob = static_cast<const GDALSieveTileJob*>(pData);
+    GDALSieveTiledContext& sCtxt = *(psJob->psCtxt);
+    if( sCtxt.bError )
+        return;
+
+    try
+    {
+        GDALSieveTileGraph sGraph;
+        if( !GDALSieveBuildTileGraph(sCtxt, psJob->iTile, sGraph) )
+        {
+            sCtxt.bError = true;
+            return;
+        }
+
+        auto& asCandidates = sCtxt.asTiles[psJob->iTile].asCandidates;
+        for( const auto& oIter : sGraph.oMapBorderNode )
+        {
+            const GDALSieveNode& sNode = sGraph.asNodes[oIter.second];
+            if( sNode.iBest < 0 || sNode.nSize >= sCtxt.nSizeThreshold )
+                continue;
+
+            GDALSieveCandidate sCandidate;
+            sCandidate.nSize = sNode.nBestSize;
+            sCandidate.nKey = sNode.nBestKey;
+            const GDALSieveNode& sBest = sGraph.asNodes[sNode.iBest];
+            if( sBest.nBorderComp != SIEVE_INTERIOR )
+            {
+                sCandidate.sTarget.eType = SIEVE_BORDER;
+                sCandidate.sTarget.nBorderComp = sBest.nBorderComp;
+            }
+            else if( sBest.nSize >= sCtxt.nSizeThreshold )
+            {
+                sCandidate.sTarget.eType = SIEVE_VALUE;
+                sCandidate.sTarget.nValue = sBest.nValue;
+            }
+            else
+            {
+                sCandidate.sTarget = sGraph.asResolution[sNode.iBest];
+            }
+            asCandidates.emplace_back(oIter.first, sCandidate);
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALSieveFilter()");
+        sCtxt.bError = true;
+    }
+}
+
+/************************************************************************/
+/*                      GDALSieveResolveBorderComps()                   */
+/*                                                                      */
+/*      Step 4: follow the chains of small border polygons.             */
+/************************************************************************/
+
+static void GDALSieveResolveBorderComps( GDALSieveTiledContext& sCtxt )
+{
+    const size_t nBorderComps = sCtxt.anBorderParent.size();
+    std::vector<GDALSieveCandidate> asBest(nBorderComps);
+    for( auto& sTile : sCtxt.asTiles )
+    {
+        for( const auto& oCandidate : sTile.asCandidates )
+        {
+            GDALSieveCandidate& sBest = asBest[oCandidate.first];
+            if( oCandidate.second.nSize > sBest.nSize ||
+                (oCandidate.second.nSize == sBest.nSize &&
+                 oCandidate.second.nKey < sBest.nKey) )
+            {
+                sBest = oCandidate.second;
+            }
+        }
+        std::vector<std::pair<size_t, GDALSieveCandidate>>().swap(
+            sTile.asCandidates);
+    }
+
+    sCtxt.asBorderResolution.resize(nBorderComps);
+    std::vector<GByte> abyState(nBorderComps, 0);  // 0: todo, 1: in chain, 2: done
+    std::vector<size_t> anChain;
+    for( size_t iStart = 0; iStart < nBorderComps; iStart++ )
+    {
+        if( abyState[iStart] != 0 ||
+            sCtxt.anBorderParent[iStart] != iStart ||
+            sCtxt.anBorderSize[iStart] >= sCtxt.nSizeThreshold ||
+            asBest[iStart].nSize < 0 )
+        {
+            continue;
+        }
+
+        GDALSieveResolution sRes;
+        anChain.clear();
+        size_t iComp = iStart;
+        while( true )
+        {
+            abyState[iComp] = 1;
+            anChain.push_back(iComp);
+            const GDALSieveResolution& sTarget = asBest[iComp].sTarget;
+            if( asBest[iComp].nSize < 0 || sTarget.eType != SIEVE_BORDER )
+            {
+                sRes = sTarget;
+                break;
+            }
+            const size_t iNext = sTarget.nBorderComp;
+            if( sCtxt.anBorderSize[iNext] >= sCtxt.nSizeThreshold )
+            {
+                sRes.eType = SIEVE_VALUE;
+                sRes.nValue = sCtxt.anBorderValue[iNext];
+                break;
+            }
+            if( abyState[iNext] == 2 )
+            {
+                sRes = sCtxt.asBorderResolution[iNext];
+                break;
+            }
+            if( abyState[iNext] == 1 )
+            {
+                // Cycle of small polygons: cannot merge.
+                break;
+            }
+            iComp = iNext;
+        }
+        for( size_t iChainComp : anChain )
+        {
+            abyState[iChainComp] = 2;
+            sCtxt.asBorderResolution[iChainComp] = sRes;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALSieveWriteTileJobFunc()                    */
+/*                                                                      */
+/*      Step 5: remap the pixels of the tile.                           */
+/************************************************************************/
+
+static void GDALSieveWriteTileJobFunc( void* pData )
+{
+    const GDALSieveTileJob* psJob = static_cast<const GDALSieveTileJob*>(pData);
+    GDALSieveTiledContext& sCtxt = *(psJob->psCtxt);
+    if( sCtxt.bError )
+        return;
+
+    try
+    {
+        GDALSieveTileGraph sGraph;
+        if( !GDALSieveBuildTileGraph(sCtxt, psJob->iTile, sGraph) )
+        {
+            sCtxt.bError = true;
+            return;
+        }
+
+        const size_t nNodes = sGraph.asNodes.size();
+        std::vector<GDALSieveResolution> asFinal(nNodes);
+        for( size_t iNode = 0; iNode < nNodes; iNode++ )
+        {
+            const GDALSieveNode& sNode = sGraph.asNodes[iNode];
+            if( sNode.nSize >= sCtxt.nSizeThreshold )
+                continue;
+            if( sNode.nBorderComp != SIEVE_INTERIOR )
+                asFinal[iNode] = sCtxt.asBorderResolution[sNode.nBorderComp];
+            else if( sGraph.asResolution[iNode].eType == SIEVE_BORDER )
+                asFinal[iNode] = sCtxt.asBorderResolution[
+                    sGraph.asResolution[iNode].nBorderComp];
+            else
+                asFinal[iNode] = sGraph.asResolution[iNode];
+        }
+
+        GDALSieveTileData& sData = sGraph.sData;
+        for( size_t i = 0; i < sData.anValue.size(); i++ )
+        {
+            const GInt32 nLabel = sData.anLabel[i];
+            if( nLabel < 0 )
+                continue;
+            const GDALSieveResolution& sRes =
+                asFinal[sGraph.anLabelNode[nLabel]];
+            if( sRes.eType == SIEVE_VALUE )
+                sData.anValue[i] = sRes.nValue;
+        }
+
+        const GDALSieveTile& sTile = sCtxt.asTiles[psJob->iTile];
+        std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+        if( GDALRasterIO( sCtxt.hDstBand, GF_Write,
+                          sTile.nXOff, sTile.nYOff, sTile.nXSize, sTile.nYSize,
+                          sData.anValue.data(), sTile.nXSize, sTile.nYSize,
+                          GDT_Int64, 0, 0 ) != CE_None )
+        {
+            sCtxt.bError = true;
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALSieveFilter()");
+        sCtxt.bError = true;
+    }
+}
+
+/************************************************************************/
+/*                          GDALSieveRunTiles()                         */
+/************************************************************************/
+
+static CPLErr GDALSieveRunTiles( GDALSieveTiledContext& sCtxt,
+                                 CPLJobQueue* poJobQueue,
+                                 CPLThreadFunc pfnFunc,
+                                 double dfProgressStart, double dfProgressEnd,
+                                 GDALProgressFunc pfnProgress,
+                                 void * pProgressArg )
+{
+    const int nTiles = static_cast<int>(sCtxt.asTiles.size());
+    std::vector<GDALSieveTileJob> asJobs(nTiles);
+    for( int i = 0; i < nTiles; i++ )
+    {
+        asJobs[i].psCtxt = &sCtxt;
+        asJobs[i].iTile = i;
+    }
+
+    const auto Progress = [&](int nDone)
+    {
+        if( !sCtxt.bError &&
+            !pfnProgress( dfProgressStart + (dfProgressEnd - dfProgressStart) *
+                              nDone / nTiles,
+                          "", pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            sCtxt.bError = true;
+        }
+    };
+
+    if( poJobQueue == nullptr )
+    {
+        for( int i = 0; i < nTiles && !sCtxt.bError; i++ )
+        {
+            pfnFunc(&asJobs[i]);
+            Progress(i + 1);
+        }
+    }
+    else
+    {
+        for( int i = 0; i < nTiles; i++ )
+            poJobQueue->SubmitJob(pfnFunc, &asJobs[i]);
+        for( int nRemaining = nTiles - 1; nRemaining >= 0; nRemaining-- )
+        {
+            poJobQueue->WaitCompletion(nRemaining);
+            Progress(nTiles - nRemaining);
+        }
+        poJobQueue->WaitCompletion();
+    }
+
+    return sCtxt.bError ? CE_Failure : CE_None;
+}
+
+/************************************************************************/
+/*                         GDALSieveFilterTiled()                       */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterTiled( GDALRasterBandH hSrcBand,
+                                    GDALRasterBandH hMaskBand,
+                                    GDALRasterBandH hDstBand,
+                                    int nSizeThreshold, int nConnectedness,
+                                    int nThreads, double dfMaxMemory,
+                                    GDALProgressFunc pfnProgress,
+                                    void * pProgressArg )
+{
+    GDALSieveTiledContext sCtxt;
+    sCtxt.hSrcBand = hSrcBand;
+    sCtxt.hMaskBand = hMaskBand;
+    sCtxt.hDstBand = hDstBand;
+    sCtxt.nXSize = GDALGetRasterBandXSize(hSrcBand);
+    sCtxt.nYSize = GDALGetRasterBandYSize(hSrcBand);
+    sCtxt.nConnectedness = nConnectedness;
+    sCtxt.nSizeThreshold = nSizeThreshold;
+
+    // Half of the memory is for the tiles being processed, the other half
+    // for the border polygons.
+    const double dfTileSize =
+        sqrt(dfMaxMemory / 2 / nThreads / SIEVE_BYTES_PER_PIXEL);
+    const int nTileSize = static_cast<int>(
+        std::max<double>(SIEVE_MIN_TILE_SIZE,
+                         std::min<double>(SIEVE_MAX_TILE_SIZE, dfTileSize)));
+    sCtxt.nXTiles = (sCtxt.nXSize + nTileSize - 1) / nTileSize;
+    sCtxt.nYTiles = (sCtxt.nYSize + nTileSize - 1) / nTileSize;
+    CPLDebug("GDALSieveFilter", "Using %d threads and tiles of %dx%d pixels",
+             nThreads, nTileSize, nTileSize);
+
+    try
+    {
+        sCtxt.asTiles.resize(static_cast<size_t>(sCtxt.nXTiles) * sCtxt.nYTiles);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALSieveFilter()");
+        return CE_Failure;
+    }
+    for( int iTileY = 0; iTileY < sCtxt.nYTiles; iTileY++ )
+    {
+        for( int iTileX = 0; iTileX < sCtxt.nXTiles; iTileX++ )
+        {
+            GDALSieveTile& sTile =
+                sCtxt.asTiles[iTileY * sCtxt.nXTiles + iTileX];
+            sTile.nXOff = iTileX * nTileSize;
+            sTile.nYOff = iTileY * nTileSize;
+            sTile.nXSize = std::min(nTileSize, sCtxt.nXSize - sTile.nXOff);
+            sTile.nYSize = std::min(nTileSize, sCtxt.nYSize - sTile.nYOff);
+        }
+    }
+
+    // The jobs block on the IO mutex, so they do not run in the global
+    // thread pool, whose workers might be needed by the I/O itself (for
+    // example for multi-threaded GeoTIFF decoding or compression).
+    CPLWorkerThreadPool oThreadPool;
+    auto poJobQueue = nThreads > 1 && oThreadPool.Setup(nThreads, nullptr, nullptr) ?
+        oThreadPool.CreateJobQueue() : nullptr;
+
+    CPLErr eErr = GDALSieveRunTiles( sCtxt, poJobQueue.get(),
+                                     GDALSieveLabelTileJobFunc, 0.0, 0.25,
+                                     pfnProgress, pProgressArg );
+    if( eErr == CE_None )
+    {
+        try
+        {
+            GDALSieveMergeBorderComps(sCtxt);
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for GDALSieveFilter()");
+            return CE_Failure;
+        }
+        eErr = GDALSieveRunTiles( sCtxt, poJobQueue.get(),
+                                  GDALSieveNeighbourTileJobFunc, 0.25, 0.5,
+                                  pfnProgress, pProgressArg );
+    }
+    if( eErr == CE_None )
+    {
+        try
+        {
+            GDALSieveResolveBorderComps(sCtxt);
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for GDALSieveFilter()");
+            return CE_Failure;
+        }
+        eErr = GDALSieveRunTiles( sCtxt, poJobQueue.get(),
+                                  GDALSieveWriteTileJobFunc, 0.5, 1.0,
+                                  pfnProgress, pProgressArg );
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -187,8 +1320,20 @@ static inline void CompareNeighbour( int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * <ul>
+ * <li>NUM_THREADS=n|ALL_CPUS (GDAL >= 3.7). Number of threads. Defaults to
+ * the value of the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * <li>MAX_MEMORY=megabytes (GDAL >= 3.7). Memory budget of the tiled
+ * implementation. Defaults to 256.</li>
+ * </ul>
+ * When NUM_THREADS is greater than 1 or MAX_MEMORY is specified, polygons are
+ * labelled per tile with a union-find, and labels are then merged along tile
+ * borders. Tiles are processed in parallel, and sized so that their working
+ * buffers use at most half of MAX_MEMORY. The rest of the memory is used by
+ * the polygons crossing tile borders, so memory use no longer depends on the
+ * total number of polygons. The result is the same as with the default
+ * implementation.
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -200,7 +1345,7 @@ CPLErr CPL_STDCALL
 GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
                  GDALRasterBandH hDstBand,
                  int nSizeThreshold, int nConnectedness,
-                 CPL_UNUSED char **papszOptions,
+                 char **papszOptions,
                  GDALProgressFunc pfnProgress,
                  void * pProgressArg )
 {
@@ -210,6 +1355,31 @@ GDALSieveFilter( GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
     if( pfnProgress == nullptr )
         pfnProgress = GDALDummyProgress;
 
+/* -------------------------------------------------------------------- */
+/*      Use the tiled implementation if requested.                      */
+/* -------------------------------------------------------------------- */
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if( pszThreads == nullptr )
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128,
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+    const char *pszMaxMemory = CSLFetchNameValue(papszOptions, "MAX_MEMORY");
+    if( nThreads > 1 || pszMaxMemory != nullptr )
+    {
+        const double dfMaxMemory =
+            (pszMaxMemory ? CPLAtof(pszMaxMemory) : 256.0) * 1024 * 1024;
+        if( !(dfMaxMemory > 0) )
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "Invalid value for MAX_MEMORY: %s", pszMaxMemory);
+            return CE_Failure;
+        }
+        return GDALSieveFilterTiled( hSrcBand, hMaskBand, hDstBand,
+                                     nSizeThreshold, nConnectedness,
+                                     nThreads, dfMaxMemory,
+                                     pfnProgress, pProgressArg );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Allocate working buffers.                                       */
 /* -------------------------------------------------------------------- */
@@ -42,11 +42,17 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_list.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
@@ -3545,6 +3551,335 @@ GDALDeserializeReprojectionTransformer( CPLXMLNode *psTree )
     return pResult;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                      Transformation grid cache                       */
+/* ==================================================================== */
+/************************************************************************/
+
+// Rows of points transformed by GDALApproxTransform(), kept so that warping
+// again the same source grid into the same target grid does not need to
+// call the base transformer (typically PROJ) again. Rows are keyed by a
+// hash of the serialized definition of the approximate transformer (which
+// contains the CRS pair and the geotransforms), and of the input points.
+// Rows computed by a transformer can also be appended to a file per
+// definition in GDAL_TRANSFORMER_GRID_CACHE_DIR, which is loaded by the
+// next process using the same definition.
+
+constexpr char GTGC_SIGNATURE[] = "GDALTGC1";
+constexpr uint64_t GTGC_FNV_OFFSET = 14695981039346656037ULL;
+
+static uint64_t GDALTransformGridCacheHash( uint64_t nHash,
+                                            const void *pData, size_t nSize )
+{
+    const GByte *pabyData = static_cast<const GByte *>(pData);
+    for( size_t i = 0; i < nSize; i++ )
+    {
+        nHash ^= pabyData[i];
+        nHash *= 1099511628211ULL;
+    }
+    return nHash;
+}
+
+namespace {
+
+struct GDALTransformGridRow
+{
+    uint64_t nDefHash = 0;
+    int bDstToSrc = FALSE;
+    int nPoints = 0;
+    int bRet = FALSE;
+    // First and last input points, to protect against hash collisions.
+    double adfInput[4] = {};
+    // x, then y, then z.
+    std::vector<double> adfXYZ{};
+    std::vector<int> anSuccess{};
+
+    size_t GetMemorySize() const
+    {
+        return sizeof(*this) + adfXYZ.size() * sizeof(double) +
+               anSuccess.size() * sizeof(int);
+    }
+};
+
+// On-disk record header. Followed by 3 * nPoints doubles and nPoints ints.
+struct GDALTransformGridRecord
+{
+    uint64_t nRowKey;
+    int32_t bDstToSrc;
+    int32_t nPoints;
+    int32_t bRet;
+    int32_t nReserved;
+    double adfInput[4];
+};
+
+class GDALTransformGridCache
+{
+    std::mutex m_oMutex{};
+    lru11::Cache<uint64_t, std::shared_ptr<const GDALTransformGridRow>>
+        m_oCache{0, 0};
+    size_t m_nMemorySize = 0;
+    size_t m_nMaxMemorySize = 0;
+    std::map<uint64_t, bool> m_oMapLoadedDefs{};
+
+    bool LoadFileInternal( uint64_t nDefHash, uint64_t nVersionHash,
+                           const std::string& osFilename );
+
+    void InsertLocked( uint64_t nRowKey,
+                       const std::shared_ptr<const GDALTransformGridRow>& poRow )
+    {
+        std::shared_ptr<const GDALTransformGridRow> poOldRow;
+        if( m_oCache.tryGet(nRowKey, poOldRow) )
+        {
+            m_nMemorySize -= poOldRow->GetMemorySize();
+            m_oCache.remove(nRowKey);
+        }
+        const size_t nRowSize = poRow->GetMemorySize();
+        if( nRowSize > m_nMaxMemorySize )
+            return;
+        while( m_nMemorySize + nRowSize > m_nMaxMemorySize )
+        {
+            uint64_t nOldestKey = 0;
+            if( !m_oCache.getOldestEntry(nOldestKey, poOldRow) )
+                break;
+            m_nMemorySize -= poOldRow->GetMemorySize();
+            m_oCache.remove(nOldestKey);
+        }
+        m_oCache.insert(nRowKey, poRow);
+        m_nMemorySize += nRowSize;
+    }
+
+  public:
+    GDALTransformGridCache()
+    {
+        const char* pszMaxMem =
+            CPLGetConfigOption("GDAL_TRANSFORMER_GRID_CACHE_MAX_MEMORY",
+                               "67108864");
+        const GIntBig nMaxMem = CPLAtoGIntBig(pszMaxMem);
+        m_nMaxMemorySize = static_cast<size_t>(std::max<GIntBig>(0,
+            std::min<GIntBig>(nMaxMem,
+                              std::numeric_limits<size_t>::max() / 2)));
+    }
+
+    std::shared_ptr<const GDALTransformGridRow> Get( uint64_t nRowKey )
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        std::shared_ptr<const GDALTransformGridRow> poRow;
+        m_oCache.tryGet(nRowKey, poRow);
+        return poRow;
+    }
+
+    void Insert( uint64_t nRowKey,
+                 const std::shared_ptr<const GDALTransformGridRow>& poRow )
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        InsertLocked(nRowKey, poRow);
+    }
+
+    // Load the rows of a file written by GDALApproxTransformFlushCache(),
+    // if not already done. Return false if rows must not be appended to it.
+    bool LoadFile( uint64_t nDefHash, uint64_t nVersionHash,
+                   const std::string& osFilename );
+};
+
+/************************************************************************/
+/*                GDALTransformGridCache::LoadFile()                    */
+/************************************************************************/
+
+bool GDALTransformGridCache::LoadFile( uint64_t nDefHash,
+                                       uint64_t nVersionHash,
+                                       const std::string& osFilename )
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        auto oIter = m_oMapLoadedDefs.find(nDefHash);
+        if( oIter != m_oMapLoadedDefs.end() )
+            return oIter->second;
+    }
+    const bool bUsable = LoadFileInternal( nDefHash, nVersionHash,
+                                           osFilename );
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_oMapLoadedDefs[nDefHash] = bUsable;
+    return bUsable;
+}
+
+/************************************************************************/
+/*            GDALTransformGridCache::LoadFileInternal()                */
+/************************************************************************/
+
+bool GDALTransformGridCache::LoadFileInternal( uint64_t nDefHash,
+                                               uint64_t nVersionHash,
+                                               const std::string& osFilename )
+{
+    VSIStatBufL sStat;
+    if( VSIStatL(osFilename.c_str(), &sStat) != 0 )
+        return true;
+    if( static_cast<GUIntBig>(sStat.st_size) > m_nMaxMemorySize )
+    {
+        // Do not make it grow further with rows that it already contains.
+        CPLDebug("GDAL", "Transformer grid cache %s is larger than "
+                 "GDAL_TRANSFORMER_GRID_CACHE_MAX_MEMORY. Not using it",
+                 osFilename.c_str());
+        return false;
+    }
+
+    GByte *pabyData = nullptr;
+    vsi_l_offset nDataSize = 0;
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        if( !VSIIngestFile( nullptr, osFilename.c_str(), &pabyData, &nDataSize,
+                            -1 ) )
+        {
+            return false;
+        }
+    }
+
+    const size_t nHeaderSize = strlen(GTGC_SIGNATURE) + sizeof(uint64_t);
+    if( nDataSize < nHeaderSize ||
+        memcmp(pabyData, GTGC_SIGNATURE, strlen(GTGC_SIGNATURE)) != 0 ||
+        memcmp(pabyData + strlen(GTGC_SIGNATURE), &nVersionHash,
+               sizeof(uint64_t)) != 0 )
+    {
+        // Written by another version of GDAL or PROJ: start again.
+        CPLDebug("GDAL", "Discarding transformer grid cache %s: "
+                 "not compatible with this version", osFilename.c_str());
+        VSIFree(pabyData);
+        return VSIUnlink(osFilename.c_str()) == 0;
+    }
+
+    int nRows = 0;
+    size_t nOffset = nHeaderSize;
+    while( nOffset + sizeof(GDALTransformGridRecord) <= nDataSize )
+    {
+        GDALTransformGridRecord sRecord;
+        memcpy(&sRecord, pabyData + nOffset, sizeof(sRecord));
+        nOffset += sizeof(sRecord);
+        if( sRecord.nPoints <= 0 ||
+            static_cast<size_t>(sRecord.nPoints) >
+                (nDataSize - nOffset) / (3 * sizeof(double) + sizeof(int)) )
+        {
+            // Truncated or corrupted record.
+            break;
+        }
+
+        auto poRow = std::make_shared<GDALTransformGridRow>();
+        poRow->nDefHash = nDefHash;
+        poRow->bDstToSrc = sRecord.bDstToSrc;
+        poRow->nPoints = sRecord.nPoints;
+        poRow->bRet = sRecord.bRet;
+        memcpy(poRow->adfInput, sRecord.adfInput, sizeof(sRecord.adfInput));
+        poRow->adfXYZ.resize(3 * static_cast<size_t>(sRecord.nPoints));
+        memcpy(poRow->adfXYZ.data(), pabyData + nOffset,
+               poRow->adfXYZ.size() * sizeof(double));
+        nOffset += poRow->adfXYZ.size() * sizeof(double);
+        poRow->anSuccess.resize(sRecord.nPoints);
+        memcpy(poRow->anSuccess.data(), pabyData + nOffset,
+               poRow->anSuccess.size() * sizeof(int));
+        nOffset += poRow->anSuccess.size() * sizeof(int);
+
+        Insert(sRecord.nRowKey, poRow);
+        nRows++;
+    }
+    VSIFree(pabyData);
+
+    CPLDebug("GDAL", "Loaded %d rows from transformer grid cache %s",
+             nRows, osFilename.c_str());
+    return true;
+}
+
+} // namespace
+
+static std::mutex goTransformGridCacheMutex;
+static GDALTransformGridCache *gpoTransformGridCache = nullptr;
+
+static GDALTransformGridCache *GDALGetTransformGridCache()
+{
+    std::lock_guard<std::mutex> oLock(goTransformGridCacheMutex);
+    if( gpoTransformGridCache == nullptr )
+        gpoTransformGridCache = new GDALTransformGridCache();
+    return gpoTransformGridCache;
+}
+
+/************************************************************************/
+/*                   GDALCleanupTransformGridCache()                    */
+/************************************************************************/
+
+void GDALCleanupTransformGridCache()
+{
+    std::lock_guard<std::mutex> oLock(goTransformGridCacheMutex);
+    delete gpoTransformGridCache;
+    gpoTransformGridCache = nullptr;
+}
+
+/************************************************************************/
+/*                     GDALApproxTransformCacheState                    */
+/************************************************************************/
+
+// Per approximate transformer state of the transformation grid cache.
+struct GDALApproxTransformCacheState
+{
+    bool bKeyComputed = false;
+    bool bDisabled = false;
+    uint64_t nDefHash = 0;
+    uint64_t nVersionHash = 0;
+    std::string osFilename{};
+    // Records of the rows computed by this transformer, not yet written to
+    // osFilename.
+    std::string osPendingRecords{};
+    int nHits = 0;
+    int nMisses = 0;
+};
+
+/************************************************************************/
+/*                  GDALApproxTransformCacheEnabled()                   */
+/************************************************************************/
+
+static bool GDALApproxTransformCacheEnabled()
+{
+    return CPLTestBool(
+               CPLGetConfigOption("GDAL_TRANSFORMER_GRID_CACHE", "NO")) ||
+           CPLGetConfigOption("GDAL_TRANSFORMER_GRID_CACHE_DIR",
+                              nullptr) != nullptr;
+}
+
+/************************************************************************/
+/*                    GDALApproxTransformFlushCache()                   */
+/************************************************************************/
+
+static void GDALApproxTransformFlushCache( GDALApproxTransformCacheState *psCache )
+{
+    if( psCache->osPendingRecords.empty() )
+        return;
+
+    VSILFILE *fp = VSIFOpenL(psCache->osFilename.c_str(), "ab");
+    if( fp == nullptr )
+    {
+        CPLDebug("GDAL", "Cannot write transformer grid cache %s",
+                 psCache->osFilename.c_str());
+        psCache->osPendingRecords.clear();
+        return;
+    }
+    VSIFSeekL(fp, 0, SEEK_END);
+    bool bOK = true;
+    if( VSIFTellL(fp) == 0 )
+    {
+        bOK = VSIFWriteL(GTGC_SIGNATURE, strlen(GTGC_SIGNATURE), 1, fp) == 1 &&
+              VSIFWriteL(&psCache->nVersionHash,
+                         sizeof(psCache->nVersionHash), 1, fp) == 1;
+    }
+    // A single write, so that records of processes sharing the directory
+    // are not interleaved.
+    bOK = bOK && VSIFWriteL(psCache->osPendingRecords.data(),
+                            psCache->osPendingRecords.size(), 1, fp) == 1;
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+    if( !bOK )
+    {
+        CPLDebug("GDAL", "Error while writing transformer grid cache %s",
+                 psCache->osFilename.c_str());
+    }
+    psCache->osPendingRecords.clear();
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*      Approximate transformer.                                        */
@@ -3561,6 +3896,9 @@ typedef struct
     double dfMaxErrorReverse;
 
     int bOwnSubtransformer;
+
+    // Transformation grid cache, or nullptr if disabled.
+    GDALApproxTransformCacheState *psCache;
 } ApproxTransformInfo;
 
 /************************************************************************/
@@ -3594,6 +3932,8 @@ GDALCreateSimilarApproxTransformer( void *hTransformArg,
         }
     }
     psClonedInfo->bOwnSubtransformer = TRUE;
+    if( psClonedInfo->psCache )
+        psClonedInfo->psCache = new GDALApproxTransformCacheState();
 
     return psClonedInfo;
 }
@@ -3643,6 +3983,112 @@ GDALSerializeApproxTransformer( void *pTransformArg )
     return psTree;
 }
 
+/************************************************************************/
+/*                 GDALApproxTransformComputeCacheKey()                 */
+/************************************************************************/
+
+static void GDALApproxTransformComputeCacheKey( ApproxTransformInfo *psATInfo )
+{
+    GDALApproxTransformCacheState *psCache = psATInfo->psCache;
+    psCache->bKeyComputed = true;
+
+    CPLXMLNode *psTree = nullptr;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        psTree = GDALSerializeApproxTransformer(psATInfo);
+    }
+    CPLXMLNode *psBase = CPLGetXMLNode(psTree, "BaseTransformer");
+    if( psBase == nullptr || psBase->psChild == nullptr )
+    {
+        // Base transformer that cannot be serialized.
+        CPLDestroyXMLNode(psTree);
+        psCache->bDisabled = true;
+        return;
+    }
+    CPLString osDef;
+    char *pszXML = CPLSerializeXMLTree(psTree);
+    osDef = pszXML;
+    CPLFree(pszXML);
+    CPLDestroyXMLNode(psTree);
+    osDef += CPLGetConfigOption("CHECK_WITH_INVERT_PROJ", "");
+    psCache->nDefHash =
+        GDALTransformGridCacheHash(GTGC_FNV_OFFSET, osDef.data(), osDef.size());
+
+    // Results written by another version of GDAL or PROJ, or on a
+    // different architecture, are not reused.
+    int nPROJMajor = 0;
+    int nPROJMinor = 0;
+    int nPROJPatch = 0;
+    OSRGetPROJVersion(&nPROJMajor, &nPROJMinor, &nPROJPatch);
+    const CPLString osVersion(
+        CPLSPrintf("%s %d.%d.%d %d %d", GDALVersionInfo("RELEASE_NAME"),
+                   nPROJMajor, nPROJMinor, nPROJPatch,
+                   static_cast<int>(sizeof(void*)), CPL_IS_LSB));
+    psCache->nVersionHash =
+        GDALTransformGridCacheHash(GTGC_FNV_OFFSET, osVersion.data(),
+                                   osVersion.size());
+
+    const char *pszDir =
+        CPLGetConfigOption("GDAL_TRANSFORMER_GRID_CACHE_DIR", nullptr);
+    if( pszDir != nullptr && pszDir[0] != '\0' )
+    {
+        psCache->osFilename = CPLFormFilename(
+            pszDir,
+            CPLSPrintf("%016llx",
+                       static_cast<unsigned long long>(psCache->nDefHash)),
+            "gtgc");
+        if( !GDALGetTransformGridCache()->LoadFile(
+                psCache->nDefHash, psCache->nVersionHash, psCache->osFilename) )
+        {
+            psCache->osFilename.clear();
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GDALApproxTransformGetRowKey()                    */
+/************************************************************************/
+
+// Return the key of a row of points in the transformation grid cache, or 0
+// if the row must not be cached.
+static uint64_t GDALApproxTransformGetRowKey( ApproxTransformInfo *psATInfo,
+                                              int bDstToSrc, int nPoints,
+                                              const double *x,
+                                              const double *y,
+                                              const double *z )
+{
+    GDALApproxTransformCacheState *psCache = psATInfo->psCache;
+    if( !psCache->bKeyComputed )
+        GDALApproxTransformComputeCacheKey(psATInfo);
+    if( psCache->bDisabled )
+        return 0;
+
+    uint64_t nHash = psCache->nDefHash;
+    nHash = GDALTransformGridCacheHash(nHash, &bDstToSrc, sizeof(bDstToSrc));
+    nHash = GDALTransformGridCacheHash(nHash, &nPoints, sizeof(nPoints));
+    nHash = GDALTransformGridCacheHash(nHash, x, nPoints * sizeof(double));
+    nHash = GDALTransformGridCacheHash(nHash, y, nPoints * sizeof(double));
+    nHash = GDALTransformGridCacheHash(nHash, z, nPoints * sizeof(double));
+
+    // The geotransforms of a GenImgProj transformer can be changed after
+    // the definition was hashed, e.g. by GDALSetTransformerDstGeoTransform()
+    if( psATInfo->pfnBaseTransformer == GDALGenImgProjTransform )
+    {
+        const GDALGenImgProjTransformInfo *psGenImgProjInfo =
+            static_cast<const GDALGenImgProjTransformInfo *>(
+                psATInfo->pBaseCBData);
+        nHash = GDALTransformGridCacheHash(
+            nHash, psGenImgProjInfo->adfSrcGeoTransform,
+            sizeof(psGenImgProjInfo->adfSrcGeoTransform));
+        nHash = GDALTransformGridCacheHash(
+            nHash, psGenImgProjInfo->adfDstGeoTransform,
+            sizeof(psGenImgProjInfo->adfDstGeoTransform));
+    }
+
+    return nHash == 0 ? 1 : nHash;
+}
+
 /************************************************************************/
 /*                    GDALCreateApproxTransformer()                     */
 /************************************************************************/
@@ -3674,6 +4120,16 @@ GDALSerializeApproxTransformer( void *pTransformArg )
  * circumstances as little internal validation is done, in order to keep things
  * fast.
  *
+ * Starting with GDAL 3.7, if the GDAL_TRANSFORMER_GRID_CACHE configuration
+ * option is set to YES, or GDAL_TRANSFORMER_GRID_CACHE_DIR to a directory, the
+ * results of GDALApproxTransform() are cached per transformer definition, so
+ * that transforming again the same rows of points, for example when warping
+ * again into the same target grid, does not call the base transformer. The
+ * size of the in-memory cache is set with
+ * GDAL_TRANSFORMER_GRID_CACHE_MAX_MEMORY (in bytes, 64 MB by default), and
+ * GDAL_TRANSFORMER_GRID_CACHE_DIR is where rows are saved to be reused by
+ * later processes.
+ *
  * @param pfnBaseTransformer the high precision transformer which should be
  * approximated.
  * @param pBaseTransformArg the callback argument for the high precision
@@ -3710,6 +4166,8 @@ void *GDALCreateApproxTransformer2( GDALTransformerFunc pfnBaseTransformer,
     psATInfo->dfMaxErrorForward = dfMaxErrorForward;
     psATInfo->dfMaxErrorReverse = dfMaxErrorReverse;
     psATInfo->bOwnSubtransformer = FALSE;
+    psATInfo->psCache = GDALApproxTransformCacheEnabled() ?
+                            new GDALApproxTransformCacheState() : nullptr;
 
     memcpy(psATInfo->sTI.abySignature,
            GDAL_GTI2_SIGNATURE,
@@ -3760,6 +4218,18 @@ void GDALDestroyApproxTransformer( void * pCBData )
     if( psATInfo->bOwnSubtransformer )
         GDALDestroyTransformer( psATInfo->pBaseCBData );
 
+    if( psATInfo->psCache )
+    {
+        if( psATInfo->psCache->nHits || psATInfo->psCache->nMisses )
+        {
+            CPLDebug( "GDAL", "ApproxTransformer grid cache: "
+                      "%d hits, %d misses",
+                      psATInfo->psCache->nHits, psATInfo->psCache->nMisses );
+        }
+        GDALApproxTransformFlushCache( psATInfo->psCache );
+        delete psATInfo->psCache;
+    }
+
     CPLFree( pCBData );
 }
 
@@ -3776,6 +4246,14 @@ void GDALRefreshApproxTransformer( void* hTransformArg )
     {
         GDALRefreshGenImgProjTransformer( psInfo->pBaseCBData );
     }
+
+    if( psInfo->psCache )
+    {
+        // CHECK_WITH_INVERT_PROJ might have changed.
+        GDALApproxTransformFlushCache( psInfo->psCache );
+        psInfo->psCache->bKeyComputed = false;
+        psInfo->psCache->bDisabled = false;
+    }
 }
 
 /************************************************************************/
@@ -4064,6 +4542,55 @@ static int GDALApproxTransformInternal( void *pCBData, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                    GDALApproxTransformCacheRow()                     */
+/************************************************************************/
+
+static void GDALApproxTransformCacheRow( ApproxTransformInfo *psATInfo,
+                                         uint64_t nRowKey,
+                                         const double adfInput[4],
+                                         int bDstToSrc, int nPoints,
+                                         const double *x, const double *y,
+                                         const double *z,
+                                         const int *panSuccess, int bRet )
+{
+    GDALApproxTransformCacheState *psCache = psATInfo->psCache;
+
+    auto poRow = std::make_shared<GDALTransformGridRow>();
+    poRow->nDefHash = psCache->nDefHash;
+    poRow->bDstToSrc = bDstToSrc;
+    poRow->nPoints = nPoints;
+    poRow->bRet = bRet;
+    memcpy(poRow->adfInput, adfInput, sizeof(poRow->adfInput));
+    poRow->adfXYZ.resize(3 * static_cast<size_t>(nPoints));
+    memcpy(poRow->adfXYZ.data(), x, nPoints * sizeof(double));
+    memcpy(poRow->adfXYZ.data() + nPoints, y, nPoints * sizeof(double));
+    memcpy(poRow->adfXYZ.data() + 2 * nPoints, z, nPoints * sizeof(double));
+    poRow->anSuccess.assign(panSuccess, panSuccess + nPoints);
+
+    if( !psCache->osFilename.empty() )
+    {
+        GDALTransformGridRecord sRecord;
+        sRecord.nRowKey = nRowKey;
+        sRecord.bDstToSrc = bDstToSrc;
+        sRecord.nPoints = nPoints;
+        sRecord.bRet = bRet;
+        sRecord.nReserved = 0;
+        memcpy(sRecord.adfInput, adfInput, sizeof(sRecord.adfInput));
+        psCache->osPendingRecords.append(
+            reinterpret_cast<const char *>(&sRecord), sizeof(sRecord));
+        psCache->osPendingRecords.append(
+            reinterpret_cast<const char *>(poRow->adfXYZ.data()),
+            poRow->adfXYZ.size() * sizeof(double));
+        psCache->osPendingRecords.append(
+            reinterpret_cast<const char *>(panSuccess), nPoints * sizeof(int));
+        if( psCache->osPendingRecords.size() > 1024 * 1024 )
+            GDALApproxTransformFlushCache(psCache);
+    }
+
+    GDALGetTransformGridCache()->Insert(nRowKey, poRow);
+}
+
 /************************************************************************/
 /*                        GDALApproxTransform()                         */
 /************************************************************************/
@@ -4090,6 +4617,39 @@ int GDALApproxTransform( void *pCBData, int bDstToSrc, int nPoints,
 
     const int nMiddle = (nPoints - 1) / 2;
 
+/* -------------------------------------------------------------------- */
+/*      Look for the row in the transformation grid cache.              */
+/* -------------------------------------------------------------------- */
+    uint64_t nRowKey = 0;
+    double adfInput[4] = {};
+    if( psATInfo->psCache != nullptr && nPoints > 5 )
+    {
+        nRowKey = GDALApproxTransformGetRowKey( psATInfo, bDstToSrc,
+                                                nPoints, x, y, z );
+        adfInput[0] = x[0];
+        adfInput[1] = x[nPoints-1];
+        adfInput[2] = y[0];
+        adfInput[3] = z[0];
+    }
+    if( nRowKey != 0 )
+    {
+        auto poRow = GDALGetTransformGridCache()->Get(nRowKey);
+        if( poRow && poRow->nDefHash == psATInfo->psCache->nDefHash &&
+            poRow->bDstToSrc == bDstToSrc && poRow->nPoints == nPoints &&
+            memcmp(poRow->adfInput, adfInput, sizeof(adfInput)) == 0 )
+        {
+            psATInfo->psCache->nHits++;
+            memcpy(x, poRow->adfXYZ.data(), nPoints * sizeof(double));
+            memcpy(y, poRow->adfXYZ.data() + nPoints,
+                   nPoints * sizeof(double));
+            memcpy(z, poRow->adfXYZ.data() + 2 * nPoints,
+                   nPoints * sizeof(double));
+            memcpy(panSuccess, poRow->anSuccess.data(), nPoints * sizeof(int));
+            return poRow->bRet;
+        }
+        psATInfo->psCache->nMisses++;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Bail if our preconditions are not met, or if error is not       */
 /*      acceptable.                                                     */
@@ -4141,6 +4701,10 @@ end:
                 i, x[i], y[i], panSuccess[i]);
 #endif
 
+    if( nRowKey != 0 )
+        GDALApproxTransformCacheRow( psATInfo, nRowKey, adfInput, bDstToSrc,
+                                     nPoints, x, y, z, panSuccess, bRet );
+
     return bRet;
 }
 
@@ -1183,7 +1183,10 @@ GDALWarpDstAlphaMasker( void *pMaskFuncArg, int nBandCount,
  *
  * <li>NUM_THREADS: (GDAL >= 1.10) Can be set to a numeric value or ALL_CPUS to
  * set the number of threads to use to parallelize the computation part of the
- * warping. If not set, computation will be done in a single thread.</li>
+ * warping. If not set, computation will be done in a single thread.
+ * Starting with GDAL 3.7, when used with GDALWarpOperation::ChunkAndWarpMulti()
+ * (gdalwarp -multi), several chunks can also be processed at the same
+ * time.</li>
  *
  * <li>STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
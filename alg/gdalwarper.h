@@ -509,6 +509,9 @@ private:
                                       int nDstXSize, int nDstYSize );
     void            CollectChunkList( int nDstXOff, int nDstYOff,
                                       int nDstXSize, int nDstYSize );
+    CPLErr          ChunkAndWarpConcurrently( int nDstXOff, int nDstYOff,
+                                              int nDstXSize, int nDstYSize,
+                                              int nThreads );
     void            ReportTiming( const char * );
 
 public:
@@ -87,6 +87,10 @@ CPL_CVSID("$Id$")
 constexpr double BAND_DENSITY_THRESHOLD = 0.0000000001;
 constexpr float SRC_DENSITY_THRESHOLD =  0.000000001f;
 
+// Number of jobs per thread in which the destination rows of a chunk are
+// split by GWKRun(), for load balancing.
+constexpr int GWK_JOBS_PER_THREAD = 8;
+
 // #define INSTANTIATE_FLOAT64_SSE2_IMPL
 
 static const int anGWKFilterRadius[] =
@@ -410,6 +414,8 @@ static void ThreadFuncAdapter(void* pData)
         if( !pTransformerArg )
         {
             psJob->stopFlag = true;
+            // Wake up GWKRun() which might be waiting for progress.
+            psJob->cv.notify_one();
             return;
         }
         psThreadData->mapThreadToTransformerArg[nThreadId] = pTransformerArg;
@@ -467,27 +473,53 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
     if( nThreads <= 0 )
         nThreads = 1;
 
-    CPLDebug("WARP", "Using %d threads", nThreads);
+    // Split the rows in several jobs per thread rather than in one job per
+    // thread, so that a thread that is done with cheap rows (e.g. rows that
+    // fall outside of the source footprint) can take over the remaining
+    // jobs of the queue, instead of waiting for the slowest thread.
+    int nJobs = nThreads;
+    if( nThreads > 1 )
+    {
+        GIntBig nMaxJobs = static_cast<GIntBig>(nThreads) * GWK_JOBS_PER_THREAD;
+        nMaxJobs = std::min(nMaxJobs, static_cast<GIntBig>(nDstYSize));
+        if( nWarpChunkSize > 0 )
+        {
+            nMaxJobs = std::min(nMaxJobs,
+                static_cast<GIntBig>(nDstYSize) * poWK->nDstXSize / nWarpChunkSize);
+        }
+        nJobs = std::max(nThreads, static_cast<int>(nMaxJobs));
+    }
+
+    CPLDebug("WARP", "Using %d threads and %d jobs", nThreads, nJobs);
 
     auto& jobs = *psThreadData->threadJobs;
-    CPLAssert( static_cast<int>(jobs.size()) >= nThreads );
+    while( static_cast<int>(jobs.size()) < nJobs )
+    {
+        jobs.emplace_back(psThreadData->mutex, psThreadData->cv,
+                          psThreadData->counter, psThreadData->stopFlag);
+    }
     // Fill-in job structures.
-    for (int i = 0; i < nThreads; ++i)
+    for (int i = 0; i < nJobs; ++i)
     {
         auto& job = jobs[i];
         job.poWK = poWK;
-        job.iYMin = static_cast<int>(static_cast<int64_t>(i) * nDstYSize / nThreads);
-        job.iYMax = static_cast<int>(static_cast<int64_t>(i + 1) * nDstYSize / nThreads);
-        if( poWK->pfnProgress != GDALDummyProgress )
-            job.pfnProgress = GWKProgressThread;
+        job.iYMin = static_cast<int>(static_cast<int64_t>(i) * nDstYSize / nJobs);
+        job.iYMax = static_cast<int>(static_cast<int64_t>(i + 1) * nDstYSize / nJobs);
+        job.pfnProgress = poWK->pfnProgress != GDALDummyProgress ?
+                                            GWKProgressThread : nullptr;
         job.pfnFunc = pfnFunc;
     }
 
     {
         std::unique_lock<std::mutex> lock(psThreadData->mutex);
 
+        // The counter and the stop flag are shared by all the GWKRun() calls
+        // of a warp operation.
+        psThreadData->counter = 0;
+        psThreadData->stopFlag = false;
+
         // Start jobs.
-        for (int i = 0; i < nThreads; ++i)
+        for (int i = 0; i < nJobs; ++i)
         {
             auto& job = jobs[i];
             psThreadData->poJobQueue->SubmitJob( ThreadFuncAdapter,
@@ -500,7 +532,7 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
         if( poWK->pfnProgress != GDALDummyProgress )
         {
             int& counter = psThreadData->counter;
-            while (counter < nDstYSize)
+            while (counter < nDstYSize && !psThreadData->stopFlag)
             {
                 psThreadData->cv.wait(lock);
                 if( !poWK->pfnProgress(
@@ -3412,12 +3444,19 @@ struct _GWKResampleWrkStruct
     double  *padfWeightsX;
     bool    *pabCalcX;
 
-    double  *padfWeightsY; // Only used by GWKResampleOptimizedLanczos.
+    double  *padfWeightsY;
     int      iLastSrcX; // Only used by GWKResampleOptimizedLanczos.
     int      iLastSrcY; // Only used by GWKResampleOptimizedLanczos.
     double   dfLastDeltaX; // Only used by GWKResampleOptimizedLanczos.
     double   dfLastDeltaY; // Only used by GWKResampleOptimizedLanczos.
 
+    // Saved Y weights, and source position for which the saved X and Y
+    // weights are valid, so that they are computed once for all bands.
+    // Only used by GWKResample.
+    bool    *pabCalcY;
+    double   dfLastSrcX;
+    double   dfLastSrcY;
+
     // Space for saving a row of pixels.
     double  *padfRowDensity;
     double  *padfRowReal;
@@ -3460,6 +3499,10 @@ static GWKResampleWrkStruct* GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
     psWrkStruct->iLastSrcY = -10;
     psWrkStruct->dfLastDeltaX = -10;
     psWrkStruct->dfLastDeltaY = -10;
+    psWrkStruct->pabCalcY =
+        static_cast<bool *>(CPLMalloc(nYDist * sizeof(bool)));
+    psWrkStruct->dfLastSrcX = std::numeric_limits<double>::quiet_NaN();
+    psWrkStruct->dfLastSrcY = std::numeric_limits<double>::quiet_NaN();
 
     // Alloc space for saving a row of pixels.
     if( poWK->pafUnifiedSrcDensity == nullptr &&
@@ -3531,6 +3574,7 @@ static void GWKResampleDeleteWrkStruct(GWKResampleWrkStruct* psWrkStruct)
     CPLFree( psWrkStruct->padfWeightsX );
     CPLFree( psWrkStruct->padfWeightsY );
     CPLFree( psWrkStruct->pabCalcX );
+    CPLFree( psWrkStruct->pabCalcY );
     CPLFree( psWrkStruct->padfRowDensity );
     CPLFree( psWrkStruct->padfRowReal );
     CPLFree( psWrkStruct->padfRowImag );
@@ -3565,20 +3609,28 @@ static bool GWKResample( const GDALWarpKernel *poWK, int iBand,
     const double dfXScale = poWK->dfXScale;
     const double dfYScale = poWK->dfYScale;
 
-    const int nXDist = ( poWK->nXRadius + 1 ) * 2;
-
-    // Space for saved X weights.
+    // Space for saved X and Y weights.
     double *padfWeightsX = psWrkStruct->padfWeightsX;
     bool *pabCalcX = psWrkStruct->pabCalcX;
+    double *padfWeightsY = psWrkStruct->padfWeightsY;
+    bool *pabCalcY = psWrkStruct->pabCalcY;
 
     // Space for saving a row of pixels.
     double *padfRowDensity = psWrkStruct->padfRowDensity;
     double *padfRowReal = psWrkStruct->padfRowReal;
     double *padfRowImag = psWrkStruct->padfRowImag;
 
-    // Mark as needing calculation (don't calculate the weights yet,
-    // because a mask may render it unnecessary).
-    memset( pabCalcX, false, nXDist * sizeof(bool) );
+    // The bands of a destination pixel are resampled from the same source
+    // position, so the weights computed for the previous band are reused.
+    // Otherwise mark them as needing calculation (don't calculate the
+    // weights yet, because a mask may render it unnecessary).
+    if( dfSrcX != psWrkStruct->dfLastSrcX || dfSrcY != psWrkStruct->dfLastSrcY )
+    {
+        psWrkStruct->dfLastSrcX = dfSrcX;
+        psWrkStruct->dfLastSrcY = dfSrcY;
+        memset( pabCalcX, false, ( poWK->nXRadius + 1 ) * 2 * sizeof(bool) );
+        memset( pabCalcY, false, ( poWK->nYRadius + 1 ) * 2 * sizeof(bool) );
+    }
 
     FilterFuncType pfnGetWeight = apfGWKFilter[poWK->eResample];
     CPLAssert(pfnGetWeight);
@@ -3617,10 +3669,16 @@ static bool GWKResample( const GDALWarpKernel *poWK, int iBand,
                              padfRowDensity, padfRowReal, padfRowImag ) )
             continue;
 
-        // Calculate the Y weight.
-        double dfWeight1 = ( bYScaleBelow1 ) ?
+        // Make or use a cached Y weight for this row.
+        const int iWeightY = j - poWK->nFiltInitY;
+        if( !pabCalcY[iWeightY] )
+        {
+            padfWeightsY[iWeightY] = ( bYScaleBelow1 ) ?
                 pfnGetWeight((j - dfDeltaY) * dfYScale):
                 pfnGetWeight(j - dfDeltaY);
+            pabCalcY[iWeightY] = true;
+        }
+        const double dfWeight1 = padfWeightsY[iWeightY];
 
         // Iterate over pixels in row.
         double dfAccumulatorRealLocal = 0.0;
@@ -37,10 +37,13 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -49,6 +52,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_alg_priv.h"
@@ -63,12 +67,46 @@ struct _GDALWarpChunk {
     double sExtraSx, sExtraSy;
 };
 
+/************************************************************************/
+/*                       GDALWarpConcurrentChunks                       */
+/*                                                                      */
+/*      State shared by the jobs of ChunkAndWarpConcurrently(). Each    */
+/*      job pulls the next chunk of the list until it is exhausted, so  */
+/*      that the number of chunks in flight is the number of jobs.      */
+/************************************************************************/
+
+struct GDALWarpConcurrentChunks
+{
+    GDALWarpOperation *poOperation = nullptr;
+    const GDALWarpChunk *pasChunkList = nullptr;
+    int nChunkListCount = 0;
+    CPLMutex *hIOMutex = nullptr;
+
+    std::atomic<int> nNextChunk{0};
+    std::atomic<bool> bStop{false};
+
+    // One clone of the transformer per job, so that kernels of different
+    // chunks can run at the same time.
+    std::vector<void*> apTransformerArgs{};
+
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    // Protected by oMutex.
+    std::map<GIntBig, void*> oMapThreadToTransformerArg{};
+    int nActiveJobs = 0;
+    double dfPixelsProcessed = 0;
+    CPLErr eErr = CE_None;
+};
+
 struct GDALWarpPrivateData
 {
     int nStepCount = 0;
     std::vector<int> abSuccess{};
     std::vector<double> adfDstX{};
     std::vector<double> adfDstY{};
+
+    // Set while ChunkAndWarpConcurrently() is running.
+    GDALWarpConcurrentChunks *psConcurrentChunks = nullptr;
 };
 
 static std::mutex gMutex{};
@@ -1098,6 +1136,13 @@ static void ChunkThreadMain( void *pThreadData )
  * internally this method uses multiple threads to interleave input/output
  * for one region while the processing is being done for another.
  *
+ * Starting with GDAL 3.7, when the NUM_THREADS warp option (or the
+ * GDAL_NUM_THREADS configuration option) is set to more than one thread,
+ * several chunks are warped at the same time, as long as the transformer
+ * can be cloned and no chunk processor callbacks are set. The chunks are
+ * then sized so that the chunks in flight fit together in the warp memory
+ * limit.
+ *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
  * @param nDstXSize Width of output window on destination file to be produced.
@@ -1116,6 +1161,26 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(
     CPLReleaseMutex( hIOMutex );
     CPLReleaseMutex( hWarpMutex );
 
+/* -------------------------------------------------------------------- */
+/*      With several threads, warp several chunks at the same time if   */
+/*      possible.                                                       */
+/* -------------------------------------------------------------------- */
+    const char* pszWarpThreads =
+        CSLFetchNameValue(psOptions->papszWarpOptions, "NUM_THREADS");
+    if( pszWarpThreads == nullptr )
+        pszWarpThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128,
+        EQUAL(pszWarpThreads, "ALL_CPUS") ? CPLGetNumCPUs() :
+                                            atoi(pszWarpThreads)));
+    if( nThreads > 1 &&
+        CPLTestBool(CPLGetConfigOption("GDAL_WARP_CONCURRENT_CHUNKS", "YES")) )
+    {
+        const CPLErr eErr = ChunkAndWarpConcurrently(
+            nDstXOff, nDstYOff, nDstXSize, nDstYSize, nThreads );
+        if( eErr != CE_Warning )
+            return eErr;
+    }
+
     CPLCond* hCond = CPLCreateCond();
     CPLMutex* hCondMutex = CPLCreateMutex();
     CPLReleaseMutex(hCondMutex);
@@ -1237,6 +1302,244 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(
     return eErr;
 }
 
+/************************************************************************/
+/*                  GDALWarpConcurrentChunksProgress()                  */
+/*                                                                      */
+/*      Progress function of the kernels run by                         */
+/*      ChunkAndWarpConcurrently(). Progress is reported by the         */
+/*      calling thread as chunks complete, so kernels only need to      */
+/*      know if they must stop.                                         */
+/************************************************************************/
+
+static int CPL_STDCALL GDALWarpConcurrentChunksProgress(
+    double /* dfComplete */, const char * /* pszMessage */, void *pProgressArg )
+{
+    return !static_cast<GDALWarpConcurrentChunks *>(pProgressArg)->bStop;
+}
+
+/************************************************************************/
+/*                    GDALWarpConcurrentChunksJob()                     */
+/************************************************************************/
+
+namespace {
+struct GDALWarpConcurrentChunksJob
+{
+    GDALWarpConcurrentChunks *psCtxt = nullptr;
+    int iJob = 0;
+};
+} // namespace
+
+static void GDALWarpConcurrentChunksJobFunc( void *pData )
+{
+    const GDALWarpConcurrentChunksJob *psJob =
+        static_cast<const GDALWarpConcurrentChunksJob *>(pData);
+    GDALWarpConcurrentChunks *psCtxt = psJob->psCtxt;
+    const GIntBig nThreadId = CPLGetPID();
+
+    {
+        std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+        psCtxt->oMapThreadToTransformerArg[nThreadId] =
+            psCtxt->apTransformerArgs[psJob->iJob];
+    }
+
+    while( !psCtxt->bStop )
+    {
+        const int iChunk = psCtxt->nNextChunk++;
+        if( iChunk >= psCtxt->nChunkListCount )
+            break;
+        const GDALWarpChunk *pasThisChunk = psCtxt->pasChunkList + iChunk;
+
+        CPLErr eErr = CE_None;
+        if( !CPLAcquireMutex( psCtxt->hIOMutex, 600.0 ) )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Failed to acquire IOMutex in WarpRegion()." );
+            eErr = CE_Failure;
+        }
+        else
+        {
+            // The progress of the kernel is ignored, see
+            // GDALWarpConcurrentChunksProgress()
+            eErr = psCtxt->poOperation->WarpRegion(
+                                    pasThisChunk->dx, pasThisChunk->dy,
+                                    pasThisChunk->dsx, pasThisChunk->dsy,
+                                    pasThisChunk->sx, pasThisChunk->sy,
+                                    pasThisChunk->ssx, pasThisChunk->ssy,
+                                    pasThisChunk->sExtraSx,
+                                    pasThisChunk->sExtraSy,
+                                    0.0, 0.0);
+            CPLReleaseMutex( psCtxt->hIOMutex );
+        }
+
+        {
+            std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+            if( eErr != CE_None )
+            {
+                if( psCtxt->eErr == CE_None )
+                    psCtxt->eErr = eErr;
+                psCtxt->bStop = true;
+            }
+            else
+            {
+                psCtxt->dfPixelsProcessed +=
+                    pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
+            }
+        }
+        psCtxt->oCV.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+        psCtxt->oMapThreadToTransformerArg.erase(nThreadId);
+        psCtxt->nActiveJobs--;
+    }
+    psCtxt->oCV.notify_one();
+}
+
+/************************************************************************/
+/*                    GDALWarpGetTransformerArgForThread()              */
+/************************************************************************/
+
+static void* GDALWarpGetTransformerArgForThread(
+                                    GDALWarpConcurrentChunks *psCtxt )
+{
+    std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+    auto oIter = psCtxt->oMapThreadToTransformerArg.find(CPLGetPID());
+    CPLAssert( oIter != psCtxt->oMapThreadToTransformerArg.end() );
+    return oIter->second;
+}
+
+/************************************************************************/
+/*                      ChunkAndWarpConcurrently()                      */
+/************************************************************************/
+
+/**
+ * Warp several chunks at the same time, on nThreads jobs.
+ *
+ * Each job pulls the next chunk of the list until it is exhausted, and runs
+ * the read, the kernel and the write of that chunk. Reads and writes are
+ * serialized by the IO mutex, but kernels of different chunks run
+ * concurrently, each with its own clone of the transformer. The memory limit
+ * is shared between the chunks in flight.
+ *
+ * @return CE_None or CE_Failure on success or failure, or CE_Warning if the
+ * concurrent mode cannot be used, in which case nothing has been done.
+ */
+
+CPLErr GDALWarpOperation::ChunkAndWarpConcurrently(
+    int nDstXOff, int nDstYOff,  int nDstXSize, int nDstYSize, int nThreads )
+
+{
+/* -------------------------------------------------------------------- */
+/*      Application provided chunk processors might not be thread-safe. */
+/* -------------------------------------------------------------------- */
+    if( psOptions->pfnPreWarpChunkProcessor != nullptr ||
+        psOptions->pfnPostWarpChunkProcessor != nullptr )
+    {
+        return CE_Warning;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Collect chunks so that nThreads of them fit in the memory       */
+/*      limit. If that does not give at least one chunk per thread,     */
+/*      the multi-threaded kernel of ChunkAndWarpMulti() is a better    */
+/*      fit.                                                            */
+/* -------------------------------------------------------------------- */
+    const double dfWarpMemoryLimit = psOptions->dfWarpMemoryLimit;
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit / nThreads;
+    CollectChunkList( nDstXOff, nDstYOff, nDstXSize, nDstYSize );
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit;
+
+    if( nChunkListCount < nThreads )
+    {
+        WipeChunkList();
+        return CE_Warning;
+    }
+
+    // The jobs block on the IO mutex, so they do not run in the global
+    // thread pool, whose workers might be needed by the I/O itself (for
+    // example for multi-threaded GeoTIFF compression).
+    CPLWorkerThreadPool oThreadPool;
+    if( !oThreadPool.Setup(nThreads, nullptr, nullptr) )
+    {
+        WipeChunkList();
+        return CE_Warning;
+    }
+
+    GDALWarpConcurrentChunks sCtxt;
+    sCtxt.poOperation = this;
+    sCtxt.pasChunkList = pasChunkList;
+    sCtxt.nChunkListCount = nChunkListCount;
+    sCtxt.hIOMutex = hIOMutex;
+    for( int i = 0; i < nThreads; i++ )
+    {
+        void *pTransformerArg =
+            GDALCloneTransformer(psOptions->pTransformerArg);
+        if( pTransformerArg == nullptr )
+        {
+            // Transformer that cannot be serialized.
+            CPLErrorReset();
+            for( void *pArg: sCtxt.apTransformerArgs )
+                GDALDestroyTransformer(pArg);
+            WipeChunkList();
+            return CE_Warning;
+        }
+        sCtxt.apTransformerArgs.push_back(pTransformerArg);
+    }
+
+    CPLDebug( "WARP", "Warping %d chunks with %d concurrent jobs",
+              nChunkListCount, nThreads );
+
+    double dfTotalPixels = 0.0;
+    for( int iChunk = 0; iChunk < nChunkListCount; iChunk++ )
+    {
+        dfTotalPixels +=
+            pasChunkList[iChunk].dsx * static_cast<double>(pasChunkList[iChunk].dsy);
+    }
+
+    GDALWarpPrivateData *psPrivateData = GetWarpPrivateData(this);
+    psPrivateData->psConcurrentChunks = &sCtxt;
+
+    std::vector<GDALWarpConcurrentChunksJob> asJobs(nThreads);
+    auto poJobQueue = oThreadPool.CreateJobQueue();
+    sCtxt.nActiveJobs = nThreads;
+    for( int i = 0; i < nThreads; i++ )
+    {
+        asJobs[i].psCtxt = &sCtxt;
+        asJobs[i].iJob = i;
+        poJobQueue->SubmitJob(GDALWarpConcurrentChunksJobFunc, &asJobs[i]);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Report progress as chunks complete.                             */
+/* -------------------------------------------------------------------- */
+    {
+        std::unique_lock<std::mutex> oLock(sCtxt.oMutex);
+        while( sCtxt.nActiveJobs > 0 )
+        {
+            sCtxt.oCV.wait(oLock);
+            if( !sCtxt.bStop &&
+                !psOptions->pfnProgress(
+                    dfTotalPixels > 0 ?
+                        sCtxt.dfPixelsProcessed / dfTotalPixels : 1.0,
+                    "", psOptions->pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                sCtxt.eErr = CE_Failure;
+                sCtxt.bStop = true;
+            }
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    psPrivateData->psConcurrentChunks = nullptr;
+    for( void *pArg: sCtxt.apTransformerArgs )
+        GDALDestroyTransformer(pArg);
+    WipeChunkList();
+
+    return sCtxt.eErr;
+}
+
 /************************************************************************/
 /*                         GDALChunkAndWarpMulti()                      */
 /************************************************************************/
@@ -1847,6 +2150,20 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.papszWarpOptions = psOptions->papszWarpOptions;
     oWK.psThreadData = psThreadData;
 
+    // When several chunks are warped concurrently, each kernel is
+    // single-threaded and uses the transformer of the calling job.
+    GDALWarpConcurrentChunks *psConcurrentChunks =
+        hIOMutex != nullptr ? GetWarpPrivateData(this)->psConcurrentChunks
+                            : nullptr;
+    if( psConcurrentChunks )
+    {
+        oWK.pTransformerArg =
+            GDALWarpGetTransformerArgForThread(psConcurrentChunks);
+        oWK.pfnProgress = GDALWarpConcurrentChunksProgress;
+        oWK.pProgress = psConcurrentChunks;
+        oWK.psThreadData = nullptr;
+    }
+
     oWK.padfDstNoDataReal = psOptions->padfDstNoDataReal;
 
 /* -------------------------------------------------------------------- */
@@ -2244,7 +2561,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     if( hIOMutex != nullptr )
     {
         CPLReleaseMutex( hIOMutex );
-        if( !CPLAcquireMutex( hWarpMutex, 600.0 ) )
+        if( psConcurrentChunks == nullptr &&
+            !CPLAcquireMutex( hWarpMutex, 600.0 ) )
         {
             CPLError( CE_Failure, CPLE_AppDefined,
                       "Failed to acquire WarpMutex in WarpRegion()." );
@@ -2280,7 +2598,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 /* -------------------------------------------------------------------- */
     if( hIOMutex != nullptr )
     {
-        CPLReleaseMutex( hWarpMutex );
+        if( psConcurrentChunks == nullptr )
+            CPLReleaseMutex( hWarpMutex );
         if( !CPLAcquireMutex( hIOMutex, 600.0 ) )
         {
             CPLError( CE_Failure, CPLE_AppDefined,
@@ -71,6 +71,19 @@ public:
         }
         return CE_None;
     }
+
+    // Start processing at line lineIdx, instead of the first line of the
+    // raster. previousLine holds the values of line lineIdx - 1 (it is
+    // ignored if lineIdx is 0). This is used to process horizontal tiles
+    // of the raster independently.
+    void seekLine( size_t lineIdx, const double* previousLine )
+    {
+        lineIdx_ = lineIdx;
+        if ( lineIdx > 0 && previousLine != nullptr )
+            std::copy( previousLine, previousLine + width_, previousLine_.begin() );
+        else
+            std::fill( previousLine_.begin(), previousLine_.end(), NaN );
+    }
 private:
     size_t width_;
     size_t height_;
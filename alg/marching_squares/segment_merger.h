@@ -49,8 +49,12 @@ struct SegmentMerger
     // a collection of unmerged linestrings
     typedef std::list<LineStringEx> Lines;
     
-    SegmentMerger( LineWriter& lineWriter, const LevelGenerator& levelGenerator, bool polygonize_ )
+    // When tile_ is true, the merger only receives the segments of a
+    // horizontal tile of the raster, and rings crossing the tile borders
+    // are expected to be left unclosed (see TileStitcher).
+    SegmentMerger( LineWriter& lineWriter, const LevelGenerator& levelGenerator, bool polygonize_, bool tile_ = false )
         : polygonize( polygonize_ )
+        , tile( tile_ )
         , lineWriter_( lineWriter )
         , lines_()
         , levelGenerator_(levelGenerator)
@@ -58,7 +62,7 @@ struct SegmentMerger
 
     ~SegmentMerger()
     {
-        if ( polygonize )
+        if ( polygonize && !tile )
         {
             for (auto it =lines_.begin(); it!=lines_.end(); ++it) {
                 if ( ! it->second.empty() )
@@ -128,6 +132,7 @@ struct SegmentMerger
     SegmentMerger<LineWriter, LevelGenerator>& operator=( const SegmentMerger<LineWriter, LevelGenerator>& ) = delete;
 
     const bool polygonize;
+    const bool tile;
 private:
     LineWriter &lineWriter_;
     // lines of each level
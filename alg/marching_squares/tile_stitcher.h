@@ -0,0 +1,212 @@
+/******************************************************************************
+ *
+ * Project:  Marching square algorithm
+ * Purpose:  Stitching of contour lines generated on horizontal tiles.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+#ifndef MARCHING_SQUARES_TILE_STITCHER_H
+#define MARCHING_SQUARES_TILE_STITCHER_H
+
+#include "point.h"
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace marching_squares {
+
+// A line emitted by the SegmentMerger of a tile
+struct TileLine
+{
+    double level;
+    LineString ls;
+};
+
+// LineWriter collecting the lines emitted for a tile
+struct TileLineCollector
+{
+    void addLine( double level, LineString& ls, bool /* closed */ )
+    {
+        lines.push_back( TileLine{ level, LineString() } );
+        lines.back().ls.swap( ls );
+    }
+
+    std::vector<TileLine> lines = {};
+};
+
+// TileStitcher: receives the lines generated on consecutive horizontal tiles
+// of the raster, from top to bottom, joins the lines that cross the seams
+// between tiles, and forwards the resulting lines to a LineWriter.
+//
+// Lines that cross a seam have an end point on it in each tile, with
+// exactly the same coordinates, since squares on each side of the seam
+// interpolate along the same pixel edge.
+template <typename LineWriter>
+class TileStitcher
+{
+public:
+    explicit TileStitcher( LineWriter& lineWriter )
+        : lineWriter_( lineWriter )
+    {}
+
+    ~TileStitcher()
+    {
+        // Lines which could not be joined
+        for ( auto& line: pending_ )
+            emit_( line );
+    }
+
+    // Add the lines of the next tile. bottomSeamY is the y coordinate of
+    // the seam with the next tile, or NaN for the last tile.
+    void addTile( std::vector<TileLine>&& lines, double bottomSeamY )
+    {
+        std::vector<TileLine> all;
+        all.swap( pending_ );
+        const size_t nAbove = all.size();
+        for ( auto& line: lines )
+            all.push_back( std::move( line ) );
+        lines.clear();
+
+        const size_t nEnds = 2 * all.size();
+        partner_.assign( nEnds, NONE );
+
+        // Pair the end points located on the seam of lines of the previous
+        // tiles with the ones of the lines of the new tile. End point i of
+        // line k is identified as 2 * k + i, with i = 0 for the front and
+        // 1 for the back.
+        if ( !std::isnan( seamY_ ) && nAbove > 0 )
+        {
+            std::map<std::pair<double, double>, std::vector<size_t>> aboveEnds;
+            for ( size_t k = 0; k < nAbove; k++ )
+            {
+                if ( all[k].ls.front().y == seamY_ )
+                    aboveEnds[{ all[k].level, all[k].ls.front().x }].push_back( 2 * k );
+                if ( all[k].ls.back().y == seamY_ )
+                    aboveEnds[{ all[k].level, all[k].ls.back().x }].push_back( 2 * k + 1 );
+            }
+            std::map<std::pair<double, double>, size_t> used;
+            for ( size_t k = nAbove; k < all.size(); k++ )
+            {
+                for ( size_t i = 0; i < 2; i++ )
+                {
+                    const Point& p = i == 0 ? all[k].ls.front() : all[k].ls.back();
+                    if ( p.y != seamY_ )
+                        continue;
+                    const std::pair<double, double> key( all[k].level, p.x );
+                    auto it = aboveEnds.find( key );
+                    if ( it == aboveEnds.end() )
+                        continue;
+                    size_t& nUsed = used[key];
+                    if ( nUsed < it->second.size() )
+                    {
+                        const size_t other = it->second[nUsed++];
+                        partner_[2 * k + i] = other;
+                        partner_[other] = 2 * k + i;
+                    }
+                }
+            }
+        }
+
+        // Walk chains of joined lines
+        std::vector<bool> visited( all.size(), false );
+        for ( size_t k = 0; k < all.size(); k++ )
+        {
+            if ( visited[k] )
+                continue;
+
+            // Find the start of the chain containing line k: the first
+            // end point without a partner, or k itself for a ring.
+            size_t start = 2 * k;
+            for ( size_t cur = start; partner_[cur] != NONE; )
+            {
+                cur = partner_[cur] ^ 1;
+                if ( cur / 2 == k )
+                {
+                    // ring
+                    start = 2 * k;
+                    break;
+                }
+                start = cur;
+            }
+
+            TileLine result{ all[start / 2].level, LineString() };
+            size_t cur = start;
+            while ( true )
+            {
+                const size_t line = cur / 2;
+                visited[line] = true;
+                LineString& ls = all[line].ls;
+                if ( cur % 2 == 1 )
+                    ls.reverse();
+                if ( !result.ls.empty() )
+                    ls.pop_front();
+                result.ls.splice( result.ls.end(), ls );
+
+                const size_t farEnd = cur ^ 1;
+                const size_t next = partner_[farEnd];
+                if ( next == NONE || visited[next / 2] )
+                    break;
+                cur = next;
+            }
+
+            if ( !std::isnan( bottomSeamY ) &&
+                 !( result.ls.front() == result.ls.back() ) &&
+                 ( result.ls.front().y == bottomSeamY ||
+                   result.ls.back().y == bottomSeamY ) )
+            {
+                pending_.push_back( std::move( result ) );
+            }
+            else
+            {
+                emit_( result );
+            }
+        }
+        seamY_ = bottomSeamY;
+    }
+
+    // non copyable
+    TileStitcher( const TileStitcher<LineWriter>& ) = delete;
+    TileStitcher<LineWriter>& operator=( const TileStitcher<LineWriter>& ) = delete;
+
+private:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    LineWriter& lineWriter_;
+    // Lines with an end point on the bottom seam of the last tile
+    std::vector<TileLine> pending_ = {};
+    // y coordinate of the bottom seam of the last tile
+    double seamY_ = NaN;
+    std::vector<size_t> partner_ = {};
+
+    void emit_( TileLine& line )
+    {
+        const bool closed = line.ls.front() == line.ls.back();
+        lineWriter_.addLine( line.level, line.ls, closed );
+    }
+};
+
+}
+
+#endif
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -49,6 +50,8 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -543,6 +546,768 @@ GPMaskImageData( GDALRasterBandH hMaskBand, GByte* pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                             Tiled mode                               */
+/*                                                                      */
+/*      The raster is split into horizontal strips processed by         */
+/*      worker threads. A first pass enumerates the polygons of each    */
+/*      strip independently, after which the polygon ids of pixels      */
+/*      facing each other across a strip boundary are unified. A        */
+/*      second pass collects the edges of each strip: polygons lying    */
+/*      in a single strip are emitted directly, while the edges of      */
+/*      polygons spanning several strips are kept aside, and replayed   */
+/*      in raster order once the last strip they touch has been         */
+/*      processed, so that the output matches the non-tiled mode.       */
+/* ==================================================================== */
+/************************************************************************/
+
+/************************************************************************/
+/*                          GPStripEnumJob                              */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+struct GPStripEnumJob
+{
+    DataType    *panVal = nullptr;      // nLines lines of nXSize values.
+    int          nXSize = 0;
+    int          nLines = 0;
+    int          nConnectedness = 4;
+
+    std::unique_ptr<GDALRasterPolygonEnumeratorT<DataType,
+                                                 EqualityTest>> poEnum{};
+    // Final local ids of the first and last lines of the strip.
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<GInt32> anLastLineId{};
+    bool         bOK = true;
+
+    static void Process( void *pData );
+};
+
+template<class DataType, class EqualityTest>
+void GPStripEnumJob<DataType, EqualityTest>::Process( void *pData )
+
+{
+    auto psJob = static_cast<GPStripEnumJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    try
+    {
+        psJob->poEnum.reset(
+            new GDALRasterPolygonEnumeratorT<DataType, EqualityTest>(
+                psJob->nConnectedness));
+        auto& oEnum = *(psJob->poEnum);
+
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        for( int iLine = 0; iLine < psJob->nLines; iLine++ )
+        {
+            DataType *panThisLineVal = psJob->panVal +
+                                       static_cast<size_t>(iLine) * nXSize;
+            if( iLine == 0 )
+            {
+                oEnum.ProcessLine( nullptr, panThisLineVal,
+                                   nullptr, anThisLineId.data(), nXSize );
+                psJob->anFirstLineId = anThisLineId;
+            }
+            else
+            {
+                oEnum.ProcessLine( panThisLineVal - nXSize, panThisLineVal,
+                                   anLastLineId.data(), anThisLineId.data(),
+                                   nXSize );
+            }
+            std::swap(anLastLineId, anThisLineId);
+        }
+        psJob->anLastLineId = std::move(anLastLineId);
+
+        oEnum.CompleteMerges();
+
+        for( auto& nId: psJob->anFirstLineId )
+        {
+            if( nId >= 0 )
+                nId = oEnum.panPolyIdMap[nId];
+        }
+        for( auto& nId: psJob->anLastLineId )
+        {
+            if( nId >= 0 )
+                nId = oEnum.panPolyIdMap[nId];
+        }
+    }
+    catch( const std::exception& )
+    {
+        psJob->bOK = false;
+    }
+}
+
+/************************************************************************/
+/*                           GPFindRootId()                             */
+/************************************************************************/
+
+static GInt32 GPFindRootId( std::vector<GInt32>& anParent, GInt32 nId )
+{
+    while( anParent[nId] != nId )
+    {
+        anParent[nId] = anParent[anParent[nId]];
+        nId = anParent[nId];
+    }
+    return nId;
+}
+
+/************************************************************************/
+/*                               GPEdge                                 */
+/*                                                                      */
+/*      Pixel edge of a polygon spanning several strips. Edges sort     */
+/*      in the order AddEdges() would add them to the polygon.          */
+/************************************************************************/
+
+struct GPEdge
+{
+    enum Kind
+    {
+        TOP_OF_THIS = 0,        // Top edge of the pixel at iX-1, iY.
+        BOTTOM_OF_PREVIOUS = 1, // Bottom edge of the pixel at iX-1, iY-1.
+        RIGHT_OF_THIS = 2,      // Right edge of the pixel at iX-1, iY.
+        LEFT_OF_RIGHT = 3       // Left edge of the pixel at iX, iY.
+    };
+
+    int iY;
+    int nXAndKind;  // iX * 4 + Kind, iX being the AddEdges() index.
+
+    GPEdge( int iYIn, int iX, Kind eKind ):
+        iY(iYIn), nXAndKind(iX * 4 + eKind) {}
+
+    bool operator< (const GPEdge& other) const
+    {
+        return iY < other.iY ||
+               (iY == other.iY && nXAndKind < other.nXAndKind);
+    }
+
+    void AddTo( RPolygon *poPoly ) const
+    {
+        const int iXReal = (nXAndKind >> 2) - 1;
+        switch( nXAndKind & 3 )
+        {
+            case TOP_OF_THIS:
+                poPoly->AddSegment( iXReal, iY, iXReal+1, iY, 1 );
+                break;
+            case BOTTOM_OF_PREVIOUS:
+                poPoly->AddSegment( iXReal, iY, iXReal+1, iY, 0 );
+                break;
+            case RIGHT_OF_THIS:
+                poPoly->AddSegment( iXReal+1, iY, iXReal+1, iY+1, 1 );
+                break;
+            default:
+                poPoly->AddSegment( iXReal+1, iY, iXReal+1, iY+1, 0 );
+                break;
+        }
+    }
+};
+
+/************************************************************************/
+/*                          GPStripEdgesJob                             */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+struct GPStripEdgesJob
+{
+    DataType    *panVal = nullptr;      // nLines lines of nXSize values.
+    int          nXSize = 0;
+    int          nLines = 0;
+    int          nYOff = 0;
+    int          nConnectedness = 4;
+    int          iStrip = 0;
+    GInt32       nBaseId = 0;           // Global id of first local id.
+
+    // Global arrays indexed by global polygon id.
+    const GInt32   *panRootId = nullptr;
+    const int      *panMinStrip = nullptr;
+    const int      *panMaxStrip = nullptr;
+    const DataType *panPolyValue = nullptr;
+
+    // Global root ids of the lines just above and below the strip,
+    // or nullptr at the raster edges.
+    const GInt32 *panTopLineId = nullptr;
+    const GInt32 *panBottomLineId = nullptr;
+
+    // Polygons lying entirely in this strip, ready to be emitted.
+    std::vector<std::unique_ptr<RPolygon>> apoPolys{};
+    // Edges of polygons also lying in other strips, with their id.
+    std::vector<std::pair<GInt32, std::vector<GPEdge>>> aoPartialEdges{};
+    bool         bOK = true;
+
+    static void Process( void *pData );
+};
+
+template<class DataType, class EqualityTest>
+void GPStripEdgesJob<DataType, EqualityTest>::Process( void *pData )
+
+{
+    auto psJob = static_cast<GPStripEdgesJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    try
+    {
+        std::unordered_map<GInt32, std::unique_ptr<RPolygon>> oMapPolys;
+        std::unordered_map<GInt32, std::vector<GPEdge>> oMapPartialEdges;
+        const auto AddEdge = [psJob, &oMapPolys, &oMapPartialEdges](
+            GInt32 nId, int iX, int iY, GPEdge::Kind eKind)
+        {
+            const GPEdge oEdge(iY, iX, eKind);
+            if( psJob->panMinStrip[nId] == psJob->iStrip &&
+                psJob->panMaxStrip[nId] == psJob->iStrip )
+            {
+                auto& poPoly = oMapPolys[nId];
+                if( poPoly == nullptr )
+                    // FIXME loss of precision for [U]Int64
+                    poPoly.reset(new RPolygon(
+                        static_cast<double>(psJob->panPolyValue[nId])));
+                oEdge.AddTo(poPoly.get());
+            }
+            else
+            {
+                oMapPartialEdges[nId].push_back(oEdge);
+            }
+        };
+
+        // Replay the enumeration of the first pass to get local ids.
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest>
+            oEnum(psJob->nConnectedness);
+        std::vector<GInt32> anLocalLastLineId(nXSize);
+        std::vector<GInt32> anLocalThisLineId(nXSize);
+
+        // Global root ids, with -1 padding on both sides.
+        std::vector<GInt32> anLastLineId(nXSize + 2, -1);
+        std::vector<GInt32> anThisLineId(nXSize + 2, -1);
+        if( psJob->panTopLineId )
+            std::copy(psJob->panTopLineId, psJob->panTopLineId + nXSize,
+                      anLastLineId.begin() + 1);
+
+        for( int iLine = 0; iLine <= psJob->nLines; iLine++ )
+        {
+            const bool bInStrip = iLine < psJob->nLines;
+            if( bInStrip )
+            {
+                DataType *panThisLineVal = psJob->panVal +
+                                           static_cast<size_t>(iLine) * nXSize;
+                if( iLine == 0 )
+                    oEnum.ProcessLine( nullptr, panThisLineVal, nullptr,
+                                       anLocalThisLineId.data(), nXSize );
+                else
+                    oEnum.ProcessLine( panThisLineVal - nXSize, panThisLineVal,
+                                       anLocalLastLineId.data(),
+                                       anLocalThisLineId.data(), nXSize );
+                for( int iX = 0; iX < nXSize; iX++ )
+                {
+                    const GInt32 nId = anLocalThisLineId[iX];
+                    anThisLineId[iX + 1] =
+                        nId < 0 ? -1 : psJob->panRootId[psJob->nBaseId + nId];
+                }
+                std::swap(anLocalLastLineId, anLocalThisLineId);
+            }
+            else if( psJob->panBottomLineId )
+            {
+                std::copy(psJob->panBottomLineId,
+                          psJob->panBottomLineId + nXSize,
+                          anThisLineId.begin() + 1);
+            }
+            else
+            {
+                std::fill(anThisLineId.begin(), anThisLineId.end(), -1);
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Same as AddEdges(), except that the edges of the pixels of      */
+/*      the lines above and below the strip are left to the strips      */
+/*      they belong to.                                                 */
+/* -------------------------------------------------------------------- */
+            const int iY = psJob->nYOff + iLine;
+            const bool bAbove = iLine > 0;
+            for( int iX = 0; iX < nXSize + 1; iX++ )
+            {
+                const GInt32 nThisId = anThisLineId[iX];
+                const GInt32 nRightId = anThisLineId[iX + 1];
+                const GInt32 nPreviousId = anLastLineId[iX];
+
+                if( nThisId != nPreviousId )
+                {
+                    if( bInStrip && nThisId != -1 )
+                        AddEdge(nThisId, iX, iY, GPEdge::TOP_OF_THIS);
+                    if( bAbove && nPreviousId != -1 )
+                        AddEdge(nPreviousId, iX, iY,
+                                GPEdge::BOTTOM_OF_PREVIOUS);
+                }
+
+                if( bInStrip && nThisId != nRightId )
+                {
+                    if( nThisId != -1 )
+                        AddEdge(nThisId, iX, iY, GPEdge::RIGHT_OF_THIS);
+                    if( nRightId != -1 )
+                        AddEdge(nRightId, iX, iY, GPEdge::LEFT_OF_RIGHT);
+                }
+            }
+
+            std::swap(anLastLineId, anThisLineId);
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Sort polygons by id so that the output is deterministic.        */
+/* -------------------------------------------------------------------- */
+        std::vector<GInt32> anIds;
+        anIds.reserve(oMapPolys.size());
+        for( const auto& oIter: oMapPolys )
+            anIds.push_back(oIter.first);
+        std::sort(anIds.begin(), anIds.end());
+        for( const GInt32 nId: anIds )
+        {
+            auto& poPoly = oMapPolys[nId];
+            poPoly->Coalesce();
+            psJob->apoPolys.emplace_back(std::move(poPoly));
+        }
+
+        anIds.clear();
+        for( const auto& oIter: oMapPartialEdges )
+            anIds.push_back(oIter.first);
+        std::sort(anIds.begin(), anIds.end());
+        for( const GInt32 nId: anIds )
+        {
+            psJob->aoPartialEdges.emplace_back(
+                nId, std::move(oMapPartialEdges[nId]));
+        }
+    }
+    catch( const std::exception& )
+    {
+        psJob->bOK = false;
+    }
+}
+
+/************************************************************************/
+/*                             GPRunJobs()                              */
+/************************************************************************/
+
+template<class Job>
+static void GPRunJobs( CPLJobQueue *poJobQueue, std::vector<Job>& asJobs,
+                       int nJobs )
+{
+    for( int i = 0; i < nJobs; i++ )
+    {
+        if( poJobQueue )
+            poJobQueue->SubmitJob(Job::Process, &asJobs[i]);
+        else
+            Job::Process(&asJobs[i]);
+    }
+    if( poJobQueue )
+        poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                          GPReadStrips()                              */
+/************************************************************************/
+
+template<class DataType>
+static CPLErr GPReadStrips( GDALRasterBandH hSrcBand,
+                            GDALRasterBandH hMaskBand,
+                            int nXSize, int nYOff, int nLines,
+                            DataType *panVal, GByte *pabyMask,
+                            GDALDataType eDT )
+{
+    CPLErr eErr = GDALRasterIO( hSrcBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                panVal, nXSize, nLines, eDT, 0, 0 );
+    if( eErr == CE_None && hMaskBand != nullptr )
+    {
+        eErr = GDALRasterIO( hMaskBand, GF_Read, 0, nYOff, nXSize, nLines,
+                             pabyMask, nXSize, nLines, GDT_Byte, 0, 0 );
+        const size_t nCount = static_cast<size_t>(nXSize) * nLines;
+        for( size_t i = 0; eErr == CE_None && i < nCount; i++ )
+        {
+            if( pabyMask[i] == 0 )
+                panVal[i] = GP_NODATA_MARKER;
+        }
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                        GDALPolygonizeTiledT()                        */
+/************************************************************************/
+
+template<class DataType, class EqualityTest>
+static CPLErr
+GDALPolygonizeTiledT( GDALRasterBandH hSrcBand,
+                      GDALRasterBandH hMaskBand,
+                      OGRLayerH hOutLayer, int iPixValField,
+                      int nConnectedness, int nStripHeight, int nThreads,
+                      double *padfGeoTransform,
+                      GDALProgressFunc pfnProgress,
+                      void * pProgressArg,
+                      GDALDataType eDT )
+
+{
+    const int nXSize = GDALGetRasterBandXSize( hSrcBand );
+    const int nYSize = GDALGetRasterBandYSize( hSrcBand );
+    const int nStrips = (nYSize + nStripHeight - 1) / nStripHeight;
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if( poThreadPool == nullptr )
+        nThreads = 1;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if( poThreadPool )
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    // As many strips as threads are read and processed at once.
+    const int nChunkStrips = std::min(nThreads, nStrips);
+    const size_t nChunkValues =
+        static_cast<size_t>(nXSize) * nStripHeight * nChunkStrips;
+    DataType *panVal = static_cast<DataType *>(
+        VSI_MALLOC2_VERBOSE(sizeof(DataType), nChunkValues));
+    GByte *pabyMask =
+        hMaskBand != nullptr
+        ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nChunkValues))
+        : nullptr;
+    if( panVal == nullptr || (hMaskBand != nullptr && pabyMask == nullptr) )
+    {
+        CPLFree(panVal);
+        CPLFree(pabyMask);
+        return CE_Failure;
+    }
+
+    CPLErr eErr = CE_None;
+
+    // Global polygon id maps, and global ids of the first and last lines
+    // of each strip.
+    std::vector<GInt32> anRootId;
+    std::vector<DataType> anPolyValue;
+    std::vector<std::vector<GInt32>> aanFirstLineId;
+    std::vector<std::vector<GInt32>> aanLastLineId;
+    std::vector<DataType> anLastLineVal;
+    std::vector<GInt32> anBaseId;
+
+/* ==================================================================== */
+/*      First pass: enumerate polygons of each strip, and unify the     */
+/*      ids of polygons that continue across strip boundaries.          */
+/* ==================================================================== */
+    typedef GPStripEnumJob<DataType, EqualityTest> EnumJob;
+    try
+    {
+        aanFirstLineId.resize(nStrips);
+        aanLastLineId.resize(nStrips);
+        anBaseId.resize(nStrips);
+        anLastLineVal.resize(nXSize);
+
+        std::vector<EnumJob> asJobs(nChunkStrips);
+        for( int iFirstStrip = 0;
+             eErr == CE_None && iFirstStrip < nStrips;
+             iFirstStrip += nChunkStrips )
+        {
+            const int nJobs = std::min(nChunkStrips, nStrips - iFirstStrip);
+            const int nYOff = iFirstStrip * nStripHeight;
+            const int nLines = std::min(nYSize - nYOff, nJobs * nStripHeight);
+            eErr = GPReadStrips( hSrcBand, hMaskBand, nXSize, nYOff, nLines,
+                                 panVal, pabyMask, eDT );
+            if( eErr != CE_None )
+                break;
+
+            for( int i = 0; i < nJobs; i++ )
+            {
+                auto& sJob = asJobs[i];
+                sJob = EnumJob();
+                sJob.panVal = panVal +
+                    static_cast<size_t>(i) * nStripHeight * nXSize;
+                sJob.nXSize = nXSize;
+                sJob.nLines = std::min(nStripHeight, nLines - i * nStripHeight);
+                sJob.nConnectedness = nConnectedness;
+            }
+            GPRunJobs(poJobQueue.get(), asJobs, nJobs);
+
+            for( int i = 0; eErr == CE_None && i < nJobs; i++ )
+            {
+                auto& sJob = asJobs[i];
+                const int iStrip = iFirstStrip + i;
+                if( !sJob.bOK )
+                {
+                    CPLError( CE_Failure, CPLE_OutOfMemory,
+                              "Out of memory in GDALPolygonize()" );
+                    eErr = CE_Failure;
+                    break;
+                }
+                if( static_cast<GIntBig>(anRootId.size()) +
+                        sJob.poEnum->nNextPolygonId > INT_MAX )
+                {
+                    CPLError( CE_Failure, CPLE_NotSupported,
+                              "Too many polygons in GDALPolygonize()" );
+                    eErr = CE_Failure;
+                    break;
+                }
+
+                // Append the local polygon maps to the global ones.
+                const auto& oEnum = *(sJob.poEnum);
+                const GInt32 nBaseId = static_cast<GInt32>(anRootId.size());
+                anBaseId[iStrip] = nBaseId;
+                for( int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++ )
+                {
+                    anRootId.push_back(nBaseId + oEnum.panPolyIdMap[iPoly]);
+                    anPolyValue.push_back(oEnum.panPolyValue[iPoly]);
+                }
+                sJob.poEnum.reset();
+
+                for( auto& nId: sJob.anFirstLineId )
+                {
+                    if( nId >= 0 )
+                        nId += nBaseId;
+                }
+                for( auto& nId: sJob.anLastLineId )
+                {
+                    if( nId >= 0 )
+                        nId += nBaseId;
+                }
+
+/* -------------------------------------------------------------------- */
+/*      Merge polygons facing each other across the boundary with       */
+/*      the previous strip, following the logic of ProcessLine().       */
+/* -------------------------------------------------------------------- */
+                const DataType *panFirstLineVal = sJob.panVal;
+                if( iStrip > 0 )
+                {
+                    EqualityTest eq;
+                    const auto& anAboveId = aanLastLineId[iStrip - 1];
+                    const auto& anBelowId = sJob.anFirstLineId;
+                    const auto Merge = [&anRootId](GInt32 nId1, GInt32 nId2)
+                    {
+                        nId1 = GPFindRootId(anRootId, nId1);
+                        nId2 = GPFindRootId(anRootId, nId2);
+                        if( nId1 < nId2 )
+                            anRootId[nId2] = nId1;
+                        else if( nId2 < nId1 )
+                            anRootId[nId1] = nId2;
+                    };
+                    for( int iX = 0; iX < nXSize; iX++ )
+                    {
+                        if( anBelowId[iX] < 0 )
+                            continue;
+                        const int iXStart =
+                            nConnectedness == 8 ? std::max(0, iX - 1) : iX;
+                        const int iXEnd =
+                            nConnectedness == 8 ? std::min(nXSize - 1, iX + 1)
+                                                : iX;
+                        for( int iXAbove = iXStart; iXAbove <= iXEnd;
+                             iXAbove++ )
+                        {
+                            if( anAboveId[iXAbove] >= 0 &&
+                                eq.operator()(anLastLineVal[iXAbove],
+                                              panFirstLineVal[iX]) )
+                            {
+                                Merge(anAboveId[iXAbove], anBelowId[iX]);
+                            }
+                        }
+                    }
+                }
+
+                std::copy(sJob.panVal +
+                              static_cast<size_t>(sJob.nLines - 1) * nXSize,
+                          sJob.panVal +
+                              static_cast<size_t>(sJob.nLines) * nXSize,
+                          anLastLineVal.begin());
+                aanFirstLineId[iStrip] = std::move(sJob.anFirstLineId);
+                aanLastLineId[iStrip] = std::move(sJob.anLastLineId);
+            }
+
+            if( eErr == CE_None &&
+                !pfnProgress( 0.10 * (nYOff + nLines) /
+                                  static_cast<double>(nYSize),
+                              "", pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                eErr = CE_Failure;
+            }
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Out of memory in GDALPolygonize()" );
+        eErr = CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Make every id point to its final id, and compute the range of   */
+/*      strips covered by each final polygon.                           */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anMinStrip;
+    std::vector<int> anMaxStrip;
+    if( eErr == CE_None )
+    {
+        try
+        {
+            const GInt32 nIds = static_cast<GInt32>(anRootId.size());
+            for( GInt32 nId = 0; nId < nIds; nId++ )
+                anRootId[nId] = GPFindRootId(anRootId, nId);
+
+            anMinStrip.resize(nIds, nStrips);
+            anMaxStrip.resize(nIds, -1);
+            for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+            {
+                const GInt32 nEndId =
+                    iStrip + 1 < nStrips ? anBaseId[iStrip + 1] : nIds;
+                for( GInt32 nId = anBaseId[iStrip]; nId < nEndId; nId++ )
+                {
+                    const GInt32 nRootId = anRootId[nId];
+                    anMinStrip[nRootId] =
+                        std::min(anMinStrip[nRootId], iStrip);
+                    anMaxStrip[nRootId] =
+                        std::max(anMaxStrip[nRootId], iStrip);
+                }
+            }
+
+            for( auto& anIds: aanFirstLineId )
+            {
+                for( auto& nId: anIds )
+                {
+                    if( nId >= 0 )
+                        nId = anRootId[nId];
+                }
+            }
+            for( auto& anIds: aanLastLineId )
+            {
+                for( auto& nId: anIds )
+                {
+                    if( nId >= 0 )
+                        nId = anRootId[nId];
+                }
+            }
+        }
+        catch( const std::exception& )
+        {
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Out of memory in GDALPolygonize()" );
+            eErr = CE_Failure;
+        }
+    }
+
+/* ==================================================================== */
+/*      Second pass: collect polygon edges of each strip, and emit the  */
+/*      completed polygons in strip order.                              */
+/* ==================================================================== */
+    typedef GPStripEdgesJob<DataType, EqualityTest> EdgesJob;
+    std::map<GInt32, std::vector<GPEdge>> oMapPendingEdges;
+    try
+    {
+        std::vector<EdgesJob> asJobs(eErr == CE_None ? nChunkStrips : 0);
+        for( int iFirstStrip = 0;
+             eErr == CE_None && iFirstStrip < nStrips;
+             iFirstStrip += nChunkStrips )
+        {
+            const int nJobs = std::min(nChunkStrips, nStrips - iFirstStrip);
+            const int nYOff = iFirstStrip * nStripHeight;
+            const int nLines = std::min(nYSize - nYOff, nJobs * nStripHeight);
+            eErr = GPReadStrips( hSrcBand, hMaskBand, nXSize, nYOff, nLines,
+                                 panVal, pabyMask, eDT );
+            if( eErr != CE_None )
+                break;
+
+            for( int i = 0; i < nJobs; i++ )
+            {
+                auto& sJob = asJobs[i];
+                const int iStrip = iFirstStrip + i;
+                sJob = EdgesJob();
+                sJob.panVal = panVal +
+                    static_cast<size_t>(i) * nStripHeight * nXSize;
+                sJob.nXSize = nXSize;
+                sJob.nLines = std::min(nStripHeight, nLines - i * nStripHeight);
+                sJob.nYOff = nYOff + i * nStripHeight;
+                sJob.nConnectedness = nConnectedness;
+                sJob.iStrip = iStrip;
+                sJob.nBaseId = anBaseId[iStrip];
+                sJob.panRootId = anRootId.data();
+                sJob.panMinStrip = anMinStrip.data();
+                sJob.panMaxStrip = anMaxStrip.data();
+                sJob.panPolyValue = anPolyValue.data();
+                sJob.panTopLineId =
+                    iStrip > 0 ? aanLastLineId[iStrip - 1].data() : nullptr;
+                sJob.panBottomLineId =
+                    iStrip + 1 < nStrips ? aanFirstLineId[iStrip + 1].data()
+                                         : nullptr;
+            }
+            GPRunJobs(poJobQueue.get(), asJobs, nJobs);
+
+            for( int i = 0; eErr == CE_None && i < nJobs; i++ )
+            {
+                auto& sJob = asJobs[i];
+                if( !sJob.bOK )
+                {
+                    CPLError( CE_Failure, CPLE_OutOfMemory,
+                              "Out of memory in GDALPolygonize()" );
+                    eErr = CE_Failure;
+                    break;
+                }
+
+                for( auto& poPoly: sJob.apoPolys )
+                {
+                    eErr = EmitPolygonToLayer( hOutLayer, iPixValField,
+                                               poPoly.get(), padfGeoTransform );
+                    if( eErr != CE_None )
+                        break;
+                    poPoly.reset();
+                }
+
+/* -------------------------------------------------------------------- */
+/*      Accumulate the edges of polygons spanning several strips, and   */
+/*      build and emit those whose last strip has been reached.         */
+/* -------------------------------------------------------------------- */
+                for( auto& oPartialEdges: sJob.aoPartialEdges )
+                {
+                    if( eErr != CE_None )
+                        break;
+                    const GInt32 nId = oPartialEdges.first;
+                    auto& asEdges = oMapPendingEdges[nId];
+                    if( asEdges.empty() )
+                        asEdges = std::move(oPartialEdges.second);
+                    else
+                        asEdges.insert(asEdges.end(),
+                                       oPartialEdges.second.begin(),
+                                       oPartialEdges.second.end());
+                    oPartialEdges.second = std::vector<GPEdge>();
+
+                    if( anMaxStrip[nId] == sJob.iStrip )
+                    {
+                        // Edges of the boundary lines come from both
+                        // strips, and must be interleaved.
+                        std::sort(asEdges.begin(), asEdges.end());
+
+                        // FIXME loss of precision for [U]Int64
+                        RPolygon oPoly(static_cast<double>(anPolyValue[nId]));
+                        for( const auto& oEdge: asEdges )
+                            oEdge.AddTo(&oPoly);
+                        oMapPendingEdges.erase(nId);
+
+                        eErr = EmitPolygonToLayer( hOutLayer, iPixValField,
+                                                   &oPoly, padfGeoTransform );
+                    }
+                }
+                sJob.apoPolys.clear();
+                sJob.aoPartialEdges.clear();
+            }
+
+            if( eErr == CE_None &&
+                !pfnProgress( 0.10 + 0.90 * (nYOff + nLines) /
+                                  static_cast<double>(nYSize),
+                              "", pProgressArg ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                eErr = CE_Failure;
+            }
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Out of memory in GDALPolygonize()" );
+        eErr = CE_Failure;
+    }
+
+    CPLFree(panVal);
+    CPLFree(pabyMask);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -567,6 +1332,21 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
     const int nConnectedness =
         CSLFetchNameValue( papszOptions, "8CONNECTED" ) ? 8 : 4;
 
+    const char* pszThreads = CSLFetchNameValue( papszOptions, "NUM_THREADS" );
+    if( pszThreads == nullptr )
+        pszThreads = CPLGetConfigOption( "GDAL_NUM_THREADS", "1" );
+    const int nThreads = std::max(1, std::min(128,
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+
+    const char* pszStripHeight =
+        CSLFetchNameValue( papszOptions, "STRIP_HEIGHT" );
+    if( pszStripHeight != nullptr && atoi(pszStripHeight) <= 0 )
+    {
+        CPLError( CE_Failure, CPLE_IllegalArg,
+                  "Invalid value for STRIP_HEIGHT: %s", pszStripHeight );
+        return CE_Failure;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Confirm our output layer will support feature creation.         */
 /* -------------------------------------------------------------------- */
@@ -643,6 +1423,31 @@ GDALPolygonizeT( GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Process the raster by strips if several threads or an explicit  */
+/*      strip height are requested.                                     */
+/* -------------------------------------------------------------------- */
+    if( nThreads > 1 || pszStripHeight != nullptr )
+    {
+        const int nStripHeight = pszStripHeight != nullptr
+            ? atoi(pszStripHeight)
+            : std::max(1, std::min(1024,
+                    (nYSize + 4 * nThreads - 1) / (4 * nThreads)));
+        if( nStripHeight < nYSize )
+        {
+            CPLFree( panThisLineId );
+            CPLFree( panLastLineId );
+            CPLFree( panThisLineVal );
+            CPLFree( panLastLineVal );
+            CPLFree( pabyMaskLine );
+
+            return GDALPolygonizeTiledT<DataType, EqualityTest>(
+                hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+                nStripHeight, nThreads, adfGeoTransform,
+                pfnProgress, pProgressArg, eDT );
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      The first pass over the raster is only used to build up the     */
 /*      polygon id map so we will know in advance what polygons are     */
@@ -941,6 +1746,15 @@ GBool GDALFloatEquals( float A, float B )
  * <ul>
  * <li>8CONNECTED=8: May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm</li>
+ * <li>NUM_THREADS=n|ALL_CPUS: (GDAL >= 3.7) Number of threads used to
+ * process the raster by horizontal strips. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
+ * <li>STRIP_HEIGHT=n: (GDAL >= 3.7) Height in lines of the strips in which
+ * the raster is split when NUM_THREADS is greater than 1. Setting it also
+ * enables processing by strips with a single thread, which bounds the
+ * memory used to hold polygons being formed to those intersecting a strip,
+ * plus the ones spanning several strips. Defaults to a value depending on
+ * the raster height and number of threads, at most 1024.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -1018,6 +1832,15 @@ GDALPolygonize( GDALRasterBandH hSrcBand,
  * <ul>
  * <li>8CONNECTED=8: May be set to "8" to use 8 connectedness.
  * Otherwise 4 connectedness will be applied to the algorithm</li>
+ * <li>NUM_THREADS=n|ALL_CPUS: (GDAL >= 3.7) Number of threads used to
+ * process the raster by horizontal strips. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
+ * <li>STRIP_HEIGHT=n: (GDAL >= 3.7) Height in lines of the strips in which
+ * the raster is split when NUM_THREADS is greater than 1. Setting it also
+ * enables processing by strips with a single thread, which bounds the
+ * memory used to hold polygons being formed to those intersecting a strip,
+ * plus the ones spanning several strips. Defaults to a value depending on
+ * the raster height and number of threads, at most 1024.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
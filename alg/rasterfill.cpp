@@ -35,14 +35,18 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 
@@ -366,6 +370,722 @@ inline void QUAD_CHECK(double& dfQuadDist, float& fQuadValue,
     }
 }
 
+/************************************************************************/
+/*                    GDALFillNodataInterpolateLine()                   */
+/*                                                                      */
+/*      Interpolate the nodata pixels of line iY from the "last known   */
+/*      value" information collected by the top-down and bottom-up      */
+/*      passes.  pabyMask and pafScanline are updated in place, and     */
+/*      pabyFiltMask is set to 255 for the pixels that got a value.     */
+/************************************************************************/
+
+static void
+GDALFillNodataInterpolateLine( int iY, int nXSize,
+                               double dfMaxSearchDist, int nMaxSearchDist,
+                               GUInt32 nNoDataVal,
+                               bool bHasNoData, float fNoData,
+                               const GUInt32 *panTopDownY,
+                               const float *pafTopDownValue,
+                               const GUInt32 *panLastY,
+                               const float *pafLastValue,
+                               GByte *pabyMask, GByte *pabyFiltMask,
+                               float *pafScanline )
+
+{
+    memset( pabyFiltMask, 0, nXSize );
+    for( int iX = 0; iX < nXSize; iX++ )
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if( pabyMask[iX] )
+            continue;
+
+        // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
+        double adfQuadDist[4] = {};
+        float fQuadValue[4] = {};
+
+        for( int iQuad = 0; iQuad < 4; iQuad++ )
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            fQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for( int iStep = 0; iStep <= nThisMaxSearchDist; iStep++ )
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[0], fQuadValue[0],
+                       iLeftX, panTopDownY[iLeftX], iX, iY,
+                       pafTopDownValue[iLeftX], nNoDataVal );
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[1], fQuadValue[1],
+                       iLeftX, panLastY[iLeftX], iX, iY,
+                       pafLastValue[iLeftX], nNoDataVal );
+
+            // Top right and bottom right do no include center pixel.
+            if( iStep == 0 )
+                 continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[2], fQuadValue[2],
+                       iRightX, panTopDownY[iRightX], iX, iY,
+                       pafTopDownValue[iRightX], nNoDataVal );
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[3], fQuadValue[3],
+                       iRightX, panLastY[iRightX], iX, iY,
+                       pafLastValue[iRightX], nNoDataVal );
+
+            // Every four steps, recompute maximum distance.
+            if( (iStep & 0x3) == 0 )
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        double dfWeightSum = 0.0;
+        double dfValueSum = 0.0;
+        bool bHasSrcValues = false;
+
+        for( int iQuad = 0; iQuad < 4; iQuad++ )
+        {
+            if( adfQuadDist[iQuad] <= dfMaxSearchDist )
+            {
+                bHasSrcValues = true;
+                if( !bHasNoData || fQuadValue[iQuad] != fNoData )
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                    dfWeightSum += dfWeight;
+                    dfValueSum += fQuadValue[iQuad] * dfWeight;
+                }
+            }
+        }
+
+        if( bHasSrcValues )
+        {
+            pabyFiltMask[iX] = 255;
+            if( dfWeightSum > 0.0 )
+            {
+                pabyMask[iX] = 255;
+                pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
+            }
+            else
+                pafScanline[iX] = fNoData;
+        }
+    }
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*      Tiled, multi-threaded implementation.                           */
+/*                                                                      */
+/*      The result for a given pixel only depends on the pixels at      */
+/*      most nMaxSearchDist away from it for the interpolation, and     */
+/*      nSmoothingIterations away from it for the smoothing, so each    */
+/*      tile can be processed independently from a window extended      */
+/*      by that halo, with a memory use that only depends on the tile   */
+/*      size.  Tiles are computed in parallel, and their raster I/O     */
+/*      is serialized.  As tiles read their halo from the target band,  */
+/*      results are written into a work file and copied back into the  */
+/*      target band once all tiles have been processed.                 */
+/* ==================================================================== */
+/************************************************************************/
+
+// Minimum size of the tiles processed by the multi-threaded implementation.
+constexpr int FILL_NODATA_MIN_TILE_SIZE = 256;
+
+// Above that halo, windows get too large and the line-based single threaded
+// implementation is used.
+constexpr int FILL_NODATA_MAX_TILED_HALO = 512;
+
+namespace {
+
+struct GDALFillNodataTiledContext
+{
+    GDALRasterBandH hTargetBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hValBand = nullptr;
+    GDALRasterBandH hFiltMaskBand = nullptr;
+
+    int nXSize = 0;
+    int nYSize = 0;
+    int nTileSize = 0;
+    int nXTiles = 0;
+    int nYTiles = 0;
+
+    double dfMaxSearchDist = 0.0;
+    int nMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bHasNoData = false;
+    float fNoData = 0.0f;
+    int nSmoothingIterations = 0;
+
+    // Protects all the raster I/O.
+    std::mutex oIOMutex{};
+    std::atomic<bool> bError{false};
+};
+
+struct GDALFillNodataTileJob
+{
+    GDALFillNodataTiledContext* psCtxt = nullptr;
+    int iTile = 0;
+};
+
+// Tile (nXOff, nYOff, nXSize, nYSize) and its window extended by the halo.
+struct GDALFillNodataTileWindow
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nWinXOff = 0;
+    int nWinYOff = 0;
+    int nWinXSize = 0;
+    int nWinYSize = 0;
+};
+
+} // namespace
+
+/************************************************************************/
+/*                      GDALFillNodataGetTileWindow()                   */
+/************************************************************************/
+
+static GDALFillNodataTileWindow
+GDALFillNodataGetTileWindow( const GDALFillNodataTiledContext& sCtxt,
+                             int iTile, int nHalo )
+{
+    GDALFillNodataTileWindow sWin;
+    sWin.nXOff = (iTile % sCtxt.nXTiles) * sCtxt.nTileSize;
+    sWin.nYOff = (iTile / sCtxt.nXTiles) * sCtxt.nTileSize;
+    sWin.nXSize = std::min(sCtxt.nTileSize, sCtxt.nXSize - sWin.nXOff);
+    sWin.nYSize = std::min(sCtxt.nTileSize, sCtxt.nYSize - sWin.nYOff);
+    sWin.nWinXOff = std::max(0, sWin.nXOff - nHalo);
+    sWin.nWinYOff = std::max(0, sWin.nYOff - nHalo);
+    sWin.nWinXSize = std::min(sCtxt.nXSize, sWin.nXOff + sWin.nXSize + nHalo) -
+                     sWin.nWinXOff;
+    sWin.nWinYSize = std::min(sCtxt.nYSize, sWin.nYOff + sWin.nYSize + nHalo) -
+                     sWin.nWinYOff;
+    return sWin;
+}
+
+/************************************************************************/
+/*                       GDALFillNodataTileJobFunc()                    */
+/*                                                                      */
+/*      Interpolation of the nodata pixels of one tile.  This runs the  */
+/*      same top-down and bottom-up passes as the single threaded       */
+/*      implementation, but restricted to the tile window.              */
+/************************************************************************/
+
+static void GDALFillNodataTileJobFunc( void* pData )
+{
+    const GDALFillNodataTileJob* psJob =
+        static_cast<const GDALFillNodataTileJob*>(pData);
+    GDALFillNodataTiledContext& sCtxt = *(psJob->psCtxt);
+    if( sCtxt.bError )
+        return;
+
+    const GDALFillNodataTileWindow sWin =
+        GDALFillNodataGetTileWindow(sCtxt, psJob->iTile, sCtxt.nMaxSearchDist);
+    const int nWinXSize = sWin.nWinXSize;
+    const GUInt32 nNoDataVal = sCtxt.nNoDataVal;
+    const double dfMaxSearchDist = sCtxt.dfMaxSearchDist;
+
+    std::vector<GByte> abyMask;
+    std::vector<float> afValue;
+    std::vector<GUInt32> anTopDownY;
+    std::vector<float> afTopDownValue;
+    std::vector<GByte> abyFiltMask;
+    std::vector<GUInt32> anLastY;
+    std::vector<GUInt32> anThisY;
+    std::vector<float> afLastValue;
+    std::vector<float> afThisValue;
+    try
+    {
+        const size_t nWinPixels =
+            static_cast<size_t>(nWinXSize) * sWin.nWinYSize;
+        const size_t nTilePixels =
+            static_cast<size_t>(nWinXSize) * sWin.nYSize;
+        abyMask.resize(nWinPixels);
+        afValue.resize(nWinPixels);
+        anTopDownY.resize(nTilePixels);
+        afTopDownValue.resize(nTilePixels);
+        abyFiltMask.resize(nTilePixels);
+        anLastY.resize(nWinXSize);
+        anThisY.resize(nWinXSize);
+        afLastValue.resize(nWinXSize);
+        afThisValue.resize(nWinXSize);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALFillNodata()");
+        sCtxt.bError = true;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+        if( GDALRasterIO( sCtxt.hMaskBand, GF_Read,
+                          sWin.nWinXOff, sWin.nWinYOff,
+                          nWinXSize, sWin.nWinYSize,
+                          abyMask.data(), nWinXSize, sWin.nWinYSize,
+                          GDT_Byte, 0, 0 ) != CE_None ||
+            GDALRasterIO( sCtxt.hTargetBand, GF_Read,
+                          sWin.nWinXOff, sWin.nWinYOff,
+                          nWinXSize, sWin.nWinYSize,
+                          afValue.data(), nWinXSize, sWin.nWinYSize,
+                          GDT_Float32, 0, 0 ) != CE_None )
+        {
+            sCtxt.bError = true;
+            return;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Top to bottom pass, keeping the "last known value" of the       */
+/*      lines of the tile.                                              */
+/* -------------------------------------------------------------------- */
+    std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
+    for( int iY = sWin.nWinYOff; iY < sWin.nYOff + sWin.nYSize; iY++ )
+    {
+        const size_t nLineOff =
+            static_cast<size_t>(iY - sWin.nWinYOff) * nWinXSize;
+        const GByte* pabyMask = abyMask.data() + nLineOff;
+        const float* pafScanline = afValue.data() + nLineOff;
+
+        for( int iX = 0; iX < nWinXSize; iX++ )
+        {
+            if( pabyMask[iX] )
+            {
+                afThisValue[iX] = pafScanline[iX];
+                anThisY[iX] = iY;
+            }
+            else if( iY <= dfMaxSearchDist + anLastY[iX] )
+            {
+                afThisValue[iX] = afLastValue[iX];
+                anThisY[iX] = anLastY[iX];
+            }
+            else
+            {
+                anThisY[iX] = nNoDataVal;
+            }
+        }
+
+        if( iY >= sWin.nYOff )
+        {
+            const size_t nTileLineOff =
+                static_cast<size_t>(iY - sWin.nYOff) * nWinXSize;
+            memcpy(anTopDownY.data() + nTileLineOff, anThisY.data(),
+                   nWinXSize * sizeof(GUInt32));
+            memcpy(afTopDownValue.data() + nTileLineOff, afThisValue.data(),
+                   nWinXSize * sizeof(float));
+        }
+
+        std::swap(afThisValue, afLastValue);
+        std::swap(anThisY, anLastY);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Bottom to top pass, interpolating the lines of the tile.        */
+/* -------------------------------------------------------------------- */
+    std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
+    for( int iY = sWin.nWinYOff + sWin.nWinYSize - 1; iY >= sWin.nYOff; iY-- )
+    {
+        const size_t nLineOff =
+            static_cast<size_t>(iY - sWin.nWinYOff) * nWinXSize;
+        GByte* pabyMask = abyMask.data() + nLineOff;
+        float* pafScanline = afValue.data() + nLineOff;
+
+        for( int iX = 0; iX < nWinXSize; iX++ )
+        {
+            if( pabyMask[iX] )
+            {
+                afThisValue[iX] = pafScanline[iX];
+                anThisY[iX] = iY;
+            }
+            else if( anLastY[iX] - iY <= dfMaxSearchDist )
+            {
+                afThisValue[iX] = afLastValue[iX];
+                anThisY[iX] = anLastY[iX];
+            }
+            else
+            {
+                anThisY[iX] = nNoDataVal;
+            }
+        }
+
+        if( iY < sWin.nYOff + sWin.nYSize )
+        {
+            const size_t nTileLineOff =
+                static_cast<size_t>(iY - sWin.nYOff) * nWinXSize;
+            GByte* pabyFiltMask = abyFiltMask.data() + nTileLineOff;
+            GDALFillNodataInterpolateLine( iY, nWinXSize, dfMaxSearchDist,
+                                           sCtxt.nMaxSearchDist, nNoDataVal,
+                                           sCtxt.bHasNoData, sCtxt.fNoData,
+                                           anTopDownY.data() + nTileLineOff,
+                                           afTopDownValue.data() + nTileLineOff,
+                                           anLastY.data(), afLastValue.data(),
+                                           pabyMask, pabyFiltMask,
+                                           pafScanline );
+
+            // Pixels for which only source values at NODATA were found are
+            // flagged with 1, so that the mask can be updated afterwards.
+            for( int iX = 0; iX < nWinXSize; iX++ )
+            {
+                if( pabyFiltMask[iX] && !pabyMask[iX] )
+                    pabyFiltMask[iX] = 1;
+            }
+        }
+
+        std::swap(afThisValue, afLastValue);
+        std::swap(anThisY, anLastY);
+    }
+
+    const int nTileXOffInWin = sWin.nXOff - sWin.nWinXOff;
+    std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+    if( GDALRasterIO( sCtxt.hValBand, GF_Write,
+                      sWin.nXOff, sWin.nYOff, sWin.nXSize, sWin.nYSize,
+                      afValue.data() +
+                          static_cast<size_t>(sWin.nYOff - sWin.nWinYOff) *
+                              nWinXSize + nTileXOffInWin,
+                      sWin.nXSize, sWin.nYSize, GDT_Float32,
+                      static_cast<int>(sizeof(float)),
+                      static_cast<int>(sizeof(float)) * nWinXSize ) != CE_None ||
+        GDALRasterIO( sCtxt.hFiltMaskBand, GF_Write,
+                      sWin.nXOff, sWin.nYOff, sWin.nXSize, sWin.nYSize,
+                      abyFiltMask.data() + nTileXOffInWin,
+                      sWin.nXSize, sWin.nYSize, GDT_Byte,
+                      1, nWinXSize ) != CE_None )
+    {
+        sCtxt.bError = true;
+    }
+}
+
+/************************************************************************/
+/*                    GDALFillNodataSmoothTileJobFunc()                 */
+/*                                                                      */
+/*      Smoothing iterations over one tile.  Each iteration applies     */
+/*      GDALFilterLine() to all the lines of the window, from the       */
+/*      values of the previous iteration, as GDALMultiFilter() does.    */
+/************************************************************************/
+
+static void GDALFillNodataSmoothTileJobFunc( void* pData )
+{
+    const GDALFillNodataTileJob* psJob =
+        static_cast<const GDALFillNodataTileJob*>(pData);
+    GDALFillNodataTiledContext& sCtxt = *(psJob->psCtxt);
+    if( sCtxt.bError )
+        return;
+
+    const GDALFillNodataTileWindow sWin =
+        GDALFillNodataGetTileWindow(sCtxt, psJob->iTile,
+                                    sCtxt.nSmoothingIterations);
+    const int nWinXSize = sWin.nWinXSize;
+    const int nWinYSize = sWin.nWinYSize;
+
+    std::vector<GByte> abyTMask;
+    std::vector<GByte> abyFMask;
+    std::vector<float> afLastPass;
+    std::vector<float> afThisPass;
+    try
+    {
+        const size_t nWinPixels = static_cast<size_t>(nWinXSize) * nWinYSize;
+        abyTMask.resize(nWinPixels);
+        abyFMask.resize(nWinPixels);
+        afLastPass.resize(nWinPixels);
+        afThisPass.resize(nWinPixels);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALFillNodata()");
+        sCtxt.bError = true;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+        if( GDALRasterIO( sCtxt.hMaskBand, GF_Read,
+                          sWin.nWinXOff, sWin.nWinYOff, nWinXSize, nWinYSize,
+                          abyTMask.data(), nWinXSize, nWinYSize,
+                          GDT_Byte, 0, 0 ) != CE_None ||
+            GDALRasterIO( sCtxt.hFiltMaskBand, GF_Read,
+                          sWin.nWinXOff, sWin.nWinYOff, nWinXSize, nWinYSize,
+                          abyFMask.data(), nWinXSize, nWinYSize,
+                          GDT_Byte, 0, 0 ) != CE_None ||
+            GDALRasterIO( sCtxt.hTargetBand, GF_Read,
+                          sWin.nWinXOff, sWin.nWinYOff, nWinXSize, nWinYSize,
+                          afLastPass.data(), nWinXSize, nWinYSize,
+                          GDT_Float32, 0, 0 ) != CE_None )
+        {
+            sCtxt.bError = true;
+            return;
+        }
+    }
+
+    // Lines on the border of the window are only wrong in the halo, which
+    // is as large as the number of iterations.
+    for( int iIter = 0; iIter < sCtxt.nSmoothingIterations; iIter++ )
+    {
+        for( int iLine = 0; iLine < nWinYSize; iLine++ )
+        {
+            const size_t nLineOff = static_cast<size_t>(iLine) * nWinXSize;
+            const int iY = sWin.nWinYOff + iLine;
+
+            // TODO: Enable first and last line.
+            // Skip the first and last line.
+            if( iLine < 1 || iLine >= nWinYSize - 1 ||
+                iY < 1 || iY >= sCtxt.nYSize - 1 )
+            {
+                memcpy( afThisPass.data() + nLineOff,
+                        afLastPass.data() + nLineOff,
+                        sizeof(float) * nWinXSize );
+                continue;
+            }
+
+            GDALFilterLine(
+                afLastPass.data() + nLineOff - nWinXSize,
+                afLastPass.data() + nLineOff,
+                afLastPass.data() + nLineOff + nWinXSize,
+                afThisPass.data() + nLineOff,
+                abyTMask.data() + nLineOff - nWinXSize,
+                abyTMask.data() + nLineOff,
+                abyTMask.data() + nLineOff + nWinXSize,
+                abyFMask.data() + nLineOff,
+                nWinXSize );
+        }
+        std::swap(afThisPass, afLastPass);
+    }
+
+    std::lock_guard<std::mutex> oLock(sCtxt.oIOMutex);
+    if( GDALRasterIO( sCtxt.hValBand, GF_Write,
+                      sWin.nXOff, sWin.nYOff, sWin.nXSize, sWin.nYSize,
+                      afLastPass.data() +
+                          static_cast<size_t>(sWin.nYOff - sWin.nWinYOff) *
+                              nWinXSize + (sWin.nXOff - sWin.nWinXOff),
+                      sWin.nXSize, sWin.nYSize, GDT_Float32,
+                      static_cast<int>(sizeof(float)),
+                      static_cast<int>(sizeof(float)) * nWinXSize ) != CE_None )
+    {
+        sCtxt.bError = true;
+    }
+}
+
+/************************************************************************/
+/*                        GDALFillNodataRunTiles()                      */
+/************************************************************************/
+
+static CPLErr GDALFillNodataRunTiles( GDALFillNodataTiledContext& sCtxt,
+                                      CPLJobQueue* poJobQueue,
+                                      CPLThreadFunc pfnFunc,
+                                      const char* pszMessage,
+                                      GDALProgressFunc pfnProgress,
+                                      void * pProgressArg )
+{
+    const int nTiles = sCtxt.nXTiles * sCtxt.nYTiles;
+    std::vector<GDALFillNodataTileJob> asJobs(nTiles);
+    for( int i = 0; i < nTiles; i++ )
+    {
+        asJobs[i].psCtxt = &sCtxt;
+        asJobs[i].iTile = i;
+        poJobQueue->SubmitJob(pfnFunc, &asJobs[i]);
+    }
+
+    for( int nRemaining = nTiles - 1; nRemaining >= 0; nRemaining-- )
+    {
+        poJobQueue->WaitCompletion(nRemaining);
+        if( !sCtxt.bError &&
+            !pfnProgress( (nTiles - nRemaining) / static_cast<double>(nTiles),
+                          pszMessage, pProgressArg ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            sCtxt.bError = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    return sCtxt.bError ? CE_Failure : CE_None;
+}
+
+/************************************************************************/
+/*                       GDALFillNodataCopyBack()                       */
+/*                                                                      */
+/*      Copy the content of the value work file into the target band,   */
+/*      and optionally update the mask band from the filter mask.       */
+/************************************************************************/
+
+static CPLErr GDALFillNodataCopyBack( const GDALFillNodataTiledContext& sCtxt,
+                                      bool bUpdateMask )
+{
+    const int nXSize = sCtxt.nXSize;
+    std::vector<float> afScanline;
+    std::vector<GByte> abyMask;
+    std::vector<GByte> abyFiltMask;
+    try
+    {
+        afScanline.resize(nXSize);
+        if( bUpdateMask )
+        {
+            abyMask.resize(nXSize);
+            abyFiltMask.resize(nXSize);
+        }
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for GDALFillNodata()");
+        return CE_Failure;
+    }
+
+    CPLErr eErr = CE_None;
+    for( int iY = 0; iY < sCtxt.nYSize && eErr == CE_None; iY++ )
+    {
+        eErr = GDALRasterIO( sCtxt.hValBand, GF_Read, 0, iY, nXSize, 1,
+                             afScanline.data(), nXSize, 1,
+                             GDT_Float32, 0, 0 );
+        if( eErr == CE_None )
+            eErr = GDALRasterIO( sCtxt.hTargetBand, GF_Write, 0, iY, nXSize, 1,
+                                 afScanline.data(), nXSize, 1,
+                                 GDT_Float32, 0, 0 );
+        if( eErr != CE_None || !bUpdateMask )
+            continue;
+
+        eErr = GDALRasterIO( sCtxt.hFiltMaskBand, GF_Read, 0, iY, nXSize, 1,
+                             abyFiltMask.data(), nXSize, 1, GDT_Byte, 0, 0 );
+        if( eErr == CE_None )
+            eErr = GDALRasterIO( sCtxt.hMaskBand, GF_Read, 0, iY, nXSize, 1,
+                                 abyMask.data(), nXSize, 1, GDT_Byte, 0, 0 );
+        if( eErr != CE_None )
+            continue;
+        for( int iX = 0; iX < nXSize; iX++ )
+        {
+            if( abyFiltMask[iX] == 255 )
+                abyMask[iX] = 255;
+        }
+        eErr = GDALRasterIO( sCtxt.hMaskBand, GF_Write, 0, iY, nXSize, 1,
+                             abyMask.data(), nXSize, 1, GDT_Byte, 0, 0 );
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                         GDALFillNodataTiled()                        */
+/************************************************************************/
+
+static CPLErr
+GDALFillNodataTiled( GDALRasterBandH hTargetBand,
+                     GDALRasterBandH hMaskBand,
+                     bool bUpdateMask,
+                     double dfMaxSearchDist,
+                     GUInt32 nNoDataVal,
+                     bool bHasNoData,
+                     float fNoData,
+                     int nSmoothingIterations,
+                     CPLWorkerThreadPool* poThreadPool,
+                     GDALDriverH hDriver,
+                     CSLConstList papszWorkFileOptions,
+                     const CPLString& osTmpFile,
+                     double dfProgressRatio,
+                     GDALProgressFunc pfnProgress,
+                     void * pProgressArg )
+
+{
+    GDALFillNodataTiledContext sCtxt;
+    sCtxt.hTargetBand = hTargetBand;
+    sCtxt.hMaskBand = hMaskBand;
+    sCtxt.nXSize = GDALGetRasterBandXSize(hTargetBand);
+    sCtxt.nYSize = GDALGetRasterBandYSize(hTargetBand);
+    sCtxt.dfMaxSearchDist = dfMaxSearchDist;
+    sCtxt.nMaxSearchDist = static_cast<int>(floor(dfMaxSearchDist));
+    sCtxt.nTileSize = std::max(FILL_NODATA_MIN_TILE_SIZE, sCtxt.nMaxSearchDist);
+    sCtxt.nXTiles = (sCtxt.nXSize + sCtxt.nTileSize - 1) / sCtxt.nTileSize;
+    sCtxt.nYTiles = (sCtxt.nYSize + sCtxt.nTileSize - 1) / sCtxt.nTileSize;
+    sCtxt.nNoDataVal = nNoDataVal;
+    sCtxt.bHasNoData = bHasNoData;
+    sCtxt.fNoData = fNoData;
+    sCtxt.nSmoothingIterations = nSmoothingIterations;
+
+/* -------------------------------------------------------------------- */
+/*      Create the work files receiving the interpolated values and     */
+/*      the mask of the pixels to be filtered.                          */
+/* -------------------------------------------------------------------- */
+    const CPLString osValTmpFile = osTmpFile + "fill_val_work.tif";
+    auto poValDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate( hDriver, osValTmpFile, sCtxt.nXSize, sCtxt.nYSize, 1,
+                    GDT_Float32, papszWorkFileOptions )));
+    if( poValDS == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "Could not create XY value work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poValDS->MarkSuppressOnClose();
+    sCtxt.hValBand = GDALRasterBand::ToHandle(poValDS->GetRasterBand(1));
+
+    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
+    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate( hDriver, osFiltMaskTmpFile, sCtxt.nXSize, sCtxt.nYSize, 1,
+                    GDT_Byte, papszWorkFileOptions )));
+    if( poFiltMaskDS == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "Could not create mask work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poFiltMaskDS->MarkSuppressOnClose();
+    sCtxt.hFiltMaskBand =
+        GDALRasterBand::ToHandle(poFiltMaskDS->GetRasterBand(1));
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+/* -------------------------------------------------------------------- */
+/*      Interpolate the nodata pixels.                                  */
+/* -------------------------------------------------------------------- */
+    void *pScaledProgress =
+        GDALCreateScaledProgress( 0.0, dfProgressRatio, pfnProgress, pProgressArg );
+    CPLErr eErr = GDALFillNodataRunTiles( sCtxt, poJobQueue.get(),
+                                          GDALFillNodataTileJobFunc,
+                                          "Filling...",
+                                          GDALScaledProgress, pScaledProgress );
+    GDALDestroyScaledProgress( pScaledProgress );
+
+    if( eErr == CE_None )
+        eErr = GDALFillNodataCopyBack( sCtxt, bUpdateMask );
+
+/* -------------------------------------------------------------------- */
+/*      Smoothing iterations.                                           */
+/* -------------------------------------------------------------------- */
+    if( eErr == CE_None && nSmoothingIterations > 0 )
+    {
+        if( !bUpdateMask )
+        {
+            // Force masks to be to flushed and recomputed when the user
+            // didn't pass a user-provided hMaskBand, and we assigned it
+            // to be the mask band of hTargetBand.
+            GDALFlushRasterCache( hMaskBand );
+        }
+
+        pScaledProgress =
+            GDALCreateScaledProgress( dfProgressRatio, 1.0, pfnProgress, pProgressArg );
+        eErr = GDALFillNodataRunTiles( sCtxt, poJobQueue.get(),
+                                       GDALFillNodataSmoothTileJobFunc,
+                                       "Smoothing Filter...",
+                                       GDALScaledProgress, pScaledProgress );
+        GDALDestroyScaledProgress( pScaledProgress );
+
+        if( eErr == CE_None )
+            eErr = GDALFillNodataCopyBack( sCtxt, false );
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -403,6 +1123,13 @@ inline void QUAD_CHECK(double& dfQuadDist, float& fQuadValue,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>NUM_THREADS=n|ALL_CPUS (GDAL >= 3.7). Number of threads. Defaults to
+ * the value of the GDAL_NUM_THREADS configuration option, or 1. When greater
+ * than 1, the raster is processed by tiles, extended by the maximum search
+ * distance and the number of smoothing iterations, in parallel. Memory use
+ * then depends on the tile size rather than on the raster width. This mode is
+ * only used when the maximum search distance and the number of smoothing
+ * iterations are not larger than 512 pixels.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -530,6 +1257,46 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Use the tiled implementation if several threads are requested. */
+/* -------------------------------------------------------------------- */
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if( pszThreads == nullptr )
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128,
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+    if( nThreads > 1 )
+    {
+        // The jobs block on the IO mutex, so they do not run in the global
+        // thread pool, whose workers might be needed by the I/O itself (for
+        // example for multi-threaded GeoTIFF decoding or compression).
+        CPLWorkerThreadPool oThreadPool;
+        bool bUseThreadPool = false;
+        if( nMaxSearchDist > FILL_NODATA_MAX_TILED_HALO ||
+            nSmoothingIterations > FILL_NODATA_MAX_TILED_HALO )
+        {
+            CPLDebug("GDAL", "GDALFillNodata(): search distance or number of "
+                     "smoothing iterations too large for the multi-threaded "
+                     "implementation");
+        }
+        else if( nXSize > FILL_NODATA_MIN_TILE_SIZE ||
+                 nYSize > FILL_NODATA_MIN_TILE_SIZE )
+        {
+            bUseThreadPool = oThreadPool.Setup(nThreads, nullptr, nullptr);
+        }
+        if( bUseThreadPool )
+        {
+            return GDALFillNodataTiled( hTargetBand, hMaskBand,
+                                        poTmpMaskDS != nullptr,
+                                        dfMaxSearchDist, nNoDataVal,
+                                        bHasNoData, fNoData,
+                                        nSmoothingIterations, &oThreadPool,
+                                        hDriver, aosWorkFileOptions.List(),
+                                        osTmpFile, dfProgressRatio,
+                                        pfnProgress, pProgressArg );
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Create a work file to hold the Y "last value" indices.          */
 /* -------------------------------------------------------------------- */
@@ -775,93 +1542,12 @@ GDALFillNodata( GDALRasterBandH hTargetBand,
 /* -------------------------------------------------------------------- */
 /*      Attempt to interpolate any pixels that are nodata.              */
 /* -------------------------------------------------------------------- */
-        memset( pabyFiltMask, 0, nXSize );
-        for( int iX = 0; iX < nXSize; iX++ )
-        {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if( pabyMask[iX] )
-                continue;
-
-            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
-            double adfQuadDist[4] = {};
-            float fQuadValue[4] = {};
-
-            for( int iQuad = 0; iQuad < 4; iQuad++ )
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                fQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for( int iStep = 0; iStep <= nThisMaxSearchDist; iStep++ )
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[0], fQuadValue[0],
-                           iLeftX, panTopDownY[iLeftX], iX, iY,
-                           pafTopDownValue[iLeftX], nNoDataVal );
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[1], fQuadValue[1],
-                           iLeftX, panLastY[iLeftX], iX, iY,
-                           pafLastValue[iLeftX], nNoDataVal );
-
-                // Top right and bottom right do no include center pixel.
-                if( iStep == 0 )
-                     continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[2], fQuadValue[2],
-                           iRightX, panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal );
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[3], fQuadValue[3],
-                           iRightX, panLastY[iRightX], iX, iY,
-                           pafLastValue[iRightX], nNoDataVal );
-
-                // Every four steps, recompute maximum distance.
-                if( (iStep & 0x3) == 0 )
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            double dfWeightSum = 0.0;
-            double dfValueSum = 0.0;
-            bool bHasSrcValues = false;
-
-            for( int iQuad = 0; iQuad < 4; iQuad++ )
-            {
-                if( adfQuadDist[iQuad] <= dfMaxSearchDist )
-                {
-                    bHasSrcValues = true;
-                    if( !bHasNoData || fQuadValue[iQuad] != fNoData )
-                    {
-                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                        dfWeightSum += dfWeight;
-                        dfValueSum += fQuadValue[iQuad] * dfWeight;
-                    }
-                }
-            }
-
-            if( bHasSrcValues )
-            {
-                pabyFiltMask[iX] = 255;
-                if( dfWeightSum > 0.0 )
-                {
-                    pabyMask[iX] = 255;
-                    pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
-                }
-                else
-                    pafScanline[iX] = fNoData;
-            }
-        }
+        GDALFillNodataInterpolateLine( iY, nXSize, dfMaxSearchDist,
+                                       nMaxSearchDist, nNoDataVal,
+                                       bHasNoData, fNoData,
+                                       panTopDownY, pafTopDownValue,
+                                       panLastY, pafLastValue,
+                                       pabyMask, pabyFiltMask, pafScanline );
 
 /* -------------------------------------------------------------------- */
 /*      Write out the updated data and mask information.                */
@@ -31,16 +31,22 @@
 #include <cmath>
 #include <cstring>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_spatialref.h"
 #include "ogr_core.h"
@@ -114,6 +120,360 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
 }
 
 
+/************************************************************************/
+/*                         In-memory viewshed engine                    */
+/************************************************************************/
+
+// The sweep of GDALViewshedGenerate() only propagates information away from
+// the observer: the left part of a line depends on the left part of the
+// previous line and on the observer column, and symetrically for the right
+// part. The four quadrants around the observer can thus be computed
+// independently, each one recomputing the (cheap) observer row and column it
+// needs. This engine works on a DEM already loaded in memory, so that it can
+// be shared by several observers.
+
+namespace {
+
+struct GDALViewshedParams
+{
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    double dfTargetHeight = 0;
+    double dfCurvCoeff = 0;
+    double dfSphereDiameter = std::numeric_limits<double>::infinity();
+    double dfDistance2 = 0;
+    GDALViewshedMode eMode = GVM_Edge;
+    GDALViewshedOutputType eOutputType = GVOT_NORMAL;
+    GByte byVisibleVal = 255;
+    GByte byInvisibleVal = 0;
+    GByte byOutOfRangeVal = 0;
+    double dfOutOfRangeVal = 0;
+};
+
+// Window of the DEM, as Float64 values, shared by all observers.
+struct GDALViewshedDEM
+{
+    const double* padfData = nullptr;
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+};
+
+struct GDALViewshedObserver
+{
+    // Observer position and processing window, in DEM pixel coordinates.
+    int nX = 0;
+    int nY = 0;
+    int nXStart = 0;
+    int nXStop = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+    double dfHeight = 0;
+};
+
+} // namespace
+
+/************************************************************************/
+/*                      GDALViewshedComputeObserver()                   */
+/************************************************************************/
+
+// Compute the position and processing window of an observer, following
+// the conventions of GDALViewshedGenerate().
+static bool GDALViewshedComputeObserver(double* adfInvGeoTransform,
+                                        int nRasterXSize, int nRasterYSize,
+                                        double dfObserverX, double dfObserverY,
+                                        double dfObserverHeight,
+                                        double dfMaxDistance,
+                                        GDALViewshedObserver& sObs)
+{
+    double dfX, dfY;
+    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX, &dfY);
+    if( !(dfX >= 0 && dfX < nRasterXSize && dfY >= 0 && dfY < nRasterYSize) )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "The observer location falls outside of the DEM area");
+        return false;
+    }
+    sObs.nX = static_cast<int>(dfX);
+    sObs.nY = static_cast<int>(dfY);
+    sObs.dfHeight = dfObserverHeight;
+    sObs.nXStart = dfMaxDistance > 0? (std::max)(0, static_cast<int>(std::floor(sObs.nX - adfInvGeoTransform[1] * dfMaxDistance))) : 0;
+    sObs.nXStop = dfMaxDistance > 0? (std::min)(nRasterXSize, static_cast<int>(std::ceil(sObs.nX + adfInvGeoTransform[1] * dfMaxDistance) + 1)) : nRasterXSize;
+    sObs.nYStart = dfMaxDistance > 0? (std::max)(0, static_cast<int>(std::floor(sObs.nY + adfInvGeoTransform[5] * dfMaxDistance))) : 0;
+    sObs.nYStop = dfMaxDistance > 0? (std::min)(nRasterYSize, static_cast<int>(std::ceil(sObs.nY - adfInvGeoTransform[5] * dfMaxDistance) + 1)) : nRasterYSize;
+    if( sObs.nXStart >= sObs.nXStop || sObs.nYStart >= sObs.nYStop )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                      GDALViewshedComputeQuadrant()                   */
+/************************************************************************/
+
+// Compute the quadrant (nDirX, nDirY) of the viewshed of an observer into
+// pabyResult (GVOT_NORMAL) or padfHeightResult (other output types), which
+// are buffers covering the observer window. Pixels of the observer row are
+// written by the upper quadrants, and those of the observer column by the
+// left ones, so that the four quadrants can run concurrently.
+static void GDALViewshedComputeQuadrant(const GDALViewshedParams& sParams,
+                                        const GDALViewshedDEM& sDEM,
+                                        const GDALViewshedObserver& sObs,
+                                        int nDirX, int nDirY,
+                                        GByte* pabyResult,
+                                        double* padfHeightResult)
+{
+    const int nKMax = nDirX < 0 ? sObs.nX - sObs.nXStart : sObs.nXStop - 1 - sObs.nX;
+    const int nLMax = nDirY < 0 ? sObs.nY - sObs.nYStart : sObs.nYStop - 1 - sObs.nY;
+    const int nKFirstOwned = nDirX < 0 ? 0 : 1;
+    const int nWinXSize = sObs.nXStop - sObs.nXStart;
+    const bool bGroundFromDEM = sParams.eOutputType == GVOT_MIN_TARGET_HEIGHT_FROM_DEM;
+    const double* adfGeoTransform = sParams.adfGeoTransform.data();
+    const double dfCurvCoeff = sParams.dfCurvCoeff;
+    const double dfDistance2 = sParams.dfDistance2;
+    const double dfSphereDiameter = sParams.dfSphereDiameter;
+    const GDALViewshedMode eMode = sParams.eMode;
+
+    std::vector<double> adfLastLineVal(nKMax + 1);
+    std::vector<double> adfThisLineVal(nKMax + 1);
+    double* padfLastLineVal = adfLastLineVal.data();
+    double* padfThisLineVal = adfThisLineVal.data();
+
+    // Load the quadrant part of a DEM line, in increasing distance order.
+    const auto LoadLine = [&sDEM, &sObs, nDirX, nKMax](int iLine, double* padfLine)
+    {
+        const double* padfSrc = sDEM.padfData +
+            static_cast<size_t>(iLine - sDEM.nYOff) * sDEM.nXSize +
+            (sObs.nX - sDEM.nXOff);
+        for( int k = 0; k <= nKMax; k++ )
+            padfLine[k] = padfSrc[nDirX * k];
+    };
+
+    // Set the output pixel at distance k on the line and raise the
+    // line height as in SetVisibility().
+    const auto SetPixel = [&sParams, pabyResult, padfHeightResult](
+        size_t nOff, bool bOwned, double dfZ, double& dfZVal, double dfGroundLevel)
+    {
+        if( bOwned )
+        {
+            if( padfHeightResult )
+                padfHeightResult[nOff] = std::max(0.0, dfZ - dfZVal + dfGroundLevel);
+            else
+                pabyResult[nOff] = dfZVal + sParams.dfTargetHeight < dfZ ?
+                    sParams.byInvisibleVal : sParams.byVisibleVal;
+        }
+        if( dfZVal < dfZ )
+            dfZVal = dfZ;
+    };
+
+    const auto SetOutOfRange = [&sParams, pabyResult, padfHeightResult,
+                                nDirX, nKFirstOwned](
+        size_t nLineOff, bool bOwnedLine, int kStart, int kEnd)
+    {
+        if( !bOwnedLine )
+            return;
+        for( int k = std::max(kStart, nKFirstOwned); k <= kEnd; k++ )
+        {
+            const size_t nOff = nLineOff + nDirX * k;
+            if( padfHeightResult )
+                padfHeightResult[nOff] = sParams.dfOutOfRangeVal;
+            else
+                pabyResult[nOff] = sParams.byOutOfRangeVal;
+        }
+    };
+
+    /* process observer line */
+    LoadLine(sObs.nY, padfLastLineVal);
+    const double dfZObserver = sObs.dfHeight + padfLastLineVal[0];
+    {
+        const bool bOwnedLine = nDirY < 0;
+        const size_t nLineOff = static_cast<size_t>(sObs.nY - sObs.nYStart) * nWinXSize +
+                                (sObs.nX - sObs.nXStart);
+        for( int k = 0; k <= std::min(1, nKMax); k++ )
+        {
+            const double dfGroundLevel = bGroundFromDEM ? padfLastLineVal[k] : 0.0;
+            if( k == 1 )
+            {
+                CPL_IGNORE_RET_VAL(
+                    AdjustHeightInRange(adfGeoTransform, 1, 0, padfLastLineVal[k],
+                                        dfDistance2, dfCurvCoeff, dfSphereDiameter));
+            }
+            if( bOwnedLine && k >= nKFirstOwned )
+            {
+                const size_t nOff = nLineOff + nDirX * k;
+                if( padfHeightResult )
+                    padfHeightResult[nOff] = dfGroundLevel;
+                else
+                    pabyResult[nOff] = sParams.byVisibleVal;
+            }
+        }
+        for( int k = 2; k <= nKMax; k++ )
+        {
+            const double dfGroundLevel = bGroundFromDEM ? padfLastLineVal[k] : 0.0;
+            if( !AdjustHeightInRange(adfGeoTransform, k, 0, padfLastLineVal[k],
+                                     dfDistance2, dfCurvCoeff, dfSphereDiameter) )
+            {
+                SetOutOfRange(nLineOff, bOwnedLine, k, nKMax);
+                break;
+            }
+            const double dfZ = CalcHeightLine(k, padfLastLineVal[k - 1], dfZObserver);
+            SetPixel(nLineOff + nDirX * k, bOwnedLine, dfZ,
+                     padfLastLineVal[k], dfGroundLevel);
+        }
+    }
+
+    /* process other lines, moving away from the observer */
+    double dfZ = 0.0;
+    for( int l = 1; l <= nLMax; l++ )
+    {
+        const int iLine = sObs.nY + nDirY * l;
+        LoadLine(iLine, padfThisLineVal);
+        const size_t nLineOff = static_cast<size_t>(iLine - sObs.nYStart) * nWinXSize +
+                                (sObs.nX - sObs.nXStart);
+
+        /* set up initial point on the scanline */
+        double dfGroundLevel = bGroundFromDEM ? padfThisLineVal[0] : 0.0;
+        if( AdjustHeightInRange(adfGeoTransform, 0, l, padfThisLineVal[0],
+                                dfDistance2, dfCurvCoeff, dfSphereDiameter) )
+        {
+            dfZ = CalcHeightLine(l, padfLastLineVal[0], dfZObserver);
+            SetPixel(nLineOff, nKFirstOwned == 0, dfZ, padfThisLineVal[0],
+                     dfGroundLevel);
+        }
+        else
+        {
+            SetOutOfRange(nLineOff, true, 0, 0);
+        }
+
+        for( int k = 1; k <= nKMax; k++ )
+        {
+            dfGroundLevel = bGroundFromDEM ? padfThisLineVal[k] : 0.0;
+            if( !AdjustHeightInRange(adfGeoTransform, k, l, padfThisLineVal[k],
+                                     dfDistance2, dfCurvCoeff, dfSphereDiameter) )
+            {
+                SetOutOfRange(nLineOff, true, k, nKMax);
+                break;
+            }
+            if( eMode != GVM_Edge )
+                dfZ = CalcHeightDiagonal(k, l,
+                                         padfThisLineVal[k - 1],
+                                         padfLastLineVal[k],
+                                         dfZObserver);
+
+            if( eMode != GVM_Diagonal )
+            {
+                const double dfZ2 = k >= l ?
+                    CalcHeightEdge(l, k,
+                                   padfLastLineVal[k - 1],
+                                   padfThisLineVal[k - 1],
+                                   dfZObserver) :
+                    CalcHeightEdge(k, l,
+                                   padfLastLineVal[k - 1],
+                                   padfLastLineVal[k],
+                                   dfZObserver);
+                dfZ = CalcHeight(dfZ, dfZ2, eMode);
+            }
+
+            SetPixel(nLineOff + nDirX * k, true, dfZ, padfThisLineVal[k],
+                     dfGroundLevel);
+        }
+
+        std::swap(padfLastLineVal, padfThisLineVal);
+    }
+}
+
+/************************************************************************/
+/*                      GDALViewshedComputeObserverAll()                */
+/************************************************************************/
+
+namespace {
+struct GDALViewshedQuadrantJob
+{
+    const GDALViewshedParams* psParams = nullptr;
+    const GDALViewshedDEM* psDEM = nullptr;
+    const GDALViewshedObserver* psObs = nullptr;
+    int nDirX = 0;
+    int nDirY = 0;
+    GByte* pabyResult = nullptr;
+    double* padfHeightResult = nullptr;
+};
+} // namespace
+
+static void GDALViewshedQuadrantJobFunc(void* pData)
+{
+    const auto psJob = static_cast<const GDALViewshedQuadrantJob*>(pData);
+    GDALViewshedComputeQuadrant(*(psJob->psParams), *(psJob->psDEM),
+                                *(psJob->psObs), psJob->nDirX, psJob->nDirY,
+                                psJob->pabyResult, psJob->padfHeightResult);
+}
+
+// Compute the whole viewshed of an observer. If poJobQueue is not null, the
+// four quadrants are computed in parallel.
+static void GDALViewshedComputeObserverAll(const GDALViewshedParams& sParams,
+                                           const GDALViewshedDEM& sDEM,
+                                           const GDALViewshedObserver& sObs,
+                                           GByte* pabyResult,
+                                           double* padfHeightResult,
+                                           CPLJobQueue* poJobQueue)
+{
+    GDALViewshedQuadrantJob asJobs[4];
+    for( int i = 0; i < 4; i++ )
+    {
+        asJobs[i].psParams = &sParams;
+        asJobs[i].psDEM = &sDEM;
+        asJobs[i].psObs = &sObs;
+        asJobs[i].nDirX = (i % 2) == 0 ? -1 : 1;
+        asJobs[i].nDirY = (i / 2) == 0 ? -1 : 1;
+        asJobs[i].pabyResult = pabyResult;
+        asJobs[i].padfHeightResult = padfHeightResult;
+        if( poJobQueue )
+            poJobQueue->SubmitJob(GDALViewshedQuadrantJobFunc, &asJobs[i]);
+        else
+            GDALViewshedQuadrantJobFunc(&asJobs[i]);
+    }
+    if( poJobQueue )
+        poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                        GDALViewshedGetThreadCount()                  */
+/************************************************************************/
+
+static int GDALViewshedGetThreadCount(CSLConstList papszOptions)
+{
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if( pszThreads == nullptr )
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128,
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                      GDALViewshedGetSphereDiameter()                 */
+/************************************************************************/
+
+static double GDALViewshedGetSphereDiameter(const OGRSpatialReference* poSRS)
+{
+    /* If we can't get a SemiMajor axis from the SRS, it will be
+     * SRS_WGS84_SEMIMAJOR
+    */
+    double dfSphereDiameter(std::numeric_limits<double>::infinity());
+    if (poSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poSRS->GetSemiMajor(&eSRSerr);
+
+        /* If we fetched the axis from the SRS, use it */
+        if (eSRSerr != OGRERR_FAILURE)
+            dfSphereDiameter = dfSemiMajor * 2.0;
+        else
+            CPLDebug( "GDALViewshedGenerate", "Unable to fetch SemiMajor axis from spatial reference");
+    }
+    return dfSphereDiameter;
+}
+
 /************************************************************************/
 /*                        GDALViewshedGenerate()                         */
 /************************************************************************/
@@ -192,7 +552,15 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
  *                   Parameters dfTargetHeight, dfVisibleVal and dfInvisibleVal will be ignored.
  *
  *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
+ * @param papszExtraOptions NULL terminated list of options, or NULL.
+ * Starting with GDAL 3.7, the following option is supported:
+ * <ul>
+ * <li>NUM_THREADS=n|ALL_CPUS: number of threads used to compute the viewshed.
+ * Defaults to 1. The GDAL_NUM_THREADS configuration option is not taken into
+ * account. When greater than 1, the part of the DEM within the processing
+ * area is loaded in memory, and the four quadrants around the observer are
+ * computed in parallel.</li>
+ * </ul>
  *
  * @return not NULL output dataset on success (to be closed with GDALClose()) or NULL if an error occurs.
  *
@@ -214,8 +582,6 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
     VALIDATE_POINTER1( hBand, "GDALViewshedGenerate", nullptr );
     VALIDATE_POINTER1( pszTargetRasterName, "GDALViewshedGenerate", nullptr );
 
-    CPL_IGNORE_RET_VAL(papszExtraOptions);
-
     if( pfnProgress == nullptr )
         pfnProgress = GDALDummyProgress;
 
@@ -256,9 +622,9 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
     int nYSize = GDALGetRasterBandYSize( hBand );
 
     if (nX < 0 ||
-        nX > nXSize ||
+        nX >= nXSize ||
         nY < 0 ||
-        nY > nYSize)
+        nY >= nYSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "The observer location falls outside of the DEM area");
         return nullptr;
@@ -364,22 +730,101 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
     double dfZ = 0.0;
     const double dfDistance2 = dfMaxDistance * dfMaxDistance;
 
-    /* If we can't get a SemiMajor axis from the SRS, it will be
-     * SRS_WGS84_SEMIMAJOR
-    */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
-    const OGRSpatialReference* poDstSRS = poDstDS->GetSpatialRef();
-    if (poDstSRS)
+    const double dfSphereDiameter =
+        GDALViewshedGetSphereDiameter(poDstDS->GetSpatialRef());
+
+    // The multi-threaded code path loads the processing area in memory, so
+    // it is only used when explicitly requested, not from GDAL_NUM_THREADS.
+    const int nThreads =
+        CSLFetchNameValue(papszExtraOptions, "NUM_THREADS") != nullptr ?
+            GDALViewshedGetThreadCount(papszExtraOptions) : 1;
+    if( nThreads > 1 )
     {
-        OGRErr eSRSerr;
-        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
+        /* compute the four quadrants in parallel on the in-memory DEM */
+        GDALViewshedParams sParams;
+        sParams.adfGeoTransform = adfGeoTransform;
+        sParams.dfTargetHeight = dfTargetHeight;
+        sParams.dfCurvCoeff = dfCurvCoeff;
+        sParams.dfSphereDiameter = dfSphereDiameter;
+        sParams.dfDistance2 = dfDistance2;
+        sParams.eMode = eMode;
+        sParams.eOutputType = heightMode;
+        sParams.byVisibleVal = byVisibleVal;
+        sParams.byInvisibleVal = byInvisibleVal;
+        sParams.byOutOfRangeVal = byOutOfRangeVal;
+        sParams.dfOutOfRangeVal = dfOutOfRangeVal;
+
+        GDALViewshedObserver sObs;
+        sObs.nX = nX + nXStart;
+        sObs.nY = nY;
+        sObs.nXStart = nXStart;
+        sObs.nXStop = nXStop;
+        sObs.nYStart = nYStart;
+        sObs.nYStop = nYStop;
+        sObs.dfHeight = dfObserverHeight;
+
+        std::vector<double> adfDEM;
+        std::vector<GByte> abyWinResult;
+        std::vector<double> adfWinHeightResult;
+        try
+        {
+            const size_t nWinSize = static_cast<size_t>(nXSize) * nYSize;
+            adfDEM.resize(nWinSize);
+            if( heightMode != GVOT_NORMAL )
+                adfWinHeightResult.resize(nWinSize);
+            else
+                abyWinResult.resize(nWinSize);
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate buffers for viewshed");
+            return nullptr;
+        }
 
-        /* If we fetched the axis from the SRS, use it */
-        if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
-        else
-            CPLDebug( "GDALViewshedGenerate", "Unable to fetch SemiMajor axis from spatial reference");
+        if (GDALRasterIO(hBand, GF_Read, nXStart, nYStart, nXSize, nYSize,
+                         adfDEM.data(), nXSize, nYSize, GDT_Float64, 0, 0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                "RasterIO error when reading DEM at position (%d,%d), size (%d,%d)", nXStart, nYStart, nXSize, nYSize);
+            return nullptr;
+        }
+        if( !pfnProgress(0.5, "", pProgressArg) )
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return nullptr;
+        }
+
+        GDALViewshedDEM sDEM;
+        sDEM.padfData = adfDEM.data();
+        sDEM.nXOff = nXStart;
+        sDEM.nYOff = nYStart;
+        sDEM.nXSize = nXSize;
+        sDEM.nYSize = nYSize;
+
+        CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        GDALViewshedComputeObserverAll(sParams, sDEM, sObs,
+                                       abyWinResult.data(),
+                                       heightMode != GVOT_NORMAL ? adfWinHeightResult.data() : nullptr,
+                                       poJobQueue.get());
+
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, 0, nXSize, nYSize,
+            heightMode != GVOT_NORMAL ? static_cast<void*>(adfWinHeightResult.data()) : static_cast<void*>(abyWinResult.data()),
+            nXSize, nYSize, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte, 0, 0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, 0, nXSize, nYSize);
+            return nullptr;
+        }
 
+        if (!pfnProgress(1.0, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return nullptr;
+        }
+
+        return GDALDataset::FromHandle(poDstDS.release());
     }
 
     /* mark the observer point as visible */
@@ -869,3 +1314,479 @@ GDALDatasetH GDALViewshedGenerate(GDALRasterBandH hBand,
 
     return GDALDataset::FromHandle(poDstDS.release());
 }
+
+/************************************************************************/
+/*                       GDALViewshedMultiContext                       */
+/************************************************************************/
+
+namespace {
+
+struct GDALViewshedMultiContext
+{
+    const GDALViewshedParams* psParams = nullptr;
+    const GDALViewshedDEM* psDEM = nullptr;
+    const std::vector<GDALViewshedObserver>* pasObservers = nullptr;
+
+    // Output extent, in DEM pixel coordinates.
+    int nDstXOff = 0;
+    int nDstYOff = 0;
+    int nDstXSize = 0;
+    int nDstYSize = 0;
+
+    // OUTPUT=CUMULATIVE: visibility counts, protected by one mutex per
+    // stripe of COUNT_STRIPE_HEIGHT lines.
+    GUInt32* panCount = nullptr;
+    std::vector<std::mutex>* paoCountMutex = nullptr;
+
+    // OUTPUT=PER_OBSERVER: output dataset, protected by oDstMutex.
+    GDALDataset* poDstDS = nullptr;
+    std::mutex oDstMutex{};
+
+    std::atomic<bool> bStop{false};
+    std::atomic<bool> bError{false};
+};
+
+struct GDALViewshedObserverJob
+{
+    GDALViewshedMultiContext* psCtxt = nullptr;
+    int iObs = 0;
+};
+
+constexpr int COUNT_STRIPE_HEIGHT = 64;
+
+} // namespace
+
+/************************************************************************/
+/*                      GDALViewshedProcessObserver()                   */
+/************************************************************************/
+
+static void GDALViewshedProcessObserver(GDALViewshedMultiContext& sCtxt,
+                                        int iObs, CPLJobQueue* poJobQueue)
+{
+    if( sCtxt.bStop )
+        return;
+
+    const GDALViewshedObserver& sObs = (*sCtxt.pasObservers)[iObs];
+    const int nWinXSize = sObs.nXStop - sObs.nXStart;
+    const int nWinYSize = sObs.nYStop - sObs.nYStart;
+    std::vector<GByte> abyResult;
+    try
+    {
+        abyResult.resize(static_cast<size_t>(nWinXSize) * nWinYSize);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for viewshed");
+        sCtxt.bError = true;
+        sCtxt.bStop = true;
+        return;
+    }
+
+    GDALViewshedComputeObserverAll(*(sCtxt.psParams), *(sCtxt.psDEM), sObs,
+                                   abyResult.data(), nullptr, poJobQueue);
+
+    if( sCtxt.panCount )
+    {
+        // Visible pixels are set to 1, others to 0.
+        for( int iLine = 0; iLine < nWinYSize; )
+        {
+            const int iDstLine = sObs.nYStart - sCtxt.nDstYOff + iLine;
+            const int iStripe = iDstLine / COUNT_STRIPE_HEIGHT;
+            const int nLines = std::min(nWinYSize - iLine,
+                                        (iStripe + 1) * COUNT_STRIPE_HEIGHT - iDstLine);
+            std::lock_guard<std::mutex> oLock((*sCtxt.paoCountMutex)[iStripe]);
+            for( int i = 0; i < nLines; i++ )
+            {
+                GUInt32* panCountLine = sCtxt.panCount +
+                    static_cast<size_t>(iDstLine + i) * sCtxt.nDstXSize +
+                    (sObs.nXStart - sCtxt.nDstXOff);
+                const GByte* pabyLine = abyResult.data() +
+                    static_cast<size_t>(iLine + i) * nWinXSize;
+                for( int iPixel = 0; iPixel < nWinXSize; iPixel++ )
+                    panCountLine[iPixel] += pabyLine[iPixel];
+            }
+            iLine += nLines;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> oLock(sCtxt.oDstMutex);
+        GDALRasterBand* poBand = sCtxt.poDstDS->GetRasterBand(iObs + 1);
+        CPLErr eErr = CE_None;
+        if( nWinXSize != sCtxt.nDstXSize || nWinYSize != sCtxt.nDstYSize )
+            eErr = poBand->Fill(sCtxt.psParams->byOutOfRangeVal);
+        if( eErr == CE_None )
+            eErr = poBand->RasterIO(GF_Write,
+                                    sObs.nXStart - sCtxt.nDstXOff,
+                                    sObs.nYStart - sCtxt.nDstYOff,
+                                    nWinXSize, nWinYSize,
+                                    abyResult.data(), nWinXSize, nWinYSize,
+                                    GDT_Byte, 0, 0, nullptr);
+        if( eErr != CE_None )
+        {
+            sCtxt.bError = true;
+            sCtxt.bStop = true;
+        }
+    }
+}
+
+static void GDALViewshedObserverJobFunc(void* pData)
+{
+    const auto psJob = static_cast<const GDALViewshedObserverJob*>(pData);
+    GDALViewshedProcessObserver(*(psJob->psCtxt), psJob->iObs, nullptr);
+}
+
+/************************************************************************/
+/*                      GDALViewshedGenerateMulti()                     */
+/************************************************************************/
+
+/**
+ * Create viewsheds of several observers from raster DEM.
+ *
+ * This function uses the same algorithm as GDALViewshedGenerate(), but
+ * processes a batch of observers located on the same DEM. The part of the
+ * DEM needed by all observers is read once and kept in memory as Float64
+ * values, and the viewsheds of the observers are computed in parallel when
+ * several threads are used. The output is either a single band raster with
+ * the number of observers from which each cell is visible (cumulative
+ * viewshed), or a raster with one visibility band per observer.
+ *
+ * The extent of the output raster is the union of the processing areas of the
+ * observers (the whole raster if dfMaxDistance is 0).
+ *
+ * @param hBand The band to read the DEM data from.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated. Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param nObserverCount number of observers. Must be at least 1.
+ *
+ * @param padfObserverX array of nObserverCount observer X values (in SRS units)
+ *
+ * @param padfObserverY array of nObserverCount observer Y values (in SRS units)
+ *
+ * @param padfObserverHeight array of nObserverCount heights of the observers
+ * above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ *
+ * @param dfVisibleVal pixel value for visibility, with OUTPUT=PER_OBSERVER.
+ *
+ * @param dfInvisibleVal pixel value for invisibility, with OUTPUT=PER_OBSERVER.
+ *
+ * @param dfOutOfRangeVal The value to be set for the cells that fall outside of the
+ * range of an observer, with OUTPUT=PER_OBSERVER.
+ *
+ * @param dfNoDataVal The nodata value of the output bands, with
+ * OUTPUT=PER_OBSERVER. If set to a negative value, nodata is not set.
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and refraction.
+ * See GDALViewshedGenerate().
+ *
+ * @param eMode The mode of the viewshed calculation.
+ * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3, GVM_Min = 4.
+ *
+ * @param dfMaxDistance maximum distance range to compute viewshed.
+ *                      If set to 0, then unlimited range is assumed.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param papszOptions NULL terminated list of options, or NULL. Supported options:
+ * <ul>
+ * <li>OUTPUT=CUMULATIVE|PER_OBSERVER: CUMULATIVE (default) returns a single
+ * band of type UInt16 (UInt32 if there are more than 65535 observers) with
+ * the number of observers that see each cell. PER_OBSERVER returns one Byte
+ * band per observer, in the order of the observers, with the same values as
+ * GDALViewshedGenerate() in GVOT_NORMAL mode.</li>
+ * <li>NUM_THREADS=n|ALL_CPUS: number of threads. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1. Observers are processed in
+ * parallel when there are at least as many observers as threads; otherwise
+ * the four quadrants around each observer are processed in parallel.</li>
+ * </ul>
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or NULL if an error occurs.
+ *
+ * @since GDAL 3.7
+ */
+
+GDALDatasetH GDALViewshedGenerateMulti(GDALRasterBandH hBand,
+                                       const char* pszDriverName,
+                                       const char* pszTargetRasterName,
+                                       CSLConstList papszCreationOptions,
+                                       int nObserverCount,
+                                       const double* padfObserverX,
+                                       const double* padfObserverY,
+                                       const double* padfObserverHeight,
+                                       double dfTargetHeight, double dfVisibleVal,
+                                       double dfInvisibleVal, double dfOutOfRangeVal,
+                                       double dfNoDataVal, double dfCurvCoeff,
+                                       GDALViewshedMode eMode, double dfMaxDistance,
+                                       GDALProgressFunc pfnProgress, void *pProgressArg,
+                                       CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1( hBand, "GDALViewshedGenerateMulti", nullptr );
+    VALIDATE_POINTER1( pszTargetRasterName, "GDALViewshedGenerateMulti", nullptr );
+    VALIDATE_POINTER1( padfObserverX, "GDALViewshedGenerateMulti", nullptr );
+    VALIDATE_POINTER1( padfObserverY, "GDALViewshedGenerateMulti", nullptr );
+    VALIDATE_POINTER1( padfObserverHeight, "GDALViewshedGenerateMulti", nullptr );
+
+    if( nObserverCount <= 0 )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "At least one observer is needed");
+        return nullptr;
+    }
+
+    const char* pszOutput = CSLFetchNameValueDef(papszOptions, "OUTPUT", "CUMULATIVE");
+    bool bCumulative = true;
+    if( EQUAL(pszOutput, "PER_OBSERVER") )
+        bCumulative = false;
+    else if( !EQUAL(pszOutput, "CUMULATIVE") )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Unsupported value for OUTPUT: %s", pszOutput);
+        return nullptr;
+    }
+    const int nThreads = GDALViewshedGetThreadCount(papszOptions);
+
+    if( pfnProgress == nullptr )
+        pfnProgress = GDALDummyProgress;
+
+    if( !pfnProgress( 0.0, "", pProgressArg ) )
+    {
+        CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+        return nullptr;
+    }
+
+    GDALViewshedParams sParams;
+    sParams.dfTargetHeight = dfTargetHeight;
+    sParams.dfCurvCoeff = dfCurvCoeff;
+    sParams.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    sParams.eMode = eMode;
+    sParams.eOutputType = GVOT_NORMAL;
+    if( bCumulative )
+    {
+        sParams.byVisibleVal = 1;
+        sParams.byInvisibleVal = 0;
+        sParams.byOutOfRangeVal = 0;
+    }
+    else
+    {
+        sParams.byVisibleVal = dfVisibleVal >= 0 && dfVisibleVal <= 255 ? static_cast<GByte>(dfVisibleVal) : 255;
+        sParams.byInvisibleVal = dfInvisibleVal >= 0 && dfInvisibleVal <= 255 ? static_cast<GByte>(dfInvisibleVal) : 0;
+        sParams.byOutOfRangeVal = dfOutOfRangeVal >= 0 && dfOutOfRangeVal <= 255 ? static_cast<GByte>(dfOutOfRangeVal) : 0;
+    }
+
+    /* set up geotransformation */
+    GDALDatasetH hSrcDS = GDALGetBandDataset( hBand );
+    if( hSrcDS != nullptr )
+        GDALGetGeoTransform( hSrcDS, sParams.adfGeoTransform.data());
+
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(sParams.adfGeoTransform.data(), adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
+
+    /* compute the observer windows and their union */
+    const int nRasterXSize = GDALGetRasterBandXSize( hBand );
+    const int nRasterYSize = GDALGetRasterBandYSize( hBand );
+    std::vector<GDALViewshedObserver> asObservers;
+    try
+    {
+        asObservers.resize(nObserverCount);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Too many observers");
+        return nullptr;
+    }
+    int nXStart = nRasterXSize;
+    int nXStop = 0;
+    int nYStart = nRasterYSize;
+    int nYStop = 0;
+    for( int i = 0; i < nObserverCount; i++ )
+    {
+        auto& sObs = asObservers[i];
+        if( !GDALViewshedComputeObserver(adfInvGeoTransform,
+                                         nRasterXSize, nRasterYSize,
+                                         padfObserverX[i], padfObserverY[i],
+                                         padfObserverHeight[i],
+                                         dfMaxDistance, sObs) )
+        {
+            return nullptr;
+        }
+        nXStart = std::min(nXStart, sObs.nXStart);
+        nXStop = std::max(nXStop, sObs.nXStop);
+        nYStart = std::min(nYStart, sObs.nYStart);
+        nYStop = std::max(nYStop, sObs.nYStop);
+    }
+    const int nXSize = nXStop - nXStart;
+    const int nYSize = nYStop - nYStart;
+
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver = hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+
+    /* create output raster */
+    const GDALDataType eDstType = !bCumulative ? GDT_Byte :
+                                  nObserverCount <= 65535 ? GDT_UInt16 : GDT_UInt32;
+    auto poDstDS = std::unique_ptr<GDALDataset>(hDriver->Create(
+        pszTargetRasterName, nXSize, nYSize, bCumulative ? 1 : nObserverCount,
+        eDstType, const_cast<char**>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "Cannot create dataset for %s", pszTargetRasterName);
+        return nullptr;
+    }
+    /* copy srs */
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+
+    const auto& adfGeoTransform = sParams.adfGeoTransform;
+    std::array<double, 6> adfDstGeoTransform;
+    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart + adfGeoTransform[2] * nYStart;
+    adfDstGeoTransform[1] = adfGeoTransform[1];
+    adfDstGeoTransform[2] = adfGeoTransform[2];
+    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart + adfGeoTransform[5] * nYStart;
+    adfDstGeoTransform[4] = adfGeoTransform[4];
+    adfDstGeoTransform[5] = adfGeoTransform[5];
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
+
+    if( !bCumulative && dfNoDataVal >= 0 )
+    {
+        const GByte byNoDataVal = dfNoDataVal <= 255 ? static_cast<GByte>(dfNoDataVal) : 0;
+        for( int i = 0; i < nObserverCount; i++ )
+            poDstDS->GetRasterBand(i + 1)->SetNoDataValue(byNoDataVal);
+    }
+
+    sParams.dfSphereDiameter =
+        GDALViewshedGetSphereDiameter(poDstDS->GetSpatialRef());
+
+    /* load the DEM once for all observers */
+    std::vector<double> adfDEM;
+    std::vector<GUInt32> anCount;
+    std::vector<std::mutex> aoCountMutex(
+        bCumulative ? (nYSize + COUNT_STRIPE_HEIGHT - 1) / COUNT_STRIPE_HEIGHT : 0);
+    try
+    {
+        adfDEM.resize(static_cast<size_t>(nXSize) * nYSize);
+        if( bCumulative )
+            anCount.resize(static_cast<size_t>(nXSize) * nYSize);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for viewshed");
+        return nullptr;
+    }
+
+    if (GDALRasterIO(hBand, GF_Read, nXStart, nYStart, nXSize, nYSize,
+                     adfDEM.data(), nXSize, nYSize, GDT_Float64, 0, 0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+            "RasterIO error when reading DEM at position (%d,%d), size (%d,%d)", nXStart, nYStart, nXSize, nYSize);
+        return nullptr;
+    }
+
+    GDALViewshedDEM sDEM;
+    sDEM.padfData = adfDEM.data();
+    sDEM.nXOff = nXStart;
+    sDEM.nYOff = nYStart;
+    sDEM.nXSize = nXSize;
+    sDEM.nYSize = nYSize;
+
+    GDALViewshedMultiContext sCtxt;
+    sCtxt.psParams = &sParams;
+    sCtxt.psDEM = &sDEM;
+    sCtxt.pasObservers = &asObservers;
+    sCtxt.nDstXOff = nXStart;
+    sCtxt.nDstYOff = nYStart;
+    sCtxt.nDstXSize = nXSize;
+    sCtxt.nDstYSize = nYSize;
+    sCtxt.panCount = bCumulative ? anCount.data() : nullptr;
+    sCtxt.paoCountMutex = &aoCountMutex;
+    sCtxt.poDstDS = poDstDS.get();
+
+    const double dfProgressRatio = bCumulative ? 0.95 : 1.0;
+    // With OUTPUT=PER_OBSERVER, the jobs write to the output dataset, so they
+    // do not run in the global thread pool, whose workers might be needed by
+    // the I/O itself (for example for multi-threaded GeoTIFF compression).
+    CPLWorkerThreadPool oThreadPool;
+    auto poJobQueue = nThreads > 1 && oThreadPool.Setup(nThreads, nullptr, nullptr) ?
+        oThreadPool.CreateJobQueue() : nullptr;
+    if( poJobQueue && nObserverCount >= nThreads )
+    {
+        /* process observers in parallel */
+        std::vector<GDALViewshedObserverJob> asJobs(nObserverCount);
+        for( int i = 0; i < nObserverCount; i++ )
+        {
+            asJobs[i].psCtxt = &sCtxt;
+            asJobs[i].iObs = i;
+            poJobQueue->SubmitJob(GDALViewshedObserverJobFunc, &asJobs[i]);
+        }
+        for( int nRemaining = nObserverCount - 1; nRemaining >= 0; nRemaining-- )
+        {
+            poJobQueue->WaitCompletion(nRemaining);
+            if( !sCtxt.bStop &&
+                !pfnProgress(dfProgressRatio * (nObserverCount - nRemaining) / nObserverCount,
+                             "", pProgressArg) )
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                sCtxt.bError = true;
+                sCtxt.bStop = true;
+            }
+        }
+        poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        /* process observers sequentially, and their quadrants in parallel */
+        for( int i = 0; i < nObserverCount && !sCtxt.bStop; i++ )
+        {
+            GDALViewshedProcessObserver(sCtxt, i, poJobQueue.get());
+            if( !sCtxt.bStop &&
+                !pfnProgress(dfProgressRatio * (i + 1) / nObserverCount,
+                             "", pProgressArg) )
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                sCtxt.bError = true;
+                sCtxt.bStop = true;
+            }
+        }
+    }
+    if( sCtxt.bError )
+        return nullptr;
+
+    if( bCumulative )
+    {
+        if( poDstDS->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                                                anCount.data(), nXSize, nYSize,
+                                                GDT_UInt32, 0, 0, nullptr) != CE_None )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                "RasterIO error when writing target raster at position (%d,%d), size (%d,%d)", 0, 0, nXSize, nYSize);
+            return nullptr;
+        }
+    }
+
+    if (!pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    return GDALDataset::FromHandle(poDstDS.release());
+}
@@ -109,6 +109,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
@@ -116,6 +118,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -297,6 +300,465 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                    GDALGeneric3x3ProcessingParams                    */
+/************************************************************************/
+
+namespace {
+template<class T>
+struct GDALGeneric3x3ProcessingParams
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+                                                pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+    bool bSrcHasNoData = false;
+    bool bIsSrcNoDataNan = false;
+    T fSrcNoDataValue = 0;
+    float fDstNoDataValue = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                          LineHasNoData()                             */
+/************************************************************************/
+
+// Whether a source line has nodata values. When it is not the case for
+// the 3 lines of the window, ComputeVal() can skip its nodata checks and
+// the multisample variant of the algorithm can be used.
+static bool LineHasNoData( const GDALGeneric3x3ProcessingParams<GInt32>& sParams,
+                           const GInt32* panLine )
+{
+    if( !sParams.bSrcHasNoData )
+        return false;
+    for( int iX = 0; iX < sParams.nXSize; iX++ )
+    {
+        if( panLine[iX] == sParams.fSrcNoDataValue )
+            return true;
+    }
+    return false;
+}
+
+// For floating point values, INTERPOL() at edges may produce the nodata
+// value, so always assume that lines have nodata.
+static bool LineHasNoData( const GDALGeneric3x3ProcessingParams<float>& sParams,
+                           const float* /* pafLine */ )
+{
+    return sParams.bSrcHasNoData;
+}
+
+/************************************************************************/
+/*                   GDALGeneric3x3ProcessLine()                        */
+/************************************************************************/
+
+// Computes the output values of line iY, from the source lines iY-1, iY
+// and iY+1 located at pafBuf + nLine1Off, nLine2Off and nLine3Off.
+// For the first (resp. last) line, nLine1Off (resp. nLine3Off) is ignored.
+// Both the sequential and multi-threaded code paths go through this
+// function, so that they produce identical results.
+template<class T>
+static void GDALGeneric3x3ProcessLine(
+    const GDALGeneric3x3ProcessingParams<T>& sParams,
+    int iY,
+    const T* pafBuf,
+    int nLine1Off,
+    int nLine2Off,
+    int nLine3Off,
+    bool bOneOfThreeLinesHasNoData,
+    float* pafOutputBuf )
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    const bool bComputeAtEdges = sParams.bComputeAtEdges;
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const float fDstNoDataValue = sParams.fDstNoDataValue;
+    const auto pfnAlg = sParams.pfnAlg;
+    void* pData = sParams.pData;
+
+    // Move a 3x3 pafWindow over each cell
+    // (where the cell in question is #4)
+    //
+    //      0 1 2
+    //      3 4 5
+    //      6 7 8
+
+    if( iY == 0 || iY == nYSize - 1 )
+    {
+        if( !(bComputeAtEdges && nXSize >= 2 && nYSize >= 2) )
+        {
+            // Exclude the edges
+            for( int j = 0; j < nXSize; j++ )
+            {
+                pafOutputBuf[j] = fDstNoDataValue;
+            }
+            return;
+        }
+
+        for( int j = 0; j < nXSize; j++ )
+        {
+            int jmin = (j == 0) ? j : j - 1;
+            int jmax = (j == nXSize - 1) ? j : j + 1;
+
+            if( iY == 0 )
+            {
+                T afWin[9] = {
+                    INTERPOL(pafBuf[nLine2Off + jmin],
+                             pafBuf[nLine3Off + jmin],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafBuf[nLine2Off + j],
+                             pafBuf[nLine3Off + j],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafBuf[nLine2Off + jmax],
+                             pafBuf[nLine3Off + jmax],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    pafBuf[nLine2Off + jmin],
+                    pafBuf[nLine2Off + j],
+                    pafBuf[nLine2Off + jmax],
+                    pafBuf[nLine3Off + jmin],
+                    pafBuf[nLine3Off + j],
+                    pafBuf[nLine3Off + jmax]
+                };
+                pafOutputBuf[j] = ComputeVal(
+                    bSrcHasNoData,
+                    fSrcNoDataValue,
+                    sParams.bIsSrcNoDataNan,
+                    afWin, fDstNoDataValue,
+                    pfnAlg, pData, bComputeAtEdges);
+            }
+            else
+            {
+                T afWin[9] = {
+                    pafBuf[nLine1Off + jmin],
+                    pafBuf[nLine1Off + j],
+                    pafBuf[nLine1Off + jmax],
+                    pafBuf[nLine2Off + jmin],
+                    pafBuf[nLine2Off + j],
+                    pafBuf[nLine2Off + jmax],
+                    INTERPOL(pafBuf[nLine2Off + jmin],
+                             pafBuf[nLine1Off + jmin],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafBuf[nLine2Off + j],
+                             pafBuf[nLine1Off + j],
+                             bSrcHasNoData, fSrcNoDataValue),
+                    INTERPOL(pafBuf[nLine2Off + jmax],
+                             pafBuf[nLine1Off + jmax],
+                             bSrcHasNoData, fSrcNoDataValue),
+                };
+                pafOutputBuf[j] = ComputeVal(
+                    bSrcHasNoData,
+                    fSrcNoDataValue,
+                    sParams.bIsSrcNoDataNan,
+                    afWin, fDstNoDataValue,
+                    pfnAlg, pData, bComputeAtEdges);
+            }
+        }
+        return;
+    }
+
+    if( bComputeAtEdges && nXSize >= 2 )
+    {
+        int j = 0;
+        T afWin[9] = {
+            INTERPOL(pafBuf[nLine1Off + j],
+                     pafBuf[nLine1Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafBuf[nLine1Off + j],
+            pafBuf[nLine1Off + j+1],
+            INTERPOL(pafBuf[nLine2Off + j],
+                     pafBuf[nLine2Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafBuf[nLine2Off + j],
+            pafBuf[nLine2Off + j+1],
+            INTERPOL(pafBuf[nLine3Off + j],
+                     pafBuf[nLine3Off + j+1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafBuf[nLine3Off + j],
+            pafBuf[nLine3Off + j+1]
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                sParams.bIsSrcNoDataNan,
+                afWin, fDstNoDataValue,
+                pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = fDstNoDataValue;
+    }
+
+    int j = 1;
+    if( sParams.pfnAlg_multisample && !bOneOfThreeLinesHasNoData )
+    {
+        j = sParams.pfnAlg_multisample(pafBuf,
+                                       nLine1Off,
+                                       nLine2Off,
+                                       nLine3Off,
+                                       nXSize,
+                                       pData,
+                                       pafOutputBuf);
+    }
+
+    for( ; j < nXSize - 1; j++ )
+    {
+        T afWin[9] = {
+            pafBuf[nLine1Off + j-1],
+            pafBuf[nLine1Off + j],
+            pafBuf[nLine1Off + j+1],
+            pafBuf[nLine2Off + j-1],
+            pafBuf[nLine2Off + j],
+            pafBuf[nLine2Off + j+1],
+            pafBuf[nLine3Off + j-1],
+            pafBuf[nLine3Off + j],
+            pafBuf[nLine3Off + j+1]
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                sParams.bIsSrcNoDataNan,
+                afWin, fDstNoDataValue,
+                pfnAlg, pData, bComputeAtEdges);
+    }
+
+    if( bComputeAtEdges && nXSize >= 2 )
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {
+            pafBuf[nLine1Off + j-1],
+            pafBuf[nLine1Off + j],
+            INTERPOL(pafBuf[nLine1Off + j],
+                     pafBuf[nLine1Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafBuf[nLine2Off + j-1],
+            pafBuf[nLine2Off + j],
+            INTERPOL(pafBuf[nLine2Off + j],
+                     pafBuf[nLine2Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue),
+            pafBuf[nLine3Off + j-1],
+            pafBuf[nLine3Off + j],
+            INTERPOL(pafBuf[nLine3Off + j],
+                     pafBuf[nLine3Off + j-1],
+                     bSrcHasNoData, fSrcNoDataValue)
+        };
+
+        pafOutputBuf[j] =
+            ComputeVal(
+                bOneOfThreeLinesHasNoData,
+                fSrcNoDataValue,
+                sParams.bIsSrcNoDataNan,
+                afWin, fDstNoDataValue,
+                pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if( nXSize > 1 )
+            pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                      GDALDEMGetNumThreads()                          */
+/************************************************************************/
+
+static int GDALDEMGetNumThreads()
+{
+    const char* pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128,
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                   GDALDEMGetChunkLineCount()                         */
+/************************************************************************/
+
+// Number of lines processed at once by the multi-threaded code paths.
+static int GDALDEMGetChunkLineCount( int nXSize, int nYSize, int nThreads,
+                                     int nBytesPerPixel )
+{
+    // Aim at chunks of about 16 MB of source data, and at least a few lines
+    // per thread.
+    constexpr int CHUNK_SIZE = 16 * 1024 * 1024;
+    int nLines = std::max(1, CHUNK_SIZE / std::max(1, nXSize * nBytesPerPixel));
+    nLines = std::max(nLines, 4 * nThreads);
+    return std::min(nLines, nYSize);
+}
+
+/************************************************************************/
+/*               GDALGeneric3x3ProcessingMultiThreaded()                */
+/************************************************************************/
+
+namespace {
+template<class T>
+struct GDALGeneric3x3ProcessingJob
+{
+    const GDALGeneric3x3ProcessingParams<T>* psParams = nullptr;
+    const T* pafBuf = nullptr;     // Source lines, starting at nBufFirstLine
+    int nBufFirstLine = 0;
+    int nYStart = 0;               // First output line of the job
+    int nYEnd = 0;                 // Last output line of the job + 1
+    float* pafOutputBuf = nullptr; // Output buffer for line nYStart
+};
+}  // namespace
+
+template<class T>
+static void GDALGeneric3x3ProcessingJobFunc( void* pData )
+{
+    const auto psJob = static_cast<GDALGeneric3x3ProcessingJob<T>*>(pData);
+    const auto& sParams = *(psJob->psParams);
+    const int nXSize = sParams.nXSize;
+
+    const auto GetLineOff = [psJob, nXSize](int iLine)
+    {
+        return (iLine - psJob->nBufFirstLine) * nXSize;
+    };
+
+    // Whether each line from nYStart - 1 to nYEnd has nodata values.
+    std::vector<bool> abLineHasNoDataValue;
+    const int nFirstLine = std::max(0, psJob->nYStart - 1);
+    const int nLastLine = std::min(sParams.nYSize - 1, psJob->nYEnd);
+    for( int iLine = nFirstLine; iLine <= nLastLine; ++iLine )
+    {
+        abLineHasNoDataValue.push_back(
+            LineHasNoData(sParams, psJob->pafBuf + GetLineOff(iLine)));
+    }
+
+    for( int iY = psJob->nYStart; iY < psJob->nYEnd; ++iY )
+    {
+        bool bOneOfThreeLinesHasNoData = false;
+        for( int iLine = std::max(0, iY - 1);
+                 iLine <= std::min(sParams.nYSize - 1, iY + 1); ++iLine )
+        {
+            if( abLineHasNoDataValue[iLine - nFirstLine] )
+                bOneOfThreeLinesHasNoData = true;
+        }
+        GDALGeneric3x3ProcessLine(
+            sParams, iY, psJob->pafBuf,
+            iY > 0 ? GetLineOff(iY - 1) : 0,
+            GetLineOff(iY),
+            iY < sParams.nYSize - 1 ? GetLineOff(iY + 1) : 0,
+            bOneOfThreeLinesHasNoData,
+            psJob->pafOutputBuf +
+                static_cast<size_t>(iY - psJob->nYStart) * nXSize);
+    }
+}
+
+// Processes the raster by chunks of lines. The main thread reads the source
+// lines of a chunk (with a one-line halo above and below) while the lines
+// of the previous chunk are computed on the thread pool, split in
+// horizontal stripes, and then writes the output lines.
+template<class T>
+static CPLErr GDALGeneric3x3ProcessingMultiThreaded(
+    GDALRasterBandH hSrcBand,
+    GDALRasterBandH hDstBand,
+    GDALDataType eReadDT,
+    const GDALGeneric3x3ProcessingParams<T>& sParams,
+    CPLWorkerThreadPool* poThreadPool,
+    GDALProgressFunc pfnProgress,
+    void *pProgressData )
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    const int nThreads = poThreadPool->GetThreadCount();
+    const int nChunkLines = GDALDEMGetChunkLineCount(
+        nXSize, nYSize, nThreads, static_cast<int>(sizeof(T)));
+
+    std::vector<T> aSrcBuf[2];
+    std::vector<float> afOutputBuf;
+    try
+    {
+        for( auto& oSrcBuf: aSrcBuf )
+            oSrcBuf.resize(static_cast<size_t>(nChunkLines + 2) * nXSize + 1);
+        afOutputBuf.resize(static_cast<size_t>(nChunkLines) * nXSize);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALGeneric3x3Processing()");
+        return CE_Failure;
+    }
+
+    // Reads the source lines needed to compute the output lines of the chunk
+    // starting at nChunkYOff.
+    int anBufFirstLine[2] = { 0, 0 };
+    const auto ReadChunk = [&](int nChunkYOff, int iBuf)
+    {
+        const int nChunkYSize = std::min(nChunkLines, nYSize - nChunkYOff);
+        const int nFirstLine = std::max(0, nChunkYOff - 1);
+        const int nLastLine = std::min(nYSize - 1, nChunkYOff + nChunkYSize);
+        anBufFirstLine[iBuf] = nFirstLine;
+        return GDALRasterIO(hSrcBand, GF_Read,
+                            0, nFirstLine, nXSize, nLastLine - nFirstLine + 1,
+                            aSrcBuf[iBuf].data(),
+                            nXSize, nLastLine - nFirstLine + 1,
+                            eReadDT, 0, 0);
+    };
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    std::vector<GDALGeneric3x3ProcessingJob<T>> asJobs(nThreads);
+
+    CPLErr eErr = ReadChunk(0, 0);
+    int iBuf = 0;
+    for( int nChunkYOff = 0; eErr == CE_None && nChunkYOff < nYSize;
+             nChunkYOff += nChunkLines, iBuf = 1 - iBuf )
+    {
+        const int nChunkYSize = std::min(nChunkLines, nYSize - nChunkYOff);
+        const int nLinesPerJob = DIV_ROUND_UP(nChunkYSize, nThreads);
+        for( int iJob = 0; iJob < nThreads; ++iJob )
+        {
+            auto& sJob = asJobs[iJob];
+            sJob.psParams = &sParams;
+            sJob.pafBuf = aSrcBuf[iBuf].data();
+            sJob.nBufFirstLine = anBufFirstLine[iBuf];
+            sJob.nYStart = nChunkYOff +
+                std::min(nChunkYSize, iJob * nLinesPerJob);
+            sJob.nYEnd = nChunkYOff +
+                std::min(nChunkYSize, (iJob + 1) * nLinesPerJob);
+            sJob.pafOutputBuf = afOutputBuf.data() +
+                static_cast<size_t>(sJob.nYStart - nChunkYOff) * nXSize;
+            if( sJob.nYStart < sJob.nYEnd )
+            {
+                poJobQueue->SubmitJob(GDALGeneric3x3ProcessingJobFunc<T>,
+                                      &sJob);
+            }
+        }
+
+        // Read next chunk while the current one is processed.
+        if( nChunkYOff + nChunkYSize < nYSize )
+            eErr = ReadChunk(nChunkYOff + nChunkYSize, 1 - iBuf);
+
+        poJobQueue->WaitCompletion();
+
+        if( eErr == CE_None )
+        {
+            eErr = GDALRasterIO(hDstBand, GF_Write,
+                                0, nChunkYOff, nXSize, nChunkYSize,
+                                afOutputBuf.data(), nXSize, nChunkYSize,
+                                GDT_Float32, 0, 0);
+        }
+
+        if( eErr == CE_None &&
+            !pfnProgress( 1.0 * (nChunkYOff + nChunkYSize) / nYSize,
+                          nullptr, pProgressData ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -328,19 +790,6 @@ CPLErr GDALGeneric3x3Processing(
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    // 1 line destination buffer.
-    float *pafOutputBuf = static_cast<float *>(
-        VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin  = static_cast<T *>(
-        VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if( pafOutputBuf == nullptr || pafThreeLineWin == nullptr )
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
     GDALDataType eReadDT;
     int bSrcHasNoData = FALSE;
     const double dfNoDataValue =
@@ -388,17 +837,50 @@ CPLErr GDALGeneric3x3Processing(
     if( !bDstHasNoData )
         fDstNoDataValue = 0.0;
 
+    GDALGeneric3x3ProcessingParams<T> sParams;
+    sParams.nXSize = nXSize;
+    sParams.nYSize = nYSize;
+    sParams.pfnAlg = pfnAlg;
+    sParams.pfnAlg_multisample = pfnAlg_multisample;
+    sParams.pData = pData;
+    sParams.bComputeAtEdges = bComputeAtEdges;
+    sParams.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sParams.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    sParams.fSrcNoDataValue = fSrcNoDataValue;
+    sParams.fDstNoDataValue = fDstNoDataValue;
+
+    const int nThreads = GDALDEMGetNumThreads();
+    if( nThreads > 1 && nYSize > 1 )
+    {
+        CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if( poThreadPool )
+        {
+            const CPLErr eErr = GDALGeneric3x3ProcessingMultiThreaded(
+                hSrcBand, hDstBand, eReadDT, sParams, poThreadPool,
+                pfnProgress, pProgressData);
+            if( eErr == CE_None )
+                pfnProgress( 1.0, nullptr, pProgressData );
+            return eErr;
+        }
+    }
+
+    // 1 line destination buffer.
+    float *pafOutputBuf = static_cast<float *>(
+        VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
+    // 3 line rotating source buffer.
+    T *pafThreeLineWin  = static_cast<T *>(
+        VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
+    if( pafOutputBuf == nullptr || pafThreeLineWin == nullptr )
+    {
+        VSIFree(pafOutputBuf);
+        VSIFree(pafThreeLineWin);
+        return CE_Failure;
+    }
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2*nXSize;
 
-    // Move a 3x3 pafWindow over each cell
-    // (where the cell in question is #4)
-    //
-    //      0 1 2
-    //      3 4 5
-    //      6 7 8
-
     /* Preload the first 2 lines */
 
     bool abLineHasNoDataValue[3] = {
@@ -425,72 +907,17 @@ CPLErr GDALGeneric3x3Processing(
 
             return CE_Failure;
         }
-        if( std::numeric_limits<T>::is_integer && bSrcHasNoData )
-        {
-            abLineHasNoDataValue[i] = false;
-            for( int iX = 0; iX < nXSize; iX++ )
-            {
-                if( pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue )
-                {
-                    abLineHasNoDataValue[i] = true;
-                    break;
-                }
-            }
-        }
+        abLineHasNoDataValue[i] =
+            LineHasNoData(sParams, pafThreeLineWin + i * nXSize);
       }
     }  // End extra scope for VC12
 
-    CPLErr eErr = CE_None;
-    if( bComputeAtEdges && nXSize >= 2 && nYSize >= 2 )
-    {
-        for( int j = 0; j < nXSize; j++ )
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j],    pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]
-            };
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData),
-                fSrcNoDataValue,
-                CPL_TO_BOOL(bIsSrcNoDataNan),
-                afWin, fDstNoDataValue,
-                pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write,
-                    0, 0, nXSize, 1,
-                    pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
-    {
-        // Exclude the edges
-        for( int j = 0; j < nXSize; j++ )
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write,
-                    0, 0, nXSize, 1,
-                    pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-
-        if( eErr == CE_None && nYSize > 1 )
-        {
-            eErr = GDALRasterIO(hDstBand, GF_Write,
-                        0, nYSize - 1, nXSize, 1,
-                        pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
-    }
+    GDALGeneric3x3ProcessLine(sParams, 0, pafThreeLineWin,
+                              0, 0, nXSize,
+                              false, pafOutputBuf);
+    CPLErr eErr = GDALRasterIO(hDstBand, GF_Write,
+                               0, 0, nXSize, 1,
+                               pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
     if( eErr != CE_None )
     {
         CPLFree(pafOutputBuf);
@@ -521,145 +948,15 @@ CPLErr GDALGeneric3x3Processing(
 
         // In case none of the 3 lines have nodata values, then no need to
         // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if( std::numeric_limits<T>::is_integer && bSrcHasNoData )
-        {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for( ; iX + 3 < nXSize; iX +=4 )
-            {
-                if( pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue )
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if( !bLastLineHasNoDataValue )
-            {
-                for( ; iX < nXSize; iX++ )
-                {
-                    if( pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue )
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                abLineHasNoDataValue[1] ||
-                                abLineHasNoDataValue[2];
-        }
-
-        if( bComputeAtEdges && nXSize >= 2 )
-        {
-            int j = 0;
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[nLine1Off + j],
-                         pafThreeLineWin[nLine1Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + j+1],
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine2Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + j+1],
-                INTERPOL(pafThreeLineWin[nLine3Off + j],
-                         pafThreeLineWin[nLine3Off + j+1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine3Off + j],
-                pafThreeLineWin[nLine3Off + j+1]
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
+        abLineHasNoDataValue[nLine3Off / nXSize] =
+            LineHasNoData(sParams, pafThreeLineWin + nLine3Off);
+        const bool bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
+                                               abLineHasNoDataValue[1] ||
+                                               abLineHasNoDataValue[2];
 
-        int j = 1;
-        if( pfnAlg_multisample && !bOneOfThreeLinesHasNoData )
-        {
-            j = pfnAlg_multisample(pafThreeLineWin,
-                                   nLine1Off,
-                                   nLine2Off,
-                                   nLine3Off,
-                                   nXSize,
-                                   pData,
-                                   pafOutputBuf);
-        }
-
-        for( ; j < nXSize - 1; j++ )
-        {
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + j-1],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + j+1],
-                pafThreeLineWin[nLine2Off + j-1],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + j+1],
-                pafThreeLineWin[nLine3Off + j-1],
-                pafThreeLineWin[nLine3Off + j],
-                pafThreeLineWin[nLine3Off + j+1]
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-
-        if( bComputeAtEdges && nXSize >= 2 )
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + j-1],
-                pafThreeLineWin[nLine1Off + j],
-                INTERPOL(pafThreeLineWin[nLine1Off + j],
-                         pafThreeLineWin[nLine1Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine2Off + j-1],
-                pafThreeLineWin[nLine2Off + j],
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine2Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[nLine3Off + j-1],
-                pafThreeLineWin[nLine3Off + j],
-                INTERPOL(pafThreeLineWin[nLine3Off + j],
-                         pafThreeLineWin[nLine3Off + j-1],
-                         bSrcHasNoData, fSrcNoDataValue)
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(
-                    CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                    fSrcNoDataValue,
-                    CPL_TO_BOOL(bIsSrcNoDataNan),
-                    afWin, fDstNoDataValue,
-                    pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if( nXSize > 1 )
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        GDALGeneric3x3ProcessLine(sParams, i, pafThreeLineWin,
+                                  nLine1Off, nLine2Off, nLine3Off,
+                                  bOneOfThreeLinesHasNoData, pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -691,38 +988,11 @@ CPLErr GDALGeneric3x3Processing(
         nLine3Off = nTemp;
     }
 
-    if( bComputeAtEdges && nXSize >= 2 && nYSize >= 2 )
+    if( nYSize >= 2 )
     {
-        for( int j = 0; j < nXSize; j++ )
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] = ComputeVal(
-                CPL_TO_BOOL(bSrcHasNoData),
-                fSrcNoDataValue,
-                CPL_TO_BOOL(bIsSrcNoDataNan),
-                afWin, fDstNoDataValue,
-                pfnAlg, pData, bComputeAtEdges);
-        }
+        GDALGeneric3x3ProcessLine(sParams, i, pafThreeLineWin,
+                                  nLine1Off, nLine2Off, 0,
+                                  false, pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write,
                             0, i, nXSize, 1,
                             pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
@@ -1359,6 +1629,191 @@ float GDALSlopeZevenbergenThorneAlg( const T* afWin,
     return static_cast<float>(100*(sqrt(key) / (2*psData->scale)));
 }
 
+#ifdef HAVE_16_SSE_REG
+
+// Loads the x and y gradient numerators of 4 consecutive pixels, computed
+// with the same order of operations as the non-vectorized algorithms, and
+// converts them to double.
+template<class T, GradientAlg alg> struct SlopeGradient_multisample {};
+
+template<> struct SlopeGradient_multisample<GInt32, GradientAlg::HORN>
+{
+    static void Compute( const GInt32* firstLine,
+                         const GInt32* secondLine,
+                         const GInt32* thirdLine,
+                         __m128d& reg_x0, __m128d& reg_x1,
+                         __m128d& reg_y0, __m128d& reg_y1 )
+    {
+        const auto load = [](const GInt32* p)
+            { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); };
+        const __m128i w0 = load(firstLine);
+        const __m128i w1 = load(firstLine + 1);
+        const __m128i w2 = load(firstLine + 2);
+        const __m128i w3 = load(secondLine);
+        const __m128i w5 = load(secondLine + 2);
+        const __m128i w6 = load(thirdLine);
+        const __m128i w7 = load(thirdLine + 1);
+        const __m128i w8 = load(thirdLine + 2);
+        const __m128i accX = _mm_sub_epi32(
+            _mm_add_epi32(_mm_add_epi32(w0, w6), _mm_add_epi32(w3, w3)),
+            _mm_add_epi32(_mm_add_epi32(w2, w8), _mm_add_epi32(w5, w5)));
+        const __m128i accY = _mm_sub_epi32(
+            _mm_add_epi32(_mm_add_epi32(w6, w8), _mm_add_epi32(w7, w7)),
+            _mm_add_epi32(_mm_add_epi32(w0, w2), _mm_add_epi32(w1, w1)));
+        reg_x0 = _mm_cvtepi32_pd(accX);
+        reg_x1 = _mm_cvtepi32_pd(_mm_srli_si128(accX, 8));
+        reg_y0 = _mm_cvtepi32_pd(accY);
+        reg_y1 = _mm_cvtepi32_pd(_mm_srli_si128(accY, 8));
+    }
+};
+
+template<> struct SlopeGradient_multisample<GInt32,
+                                            GradientAlg::ZEVENBERGEN_THORNE>
+{
+    static void Compute( const GInt32* firstLine,
+                         const GInt32* secondLine,
+                         const GInt32* thirdLine,
+                         __m128d& reg_x0, __m128d& reg_x1,
+                         __m128d& reg_y0, __m128d& reg_y1 )
+    {
+        const auto load = [](const GInt32* p)
+            { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); };
+        const __m128i accX = _mm_sub_epi32(load(secondLine),
+                                           load(secondLine + 2));
+        const __m128i accY = _mm_sub_epi32(load(thirdLine + 1),
+                                           load(firstLine + 1));
+        reg_x0 = _mm_cvtepi32_pd(accX);
+        reg_x1 = _mm_cvtepi32_pd(_mm_srli_si128(accX, 8));
+        reg_y0 = _mm_cvtepi32_pd(accY);
+        reg_y1 = _mm_cvtepi32_pd(_mm_srli_si128(accY, 8));
+    }
+};
+
+// The float versions are only bit-exact with the non-vectorized ones if
+// single precision computations are not done with extended precision.
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define HAVE_FLOAT_SLOPE_MULTISAMPLE
+
+template<> struct SlopeGradient_multisample<float, GradientAlg::HORN>
+{
+    static void Compute( const float* firstLine,
+                         const float* secondLine,
+                         const float* thirdLine,
+                         __m128d& reg_x0, __m128d& reg_x1,
+                         __m128d& reg_y0, __m128d& reg_y1 )
+    {
+        const __m128 w0 = _mm_loadu_ps(firstLine);
+        const __m128 w1 = _mm_loadu_ps(firstLine + 1);
+        const __m128 w2 = _mm_loadu_ps(firstLine + 2);
+        const __m128 w3 = _mm_loadu_ps(secondLine);
+        const __m128 w5 = _mm_loadu_ps(secondLine + 2);
+        const __m128 w6 = _mm_loadu_ps(thirdLine);
+        const __m128 w7 = _mm_loadu_ps(thirdLine + 1);
+        const __m128 w8 = _mm_loadu_ps(thirdLine + 2);
+        // (w0 + w3 + w3 + w6) - (w2 + w5 + w5 + w8), evaluated left to right
+        const __m128 accX = _mm_sub_ps(
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(w0, w3), w3), w6),
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(w2, w5), w5), w8));
+        // (w6 + w7 + w7 + w8) - (w0 + w1 + w1 + w2)
+        const __m128 accY = _mm_sub_ps(
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(w6, w7), w7), w8),
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(w0, w1), w1), w2));
+        reg_x0 = _mm_cvtps_pd(accX);
+        reg_x1 = _mm_cvtps_pd(_mm_movehl_ps(accX, accX));
+        reg_y0 = _mm_cvtps_pd(accY);
+        reg_y1 = _mm_cvtps_pd(_mm_movehl_ps(accY, accY));
+    }
+};
+
+template<> struct SlopeGradient_multisample<float,
+                                            GradientAlg::ZEVENBERGEN_THORNE>
+{
+    static void Compute( const float* firstLine,
+                         const float* secondLine,
+                         const float* thirdLine,
+                         __m128d& reg_x0, __m128d& reg_x1,
+                         __m128d& reg_y0, __m128d& reg_y1 )
+    {
+        const __m128 accX = _mm_sub_ps(_mm_loadu_ps(secondLine),
+                                       _mm_loadu_ps(secondLine + 2));
+        const __m128 accY = _mm_sub_ps(_mm_loadu_ps(thirdLine + 1),
+                                       _mm_loadu_ps(firstLine + 1));
+        reg_x0 = _mm_cvtps_pd(accX);
+        reg_x1 = _mm_cvtps_pd(_mm_movehl_ps(accX, accX));
+        reg_y0 = _mm_cvtps_pd(accY);
+        reg_y1 = _mm_cvtps_pd(_mm_movehl_ps(accY, accY));
+    }
+};
+#endif
+
+template<class T, GradientAlg alg>
+static
+int GDALSlopeAlg_multisample( const T* pafThreeLineWin,
+                              int nLine1Off,
+                              int nLine2Off,
+                              int nLine3Off,
+                              int nXSize,
+                              void* pData,
+                              float* pafOutputBuf )
+{
+    const GDALSlopeAlgData* psData = static_cast<const GDALSlopeAlgData*>(pData);
+    const __m128d reg_ewres = _mm_set1_pd(psData->ewres);
+    const __m128d reg_nsres = _mm_set1_pd(psData->nsres);
+    const __m128d reg_scale = _mm_set1_pd(
+        (alg == GradientAlg::HORN ? 8 : 2) * psData->scale);
+    const __m128d reg_hundred = _mm_set1_pd(100);
+    const bool bDegrees = psData->slopeFormat == 1;
+
+    int j = 1;  // Used after for.
+    for( ; j < nXSize - 4; j+= 4 )
+    {
+        const T* firstLine  = pafThreeLineWin + nLine1Off + j-1;
+        const T* secondLine = pafThreeLineWin + nLine2Off + j-1;
+        const T* thirdLine  = pafThreeLineWin + nLine3Off + j-1;
+
+        __m128d reg_x0, reg_x1, reg_y0, reg_y1;
+        SlopeGradient_multisample<T, alg>::Compute(
+            firstLine, secondLine, thirdLine, reg_x0, reg_x1, reg_y0, reg_y1);
+
+        // dx = x / ewres, dy = y / nsres
+        reg_x0 = _mm_div_pd(reg_x0, reg_ewres);
+        reg_x1 = _mm_div_pd(reg_x1, reg_ewres);
+        reg_y0 = _mm_div_pd(reg_y0, reg_nsres);
+        reg_y1 = _mm_div_pd(reg_y1, reg_nsres);
+
+        // sqrt(dx * dx + dy * dy) / (N * scale)
+        __m128d reg_val0 = _mm_div_pd(_mm_sqrt_pd(
+            _mm_add_pd(_mm_mul_pd(reg_x0, reg_x0),
+                       _mm_mul_pd(reg_y0, reg_y0))), reg_scale);
+        __m128d reg_val1 = _mm_div_pd(_mm_sqrt_pd(
+            _mm_add_pd(_mm_mul_pd(reg_x1, reg_x1),
+                       _mm_mul_pd(reg_y1, reg_y1))), reg_scale);
+
+        if( bDegrees )
+        {
+            double adfVal[4];
+            _mm_storeu_pd(adfVal, reg_val0);
+            _mm_storeu_pd(adfVal + 2, reg_val1);
+            for( int k = 0; k < 4; k++ )
+            {
+                pafOutputBuf[j + k] = static_cast<float>(
+                    atan(adfVal[k]) * kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            reg_val0 = _mm_mul_pd(reg_hundred, reg_val0);
+            reg_val1 = _mm_mul_pd(reg_hundred, reg_val1);
+            const __m128 res = _mm_castsi128_ps(
+              _mm_unpacklo_epi64(_mm_castps_si128(_mm_cvtpd_ps(reg_val0)),
+                                 _mm_castps_si128(_mm_cvtpd_ps(reg_val1))));
+            _mm_storeu_ps(pafOutputBuf + j, res);
+        }
+    }
+    return j;
+}
+#endif
+
 static
 void* GDALCreateSlopeData( double* adfGeoTransform,
                            double scale,
@@ -2282,6 +2737,75 @@ GDALColorInterp GDALColorReliefRasterBand::GetColorInterpretation()
     return static_cast<GDALColorInterp>(GCI_RedBand + nBand - 1);
 }
 
+/************************************************************************/
+/*                  GDALColorReliefProcessPixels()                      */
+/************************************************************************/
+
+namespace {
+struct GDALColorReliefJob
+{
+    ColorAssociation* pasColorAssociation = nullptr;
+    int nColorAssociation = 0;
+    ColorSelectionMode eColorSelectionMode = COLOR_SELECTION_INTERPOLATE;
+    const GByte* pabyPrecomputed = nullptr;
+    int nIndexOffset = 0;
+    const int* panSourceBuf = nullptr;
+    const float* pafSourceBuf = nullptr;
+    GByte* apabyDestBuf[4] = { nullptr, nullptr, nullptr, nullptr };
+    size_t nStart = 0;  // Index of the first pixel to process
+    size_t nEnd = 0;    // Index of the last pixel to process + 1
+};
+}  // namespace
+
+static void GDALColorReliefProcessPixels( void* pData )
+{
+    const GDALColorReliefJob* psJob =
+        static_cast<const GDALColorReliefJob*>(pData);
+    GByte* pabyDestBuf1 = psJob->apabyDestBuf[0];
+    GByte* pabyDestBuf2 = psJob->apabyDestBuf[1];
+    GByte* pabyDestBuf3 = psJob->apabyDestBuf[2];
+    GByte* pabyDestBuf4 = psJob->apabyDestBuf[3];
+
+    if( psJob->pabyPrecomputed )
+    {
+        const GByte* pabyPrecomputed = psJob->pabyPrecomputed;
+        for( size_t j = psJob->nStart; j < psJob->nEnd; j++ )
+        {
+            int nIndex = psJob->panSourceBuf[j] + psJob->nIndexOffset;
+            pabyDestBuf1[j] = pabyPrecomputed[4 * nIndex];
+            pabyDestBuf2[j] = pabyPrecomputed[4 * nIndex + 1];
+            pabyDestBuf3[j] = pabyPrecomputed[4 * nIndex + 2];
+            pabyDestBuf4[j] = pabyPrecomputed[4 * nIndex + 3];
+        }
+    }
+    else
+    {
+        int nR = 0;
+        int nG = 0;
+        int nB = 0;
+        int nA = 0;
+        for( size_t j = psJob->nStart; j < psJob->nEnd; j++ )
+        {
+            GDALColorReliefGetRGBA  (psJob->pasColorAssociation,
+                                     psJob->nColorAssociation,
+                                     psJob->pafSourceBuf[j],
+                                     psJob->eColorSelectionMode,
+                                     &nR,
+                                     &nG,
+                                     &nB,
+                                     &nA);
+            pabyDestBuf1[j] = static_cast<GByte>(nR);
+            pabyDestBuf2[j] = static_cast<GByte>(nG);
+            pabyDestBuf3[j] = static_cast<GByte>(nB);
+            pabyDestBuf4[j] = static_cast<GByte>(nA);
+        }
+    }
+}
+
+/************************************************************************/
+/*                         GDALColorRelief()                            */
+/************************************************************************/
+
 static
 CPLErr GDALColorRelief( GDALRasterBandH hSrcBand,
                         GDALRasterBandH hDstBand1,
@@ -2326,18 +2850,31 @@ CPLErr GDALColorRelief( GDALRasterBandH hSrcBand,
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
+/* -------------------------------------------------------------------- */
+/*      When multi-threading is enabled, process chunks of several      */
+/*      lines, and split the computation of their colors into jobs.     */
+/* -------------------------------------------------------------------- */
+    const int nThreads = GDALDEMGetNumThreads();
+    CPLWorkerThreadPool* poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    const int nChunkLines = poThreadPool
+        ? GDALDEMGetChunkLineCount(nXSize, nYSize, nThreads, 4 + 4)
+        : 1;
+    const size_t nChunkPixels = static_cast<size_t>(nXSize) * nChunkLines;
+
     float* pafSourceBuf = nullptr;
     int* panSourceBuf = nullptr;
     if( pabyPrecomputed )
         panSourceBuf = static_cast<int *>(
-            VSI_MALLOC2_VERBOSE(sizeof(int), nXSize));
+            VSI_MALLOC2_VERBOSE(sizeof(int), nChunkPixels));
     else
         pafSourceBuf = static_cast<float *>(
-            VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    GByte* pabyDestBuf1 = static_cast<GByte *>(VSI_MALLOC2_VERBOSE(4, nXSize));
-    GByte* pabyDestBuf2 =  pabyDestBuf1 ? pabyDestBuf1 + nXSize : nullptr;
-    GByte* pabyDestBuf3 =  pabyDestBuf2 ? pabyDestBuf2 + nXSize : nullptr;
-    GByte* pabyDestBuf4 =  pabyDestBuf3 ? pabyDestBuf3 + nXSize : nullptr;
+            VSI_MALLOC2_VERBOSE(sizeof(float), nChunkPixels));
+    GByte* pabyDestBuf1 =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(4, nChunkPixels));
+    GByte* pabyDestBuf2 =  pabyDestBuf1 ? pabyDestBuf1 + nChunkPixels : nullptr;
+    GByte* pabyDestBuf3 =  pabyDestBuf2 ? pabyDestBuf2 + nChunkPixels : nullptr;
+    GByte* pabyDestBuf4 =  pabyDestBuf3 ? pabyDestBuf3 + nChunkPixels : nullptr;
 
     if( (pabyPrecomputed != nullptr && panSourceBuf == nullptr) ||
         (pabyPrecomputed == nullptr && pafSourceBuf == nullptr) ||
@@ -2364,145 +2901,96 @@ CPLErr GDALColorRelief( GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    int nR = 0;
-    int nG = 0;
-    int nB = 0;
-    int nA = 0;
+    GDALColorReliefJob sJobTemplate;
+    sJobTemplate.pasColorAssociation = pasColorAssociation;
+    sJobTemplate.nColorAssociation = nColorAssociation;
+    sJobTemplate.eColorSelectionMode = eColorSelectionMode;
+    sJobTemplate.pabyPrecomputed = pabyPrecomputed;
+    sJobTemplate.nIndexOffset = nIndexOffset;
+    sJobTemplate.panSourceBuf = panSourceBuf;
+    sJobTemplate.pafSourceBuf = pafSourceBuf;
+    sJobTemplate.apabyDestBuf[0] = pabyDestBuf1;
+    sJobTemplate.apabyDestBuf[1] = pabyDestBuf2;
+    sJobTemplate.apabyDestBuf[2] = pabyDestBuf3;
+    sJobTemplate.apabyDestBuf[3] = pabyDestBuf4;
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    std::vector<GDALColorReliefJob> asJobs;
+    if( poThreadPool )
+    {
+        poJobQueue = poThreadPool->CreateJobQueue();
+        asJobs.resize(nThreads, sJobTemplate);
+    }
 
-    for( int i = 0; i < nYSize; i++ )
+    CPLErr eErr = CE_None;
+    for( int i = 0; eErr == CE_None && i < nYSize; i += nChunkLines )
     {
+        const int nLines = std::min(nChunkLines, nYSize - i);
+        const size_t nPixels = static_cast<size_t>(nXSize) * nLines;
+
         /* Read source buffer */
-        CPLErr eErr = GDALRasterIO( hSrcBand,
-                                    GF_Read,
-                                    0, i,
-                                    nXSize, 1,
-                                    panSourceBuf
-                                    ? static_cast<void*>(panSourceBuf)
-                                    : static_cast<void*>(pafSourceBuf),
-                                    nXSize, 1,
-                                    panSourceBuf ? GDT_Int32 : GDT_Float32,
-                                    0, 0);
+        eErr = GDALRasterIO( hSrcBand,
+                             GF_Read,
+                             0, i,
+                             nXSize, nLines,
+                             panSourceBuf
+                             ? static_cast<void*>(panSourceBuf)
+                             : static_cast<void*>(pafSourceBuf),
+                             nXSize, nLines,
+                             panSourceBuf ? GDT_Int32 : GDT_Float32,
+                             0, 0);
         if( eErr != CE_None )
-        {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-            return eErr;
-        }
+            break;
 
-        if( pabyPrecomputed )
+        if( poJobQueue )
         {
-            for( int j = 0; j < nXSize; j++ )
+            const size_t nPixelsPerJob = DIV_ROUND_UP(nPixels, asJobs.size());
+            for( size_t iJob = 0; iJob < asJobs.size(); iJob++ )
             {
-                int nIndex = panSourceBuf[j] + nIndexOffset;
-                pabyDestBuf1[j] = pabyPrecomputed[4 * nIndex];
-                pabyDestBuf2[j] = pabyPrecomputed[4 * nIndex + 1];
-                pabyDestBuf3[j] = pabyPrecomputed[4 * nIndex + 2];
-                pabyDestBuf4[j] = pabyPrecomputed[4 * nIndex + 3];
+                asJobs[iJob].nStart = std::min(nPixels, iJob * nPixelsPerJob);
+                asJobs[iJob].nEnd =
+                    std::min(nPixels, (iJob + 1) * nPixelsPerJob);
+                if( asJobs[iJob].nStart < asJobs[iJob].nEnd )
+                {
+                    poJobQueue->SubmitJob(GDALColorReliefProcessPixels,
+                                          &asJobs[iJob]);
+                }
             }
+            poJobQueue->WaitCompletion();
         }
         else
         {
-            for( int j = 0; j < nXSize; j++ )
-            {
-                GDALColorReliefGetRGBA  (pasColorAssociation,
-                                         nColorAssociation,
-                                         pafSourceBuf[j],
-                                         eColorSelectionMode,
-                                         &nR,
-                                         &nG,
-                                         &nB,
-                                         &nA);
-                pabyDestBuf1[j] = static_cast<GByte>(nR);
-                pabyDestBuf2[j] = static_cast<GByte>(nG);
-                pabyDestBuf3[j] = static_cast<GByte>(nB);
-                pabyDestBuf4[j] = static_cast<GByte>(nA);
-            }
+            sJobTemplate.nStart = 0;
+            sJobTemplate.nEnd = nPixels;
+            GDALColorReliefProcessPixels(&sJobTemplate);
         }
 
         /* -----------------------------------------
-         * Write Line to Raster
+         * Write Lines to Raster
          */
-        eErr = GDALRasterIO(hDstBand1,
-                            GF_Write,
-                            0, i, nXSize,
-                            1, pabyDestBuf1, nXSize, 1, GDT_Byte, 0, 0);
-        if( eErr != CE_None )
-        {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return eErr;
-        }
-
-        eErr = GDALRasterIO(hDstBand2,
-                            GF_Write,
-                            0, i, nXSize,
-                            1, pabyDestBuf2, nXSize, 1, GDT_Byte, 0, 0);
-        if( eErr != CE_None )
+        GDALRasterBandH ahDstBand[4] =
+            { hDstBand1, hDstBand2, hDstBand3, hDstBand4 };
+        for( int iBand = 0; eErr == CE_None && iBand < 4; iBand++ )
         {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return eErr;
+            if( ahDstBand[iBand] == nullptr )
+                continue;
+            eErr = GDALRasterIO(ahDstBand[iBand],
+                                GF_Write,
+                                0, i, nXSize, nLines,
+                                sJobTemplate.apabyDestBuf[iBand],
+                                nXSize, nLines, GDT_Byte, 0, 0);
         }
 
-        eErr = GDALRasterIO(hDstBand3,
-                            GF_Write,
-                            0, i, nXSize,
-                            1, pabyDestBuf3, nXSize, 1, GDT_Byte, 0, 0);
-        if( eErr != CE_None )
-        {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return eErr;
-        }
-
-        if( hDstBand4 )
-        {
-            eErr = GDALRasterIO(hDstBand4,
-                        GF_Write,
-                        0, i, nXSize,
-                        1, pabyDestBuf4, nXSize, 1, GDT_Byte, 0, 0);
-            if( eErr != CE_None )
-            {
-                VSIFree(pabyPrecomputed);
-                CPLFree(pafSourceBuf);
-                CPLFree(panSourceBuf);
-                CPLFree(pabyDestBuf1);
-                CPLFree(pasColorAssociation);
-
-                return eErr;
-            }
-        }
-
-        if( !pfnProgress( 1.0 * (i+1) / nYSize, nullptr, pProgressData ) )
+        if( eErr == CE_None &&
+            !pfnProgress( 1.0 * (i+nLines) / nYSize, nullptr, pProgressData ) )
         {
             CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
-
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return CE_Failure;
+            eErr = CE_Failure;
         }
     }
 
-    pfnProgress( 1.0, nullptr, pProgressData );
+    if( eErr == CE_None )
+        pfnProgress( 1.0, nullptr, pProgressData );
 
     VSIFree(pabyPrecomputed);
     CPLFree(pafSourceBuf);
@@ -2510,7 +2998,7 @@ CPLErr GDALColorRelief( GDALRasterBandH hSrcBand,
     CPLFree(pabyDestBuf1);
     CPLFree(pasColorAssociation);
 
-    return CE_None;
+    return eErr;
 }
 
 /************************************************************************/
@@ -3557,6 +4045,7 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
     void* pData = nullptr;
     GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type pfnAlgFloat_multisample = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type pfnAlgInt32_multisample = nullptr;
 
     if( eUtilityMode == HILL_SHADE && psOptions->bMultiDirectional )
@@ -3648,11 +4137,27 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         {
             pfnAlgFloat = GDALSlopeZevenbergenThorneAlg<float>;
             pfnAlgInt32 = GDALSlopeZevenbergenThorneAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+#ifdef HAVE_FLOAT_SLOPE_MULTISAMPLE
+            pfnAlgFloat_multisample =
+                GDALSlopeAlg_multisample<float, GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32, GradientAlg::ZEVENBERGEN_THORNE>;
+#endif
         }
         else
         {
             pfnAlgFloat = GDALSlopeHornAlg<float>;
             pfnAlgInt32 = GDALSlopeHornAlg<GInt32>;
+#ifdef HAVE_16_SSE_REG
+#ifdef HAVE_FLOAT_SLOPE_MULTISAMPLE
+            pfnAlgFloat_multisample =
+                GDALSlopeAlg_multisample<float, GradientAlg::HORN>;
+#endif
+            pfnAlgInt32_multisample =
+                GDALSlopeAlg_multisample<GInt32, GradientAlg::HORN>;
+#endif
         }
     }
 
@@ -3913,7 +4418,7 @@ GDALDatasetH GDALDEMProcessing( const char *pszDest,
         {
             GDALGeneric3x3Processing<float>(hSrcBand, hDstBand,
                                             pfnAlgFloat,
-                                            nullptr,
+                                            pfnAlgFloat_multisample,
                                             pData,
                                             psOptions->bComputeAtEdges,
                                             pfnProgress, pProgressData);
@@ -445,6 +445,57 @@ def test_contour_raster_acquisition_error():
         )
 
 
+###############################################################################
+# Check that multi-threaded (tiled) generation gives the same result as the
+# serial one
+
+
+@pytest.mark.parametrize("polygonize", [False, True])
+def test_contour_multithreaded(polygonize):
+
+    src_ds = gdal.Open("data/contour_in.tif")
+    ds = gdal.GetDriverByName("MEM").Create(
+        "", src_ds.RasterXSize, src_ds.RasterYSize * 5
+    )
+    ds.SetGeoTransform(src_ds.GetGeoTransform())
+    data = src_ds.ReadRaster()
+    for i in range(5):
+        ds.WriteRaster(
+            0, i * src_ds.RasterYSize, src_ds.RasterXSize, src_ds.RasterYSize, data
+        )
+
+    def generate(num_threads):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        ogr_lyr = ogr_ds.CreateLayer(
+            "contour",
+            geom_type=ogr.wkbMultiPolygon if polygonize else ogr.wkbLineString,
+        )
+        ogr_lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        ogr_lyr.CreateField(ogr.FieldDefn("elev", ogr.OFTReal))
+        options = ["LEVEL_INTERVAL=10", "ID_FIELD=0", "NUM_THREADS=" + num_threads]
+        if polygonize:
+            options += ["ELEV_FIELD_MIN=1", "POLYGONIZE=TRUE"]
+        else:
+            options += ["ELEV_FIELD=1"]
+        assert (
+            gdal.ContourGenerateEx(ds.GetRasterBand(1), ogr_lyr, options=options) == 0
+        )
+        ret = {}
+        for f in ogr_lyr:
+            g = f.GetGeometryRef()
+            measure = g.GetArea() if polygonize else g.Length()
+            count, total = ret.get(f["elev"], (0, 0))
+            ret[f["elev"]] = (count + 1, total + measure)
+        return ret
+
+    ref = generate("1")
+    got = generate("4")
+    assert sorted(got.keys()) == sorted(ref.keys())
+    for elev in ref:
+        assert got[elev][0] == ref[elev][0], elev
+        assert got[elev][1] == pytest.approx(ref[elev][1], rel=1e-10), elev
+
+
 ###############################################################################
 # Cleanup
 
@@ -256,3 +256,54 @@ def test_fillnodata_user_provided_mask_with_smoothing():
     )
     got = [x for x in struct.unpack("f" * (5 * 5), targetBand.ReadRaster())]
     assert got == pytest.approx(expected, 1e-5)
+
+
+###############################################################################
+# Test that the multi-threaded tiled implementation gives the same result as
+# the single threaded one
+
+
+@pytest.mark.parametrize(
+    "maxSearchDist,smoothingIterations,user_mask",
+    [(100, 0, False), (30.5, 3, False), (20, 2, True)],
+)
+def test_fillnodata_num_threads(maxSearchDist, smoothingIterations, user_mask):
+
+    width = 700
+    height = 600
+    values = []
+    mask_values = []
+    for y in range(height):
+        for x in range(width):
+            hole = (x // 37 + y // 23) % 3 == 0 or (
+                x > 300 and x < 500 and y > 100 and y < 400
+            )
+            values.append(0 if hole else 1 + (x * 7 + y * 13) % 200)
+            mask_values.append(0 if hole else 255)
+    ar = struct.pack("f" * (width * height), *values)
+    mask_ar = struct.pack("B" * (width * height), *mask_values)
+
+    def fill(options):
+        ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, gdal.GDT_Float32)
+        targetBand = ds.GetRasterBand(1)
+        targetBand.WriteRaster(0, 0, width, height, ar)
+        maskBand = None
+        if user_mask:
+            mask_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+            mask_ds.WriteRaster(0, 0, width, height, mask_ar)
+            maskBand = mask_ds.GetRasterBand(1)
+        else:
+            targetBand.SetNoDataValue(0)
+        assert (
+            gdal.FillNodata(
+                targetBand=targetBand,
+                maskBand=maskBand,
+                maxSearchDist=maxSearchDist,
+                smoothingIterations=smoothingIterations,
+                options=["TEMP_FILE_DRIVER=MEM"] + options,
+            )
+            == 0
+        )
+        return targetBand.ReadRaster()
+
+    assert fill(["NUM_THREADS=4"]) == fill([])
@@ -33,6 +33,7 @@
 import struct
 from collections import defaultdict
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -402,3 +403,48 @@ def test_polygonize_7():
         assert (
             abs(value - dn_area_vector[key]) < pixel_area
         ), "polygonized vector area not match raster area"
+
+
+###############################################################################
+# Test that processing by strips gives the same result as the default mode
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["STRIP_HEIGHT=7"],
+        ["STRIP_HEIGHT=7", "8CONNECTED=8"],
+        ["NUM_THREADS=4"],
+        ["NUM_THREADS=4", "STRIP_HEIGHT=1", "8CONNECTED=8"],
+    ],
+)
+def test_polygonize_strips(options):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(options):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        result = gdal.Polygonize(
+            src_band, src_band.GetMaskBand(), mem_layer, 0, options
+        )
+        assert result == 0, "Polygonize failed"
+        return sorted(
+            (f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in mem_layer
+        )
+
+    ref_options = ["8CONNECTED=8"] if "8CONNECTED=8" in options else []
+    assert polygonize(options) == polygonize(ref_options)
+
+
+def test_polygonize_invalid_strip_height():
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+    mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+    with gdaltest.error_handler():
+        assert gdal.Polygonize(src_band, None, mem_layer, -1, ["STRIP_HEIGHT=0"]) != 0
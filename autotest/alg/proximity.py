@@ -29,6 +29,10 @@
 ###############################################################################
 
 
+import math
+import struct
+
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -126,3 +130,82 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test the exact Euclidean distance transform
+
+
+def test_proximity_edt():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 9, 7, 1)
+    src_ds.GetRasterBand(1).WriteRaster(4, 3, 1, 1, b"\x01")
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 9, 7, 1, gdal.GDT_Float32)
+
+    gdal.ComputeProximity(
+        src_ds.GetRasterBand(1), dst_ds.GetRasterBand(1), options=["ALGORITHM=EDT"]
+    )
+    data = struct.unpack("f" * 63, dst_ds.GetRasterBand(1).ReadRaster())
+    for y in range(7):
+        for x in range(9):
+            assert data[y * 9 + x] == pytest.approx(
+                math.sqrt((x - 4) ** 2 + (y - 3) ** 2), rel=1e-6
+            ), (x, y)
+
+    # Test MAXDIST
+    gdal.ComputeProximity(
+        src_ds.GetRasterBand(1),
+        dst_ds.GetRasterBand(1),
+        options=["ALGORITHM=EDT", "MAXDIST=2", "NODATA=-1"],
+    )
+    data = struct.unpack("f" * 63, dst_ds.GetRasterBand(1).ReadRaster())
+    for y in range(7):
+        for x in range(9):
+            dist = math.sqrt((x - 4) ** 2 + (y - 3) ** 2)
+            expected = dist if dist <= 2 else -1
+            assert data[y * 9 + x] == pytest.approx(expected, rel=1e-6), (x, y)
+
+
+###############################################################################
+# Test that the exact Euclidean distance transform gives the same result
+# whatever the number of threads
+
+
+def test_proximity_edt_multithreaded():
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def run(options):
+        dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+        gdal.ComputeProximity(
+            src_band, dst_ds.GetRasterBand(1), options=["ALGORITHM=EDT"] + options
+        )
+        return dst_ds.GetRasterBand(1).ReadRaster()
+
+    for options in (
+        [],
+        ["VALUES=65,64", "MAXDIST=12", "NODATA=-1", "FIXED_BUF_VAL=255"],
+        ["VALUES=65,64", "MAXDIST=12", "USE_INPUT_NODATA=YES", "NODATA=0"],
+    ):
+        ref = run(["NUM_THREADS=1"] + options)
+        assert run(["NUM_THREADS=4"] + options) == ref
+
+
+###############################################################################
+# Test invalid ALGORITHM value
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 1, 1, 1)
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 1, 1, 1)
+    with gdaltest.error_handler():
+        assert (
+            gdal.ComputeProximity(
+                src_ds.GetRasterBand(1),
+                dst_ds.GetRasterBand(1),
+                options=["ALGORITHM=INVALID"],
+            )
+            != 0
+        )
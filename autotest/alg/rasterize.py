@@ -30,6 +30,7 @@
 
 import struct
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -802,3 +803,78 @@ def test_rasterize_merge_alg_add_polygon(wkt):
         10,
     )
     assert got == expected, "%s" % str(got)
+
+
+###############################################################################
+# Test that multi-threaded rasterization gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("merge_alg", ["REPLACE", "ADD"])
+@pytest.mark.parametrize("all_touched", [False, True])
+def test_rasterize_num_threads(merge_alg, all_touched):
+
+    sr_wkt = 'LOCAL_CS["arbitrary"]'
+    sr = osr.SpatialReference(sr_wkt)
+
+    data_source = ogr.GetDriverByName("MEMORY").CreateDataSource("")
+    layer = data_source.CreateLayer("", sr)
+    layer.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for i in range(200):
+        x = (i * 37) % 300
+        y = (i * 53) % 400
+        r = 3 + (i * 11) % 40
+        if i % 3 == 0:
+            wkt = "POLYGON((%d %d,%d %d,%d %d,%d %d))" % (
+                x,
+                y,
+                x + r,
+                y + r // 2,
+                x + r // 3,
+                y + r,
+                x,
+                y,
+            )
+        elif i % 3 == 1:
+            wkt = "LINESTRING(%d %d,%d %d,%d %d)" % (x, y, x + r, y, x, y + r)
+        else:
+            wkt = "MULTIPOINT((%d %d),(%d %d))" % (x, y, x + r, y + r)
+        feature = ogr.Feature(layer.GetLayerDefn())
+        feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        feature["val"] = i % 50
+        layer.CreateFeature(feature)
+
+    def rasterize(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 300, 400, 2, gdal.GDT_Float32)
+        ds.SetGeoTransform([0, 1, 0, 400, 0, -1])
+        ds.SetProjection(sr_wkt)
+        options = [
+            "ATTRIBUTE=val",
+            "MERGE_ALG=" + merge_alg,
+            "ALL_TOUCHED=" + str(all_touched),
+        ]
+        if num_threads:
+            options += ["NUM_THREADS=" + num_threads, "CHUNKYSIZE=13"]
+        assert gdal.RasterizeLayer(ds, [1, 2], layer, options=options) == 0
+        return ds.ReadRaster()
+
+    ref = rasterize(None)
+    assert rasterize("4") == ref
+    assert rasterize("ALL_CPUS") == ref
+
+    # Test GDALRasterizeGeometries() through gdal_rasterize
+    def rasterize_geometries(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 300, 400, 1, gdal.GDT_Float32)
+        ds.SetGeoTransform([0, 1, 0, 400, 0, -1])
+        ds.SetProjection(sr_wkt)
+        with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+            assert gdal.Rasterize(
+                ds,
+                data_source,
+                attribute="val",
+                allTouched=all_touched,
+                add=merge_alg == "ADD",
+            )
+        return ds.ReadRaster()
+
+    assert rasterize_geometries("4") == rasterize_geometries("1")
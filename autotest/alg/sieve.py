@@ -30,6 +30,8 @@
 ###############################################################################
 
 
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -345,3 +347,51 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that the tiled implementation gives the same result as the default one
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("with_mask", [False, True])
+def test_sieve_tiled(connectedness, with_mask):
+
+    width = 300
+    height = 250
+    values = []
+    for y in range(height):
+        for x in range(width):
+            # Blocks with some noise
+            v = (x // 7 + y // 5) % 3
+            if (x * 31 + y * 17) % 5 == 0:
+                v = (x * y) % 3
+            values.append(v)
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height, 2)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, height, struct.pack("B" * (width * height), *values)
+    )
+    mask_band = None
+    if with_mask:
+        mask_band = src_ds.GetRasterBand(2)
+        mask_band.Fill(255)
+        mask_band.WriteRaster(50, 40, 60, 30, b"\x00" * (60 * 30))
+
+    def sieve(options):
+        dst_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+        gdal.SieveFilter(
+            src_ds.GetRasterBand(1),
+            mask_band,
+            dst_ds.GetRasterBand(1),
+            10,
+            connectedness,
+            options=options,
+        )
+        return dst_ds.GetRasterBand(1).ReadRaster()
+
+    expected = sieve([])
+    assert expected != src_ds.GetRasterBand(1).ReadRaster()
+    # MAX_MEMORY small enough to get tiles of the minimum size (64x64)
+    assert sieve(["MAX_MEMORY=0.01"]) == expected
+    assert sieve(["NUM_THREADS=4", "MAX_MEMORY=0.01"]) == expected
@@ -1912,3 +1912,77 @@ def test_warp_max_downsampling_missed_edges():
 
     ds = gdal.Open("data/bug_6526_warped.vrt")
     assert ds.GetRasterBand(1).ComputeRasterMinMax() == (1, 1)
+
+
+###############################################################################
+# Test warping several chunks concurrently with -multi and NUM_THREADS
+
+
+@pytest.mark.parametrize("resample_alg", ["near", "average", "mode"])
+def test_warp_multi_concurrent_chunks(resample_alg):
+
+    src_ds = gdal.Translate("", "../gcore/data/byte.tif", format="MEM", width=400)
+
+    def warp(**kwargs):
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            dstSRS="EPSG:4326",
+            resampleAlg=resample_alg,
+            warpMemoryLimit=400000,
+            **kwargs,
+        )
+
+    ref_ds = warp()
+    ref_cs = [ref_ds.GetRasterBand(1).Checksum()]
+
+    ds = warp(multithread=True, warpOptions=["NUM_THREADS=4"])
+    assert [ds.GetRasterBand(1).Checksum()] == ref_cs
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "3"):
+        ds = warp(multithread=True)
+    assert [ds.GetRasterBand(1).Checksum()] == ref_cs
+
+    def cancel(pct, msg, user_data):
+        return pct < 0.5
+
+    with gdaltest.error_handler():
+        ds = warp(multithread=True, warpOptions=["NUM_THREADS=4"], callback=cancel)
+    assert ds is None
+
+
+###############################################################################
+# Test that resampling several bands with masks gives the same result as
+# resampling them one at a time
+
+
+@pytest.mark.parametrize("resample_alg", ["bilinear", "cubic", "cubicspline"])
+def test_warp_multiband_masks_same_as_single_band(resample_alg):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 60, 50, 3)
+    src_ds.SetGeoTransform([0, 1, 0, 50, 0, -1])
+    for i in range(3):
+        src_ds.GetRasterBand(i + 1).SetNoDataValue(i)
+        src_ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, 60, 50, bytes([(j * (i + 3)) % 253 for j in range(60 * 50)])
+        )
+
+    def warp(bands):
+        return gdal.Warp(
+            "",
+            gdal.Translate("", src_ds, format="VRT", bandList=bands),
+            format="MEM",
+            outputBounds=[1.3, 2.1, 55.7, 47.9],
+            width=20,
+            height=17,
+            resampleAlg=resample_alg,
+            warpOptions=["UNIFIED_SRC_NODATA=NO"],
+        )
+
+    ds = warp([1, 2, 3])
+    for i in range(3):
+        assert (
+            ds.GetRasterBand(i + 1).Checksum()
+            == warp([i + 1]).GetRasterBand(1).Checksum()
+        )
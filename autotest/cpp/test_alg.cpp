@@ -37,6 +37,9 @@
 
 #include "gtest_include.h"
 
+#include <cmath>
+#include <vector>
+
 namespace
 {
     // Common fixture with test data
@@ -274,4 +277,202 @@ namespace
     }
 
 
+    // Create a synthetic DEM for viewshed tests
+    static GDALDatasetUniquePtr CreateViewshedDEM()
+    {
+        const int nXSize = 97;
+        const int nYSize = 83;
+        GDALDatasetUniquePtr poDS(
+            GDALDriver::FromHandle(
+                GDALGetDriverByName("MEM"))->Create("", nXSize, nYSize, 1, GDT_Float32, nullptr));
+        double adfGeoTransform[6] = { 1000, 10, 0, 5000, 0, -10 };
+        poDS->SetGeoTransform(adfGeoTransform);
+        std::vector<float> afDEM(nXSize * nYSize);
+        for( int j = 0; j < nYSize; j++ )
+        {
+            for( int i = 0; i < nXSize; i++ )
+            {
+                afDEM[j * nXSize + i] = static_cast<float>(
+                    100 + 30 * std::sin(i * 0.21) * std::cos(j * 0.17) +
+                    ((i * 7 + j * 13) % 11));
+            }
+        }
+        CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, 0, nXSize, nYSize, afDEM.data(), nXSize, nYSize,
+            GDT_Float32, 0, 0, nullptr));
+        return poDS;
+    }
+
+    static std::vector<double> ReadViewshed(GDALDatasetH hDS, int nBand = 1)
+    {
+        const int nXSize = GDALGetRasterXSize(hDS);
+        const int nYSize = GDALGetRasterYSize(hDS);
+        std::vector<double> adfVals(nXSize * nYSize);
+        CPL_IGNORE_RET_VAL(GDALRasterIO(GDALGetRasterBand(hDS, nBand), GF_Read,
+            0, 0, nXSize, nYSize, adfVals.data(), nXSize, nYSize, GDT_Float64, 0, 0));
+        return adfVals;
+    }
+
+    // Test that GDALViewshedGenerate() gives the same result with NUM_THREADS
+    TEST_F(test_alg, GDALViewshedGenerate_multithreaded)
+    {
+        auto poDEM = CreateViewshedDEM();
+        GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDEM->GetRasterBand(1));
+        const char* const apszThreads[] = { "NUM_THREADS=4", nullptr };
+        for( const auto eMode : { GVM_Diagonal, GVM_Edge, GVM_Max, GVM_Min } )
+        {
+            for( const auto eOutputType : { GVOT_NORMAL,
+                                            GVOT_MIN_TARGET_HEIGHT_FROM_DEM,
+                                            GVOT_MIN_TARGET_HEIGHT_FROM_GROUND } )
+            {
+                for( const double dfMaxDistance : { 0.0, 300.0 } )
+                {
+                    GDALDatasetH hRef = GDALViewshedGenerate(
+                        hBand, "MEM", "", nullptr, 1423, 4612, 10, 2,
+                        255, 0, 128, -1, 0.85714, eMode, dfMaxDistance,
+                        nullptr, nullptr, eOutputType, nullptr);
+                    ASSERT_TRUE(hRef != nullptr);
+                    GDALDatasetH hMT = GDALViewshedGenerate(
+                        hBand, "MEM", "", nullptr, 1423, 4612, 10, 2,
+                        255, 0, 128, -1, 0.85714, eMode, dfMaxDistance,
+                        nullptr, nullptr, eOutputType, apszThreads);
+                    ASSERT_TRUE(hMT != nullptr);
+                    EXPECT_EQ(GDALGetRasterXSize(hMT), GDALGetRasterXSize(hRef));
+                    EXPECT_EQ(GDALGetRasterYSize(hMT), GDALGetRasterYSize(hRef));
+                    EXPECT_EQ(ReadViewshed(hMT), ReadViewshed(hRef))
+                        << "mode " << eMode << ", output type " << eOutputType
+                        << ", max distance " << dfMaxDistance;
+                    GDALClose(hRef);
+                    GDALClose(hMT);
+                }
+            }
+        }
+    }
+
+    // Test GDALViewshedGenerateMulti()
+    TEST_F(test_alg, GDALViewshedGenerateMulti)
+    {
+        auto poDEM = CreateViewshedDEM();
+        GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDEM->GetRasterBand(1));
+        const double adfX[] = { 1423, 1105, 1901, 1550, 1002 };
+        const double adfY[] = { 4612, 4255, 4198, 4900, 4999 };
+        const double adfHeight[] = { 10, 25, 5, 40, 2 };
+        constexpr int nObservers = 5;
+
+        for( const char* pszThreads : { "NUM_THREADS=1", "NUM_THREADS=2",
+                                        "NUM_THREADS=8" } )
+        {
+            // Per observer masks are those of GDALViewshedGenerate()
+            const char* const apszPerObserver[] = { "OUTPUT=PER_OBSERVER",
+                                                    pszThreads, nullptr };
+            GDALDatasetH hPerObs = GDALViewshedGenerateMulti(
+                hBand, "MEM", "", nullptr, nObservers, adfX, adfY, adfHeight,
+                2, 255, 0, 0, -1, 0.85714, GVM_Edge, 0, nullptr, nullptr,
+                apszPerObserver);
+            ASSERT_TRUE(hPerObs != nullptr);
+            ASSERT_EQ(GDALGetRasterCount(hPerObs), nObservers);
+            std::vector<double> adfExpectedCount(
+                GDALGetRasterXSize(hPerObs) * GDALGetRasterYSize(hPerObs));
+            for( int i = 0; i < nObservers; i++ )
+            {
+                GDALDatasetH hRef = GDALViewshedGenerate(
+                    hBand, "MEM", "", nullptr, adfX[i], adfY[i], adfHeight[i], 2,
+                    255, 0, 0, -1, 0.85714, GVM_Edge, 0,
+                    nullptr, nullptr, GVOT_NORMAL, nullptr);
+                ASSERT_TRUE(hRef != nullptr);
+                const auto adfRef = ReadViewshed(hRef);
+                EXPECT_EQ(ReadViewshed(hPerObs, i + 1), adfRef)
+                    << pszThreads << ", observer " << i;
+                for( size_t j = 0; j < adfRef.size(); j++ )
+                {
+                    if( adfRef[j] == 255 )
+                        adfExpectedCount[j] += 1;
+                }
+                GDALClose(hRef);
+            }
+            GDALClose(hPerObs);
+
+            // Cumulative viewshed
+            const char* const apszCumulative[] = { pszThreads, nullptr };
+            GDALDatasetH hCount = GDALViewshedGenerateMulti(
+                hBand, "MEM", "", nullptr, nObservers, adfX, adfY, adfHeight,
+                2, 255, 0, 0, -1, 0.85714, GVM_Edge, 0, nullptr, nullptr,
+                apszCumulative);
+            ASSERT_TRUE(hCount != nullptr);
+            EXPECT_EQ(GDALGetRasterDataType(GDALGetRasterBand(hCount, 1)), GDT_UInt16);
+            EXPECT_EQ(ReadViewshed(hCount), adfExpectedCount) << pszThreads;
+            GDALClose(hCount);
+        }
+
+        // With a maximum distance, the output extent is the union of the
+        // observer areas
+        GDALDatasetH hCount = GDALViewshedGenerateMulti(
+            hBand, "MEM", "", nullptr, 2, adfX, adfY, adfHeight,
+            2, 255, 0, 0, -1, 0.85714, GVM_Edge, 100, nullptr, nullptr,
+            nullptr);
+        ASSERT_TRUE(hCount != nullptr);
+        EXPECT_LT(GDALGetRasterXSize(hCount), poDEM->GetRasterXSize());
+        EXPECT_LT(GDALGetRasterYSize(hCount), poDEM->GetRasterYSize());
+        GDALClose(hCount);
+
+        // Observer outside of the DEM
+        const double dfOutsideX = 0;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(GDALViewshedGenerateMulti(
+            hBand, "MEM", "", nullptr, 1, &dfOutsideX, adfY, adfHeight,
+            2, 255, 0, 0, -1, 0.85714, GVM_Edge, 0, nullptr, nullptr,
+            nullptr), nullptr);
+        CPLPopErrorHandler();
+    }
+
+    // Test GDALViewshedGenerateMulti() with a multi-threaded compressed
+    // GeoTIFF output, whose compression also uses the global thread pool
+    TEST_F(test_alg, GDALViewshedGenerateMulti_compressed_gtiff)
+    {
+        if( GDALGetDriverByName("GTiff") == nullptr )
+        {
+            GTEST_SKIP() << "GTiff driver missing";
+        }
+        auto poDEM = CreateViewshedDEM();
+        GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDEM->GetRasterBand(1));
+        const double adfX[] = { 1423, 1105, 1901, 1550, 1002, 1333, 1777, 1200 };
+        const double adfY[] = { 4612, 4255, 4198, 4900, 4999, 4400, 4700, 4300 };
+        const double adfHeight[] = { 10, 25, 5, 40, 2, 15, 8, 30 };
+        constexpr int nObservers = 8;
+        const char* const apszOptions[] = { "OUTPUT=PER_OBSERVER",
+                                            "NUM_THREADS=4", nullptr };
+
+        GDALDatasetH hRef = GDALViewshedGenerateMulti(
+            hBand, "MEM", "", nullptr, nObservers, adfX, adfY, adfHeight,
+            2, 255, 0, 0, -1, 0.85714, GVM_Edge, 0, nullptr, nullptr,
+            apszOptions);
+        ASSERT_TRUE(hRef != nullptr);
+
+        const char* const apszCreationOptions[] = {
+            "TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16",
+            "COMPRESS=DEFLATE", "NUM_THREADS=4", nullptr };
+        const char* pszFilename = "/vsimem/test_viewshed_multi_compressed.tif";
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+        GDALDatasetH hGTiff = GDALViewshedGenerateMulti(
+            hBand, "GTiff", pszFilename, apszCreationOptions,
+            nObservers, adfX, adfY, adfHeight,
+            2, 255, 0, 0, -1, 0.85714, GVM_Edge, 0, nullptr, nullptr,
+            apszOptions);
+        ASSERT_TRUE(hGTiff != nullptr);
+        GDALClose(hGTiff);
+
+        hGTiff = GDALOpen(pszFilename, GA_ReadOnly);
+        ASSERT_TRUE(hGTiff != nullptr);
+        ASSERT_EQ(GDALGetRasterCount(hGTiff), nObservers);
+        for( int i = 0; i < nObservers; i++ )
+        {
+            EXPECT_EQ(ReadViewshed(hGTiff, i + 1), ReadViewshed(hRef, i + 1))
+                << "observer " << i;
+        }
+        GDALClose(hGTiff);
+        GDALClose(hRef);
+        VSIUnlink(pszFilename);
+    }
+
+
 } // namespace
@@ -2253,6 +2253,122 @@ namespace
         EXPECT_EQ(nCountWithOneOpenOptions, 2);
     }
 
+    // Test statistics of the block cache shards
+    TEST_F(test_gdal, BlockCacheShardStatistics)
+    {
+        class TestRasterBand: public GDALRasterBand
+        {
+            protected:
+                CPLErr IReadBlock(int, int, void* pImage) override
+                {
+                    memset(pImage, 1, nBlockXSize * nBlockYSize);
+                    return CE_None;
+                }
+            public:
+                TestRasterBand()
+                {
+                    nBlockXSize = 16;
+                    nBlockYSize = 16;
+                    eDataType = GDT_Byte;
+                }
+        };
+
+        class TestDataset : public GDALDataset
+        {
+            public:
+                TestDataset()
+                {
+                    nRasterXSize = 256;
+                    nRasterYSize = 256;
+                    SetBand(1, new TestRasterBand());
+                }
+        };
+
+        struct Totals
+        {
+            GIntBig nUsed = 0;
+            GUIntBig nHits = 0;
+            GUIntBig nMisses = 0;
+            GUIntBig nEvictions = 0;
+        };
+        const auto GetTotals = []()
+        {
+            Totals sTotals;
+            const int nShards = GDALGetCacheShardCount();
+            for( int i = 0; i < nShards; ++i )
+            {
+                GIntBig nUsed = 0;
+                GUIntBig nHits = 0;
+                GUIntBig nMisses = 0;
+                GUIntBig nEvictions = 0;
+                EXPECT_TRUE(GDALGetCacheShardStatistics(
+                    i, &nUsed, &nHits, &nMisses, &nEvictions));
+                sTotals.nUsed += nUsed;
+                sTotals.nHits += nHits;
+                sTotals.nMisses += nMisses;
+                sTotals.nEvictions += nEvictions;
+            }
+            return sTotals;
+        };
+
+        const int nShards = GDALGetCacheShardCount();
+        EXPECT_GE(nShards, 1);
+        EXPECT_EQ(nShards & (nShards - 1), 0);
+        {
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            EXPECT_FALSE(GDALGetCacheShardStatistics(
+                nShards, nullptr, nullptr, nullptr, nullptr));
+        }
+
+        const GIntBig nOldCacheMax = GDALGetCacheMax64();
+        {
+            TestDataset oDS;
+            GDALRasterBand* poBand = oDS.GetRasterBand(1);
+            const auto sTotals0 = GetTotals();
+            EXPECT_EQ(sTotals0.nUsed, GDALGetCacheUsed64());
+
+            const auto ReadAllBlocks = [poBand]()
+            {
+                for( int iY = 0; iY < 16; ++iY )
+                {
+                    for( int iX = 0; iX < 16; ++iX )
+                    {
+                        GDALRasterBlock* poBlock =
+                            poBand->GetLockedBlockRef(iX, iY);
+                        ASSERT_TRUE(poBlock != nullptr);
+                        poBlock->DropLock();
+                    }
+                }
+            };
+
+            ReadAllBlocks();
+            const auto sTotals1 = GetTotals();
+            EXPECT_EQ(sTotals1.nMisses - sTotals0.nMisses, 256U);
+            EXPECT_EQ(sTotals1.nHits, sTotals0.nHits);
+            EXPECT_GT(sTotals1.nUsed, sTotals0.nUsed);
+            EXPECT_EQ(sTotals1.nUsed, GDALGetCacheUsed64());
+
+            ReadAllBlocks();
+            const auto sTotals2 = GetTotals();
+            EXPECT_EQ(sTotals2.nMisses, sTotals1.nMisses);
+            EXPECT_EQ(sTotals2.nHits - sTotals1.nHits, 256U);
+            EXPECT_EQ(sTotals2.nUsed, sTotals1.nUsed);
+
+            // Shrink the cache so that half of the blocks are evicted.
+            const GIntBig nBlocksUsed = sTotals2.nUsed - sTotals0.nUsed;
+            GDALSetCacheMax64(GDALGetCacheUsed64() - nBlocksUsed / 2);
+            const auto sTotals3 = GetTotals();
+            if( sTotals0.nUsed == 0 )
+                EXPECT_EQ(sTotals3.nEvictions - sTotals2.nEvictions, 128U);
+            else
+                EXPECT_GT(sTotals3.nEvictions, sTotals2.nEvictions);
+            EXPECT_EQ(sTotals3.nUsed, GDALGetCacheUsed64());
+            EXPECT_LE(GDALGetCacheUsed64(), GDALGetCacheMax64());
+        }
+        GDALSetCacheMax64(nOldCacheMax);
+        EXPECT_EQ(GetTotals().nUsed, GDALGetCacheUsed64());
+    }
+
     // Test GDALDeinterleave 3 components Byte()
     TEST_F(test_gdal, GDALDeinterleave3ComponentsByte)
     {
@@ -34,6 +34,10 @@
 #include "marching_squares/level_generator.h"
 #include "marching_squares/segment_merger.h"
 #include "marching_squares/contour_generator.h"
+#include "marching_squares/tile_stitcher.h"
+
+#include <algorithm>
+#include <random>
 
 #include "gtest_include.h"
 
@@ -140,6 +144,53 @@ private:
         o << "}, ";
     }
 };
+
+// Collects lines in a canonical form (orientation and, for rings, starting
+// point normalized) so that the output of different generation strategies
+// can be compared exactly.
+class CanonicalLineCollector
+{
+public:
+    typedef std::vector<std::pair<double, double>> Points;
+
+    void addLine( double level, LineString& ls, bool /* closed */ )
+    {
+        Points v;
+        for ( const auto& pt : ls ) {
+            v.push_back( std::make_pair( pt.x, pt.y ) );
+        }
+        const bool closed = v.size() > 1 && v.front() == v.back();
+        if ( closed ) {
+            v.pop_back();
+            std::rotate( v.begin(), std::min_element( v.begin(), v.end() ), v.end() );
+            Points rev( v.rbegin(), v.rend() );
+            std::rotate( rev.begin(), std::min_element( rev.begin(), rev.end() ), rev.end() );
+            if ( rev < v ) {
+                v = rev;
+            }
+            v.push_back( v.front() );
+        }
+        else {
+            Points rev( v.rbegin(), v.rend() );
+            if ( rev < v ) {
+                v = rev;
+            }
+        }
+        lines_[level].push_back( v );
+    }
+
+    std::map<double, std::vector<Points>> sorted() const
+    {
+        auto ret = lines_;
+        for ( auto& l : ret ) {
+            std::sort( l.second.begin(), l.second.end() );
+        }
+        return ret;
+    }
+
+private:
+    std::map<double, std::vector<Points>> lines_;
+};
 }
 
 namespace
@@ -389,6 +440,57 @@ namespace
             EXPECT_TRUE(w.hasRing( 18.0, { {0.9,1.5}, {0.5,1.1}, {0,1.1}, {0,1.5}, {0,2}, {0.5,2}, {0.9,2} } ) );
         }
     }
-}
 
+    TEST_F(test_ms_contour, tiles_stitching)
+    {
+        // Generating contours tile by tile and stitching them along the
+        // seams must give the same result as a single pass over the raster
+        std::mt19937 rng( 42 );
+        for ( int iter = 0; iter < 500; iter++ )
+        {
+            const size_t width = 1 + rng() % 12;
+            const size_t height = 2 + rng() % 15;
+            const bool polygonize = ( rng() % 2 ) == 0;
+            const bool hasNoData = ( rng() % 3 ) == 0;
+            const double noData = -9999.0;
+            std::vector<double> data( width * height );
+            for ( auto& v : data ) {
+                v = ( hasNoData && ( rng() % 4 ) == 0 ) ? noData : static_cast<double>( rng() % 100 ) / 3.0;
+            }
+            IntervalLevelRangeIterator levels( 0.0, 5.0 + rng() % 10 );
 
+            CanonicalLineCollector serial;
+            {
+                SegmentMerger<CanonicalLineCollector, IntervalLevelRangeIterator> writer( serial, levels, polygonize );
+                ContourGenerator<decltype(writer), IntervalLevelRangeIterator> cg( width, height, hasNoData, noData, writer, levels );
+                for ( size_t y = 0; y < height; y++ ) {
+                    cg.feedLine( &data[y * width] );
+                }
+            }
+
+            CanonicalLineCollector tiled;
+            {
+                TileStitcher<CanonicalLineCollector> stitcher( tiled );
+                size_t firstLine = 0;
+                while ( firstLine < height )
+                {
+                    const size_t nLines = std::min( height - firstLine, static_cast<size_t>( 1 + rng() % 4 ) );
+                    TileLineCollector tileLines;
+                    {
+                        SegmentMerger<TileLineCollector, IntervalLevelRangeIterator> writer( tileLines, levels, polygonize, /* tile */ true );
+                        ContourGenerator<decltype(writer), IntervalLevelRangeIterator> cg( width, height, hasNoData, noData, writer, levels );
+                        cg.seekLine( firstLine, firstLine ? &data[(firstLine - 1) * width] : nullptr );
+                        for ( size_t y = firstLine; y < firstLine + nLines; y++ ) {
+                            cg.feedLine( &data[y * width] );
+                        }
+                    }
+                    firstLine += nLines;
+                    stitcher.addTile( std::move( tileLines.lines ),
+                                      firstLine == height ? NaN : firstLine - 0.5 );
+                }
+            }
+
+            EXPECT_TRUE( serial.sorted() == tiled.sorted() ) << "iteration " << iter;
+        }
+    }
+}
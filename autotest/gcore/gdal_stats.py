@@ -905,3 +905,68 @@ def test_stats_computeminmax(datatype, minval, maxval, nodata):
         buf_ysize=1,
     )
     assert ds.GetRasterBand(1).ComputeRasterMinMax(0) == (expected_minval, maxval)
+
+
+###############################################################################
+# Test that processing blocks in several threads gives the same results as in
+# a single one
+
+
+@pytest.mark.parametrize(
+    "datatype",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_UInt16,
+        gdal.GDT_Int16,
+        gdal.GDT_Int32,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+)
+@pytest.mark.parametrize("nodata", [None, 7])
+def test_stats_multithreaded(datatype, nodata):
+
+    xsize = 1000
+    ysize = 1100
+    ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, datatype)
+    band = ds.GetRasterBand(1)
+    is_float = datatype in (gdal.GDT_Float32, gdal.GDT_Float64)
+    offset = -100 if datatype in (gdal.GDT_Int16, gdal.GDT_Int32) or is_float else 0
+    for y in range(ysize):
+        values = [(x * 7 + y * 13) % 251 + offset for x in range(xsize)]
+        if is_float:
+            values = [v + 0.25 for v in values]
+            values[y % xsize] = float("nan")
+        band.WriteRaster(
+            0,
+            y,
+            xsize,
+            1,
+            struct.pack("d" * xsize, *values),
+            buf_type=gdal.GDT_Float64,
+        )
+    if nodata is not None:
+        band.SetNoDataValue(nodata)
+
+    def compute():
+        res = []
+        for approx_ok in (False, True):
+            res.append(band.ComputeStatistics(approx_ok))
+            res.append(band.GetMetadataItem("STATISTICS_VALID_PERCENT"))
+            res.append(band.ComputeRasterMinMax(approx_ok))
+            res.append(
+                band.GetHistogram(
+                    -100.5, 250.5, 351, include_out_of_range=0, approx_ok=approx_ok
+                )
+            )
+        return res
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        res_single_thread = compute()
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        res_multi_thread = compute()
+
+    assert res_multi_thread == res_single_thread
+    stats = res_single_thread[0]
+    assert stats[0] == offset + (0.25 if is_float else 0)
+    assert stats[1] == 250 + offset + (0.25 if is_float else 0)
@@ -1271,6 +1271,106 @@ def test_pixfun_scale():
     assert numpy.allclose(data_src * 2 + 1, data_vrt)
 
 
+###############################################################################
+# Verify the expression pixel function
+
+
+def test_pixfun_expression():
+    vrt_ds = gdal.Open(
+        """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="B1 &gt; 150 ? (B1 - B2) / (B1 + B2) : max(B1, B2) ^ 2 - abs(B2) % 7"/>
+    <SourceTransferType>Float64</SourceTransferType>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/int32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/float32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    )
+    data = vrt_ds.GetRasterBand(1).ReadAsArray()
+
+    b1 = gdal.Open("data/int32.tif").GetRasterBand(1).ReadAsArray()
+    b1 = b1.astype(numpy.float64)
+    b2 = gdal.Open("data/float32.tif").GetRasterBand(1).ReadAsArray()
+    b2 = b2.astype(numpy.float64)
+    expected = numpy.where(
+        b1 > 150,
+        (b1 - b2) / (b1 + b2),
+        numpy.maximum(b1, b2) ** 2 - numpy.fmod(numpy.abs(b2), 7),
+    )
+    assert numpy.allclose(data, expected)
+
+
+@pytest.mark.parametrize(
+    "expression,error",
+    [
+        ("B1 +", "unexpected end of expression"),
+        ("B3", "B3 referenced, but only 2 source(s) defined"),
+        ("foo(B1)", "unknown identifier"),
+        ("min(B1)", "',' expected"),
+    ],
+)
+def test_pixfun_expression_errors(expression, error):
+    vrt_ds = gdal.Open(
+        """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="%s"/>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/int32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/float32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+        % expression
+    )
+    with gdaltest.error_handler():
+        assert vrt_ds.GetRasterBand(1).ReadAsArray() is None
+    assert error in gdal.GetLastErrorMsg()
+
+
+@pytest.mark.parametrize(
+    "expression",
+    [
+        "(" * 10000 + "B1" + ")" * 10000,
+        "-" * 10000 + "B1",
+        "B1 ? B2 : " * 10000 + "B1",
+    ],
+    ids=["parentheses", "unary", "conditional"],
+)
+def test_pixfun_expression_too_deeply_nested(expression):
+    vrt_ds = gdal.Open(
+        """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="%s"/>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/int32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/float32.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+        % expression
+    )
+    with gdaltest.error_handler():
+        assert vrt_ds.GetRasterBand(1).ReadAsArray() is None
+    assert "expression too deeply nested" in gdal.GetLastErrorMsg()
+
+
 def test_pixfun_missing_builtin():
     vrt_ds = gdal.Open(
         """<VRTDataset rasterXSize="20" rasterYSize="20">
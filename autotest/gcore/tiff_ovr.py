@@ -2753,6 +2753,50 @@ def test_tiff_ovr_internal_overview_different_planar_config_to_band():
     gdal.GetDriverByName("GTiff").Delete(temp_path)
 
 
+###############################################################################
+# Test that computing overview levels from the in-memory result of the
+# previous level gives the same result as reading it back
+
+
+@pytest.mark.parametrize("external", [False, True])
+@pytest.mark.parametrize("resampling", ["AVERAGE", "CUBIC", "NEAREST"])
+def test_tiff_ovr_cascade(external, resampling):
+
+    src_ds = gdal.Translate("", "data/byte.tif", format="MEM", width=1000, height=700)
+
+    def build_overviews(cascade):
+        temp_path = "/vsimem/test_tiff_ovr_cascade.tif"
+        ds = gdal.GetDriverByName("GTiff").Create(
+            temp_path,
+            1000,
+            700,
+            3,
+            options=["COMPRESS=DEFLATE", "TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64"],
+        )
+        for i in range(3):
+            ds.GetRasterBand(i + 1).WriteRaster(
+                0, 0, 1000, 700, src_ds.GetRasterBand(1).ReadRaster()
+            )
+        del ds
+        ds = gdal.Open(temp_path, gdal.GA_ReadOnly if external else gdal.GA_Update)
+        with gdaltest.config_options(
+            {"GDAL_OVR_CASCADE": cascade, "COMPRESS_OVERVIEW": "DEFLATE"}
+        ):
+            assert ds.BuildOverviews(resampling, [2, 4, 8, 16]) == 0
+        del ds
+        ds = gdal.Open(temp_path)
+        cs = [
+            ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+            for i in range(3)
+            for j in range(4)
+        ]
+        del ds
+        gdal.GetDriverByName("GTiff").Delete(temp_path)
+        return cs
+
+    assert build_overviews("YES") == build_overviews("NO")
+
+
 ###############################################################################
 # Cleanup
 
@@ -4844,6 +4844,81 @@ def test_tiff_read_multi_threaded(
     gdal.Unlink(tmpfile)
 
 
+###############################################################################
+# Test speculative multi-threaded decoding of the next blocks when reading
+# block by block
+
+
+@pytest.mark.parametrize("threads_from_config_option", [False, True])
+@pytest.mark.parametrize(
+    "creation_options",
+    [
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "INTERLEAVE=BAND"],
+        ["BLOCKYSIZE=8"],
+    ],
+)
+@pytest.mark.parametrize("method", ["DEFLATE", "ZSTD", "LZW", "LERC", "JPEG", "WEBP"])
+def test_tiff_read_multi_threaded_prefetch(
+    method, creation_options, threads_from_config_option
+):
+
+    if method not in gdal.GetDriverByName("GTiff").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip(f"Compression method {method} not supported in this build")
+
+    ref_ds = gdal.GetDriverByName("MEM").Create("", 100, 90, 3)
+    for band in range(ref_ds.RasterCount):
+        buf = b""
+        for j in range(ref_ds.RasterYSize):
+            buf += array.array(
+                "B", [band * 10 + j + i for i in range(ref_ds.RasterXSize)]
+            )
+        ref_ds.GetRasterBand(band + 1).WriteRaster(
+            0, 0, ref_ds.RasterXSize, ref_ds.RasterYSize, buf
+        )
+
+    tmpfile = "tmp/test_tiff_read_multi_threaded_prefetch.tif"
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        tmpfile, ref_ds, options=["COMPRESS=" + method] + creation_options
+    )
+
+    def read_block_by_block(ds):
+        blockxsize, blockysize = ds.GetRasterBand(1).GetBlockSize()
+        ret = []
+        for i in range(ds.RasterCount):
+            band = ds.GetRasterBand(i + 1)
+            for y in range(0, ds.RasterYSize, blockysize):
+                for x in range(0, ds.RasterXSize, blockxsize):
+                    ret.append(
+                        band.ReadRaster(
+                            x,
+                            y,
+                            min(blockxsize, ds.RasterXSize - x),
+                            min(blockysize, ds.RasterYSize - y),
+                        )
+                    )
+        return ret
+
+    ds = gdal.Open(tmpfile)
+    expected = read_block_by_block(ds)
+    ds = None
+
+    if threads_from_config_option:
+        with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+            ds = gdal.Open(tmpfile)
+            got = read_block_by_block(ds)
+    else:
+        ds = gdal.OpenEx(tmpfile, open_options=["NUM_THREADS=4"])
+        got = read_block_by_block(ds)
+    ds = None
+
+    gdal.Unlink(tmpfile)
+
+    assert got == expected
+
+
 ###############################################################################
 # Test multi-threaded decoding with /vsicurl
 
@@ -32,6 +32,7 @@
 
 
 import math
+import os
 
 import gdaltest
 import pytest
@@ -1081,3 +1082,30 @@ def test_transformer_dem_overrride_srs():
     ), "got wrong reverse transform result."
 
     gdal.Unlink("/vsimem/dem.tif")
+
+
+###############################################################################
+# Test the cache of the approximate transformer
+
+
+def test_transformer_approx_grid_cache(tmp_path):
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+
+    def warp():
+        ds = gdal.Warp(
+            "", src_ds, format="MEM", dstSRS="EPSG:4326", resampleAlg="bilinear"
+        )
+        return ds.GetRasterBand(1).Checksum()
+
+    ref_cs = warp()
+
+    with gdaltest.config_option("GDAL_TRANSFORMER_GRID_CACHE", "YES"):
+        assert warp() == ref_cs
+        assert warp() == ref_cs
+
+    with gdaltest.config_option("GDAL_TRANSFORMER_GRID_CACHE_DIR", str(tmp_path)):
+        assert warp() == ref_cs
+        assert warp() == ref_cs
+
+    assert [f for f in os.listdir(tmp_path) if f.endswith(".gtgc")]
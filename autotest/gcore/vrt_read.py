@@ -2105,3 +2105,180 @@ def test_vrt_read_compute_statistics_mosaic_optimization_not_triggered():
 
     vrt_stats = vrt_ds.GetRasterBand(1).ComputeStatistics(False)
     assert vrt_stats == src_ds.GetRasterBand(1).ComputeStatistics(False)
+
+
+###############################################################################
+# Test multi-threaded reading of overlapping sources
+
+
+@pytest.mark.parametrize("src_nodata", [None, 107])
+def test_vrt_read_multithreaded_overlapping_sources(src_nodata):
+
+    src_ds = gdal.Translate("", gdal.Open("data/byte.tif"), format="MEM")
+    src_ds1 = gdal.Translate("", src_ds, options="-of MEM -srcwin 0 0 12 20")
+    src_ds2 = gdal.Translate("", src_ds, options="-of MEM -srcwin 5 3 10 10")
+    src_ds3 = gdal.Translate("", src_ds, options="-of MEM -srcwin 8 0 12 20")
+    src_ds4 = gdal.Translate("", src_ds, options="-of MEM -srcwin 2 2 3 3")
+    # Use constant values so that the order of the sources matters
+    src_ds2.GetRasterBand(1).Fill(1)
+    src_ds4.GetRasterBand(1).Fill(2)
+    vrt_ds = gdal.BuildVRT(
+        "", [src_ds1, src_ds2, src_ds3, src_ds4], srcNodata=src_nodata
+    )
+
+    def read():
+        return (
+            vrt_ds.ReadRaster(),
+            vrt_ds.ReadRaster(1, 2, 17, 15),
+            vrt_ds.ReadRaster(buf_xsize=7, buf_ysize=9),
+            vrt_ds.ReadRaster(
+                buf_xsize=7, buf_ysize=9, resample_alg=gdal.GRIORA_Bilinear
+            ),
+            vrt_ds.ReadRaster(buf_type=gdal.GDT_Float64, buf_pixel_space=16),
+        )
+
+    expected = read()
+    with gdaltest.config_options({"GDAL_NUM_THREADS": "4"}):
+        assert read() == expected
+
+
+###############################################################################
+# Test multi-threaded reading of sources that are compressed tiled GeoTIFF
+# files, which use the global thread pool themselves when GDAL_NUM_THREADS is
+# set.
+
+
+def test_vrt_read_multithreaded_gtiff_sources():
+
+    src_ds = gdal.Translate("", gdal.Open("data/byte.tif"), format="MEM")
+    filenames = []
+    for y in range(2):
+        for x in range(4):
+            filename = "/vsimem/test_vrt_read_multithreaded_gtiff_sources_%d_%d.tif" % (
+                x,
+                y,
+            )
+            gdal.Translate(
+                filename,
+                src_ds,
+                options="-srcwin %d %d 5 10 -outsize 80 160 -co TILED=YES "
+                "-co BLOCKXSIZE=16 -co BLOCKYSIZE=16 -co COMPRESS=DEFLATE"
+                % (x * 5, y * 10),
+            )
+            filenames.append(filename)
+
+    try:
+        with gdaltest.config_options({"GDAL_NUM_THREADS": "4"}):
+            vrt_ds = gdal.BuildVRT("", filenames)
+            assert vrt_ds.RasterXSize == 320
+            assert vrt_ds.RasterYSize == 320
+            got = vrt_ds.ReadRaster()
+            got_band = vrt_ds.GetRasterBand(1).ReadRaster(8, 8, 300, 300)
+        vrt_ds = None
+
+        vrt_ds = gdal.BuildVRT("", filenames)
+        assert got == vrt_ds.ReadRaster()
+        assert got_band == vrt_ds.GetRasterBand(1).ReadRaster(8, 8, 300, 300)
+        vrt_ds = None
+    finally:
+        for filename in filenames:
+            gdal.Unlink(filename)
+
+
+###############################################################################
+# Test reading a mosaic with enough sources for the spatial index of sources
+# to be used
+
+
+def test_vrt_read_many_sources():
+
+    src_ds = gdal.Translate("", gdal.Open("data/byte.tif"), format="MEM")
+    tiles = []
+    for y in range(0, 20, 2):
+        for x in range(0, 20, 2):
+            if x == 4 and y == 6:
+                continue  # leave a hole
+            tiles.append(
+                gdal.Translate("", src_ds, options="-of MEM -srcwin %d %d 2 2" % (x, y))
+            )
+    vrt_ds = gdal.BuildVRT("", tiles)
+    assert vrt_ds.GetRasterBand(1).Checksum() != 0
+
+    expected_ds = gdal.Translate("", src_ds, format="MEM")
+    expected_ds.GetRasterBand(1).WriteRaster(4, 6, 2, 2, b"\0" * 4)
+    for xoff, yoff, xsize, ysize in [
+        (0, 0, 20, 20),
+        (3, 5, 4, 4),
+        (11, 13, 1, 1),
+        (19, 19, 1, 1),
+    ]:
+        assert vrt_ds.ReadRaster(xoff, yoff, xsize, ysize) == expected_ds.ReadRaster(
+            xoff, yoff, xsize, ysize
+        )
+        assert vrt_ds.GetRasterBand(1).ReadRaster(
+            xoff, yoff, xsize, ysize
+        ) == expected_ds.GetRasterBand(1).ReadRaster(xoff, yoff, xsize, ysize)
+    assert vrt_ds.ReadRaster(buf_xsize=7, buf_ysize=9) == expected_ds.ReadRaster(
+        buf_xsize=7, buf_ysize=9
+    )
+
+    # Adding a source after a read must be taken into account
+    fill_ds = gdal.GetDriverByName("GTiff").Create(
+        "/vsimem/test_vrt_read_many_sources.tif", 2, 2
+    )
+    fill_ds.GetRasterBand(1).Fill(255)
+    fill_ds = None
+    vrt_ds.GetRasterBand(1).SetMetadataItem(
+        "source_0",
+        """<SimpleSource>
+              <SourceFilename>/vsimem/test_vrt_read_many_sources.tif</SourceFilename>
+              <SourceBand>1</SourceBand>
+              <SrcRect xOff="0" yOff="0" xSize="2" ySize="2"/>
+              <DstRect xOff="4" yOff="6" xSize="2" ySize="2"/>
+            </SimpleSource>""",
+        "new_vrt_sources",
+    )
+    assert vrt_ds.GetRasterBand(1).ReadRaster(4, 6, 2, 2) == b"\xff" * 4
+    vrt_ds = None
+    gdal.Unlink("/vsimem/test_vrt_read_many_sources.tif")
+
+
+###############################################################################
+# Test VRT_XML_CACHE_SIZE
+
+
+def test_vrt_read_xml_cache():
+
+    filename = "/vsimem/test_vrt_read_xml_cache.vrt"
+    vrt_template = """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Byte" band="1">
+    <SimpleSource>
+      <SourceFilename>%s</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="20" />
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+
+    try:
+        with gdaltest.config_option("VRT_XML_CACHE_SIZE", "1"):
+            gdal.FileFromMemBuffer(
+                filename, vrt_template % os.path.join(os.getcwd(), "data/byte.tif")
+            )
+            for _ in range(2):
+                ds = gdal.Open(filename)
+                assert ds.GetRasterBand(1).Checksum() == 4672
+                ds = None
+
+            # Modifying the file must invalidate the cached XML
+            gdal.FileFromMemBuffer(
+                filename,
+                vrt_template % os.path.join(os.getcwd(), "data/uint16.tif"),
+            )
+            ds = gdal.Open(filename)
+            assert ds.GetRasterBand(1).Checksum() == 4672
+            assert ds.GetFileList()[1].endswith("uint16.tif")
+            ds = None
+    finally:
+        gdal.Unlink(filename)
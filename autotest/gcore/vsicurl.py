@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import threading
 import time
 
 import gdaltest
@@ -1093,6 +1094,261 @@ def test_vsicurl_GDAL_HTTP_HEADERS():
     assert statres.size == 3
 
 
+###############################################################################
+# Helpers for the VSIVirtualHandle::AdviseRead() tests, which use GTiff
+# AdviseRead() to advise the reading of the blocks of a window.
+
+ADVISE_READ_CHUNK_SIZE = 16384
+
+
+def _vsicurl_advise_read_create_file():
+
+    filename = "/vsimem/test_vsicurl_advise_read.tif"
+    src_ds = gdal.GetDriverByName("MEM").Create("", 256, 256)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 256, 256, bytes([(i * 7 + i // 256) % 251 for i in range(256 * 256)])
+    )
+    # Put the IFD at the beginning of the file, so that opening it only
+    # needs the first chunk
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename,
+        src_ds,
+        options=[
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+            "COPY_SRC_OVERVIEWS=YES",
+        ],
+    )
+    f = gdal.VSIFOpenL(filename, "rb")
+    data = gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+    gdal.VSIFCloseL(f)
+    return filename, data
+
+
+def _vsicurl_advise_read_block_offset(ds, x, y):
+    return int(
+        ds.GetRasterBand(1).GetMetadataItem("BLOCK_OFFSET_%d_%d" % (x, y), "TIFF")
+    )
+
+
+def _vsicurl_advise_read_block_in_chunk(ds, chunk):
+    """Return the coordinates of a block entirely in the given chunk"""
+    for y in range(16):
+        for x in range(16):
+            offset = _vsicurl_advise_read_block_offset(ds, x, y)
+            if (offset - 4) // ADVISE_READ_CHUNK_SIZE == chunk and (
+                offset + 256 + 4
+            ) // ADVISE_READ_CHUNK_SIZE == chunk:
+                return x, y
+    return None
+
+
+def _vsicurl_advise_read_serve_range(data, ranges, max_size=None):
+    def method(request):
+        ranges.append(request.headers["Range"])
+        start, end = [
+            int(x) for x in request.headers["Range"][len("bytes=") :].split("-")
+        ]
+        end = min(end, len(data) - 1)
+        if max_size:
+            end = min(end, start + max_size - 1)
+        request.protocol_version = "HTTP/1.1"
+        request.send_response(206)
+        request.send_header("Content-Range", "bytes %d-%d/%d" % (start, end, len(data)))
+        request.send_header("Content-Length", end - start + 1)
+        request.send_header("Connection", "close")
+        request.end_headers()
+        request.wfile.write(data[start : end + 1])
+
+    return method
+
+
+def _vsicurl_advise_read_open(path, data):
+
+    handler = webserver.SequentialHandler()
+    handler.add("HEAD", path, 200, {"Content-Length": "%d" % len(data)})
+    ranges = []
+    handler.add(
+        "GET", path, custom_method=_vsicurl_advise_read_serve_range(data, ranges)
+    )
+    with webserver.install_http_handler(handler), gdaltest.config_option(
+        "GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR"
+    ):
+        ds = gdal.Open(
+            "/vsicurl/http://localhost:%d%s" % (gdaltest.webserver_port, path)
+        )
+    assert ds
+    assert ranges == ["bytes=0-%d" % (ADVISE_READ_CHUNK_SIZE - 1)]
+    return ds
+
+
+###############################################################################
+# Test that the advised ranges are downloaded by a single request, and that
+# reading them afterwards does not issue any other request
+
+
+def test_vsicurl_advise_read():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    filename, data = _vsicurl_advise_read_create_file()
+    try:
+        ref_ds = gdal.Open(filename)
+        # The blocks of the bottom half of the raster are after the first chunk
+        first_chunk = (
+            _vsicurl_advise_read_block_offset(ref_ds, 0, 8) // ADVISE_READ_CHUNK_SIZE
+        )
+        assert first_chunk >= 1
+
+        path = "/test_vsicurl_advise_read.tif"
+        ds = _vsicurl_advise_read_open(path, data)
+
+        handler = webserver.SequentialHandler()
+        ranges = []
+        handler.add(
+            "GET", path, custom_method=_vsicurl_advise_read_serve_range(data, ranges)
+        )
+        with webserver.install_http_handler(handler):
+            assert ds.AdviseRead(0, 128, 256, 128, band_list=[1]) == gdal.CE_None
+            got = ds.ReadRaster(0, 128, 256, 128)
+        assert ranges == [
+            "bytes=%d-%d" % (first_chunk * ADVISE_READ_CHUNK_SIZE, len(data) - 1)
+        ]
+        assert got == ref_ds.ReadRaster(0, 128, 256, 128)
+
+        # Advising again ranges that are already cached does not issue any
+        # request
+        handler = webserver.SequentialHandler()
+        with webserver.install_http_handler(handler):
+            assert ds.AdviseRead(0, 128, 256, 128, band_list=[1]) == gdal.CE_None
+            got = ds.ReadRaster(0, 128, 256, 128)
+        assert got == ref_ds.ReadRaster(0, 128, 256, 128)
+
+        ds = None
+    finally:
+        gdal.VSICurlClearCache()
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that the chunks not received by a failed or short response to the
+# advised request are downloaded again when read
+
+
+@pytest.mark.parametrize("response", ["error", "short"])
+def test_vsicurl_advise_read_failed_request(response):
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    filename, data = _vsicurl_advise_read_create_file()
+    try:
+        ref_ds = gdal.Open(filename)
+        first_chunk = (
+            _vsicurl_advise_read_block_offset(ref_ds, 0, 8) // ADVISE_READ_CHUNK_SIZE
+        )
+        last_chunk = (len(data) - 1) // ADVISE_READ_CHUNK_SIZE
+        assert first_chunk >= 1
+        assert last_chunk > first_chunk
+        last_block = _vsicurl_advise_read_block_in_chunk(ref_ds, last_chunk)
+        assert last_block
+
+        path = "/test_vsicurl_advise_read_failed_request.tif"
+        ds = _vsicurl_advise_read_open(path, data)
+
+        handler = webserver.SequentialHandler()
+        ranges = []
+        if response == "error":
+            handler.add("GET", path, 500)
+        else:
+            # Only the first advised chunk, and a few bytes of the second
+            # one, are received
+            handler.add(
+                "GET",
+                path,
+                custom_method=_vsicurl_advise_read_serve_range(
+                    data, ranges, max_size=ADVISE_READ_CHUNK_SIZE + 100
+                ),
+            )
+        handler.add(
+            "GET", path, custom_method=_vsicurl_advise_read_serve_range(data, ranges)
+        )
+        with webserver.install_http_handler(handler):
+            assert ds.AdviseRead(0, 128, 256, 128, band_list=[1]) == gdal.CE_None
+            if response == "short":
+                first_block = _vsicurl_advise_read_block_in_chunk(ref_ds, first_chunk)
+                if first_block:
+                    x, y = first_block
+                    assert ds.GetRasterBand(1).ReadRaster(
+                        x * 16, y * 16, 16, 16
+                    ) == ref_ds.GetRasterBand(1).ReadRaster(x * 16, y * 16, 16, 16)
+            x, y = last_block
+            got = ds.GetRasterBand(1).ReadRaster(x * 16, y * 16, 16, 16)
+        assert got == ref_ds.GetRasterBand(1).ReadRaster(x * 16, y * 16, 16, 16)
+        assert ranges[-1].startswith(
+            "bytes=%d-" % (last_chunk * ADVISE_READ_CHUNK_SIZE)
+        )
+
+        ds = None
+    finally:
+        gdal.VSICurlClearCache()
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test closing the file while the advised ranges are being downloaded
+
+
+def test_vsicurl_advise_read_close_during_download():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    filename, data = _vsicurl_advise_read_create_file()
+    try:
+        path = "/test_vsicurl_advise_read_close_during_download.tif"
+        ds = _vsicurl_advise_read_open(path, data)
+
+        request_received = threading.Event()
+        file_closed = threading.Event()
+
+        def method(request):
+            request_received.set()
+            # Do not answer before the file is closed
+            file_closed.wait(10)
+            try:
+                request.send_response(500)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+            except Exception:
+                pass
+
+        handler = webserver.SequentialHandler()
+        handler.add("GET", path, custom_method=method)
+        with webserver.install_http_handler(handler):
+            try:
+                assert ds.AdviseRead(0, 128, 256, 128, band_list=[1]) == gdal.CE_None
+                assert request_received.wait(10)
+                start = time.time()
+                ds = None
+                elapsed = time.time() - start
+            finally:
+                file_closed.set()
+        # Closing must not wait for the response
+        assert elapsed < 5
+    finally:
+        gdal.VSICurlClearCache()
+        gdal.Unlink(filename)
+
+
 ###############################################################################
 
 
@@ -28,6 +28,7 @@
 ###############################################################################
 
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -588,3 +589,136 @@ def test_ogr_join_23():
     ds.ReleaseResultSet(sql_lyr)
 
     ds = None
+
+
+###############################################################################
+# Test that the hash based join strategies give the same results as the
+# attribute filter based one
+
+
+@pytest.mark.parametrize(
+    "config_options",
+    [
+        {"OGR_SQL_JOIN_STRATEGY": "HASH"},
+        {"OGR_SQL_JOIN_STRATEGY": "AUTO"},
+        # only FIDs of the secondary layer fit in memory
+        {"OGR_SQL_JOIN_STRATEGY": "HASH", "OGR_SQL_JOIN_MAX_MEMORY": "0.002"},
+        # nothing fits in memory: fallback to attribute filter
+        {"OGR_SQL_JOIN_STRATEGY": "HASH", "OGR_SQL_JOIN_MAX_MEMORY": "0"},
+    ],
+)
+@pytest.mark.parametrize(
+    "on_clause",
+    [
+        "first.int_key = second.int_key",
+        "second.int_key = first.int_key",
+        "first.int_key = second.real_key",
+        "first.str_key = second.str_key",
+    ],
+)
+def test_ogr_join_24(config_options, on_clause):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("first")
+    lyr.CreateField(ogr.FieldDefn("int_key", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("str_key", ogr.OFTString))
+    for i in range(50):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i % 7 != 0:
+            f["int_key"] = i % 23
+            f["str_key"] = "key%d" % (i % 23)
+        lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("second")
+    lyr.CreateField(ogr.FieldDefn("int_key", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("real_key", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str_key", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTString))
+    for i in range(40):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i % 11 != 0:
+            # duplicated keys: only the first matching feature is joined
+            f["int_key"] = i % 17
+            f["real_key"] = i % 17
+            f["str_key"] = ("KEY%d" if i % 2 else "key%d") % (i % 17)
+        f["val"] = "val%d" % i
+        lyr.CreateFeature(f)
+
+    sql = "SELECT first.*, second.val FROM first LEFT JOIN second ON " + on_clause
+
+    def get_values():
+        sql_lyr = ds.ExecuteSQL(sql)
+        ret = [(f.GetFID(), f["int_key"], f["str_key"], f["val"]) for f in sql_lyr]
+        ds.ReleaseResultSet(sql_lyr)
+        return ret
+
+    with gdaltest.config_option("OGR_SQL_JOIN_STRATEGY", "NESTED_LOOP"):
+        expected = get_values()
+    assert len([x for x in expected if x[3] is not None]) > 0
+
+    with gdaltest.config_options(config_options):
+        got = get_values()
+    assert got == expected
+
+
+###############################################################################
+# Test that hash based joins compare string keys as the attribute filter of
+# the secondary layer does: case sensitive when it is evaluated natively (by
+# SQLite for GeoPackage), case insensitive when evaluated by OGR SQL
+
+
+@pytest.mark.parametrize("driver_name", ["GPKG", "Memory"])
+def test_ogr_join_25(driver_name):
+
+    if gdal.GetDriverByName(driver_name) is None:
+        pytest.skip("%s driver missing" % driver_name)
+
+    filename = "/vsimem/test_ogr_join_25.gpkg" if driver_name == "GPKG" else ""
+    ds = ogr.GetDriverByName(driver_name).CreateDataSource(filename)
+    lyr = ds.CreateLayer("first", geom_type=ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn("str_key", ogr.OFTString))
+    for key in ["abc", "ABC", "def", "Ghi"]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str_key"] = key
+        lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("second", geom_type=ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn("str_key", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTString))
+    for key, val in [("ABC", "val1"), ("abc", "val2"), ("ghi", "val3")]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str_key"] = key
+        f["val"] = val
+        lyr.CreateFeature(f)
+
+    sql = "SELECT first.str_key, second.val FROM first LEFT JOIN second ON first.str_key = second.str_key"
+
+    def get_values():
+        sql_lyr = ds.ExecuteSQL(sql, dialect="OGRSQL")
+        ret = [(f["str_key"], f["val"]) for f in sql_lyr]
+        ds.ReleaseResultSet(sql_lyr)
+        return ret
+
+    if driver_name == "GPKG":
+        expected = [
+            ("abc", "val2"),
+            ("ABC", "val1"),
+            ("def", None),
+            ("Ghi", None),
+        ]
+    else:
+        expected = [
+            ("abc", "val1"),
+            ("ABC", "val1"),
+            ("def", None),
+            ("Ghi", "val3"),
+        ]
+
+    try:
+        for strategy in ["AUTO", "HASH", "NESTED_LOOP"]:
+            with gdaltest.config_option("OGR_SQL_JOIN_STRATEGY", strategy):
+                assert get_values() == expected, strategy
+    finally:
+        ds = None
+        if filename:
+            gdal.Unlink(filename)
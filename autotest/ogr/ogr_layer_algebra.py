@@ -586,6 +586,74 @@ def test_algebra_erase():
     recreate_layer_C()
 
 
+###############################################################################
+# Check that the spatial index based implementation, single and multi-threaded,
+# gives the same results as querying the method layer for each input feature.
+
+
+@pytest.mark.parametrize(
+    "method",
+    ["Intersection", "Union", "SymDifference", "Identity", "Update", "Clip", "Erase"],
+)
+@pytest.mark.parametrize("method_filter", [False, True])
+def test_algebra_spatial_index(method, method_filter):
+
+    wrk = ogr.GetDriverByName("Memory").CreateDataSource("wrk_spatial_index")
+
+    lyr_input = wrk.CreateLayer("input")
+    lyr_input.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr_method = wrk.CreateLayer("method")
+    lyr_method.CreateField(ogr.FieldDefn("m", ogr.OFTInteger))
+
+    for i in range(10):
+        for j in range(10):
+            f = ogr.Feature(lyr_input.GetLayerDefn())
+            f["i"] = i * 10 + j
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    "POLYGON((%d %d,%d %d,%d %d,%d %d,%d %d))"
+                    % (i, j, i, j + 1.5, i + 1.5, j + 1.5, i + 1.5, j, i, j)
+                )
+            )
+            lyr_input.CreateFeature(f)
+    # features without geometry must be ignored
+    lyr_input.CreateFeature(ogr.Feature(lyr_input.GetLayerDefn()))
+
+    for i in range(7):
+        for j in range(7):
+            f = ogr.Feature(lyr_method.GetLayerDefn())
+            f["m"] = i * 7 + j
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    "POINT(%f %f)" % (i * 1.6 + 0.3, j * 1.6 + 0.2)
+                ).Buffer(0.7, 4)
+            )
+            lyr_method.CreateFeature(f)
+    lyr_method.CreateFeature(ogr.Feature(lyr_method.GetLayerDefn()))
+
+    if method_filter:
+        lyr_method.SetSpatialFilter(
+            ogr.CreateGeometryFromWkt("POINT(5 5)").Buffer(3.5, 8)
+        )
+
+    results = []
+    for options in (
+        ["USE_SPATIAL_INDEX=NO"],
+        ["USE_SPATIAL_INDEX=YES"],
+        ["USE_SPATIAL_INDEX=YES", "NUM_THREADS=4"],
+    ):
+        lyr_result = wrk.CreateLayer("result_%d" % len(results))
+        assert getattr(lyr_input, method)(lyr_method, lyr_result, options=options) == 0
+        assert lyr_result.GetFeatureCount() > 0
+        results.append(lyr_result)
+
+    assert is_same(results[0], results[1])
+    assert is_same(results[0], results[2])
+
+    if method_filter:
+        assert lyr_method.GetSpatialFilter() is not None
+
+
 def test_algebra_cleanup():
 
     global ds, A, B, C, pointInB, D1, D2, empty
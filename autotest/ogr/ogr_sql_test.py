@@ -1649,6 +1649,89 @@ def test_ogr_sql_string_int_array_comparison():
     del ds
 
 
+###############################################################################
+# Test that the compiled evaluation of expressions matches the interpreter
+
+
+@pytest.mark.parametrize(
+    "where",
+    [
+        "int = 2",
+        "int <> 2",
+        "int IN (1, 3)",
+        "int BETWEEN 1 AND 2",
+        "int IS NULL",
+        "int IS NOT NULL",
+        "NOT (int > 1)",
+        "int + 1 >= 3",
+        "int * int64 > 10",
+        "int % 2 = 1",
+        "int / 0 = 2147483647",
+        "int64 = 1234567890123",
+        "int64 > 1 AND real < 5",
+        "int > 1 OR str = 'b'",
+        "real = 1.5",
+        "real > int",
+        "real IN (1.5, 2.5)",
+        "real BETWEEN 1 AND 3",
+        "real - int < 0",
+        "real / 0 > 0",
+        "str = 'A'",
+        "str <> 'a'",
+        "str > 'b'",
+        "str IN ('a', 'c')",
+        "str BETWEEN 'a' AND 'b'",
+        "str LIKE 'a%'",
+        "str ILIKE 'A%'",
+        "str LIKE 'a!_%' ESCAPE '!'",
+        "str IS NULL",
+        "str = '2022/01/01 12:34:56+00'",
+        "bool",
+        "bool = 1",
+        "NOT bool",
+        "bool AND int = 1",
+        "int AND bool",
+        "fid = 1",
+        "fid IN (0, 2)",
+        "int = 1 AND (str LIKE 'a%' OR real IS NULL)",
+        "(int = 1) = (str = 'a')",
+    ],
+)
+def test_ogr_sql_compiled_evaluation(where):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(fld_defn)
+    for values in [
+        (1, 1234567890123, 1.5, "a_b", 1),
+        (2, 3, 2.5, "B", 0),
+        (3, None, None, "c", None),
+        (None, 5, 0.5, None, 1),
+        (0, -1, -1.0, "2022/01/01 12:34:56", 0),
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        for i, val in enumerate(values):
+            if val is None:
+                f.SetFieldNull(i)
+            else:
+                f.SetField(i, val)
+        lyr.CreateFeature(f)
+
+    def get_fids():
+        assert lyr.SetAttributeFilter(where) == ogr.OGRERR_NONE
+        return [f.GetFID() for f in lyr]
+
+    with gdaltest.config_option("OGR_SQL_COMPILE_EXPRESSIONS", "NO"):
+        expected = get_fids()
+    assert get_fids() == expected
+
+
 ###############################################################################
 
 
@@ -701,3 +701,46 @@ def test_gdaldem_lib_nodata():
     if cs != 10:
         print(ds.ReadAsArray())  # Should be 0 0 0 0 181 0 0 0 0
         pytest.fail("Bad checksum")
+
+
+###############################################################################
+# Test that multi-threaded processing gives the same results as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("datatype", [gdal.GDT_Int16, gdal.GDT_Float32])
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {"scale": 111120, "zFactor": 30}),
+        ("hillshade", {"scale": 111120, "zFactor": 30, "computeEdges": True}),
+        ("hillshade", {"alg": "ZevenbergenThorne", "multiDirectional": True}),
+        ("slope", {"scale": 111120}),
+        ("slope", {"scale": 111120, "slopeFormat": "percent"}),
+        ("slope", {"alg": "ZevenbergenThorne", "computeEdges": True}),
+        ("aspect", {}),
+        ("TRI", {}),
+        ("color-relief", {"colorFilename": "data/color_file.txt"}),
+    ],
+)
+def test_gdaldem_lib_multithreaded(datatype, processing, options):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", outputType=datatype
+    )
+    # Add some nodata values so that both code paths are exercised
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        10, 20, 5, 3, struct.pack("h" * 15, *([0] * 15)), buf_type=gdal.GDT_Int16
+    )
+
+    def run():
+        ds = gdal.DEMProcessing("", src_ds, processing, format="MEM", **options)
+        assert ds is not None
+        return [
+            ds.GetRasterBand(i + 1).ReadRaster() for i in range(ds.RasterCount)
+        ]
+
+    ref = run()
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        assert run() == ref
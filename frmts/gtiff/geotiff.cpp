@@ -48,6 +48,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
@@ -379,6 +380,7 @@ private:
     friend void  GTIFFSetZLevel( GDALDatasetH hGTIFFDS, int nZLevel );
     friend void  GTIFFSetZSTDLevel( GDALDatasetH hGTIFFDS, int nZSTDLevel );
     friend void  GTIFFSetMaxZError( GDALDatasetH hGTIFFDS, double dfMaxZError );
+    friend bool  GTIFFHasLosslessOverviews( GDALDatasetH hGTIFFDS );
 
     TIFF                 *m_hTIFF = nullptr;
     VSILFILE             *m_fpL = nullptr;
@@ -653,6 +655,8 @@ private:
     void        FlushCacheInternal( bool bAtClosing,
                                     bool bFlushDirectory );
     bool        HasOptimizedReadMultiRange();
+    void        AdviseReadBlocks( int nXOff, int nYOff, int nXSize, int nYSize,
+                                  int nBandCount, const int* panBandMap );
 
     bool        AssociateExternalMask();
 
@@ -692,6 +696,7 @@ private:
     virtual const GDAL_GCP *GetGCPs() override;
     CPLErr SetGCPs( int nGCPCountIn, const GDAL_GCP *pasGCPListIn,
                     const OGRSpatialReference* poSRS ) override;
+    bool           HasLosslessEncoding() const;
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     bool           IsMultiThreadedReadCompatible() const;
     CPLErr         MultiThreadedRead(int nXOff, int nYOff, int nXSize, int nYSize,
@@ -709,6 +714,11 @@ private:
                               GSpacing nPixelSpace, GSpacing nLineSpace,
                               GSpacing nBandSpace,
                               GDALRasterIOExtraArg* psExtraArg ) override;
+    virtual CPLErr AdviseRead( int nXOff, int nYOff, int nXSize, int nYSize,
+                               int nBufXSize, int nBufYSize,
+                               GDALDataType eDT,
+                               int nBandCount, int *panBandMap,
+                               char **papszOptions ) override;
     virtual char **GetFileList() override;
 
     virtual CPLErr IBuildOverviews( const char *,
@@ -1339,6 +1349,31 @@ void GTIFFSetMaxZError( GDALDatasetH hGTIFFDS, double dfMaxZError )
         poDS->m_papoOverviewDS[i]->m_dfMaxZError = poDS->m_dfMaxZError;
 }
 
+/************************************************************************/
+/*                      GTIFFHasLosslessOverviews()                     */
+/* Called by GTIFFBuildOverviews() to know if the overview levels of    */
+/* the .ovr file can be computed from each other in memory.             */
+/************************************************************************/
+
+bool GTIFFHasLosslessOverviews( GDALDatasetH hGTIFFDS )
+{
+    CPLAssert(
+        EQUAL(GDALGetDriverShortName(GDALGetDatasetDriver(hGTIFFDS)), "GTIFF"));
+
+    GTiffDataset* const poDS = static_cast<GTiffDataset *>(hGTIFFDS);
+
+    poDS->ScanDirectories();
+
+    if( !poDS->HasLosslessEncoding() )
+        return false;
+    for( int i = 0; i < poDS->m_nOverviewCount; ++i )
+    {
+        if( !poDS->m_papoOverviewDS[i]->HasLosslessEncoding() )
+            return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                            GTiffRasterBand                           */
@@ -1377,6 +1412,12 @@ class GTiffRasterBand CPL_NON_FINAL: public GDALPamRasterBand
                                      int nBufXSize, int nBufYSize,
                                      GDALRasterIOExtraArg* psExtraArg );
 
+    // Index, in row order, of the last block read by IReadBlock(), to
+    // detect sequential access. Atomic since blocks of a band may be read by
+    // several threads.
+    std::atomic<GIntBig> m_nLastReadBlockId{-1};
+    void            PrefetchBlocks( int nBlockXOff, int nBlockYOff );
+
 protected:
     GTiffDataset       *m_poGDS = nullptr;
     GDALMultiDomainMetadata m_oGTiffMDMD{};
@@ -1421,6 +1462,10 @@ public:
                               GDALDataType eBufType,
                               GSpacing nPixelSpace, GSpacing nLineSpace,
                               GDALRasterIOExtraArg* psExtraArg ) override final;
+    virtual CPLErr AdviseRead( int nXOff, int nYOff, int nXSize, int nYSize,
+                               int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               char **papszOptions ) override;
 
     virtual const char *GetDescription() const override final;
     virtual void        SetDescription( const char * ) override final;
@@ -2373,6 +2418,99 @@ bool GTiffDataset::HasOptimizedReadMultiRange()
     return m_nHasOptimizedReadMultiRange != 0;
 }
 
+/************************************************************************/
+/*                          AdviseReadBlocks()                          */
+/*                                                                      */
+/*      Ask the underlying file handle to start fetching the blocks     */
+/*      intersecting the window. This is a no-op for file systems       */
+/*      that do not implement VSIVirtualHandle::AdviseRead().           */
+/************************************************************************/
+
+void GTiffDataset::AdviseReadBlocks( int nXOff, int nYOff,
+                                     int nXSize, int nYSize,
+                                     int nBandCount, const int* panBandMap )
+{
+    if( nXSize <= 0 || nYSize <= 0 || m_bStreamingIn )
+        return;
+
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
+    const int nStrilePerBlock =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG ? 1 : nBandCount;
+
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for( int i = 0; i < nStrilePerBlock; ++i )
+    {
+        for( int y = nBlockY1; y <= nBlockY2; ++y )
+        {
+            for( int x = nBlockX1; x <= nBlockX2; ++x )
+            {
+                int nBlockId = x + y * nBlocksPerRow;
+                if( m_nPlanarConfig == PLANARCONFIG_SEPARATE )
+                    nBlockId += (panBandMap[i] - 1) * m_nBlocksPerBand;
+
+                vsi_l_offset nOffset = 0;
+                vsi_l_offset nSize = 0;
+                if( !IsBlockAvailable(nBlockId, &nOffset, &nSize) ||
+                    nSize == 0 || nSize > 100U * 1024 * 1024 )
+                {
+                    continue;
+                }
+                // Include the leader and trailer of COG optimized layouts,
+                // as read by GTiffRasterBand::CacheMultiRange()
+                if( m_bLeaderSizeAsUInt4 && nOffset >= 4 )
+                {
+                    nOffset -= 4;
+                    nSize += 4;
+                }
+                if( m_bTrailerRepeatedLast4BytesRepeated )
+                    nSize += 4;
+                anOffsets.push_back(nOffset);
+                anSizes.push_back(static_cast<size_t>(nSize));
+            }
+        }
+    }
+    if( anOffsets.empty() )
+        return;
+
+    VSIVirtualHandle* fp = reinterpret_cast<VSIVirtualHandle*>(
+        VSI_TIFFGetVSILFile(TIFFClientdata( m_hTIFF )));
+    fp->AdviseRead(static_cast<int>(anOffsets.size()),
+                   anOffsets.data(), anSizes.data());
+}
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+CPLErr GTiffDataset::AdviseRead( int nXOff, int nYOff, int nXSize, int nYSize,
+                                 int nBufXSize, int nBufYSize,
+                                 GDALDataType /* eDT */,
+                                 int nBandCount, int *panBandMap,
+                                 char ** /* papszOptions */ )
+{
+    if( eAccess != GA_ReadOnly ||
+        nBufXSize != nXSize || nBufYSize != nYSize ||
+        !HasOptimizedReadMultiRange() )
+    {
+        return CE_None;
+    }
+
+    std::vector<int> anBandMap;
+    if( panBandMap == nullptr )
+    {
+        for( int i = 1; i <= nBandCount; ++i )
+            anBandMap.push_back(i);
+        panBandMap = anBandMap.data();
+    }
+    AdviseReadBlocks(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap);
+    return CE_None;
+}
+
 /************************************************************************/
 /*                            IRasterIO()                               */
 /************************************************************************/
@@ -2434,7 +2572,10 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
              eRWFlag == GF_Read &&
              nBufXSize == nXSize &&
              nBufYSize == nYSize &&
-             IsMultiThreadedReadCompatible() )
+             IsMultiThreadedReadCompatible() &&
+             // Waiting for jobs of the pool from one of its worker threads
+             // could deadlock.
+             !m_poThreadPool->IsCurrentThreadWorker() )
     {
         const int nBlockX1 = nXOff / m_nBlockXSize;
         const int nBlockY1 = nYOff / m_nBlockYSize;
@@ -2451,6 +2592,21 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
     }
 #endif
 
+    // With PLANARCONFIG_SEPARATE, the bands are read one after the other by
+    // GDALPamDataset::IRasterIO(). Start fetching the blocks of all of them
+    // in the background, so that the next bands are ready when needed.
+    if( eAccess == GA_ReadOnly &&
+        eRWFlag == GF_Read &&
+        m_nPlanarConfig == PLANARCONFIG_SEPARATE && nBandCount > 1 &&
+        nBufXSize == nXSize && nBufYSize == nYSize &&
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+        !bCanUseMultiThreadedRead &&
+#endif
+        HasOptimizedReadMultiRange() )
+    {
+        AdviseReadBlocks(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap);
+    }
+
     void* pBufferedData = nullptr;
     if( eAccess == GA_ReadOnly &&
         eRWFlag == GF_Read &&
@@ -2527,6 +2683,7 @@ struct GTiffDecompressContext
     bool     bHasPRead = false;
     bool     bCacheAllBands = false;
     bool     bSkipBlockCache = false;
+    bool     bCacheOnly = false; // only fill the block cache. pabyData unused
     bool     bUseBIPOptim = false;
     bool     bUseDeinterleaveOptimNoBlockCache = false;
     bool     bUseDeinterleaveOptimBlockCache = false;
@@ -2619,6 +2776,9 @@ static void ThreadDecompressionFunc(void* pData)
 
     if( psJob->nSize == 0 )
     {
+        // Sparse blocks are cheap to generate in IReadBlock()
+        if( psContext->bCacheOnly )
+            return;
         {
             std::lock_guard<std::mutex> oLock(psContext->oMutex);
             if( !psContext->bSuccess )
@@ -2643,6 +2803,12 @@ static void ThreadDecompressionFunc(void* pData)
         return;
     }
 
+    // Errors of speculative prefetching are reported again when the block
+    // is actually read.
+    std::unique_ptr<CPLErrorHandlerPusher> poQuietErrors;
+    if( psContext->bCacheOnly )
+        poQuietErrors.reset(new CPLErrorHandlerPusher(CPLQuietErrorHandler));
+
     const int nBandsToCache = psContext->bCacheAllBands ? poDS->nBands : nBandsToWrite;
     std::vector<GDALRasterBlock*> apoBlocks(nBandsToCache);
     std::vector<bool> abAlreadyLoadedBlocks(nBandsToCache);
@@ -2796,10 +2962,14 @@ static void ThreadDecompressionFunc(void* pData)
     }
 
     const int nDTSize = GDALGetDataTypeSizeBytes(psContext->eDT);
-    GByte* pDstPtr = psContext->pabyData
+    GByte* pDstPtr = psContext->bCacheOnly ? nullptr :
+                   psContext->pabyData
                    + nYOffsetInData * psContext->nLineSpace
                    + nXOffsetInData * psContext->nPixelSpace;
 
+    if( psContext->bCacheOnly && nAlreadyLoadedBlocks == nBandsToCache )
+        return;
+
     if( nAlreadyLoadedBlocks != nBandsToCache )
     {
         // Generate a dummy in-memory TIFF file that has all the needed tags
@@ -2952,6 +3122,9 @@ static void ThreadDecompressionFunc(void* pData)
             }
         }
 
+        if( psContext->bCacheOnly )
+            return;
+
         const GByte* pSrcPtr = pabyOutput +
                 (static_cast<size_t>(nYOffsetInBlock) *
                 poDS->m_nBlockXSize + nXOffsetInBlock) * nDTSize * nBandsPerStrile;
@@ -3082,6 +3255,9 @@ bool GTiffDataset::IsMultiThreadedReadCompatible() const
 
 /************************************************************************/
 /*                        MultiThreadedRead()                           */
+/*                                                                      */
+/*      When pData is null, the blocks intersecting the window are      */
+/*      only decoded into the block cache.                              */
 /************************************************************************/
 
 CPLErr GTiffDataset::MultiThreadedRead( int nXOff, int nYOff, int nXSize, int nYSize,
@@ -3137,7 +3313,11 @@ CPLErr GTiffDataset::MultiThreadedRead( int nXOff, int nYOff, int nXSize, int nY
     sContext.nPredictor = PREDICTOR_NONE;
     sContext.nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, m_nBlockXSize);
 
-    if( m_bDirectIO )
+    if( pData == nullptr )
+    {
+        sContext.bCacheOnly = true;
+    }
+    else if( m_bDirectIO )
     {
         sContext.bSkipBlockCache = true;
     }
@@ -3412,6 +3592,31 @@ CPLErr GTiffDataset::MultiThreadedRead( int nXOff, int nYOff, int nXSize, int nY
 
 #endif
 
+/************************************************************************/
+/*                        HasLosslessEncoding()                         */
+/*                                                                      */
+/*      Whether pixel values written in this IFD are read back          */
+/*      unaltered.                                                      */
+/************************************************************************/
+
+bool GTiffDataset::HasLosslessEncoding() const
+{
+    if( nBands == 0 ||
+        m_nBitsPerSample !=
+            GDALGetDataTypeSizeBits(papoBands[0]->GetRasterDataType()) )
+    {
+        return false;
+    }
+    return m_nCompression == COMPRESSION_NONE ||
+           m_nCompression == COMPRESSION_ADOBE_DEFLATE ||
+           m_nCompression == COMPRESSION_LZW ||
+           m_nCompression == COMPRESSION_PACKBITS ||
+           m_nCompression == COMPRESSION_LZMA ||
+           m_nCompression == COMPRESSION_ZSTD ||
+           (m_nCompression == COMPRESSION_LERC && m_dfMaxZError == 0.0) ||
+           (m_nCompression == COMPRESSION_WEBP && m_bWebPLossless);
+}
+
 /************************************************************************/
 /*                        FetchBufferVirtualMemIO                       */
 /************************************************************************/
@@ -5228,6 +5433,21 @@ int GTiffDataset::DirectIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+CPLErr GTiffRasterBand::AdviseRead( int nXOff, int nYOff,
+                                    int nXSize, int nYSize,
+                                    int nBufXSize, int nBufYSize,
+                                    GDALDataType eBufType,
+                                    char **papszOptions )
+{
+    return m_poGDS->AdviseRead(nXOff, nYOff, nXSize, nYSize,
+                               nBufXSize, nBufYSize, eBufType,
+                               1, &nBand, papszOptions);
+}
+
 /************************************************************************/
 /*                         CacheMultiRange()                            */
 /************************************************************************/
@@ -5734,7 +5954,10 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     if( eRWFlag == GF_Read &&
         m_poGDS->m_poThreadPool != nullptr &&
         nXSize == nBufXSize && nYSize == nBufYSize &&
-        m_poGDS->IsMultiThreadedReadCompatible() )
+        m_poGDS->IsMultiThreadedReadCompatible() &&
+        // Waiting for jobs of the pool from one of its worker threads could
+        // deadlock.
+        !m_poGDS->m_poThreadPool->IsCurrentThreadWorker() )
     {
         const int nBlockX1 = nXOff / nBlockXSize;
         const int nBlockY1 = nYOff / nBlockYSize;
@@ -6033,6 +6256,111 @@ bool GTiffDataset::ReadStrile(int nBlockId,
     return true;
 }
 
+/************************************************************************/
+/*                           PrefetchBlocks()                           */
+/*                                                                      */
+/*      When blocks are read one after the other, in row order for      */
+/*      tiles or column order for strips, decode the next ones in       */
+/*      parallel into the block cache, so that block-by-block readers   */
+/*      benefit from the thread pool too.                               */
+/************************************************************************/
+
+void GTiffRasterBand::PrefetchBlocks( int nBlockXOff, int nBlockYOff )
+{
+#ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
+    // Only when multi-threaded decoding was enabled when opening the
+    // dataset.
+    if( m_poGDS->m_poThreadPool == nullptr )
+        return;
+
+    // Sequential in row order: next tile along a row, first tile of the next
+    // row after the last one of the previous row, or next strip.
+    const GIntBig nBlockId =
+        static_cast<GIntBig>(nBlockYOff) * nBlocksPerRow + nBlockXOff;
+    const bool bSequential = m_nLastReadBlockId.exchange(nBlockId) ==
+                             nBlockId - 1;
+    if( !bSequential ||
+        eAccess != GA_ReadOnly ||
+        m_poGDS->m_bDirectIO ||
+        m_poGDS->m_bLoadingOtherBands ||
+        !m_poGDS->IsMultiThreadedReadCompatible() ||
+        // Waiting for jobs of the pool from one of its worker threads could
+        // deadlock.
+        m_poGDS->m_poThreadPool->IsCurrentThreadWorker() )
+    {
+        return;
+    }
+
+    int nBlockCount = atoi(CPLGetConfigOption(
+        "GTIFF_PREFETCH_BLOCK_COUNT",
+        CPLSPrintf("%d", m_poGDS->m_poThreadPool->GetThreadCount())));
+
+    // Strips are prefetched downwards, tiles along the current row
+    const bool bVertical = nBlocksPerRow == 1;
+    const int nRemaining = bVertical ? nBlocksPerColumn - 1 - nBlockYOff :
+                                       nBlocksPerRow - 1 - nBlockXOff;
+    nBlockCount = std::min(nBlockCount, nRemaining);
+
+    // Do not use more than a quarter of the block cache
+    const int nBandsPerBlock =
+        m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ? m_poGDS->nBands : 1;
+    const GIntBig nBlockMemSize =
+        static_cast<GIntBig>(nBlockXSize) * nBlockYSize * nBandsPerBlock *
+        GDALGetDataTypeSizeBytes(eDataType);
+    nBlockCount = static_cast<int>(std::min(
+        static_cast<GIntBig>(nBlockCount),
+        GDALGetCacheMax64() / 4 / nBlockMemSize));
+    if( nBlockCount <= 1 )
+        return;
+
+    const int nXBlockStart = bVertical ? nBlockXOff : nBlockXOff + 1;
+    const int nYBlockStart = bVertical ? nBlockYOff + 1 : nBlockYOff;
+    const int nXBlockEnd = bVertical ? nBlockXOff : nBlockXOff + nBlockCount;
+    const int nYBlockEnd = bVertical ? nBlockYOff + nBlockCount : nBlockYOff;
+    const int nXOff = nXBlockStart * nBlockXSize;
+    const int nYOff = nYBlockStart * nBlockYSize;
+    const int nXSize =
+        std::min(nRasterXSize, (nXBlockEnd + 1) * nBlockXSize) - nXOff;
+    const int nYSize =
+        std::min(nRasterYSize, (nYBlockEnd + 1) * nBlockYSize) - nYOff;
+
+    std::vector<int> anBandMap;
+    if( m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG )
+    {
+        for( int i = 1; i <= m_poGDS->nBands; ++i )
+            anBandMap.push_back(i);
+    }
+    else
+    {
+        anBandMap.push_back(nBand);
+    }
+
+    if( m_poGDS->MultiThreadedRead(nXOff, nYOff, nXSize, nYSize,
+                                   nullptr, eDataType,
+                                   static_cast<int>(anBandMap.size()),
+                                   anBandMap.data(), 0, 0, 0) != CE_None )
+    {
+        // Do not leave partially decoded blocks in the cache
+        for( const int iBand : anBandMap )
+        {
+            auto poBand = cpl::down_cast<GTiffRasterBand*>(
+                m_poGDS->GetRasterBand(iBand));
+            for( int y = nYBlockStart; y <= nYBlockEnd; ++y )
+            {
+                for( int x = nXBlockStart; x <= nXBlockEnd; ++x )
+                    poBand->FlushBlock(x, y, FALSE);
+            }
+        }
+        return;
+    }
+
+    m_nLastReadBlockId = nBlockId + nBlockCount;
+#else
+    CPL_IGNORE_RET_VAL(nBlockXOff);
+    CPL_IGNORE_RET_VAL(nBlockYOff);
+#endif
+}
+
 /************************************************************************/
 /*                             IReadBlock()                             */
 /************************************************************************/
@@ -6043,6 +6371,8 @@ CPLErr GTiffRasterBand::IReadBlock( int nBlockXOff, int nBlockYOff,
 {
     m_poGDS->Crystalize();
 
+    PrefetchBlocks(nBlockXOff, nBlockYOff);
+
     GPtrDiff_t nBlockBufSize = 0;
     if( TIFFIsTiled(m_poGDS->m_hTIFF) )
     {
@@ -13283,10 +13613,21 @@ CPLErr GTiffDataset::IBuildOverviews(
             }
         }
 
+        // When the overviews are read back unaltered, each level can be
+        // computed from the in-memory result of the previous one.
+        CPLStringList aosOptions(papszOptions);
+        if( aosOptions.FetchNameValue("CASCADE") == nullptr )
+        {
+            bool bLossless = true;
+            for( int i = 0; i < m_nOverviewCount && bLossless; ++i )
+                bLossless = m_papoOverviewDS[i]->HasLosslessEncoding();
+            aosOptions.SetNameValue("CASCADE", bLossless ? "YES" : "NO");
+        }
+
         GDALRegenerateOverviewsMultiBand( nBandsIn, papoBandList,
                                           nNewOverviews, papapoOverviewBands,
                                           pszResampling, pfnProgress,
-                                          pProgressData, papszOptions );
+                                          pProgressData, aosOptions.List() );
 
         for( int iBand = 0; iBand < nBandsIn; ++iBand )
         {
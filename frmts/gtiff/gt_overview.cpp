@@ -1160,13 +1160,23 @@ GTIFFBuildOverviewsEx( const char * pszFilename,
                 CSLFetchNameValue(papszOptions, "NUM_THREADS"),
                 true);
 
+            // When the overviews are read back unaltered, each level can be
+            // computed from the in-memory result of the previous one.
+            CPLStringList aosOptions(papszOptions);
+            if( aosOptions.FetchNameValue("CASCADE") == nullptr )
+            {
+                aosOptions.SetNameValue("CASCADE",
+                    GTIFFHasLosslessOverviews(GDALDataset::ToHandle(hODS)) ?
+                                                                "YES" : "NO");
+            }
+
             if( eErr == CE_None )
                 eErr =
                     GDALRegenerateOverviewsMultiBand(
                         nBands, papoBandList,
                         nOverviews, papapoOverviewBands,
                         pszResampling, pfnProgress, pProgressData,
-                        papszOptions);
+                        aosOptions.List());
         }
 
         for( int iBand = 0; iBand < nBands; iBand++ )
@@ -52,6 +52,7 @@ void    GTIFFSetWebPLossless( GDALDatasetH hGTIFFDS, bool bWebpLossless );
 void    GTIFFSetZLevel( GDALDatasetH hGTIFFDS, int nZLevel );
 void    GTIFFSetZSTDLevel( GDALDatasetH hGTIFFDS, int nZSTDLevel );
 void    GTIFFSetMaxZError( GDALDatasetH hGTIFFDS, double dfMaxZError );
+bool    GTIFFHasLosslessOverviews( GDALDatasetH hGTIFFDS );
 int     GTIFFGetCompressionMethod( const char* pszValue,
                                    const char* pszVariableName );
 bool    GTIFFSupportsPredictor(int nCompression);
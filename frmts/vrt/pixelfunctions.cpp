@@ -30,8 +30,16 @@
 #include <cmath>
 #include "gdal.h"
 #include "vrtdataset.h"
+#include "cpl_mem_cache.h"
 
+#include <algorithm>
+#include <cctype>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 
 template<typename T> inline double GetSrcVal(const void* pSource, GDALDataType eSrcType, T ii)
@@ -1307,6 +1315,730 @@ static CPLErr ScalePixelFunc( void **papoSources, int nSources, void *pData,
     return CE_None;
 }
 
+/************************************************************************/
+/*                        Expression pixel function                     */
+/************************************************************************/
+
+namespace {
+
+// Number of pixels processed at once by each instruction of an expression.
+constexpr int EXPR_CHUNK_SIZE = 256;
+
+enum class ExprOp
+{
+    Source, Constant,
+    Neg, Not,
+    Add, Sub, Mul, Div, Mod, Pow,
+    Lt, Le, Gt, Ge, Eq, Ne, And, Or,
+    Cond,
+    Abs, Sqrt, Exp, Log, Log10, Sin, Cos, Tan, Asin, Acos, Atan, Atan2,
+    Floor, Ceil, Round, Min, Max, IsNan
+};
+
+// Instruction of a compiled expression. Instruction i computes the values of
+// register i, from the registers of its operands, which are always
+// instructions that come before it.
+struct ExprInstr
+{
+    ExprOp eOp = ExprOp::Constant;
+    int iA = -1;
+    int iB = -1;
+    int iC = -1;
+    int iSource = 0;       // 0-based, for ExprOp::Source
+    double dfValue = 0;    // for ExprOp::Constant
+};
+
+template<class F> inline void ExprApply(double* r, const double* a, int n,
+                                        F f)
+{
+    for( int i = 0; i < n; ++i )
+        r[i] = f(a[i]);
+}
+
+template<class F> inline void ExprApply(double* r, const double* a,
+                                        const double* b, int n, F f)
+{
+    for( int i = 0; i < n; ++i )
+        r[i] = f(a[i], b[i]);
+}
+
+// Compute n values of an instruction, other than Source and Constant.
+static void ExprExecute(ExprOp eOp, double* r, const double* a,
+                        const double* b, const double* c, int n)
+{
+    switch( eOp )
+    {
+        case ExprOp::Source:
+        case ExprOp::Constant:
+            break;
+        case ExprOp::Neg:
+            ExprApply(r, a, n, [](double x) { return -x; });
+            break;
+        case ExprOp::Not:
+            ExprApply(r, a, n, [](double x) { return x == 0 ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Add:
+            ExprApply(r, a, b, n, [](double x, double y) { return x + y; });
+            break;
+        case ExprOp::Sub:
+            ExprApply(r, a, b, n, [](double x, double y) { return x - y; });
+            break;
+        case ExprOp::Mul:
+            ExprApply(r, a, b, n, [](double x, double y) { return x * y; });
+            break;
+        case ExprOp::Div:
+            ExprApply(r, a, b, n, [](double x, double y) { return x / y; });
+            break;
+        case ExprOp::Mod:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return std::fmod(x, y); });
+            break;
+        case ExprOp::Pow:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return std::pow(x, y); });
+            break;
+        case ExprOp::Lt:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return x < y ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Le:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return x <= y ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Gt:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return x > y ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Ge:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return x >= y ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Eq:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return x == y ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Ne:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return x != y ? 1.0 : 0.0; });
+            break;
+        case ExprOp::And:
+            ExprApply(r, a, b, n, [](double x, double y)
+                      { return x != 0 && y != 0 ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Or:
+            ExprApply(r, a, b, n, [](double x, double y)
+                      { return x != 0 || y != 0 ? 1.0 : 0.0; });
+            break;
+        case ExprOp::Cond:
+            // Both branches are evaluated, and the result selected, which
+            // keeps the loop branch-free.
+            for( int i = 0; i < n; ++i )
+                r[i] = a[i] != 0 ? b[i] : c[i];
+            break;
+        case ExprOp::Abs:
+            ExprApply(r, a, n, [](double x) { return std::fabs(x); });
+            break;
+        case ExprOp::Sqrt:
+            ExprApply(r, a, n, [](double x) { return std::sqrt(x); });
+            break;
+        case ExprOp::Exp:
+            ExprApply(r, a, n, [](double x) { return std::exp(x); });
+            break;
+        case ExprOp::Log:
+            ExprApply(r, a, n, [](double x) { return std::log(x); });
+            break;
+        case ExprOp::Log10:
+            ExprApply(r, a, n, [](double x) { return std::log10(x); });
+            break;
+        case ExprOp::Sin:
+            ExprApply(r, a, n, [](double x) { return std::sin(x); });
+            break;
+        case ExprOp::Cos:
+            ExprApply(r, a, n, [](double x) { return std::cos(x); });
+            break;
+        case ExprOp::Tan:
+            ExprApply(r, a, n, [](double x) { return std::tan(x); });
+            break;
+        case ExprOp::Asin:
+            ExprApply(r, a, n, [](double x) { return std::asin(x); });
+            break;
+        case ExprOp::Acos:
+            ExprApply(r, a, n, [](double x) { return std::acos(x); });
+            break;
+        case ExprOp::Atan:
+            ExprApply(r, a, n, [](double x) { return std::atan(x); });
+            break;
+        case ExprOp::Atan2:
+            ExprApply(r, a, b, n,
+                      [](double y, double x) { return std::atan2(y, x); });
+            break;
+        case ExprOp::Floor:
+            ExprApply(r, a, n, [](double x) { return std::floor(x); });
+            break;
+        case ExprOp::Ceil:
+            ExprApply(r, a, n, [](double x) { return std::ceil(x); });
+            break;
+        case ExprOp::Round:
+            ExprApply(r, a, n, [](double x) { return std::round(x); });
+            break;
+        case ExprOp::Min:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return y < x ? y : x; });
+            break;
+        case ExprOp::Max:
+            ExprApply(r, a, b, n,
+                      [](double x, double y) { return y > x ? y : x; });
+            break;
+        case ExprOp::IsNan:
+            ExprApply(r, a, n,
+                      [](double x) { return std::isnan(x) ? 1.0 : 0.0; });
+            break;
+    }
+}
+
+/************************************************************************/
+/*                             ExprProgram                              */
+/************************************************************************/
+
+// Expression compiled into a list of instructions, each of them evaluated
+// over a chunk of pixels at once.
+class ExprProgram
+{
+    friend class ExprParser;
+
+    std::vector<ExprInstr> m_aoInstr{};
+    int m_iResult = -1;
+    int m_nSourceCount = 0;  // 1 + greatest source index referenced
+
+  public:
+    static std::shared_ptr<const ExprProgram> Get(const char* pszExpr);
+
+    CPLErr Evaluate(void **papoSources, int nSources, void *pData,
+                    int nXSize, int nYSize,
+                    GDALDataType eSrcType, GDALDataType eBufType,
+                    int nPixelSpace, int nLineSpace) const;
+};
+
+/************************************************************************/
+/*                              ExprParser                              */
+/************************************************************************/
+
+// Recursive descent parser, compiling an expression into an ExprProgram.
+//
+// Grammar, from lowest to highest precedence:
+//   cond     := or [ '?' cond ':' cond ]
+//   or       := and { '||' and }
+//   and      := equality { '&&' equality }
+//   equality := relation { ('==' | '!=') relation }
+//   relation := sum { ('<' | '<=' | '>' | '>=') sum }
+//   sum      := product { ('+' | '-') product }
+//   product  := unary { ('*' | '/' | '%') unary }
+//   unary    := ('-' | '+' | '!') unary | power
+//   power    := primary [ '^' unary ]
+//   primary  := number | 'B'n | 'pi' | 'nan' | function '(' cond {',' cond} ')'
+//               | '(' cond ')'
+class ExprParser
+{
+    const char* m_pszExpr;
+    const char* m_pszCur;
+    ExprProgram& m_oProgram;
+    std::map<int, int> m_oMapSourceToInstr{};
+    bool m_bError = false;
+
+    // All recursions go through ParseCond() or ParseUnary(), which bound
+    // their depth so that deeply nested expressions cannot exhaust the stack.
+    static constexpr int MAX_REC_LEVEL = 128;
+    int m_nRecLevel = 0;
+
+    struct RecLevelIncrementer
+    {
+        int& m_nRecLevel;
+        explicit RecLevelIncrementer(int& nRecLevel): m_nRecLevel(nRecLevel)
+            { ++m_nRecLevel; }
+        ~RecLevelIncrementer() { --m_nRecLevel; }
+        RecLevelIncrementer(const RecLevelIncrementer&) = delete;
+        RecLevelIncrementer& operator=(const RecLevelIncrementer&) = delete;
+    };
+
+    int Error(const char* pszMsg);
+    void SkipSpaces();
+    bool Accept(const char* pszToken);
+    int Emit(ExprOp eOp, int iA = -1, int iB = -1, int iC = -1);
+    int EmitConstant(double dfValue);
+
+    int ParseCond();
+    int ParseOr();
+    int ParseAnd();
+    int ParseEquality();
+    int ParseRelation();
+    int ParseSum();
+    int ParseProduct();
+    int ParseUnary();
+    int ParsePower();
+    int ParsePrimary();
+
+  public:
+    ExprParser(const char* pszExpr, ExprProgram& oProgram):
+        m_pszExpr(pszExpr), m_pszCur(pszExpr), m_oProgram(oProgram) {}
+
+    bool Parse();
+};
+
+int ExprParser::Error(const char* pszMsg)
+{
+    if( !m_bError )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression: %s at offset %d of '%s'",
+                 pszMsg, static_cast<int>(m_pszCur - m_pszExpr), m_pszExpr);
+        m_bError = true;
+    }
+    return -1;
+}
+
+void ExprParser::SkipSpaces()
+{
+    while( isspace(static_cast<unsigned char>(*m_pszCur)) )
+        ++m_pszCur;
+}
+
+bool ExprParser::Accept(const char* pszToken)
+{
+    SkipSpaces();
+    const size_t nLen = strlen(pszToken);
+    if( strncmp(m_pszCur, pszToken, nLen) != 0 )
+        return false;
+    // Do not take the '<' of '<=', the '!' of '!=', etc.
+    if( nLen == 1 && m_pszCur[1] == '=' &&
+        (*pszToken == '<' || *pszToken == '>' || *pszToken == '!') )
+        return false;
+    m_pszCur += nLen;
+    return true;
+}
+
+int ExprParser::Emit(ExprOp eOp, int iA, int iB, int iC)
+{
+    if( m_bError )
+        return -1;
+    auto& aoInstr = m_oProgram.m_aoInstr;
+    const auto IsConstant = [&aoInstr](int i)
+        { return i < 0 || aoInstr[i].eOp == ExprOp::Constant; };
+    if( eOp != ExprOp::Source &&
+        IsConstant(iA) && IsConstant(iB) && IsConstant(iC) )
+    {
+        // Fold operations on constants.
+        const double dfA = iA >= 0 ? aoInstr[iA].dfValue : 0;
+        const double dfB = iB >= 0 ? aoInstr[iB].dfValue : 0;
+        const double dfC = iC >= 0 ? aoInstr[iC].dfValue : 0;
+        double dfRes = 0;
+        ExprExecute(eOp, &dfRes, &dfA, &dfB, &dfC, 1);
+        return EmitConstant(dfRes);
+    }
+    ExprInstr oInstr;
+    oInstr.eOp = eOp;
+    oInstr.iA = iA;
+    oInstr.iB = iB;
+    oInstr.iC = iC;
+    aoInstr.push_back(oInstr);
+    return static_cast<int>(aoInstr.size()) - 1;
+}
+
+int ExprParser::EmitConstant(double dfValue)
+{
+    ExprInstr oInstr;
+    oInstr.eOp = ExprOp::Constant;
+    oInstr.dfValue = dfValue;
+    m_oProgram.m_aoInstr.push_back(oInstr);
+    return static_cast<int>(m_oProgram.m_aoInstr.size()) - 1;
+}
+
+int ExprParser::ParseCond()
+{
+    RecLevelIncrementer oIncrementer(m_nRecLevel);
+    if( m_nRecLevel > MAX_REC_LEVEL )
+        return Error("expression too deeply nested");
+    const int iCond = ParseOr();
+    if( iCond < 0 || !Accept("?") )
+        return iCond;
+    const int iTrue = ParseCond();
+    if( iTrue < 0 )
+        return -1;
+    if( !Accept(":") )
+        return Error("':' expected");
+    const int iFalse = ParseCond();
+    if( iFalse < 0 )
+        return -1;
+    return Emit(ExprOp::Cond, iCond, iTrue, iFalse);
+}
+
+int ExprParser::ParseOr()
+{
+    int iRes = ParseAnd();
+    while( iRes >= 0 && Accept("||") )
+        iRes = Emit(ExprOp::Or, iRes, ParseAnd());
+    return iRes;
+}
+
+int ExprParser::ParseAnd()
+{
+    int iRes = ParseEquality();
+    while( iRes >= 0 && Accept("&&") )
+        iRes = Emit(ExprOp::And, iRes, ParseEquality());
+    return iRes;
+}
+
+int ExprParser::ParseEquality()
+{
+    int iRes = ParseRelation();
+    while( iRes >= 0 )
+    {
+        if( Accept("==") )
+            iRes = Emit(ExprOp::Eq, iRes, ParseRelation());
+        else if( Accept("!=") )
+            iRes = Emit(ExprOp::Ne, iRes, ParseRelation());
+        else
+            break;
+    }
+    return iRes;
+}
+
+int ExprParser::ParseRelation()
+{
+    int iRes = ParseSum();
+    while( iRes >= 0 )
+    {
+        if( Accept("<=") )
+            iRes = Emit(ExprOp::Le, iRes, ParseSum());
+        else if( Accept(">=") )
+            iRes = Emit(ExprOp::Ge, iRes, ParseSum());
+        else if( Accept("<") )
+            iRes = Emit(ExprOp::Lt, iRes, ParseSum());
+        else if( Accept(">") )
+            iRes = Emit(ExprOp::Gt, iRes, ParseSum());
+        else
+            break;
+    }
+    return iRes;
+}
+
+int ExprParser::ParseSum()
+{
+    int iRes = ParseProduct();
+    while( iRes >= 0 )
+    {
+        if( Accept("+") )
+            iRes = Emit(ExprOp::Add, iRes, ParseProduct());
+        else if( Accept("-") )
+            iRes = Emit(ExprOp::Sub, iRes, ParseProduct());
+        else
+            break;
+    }
+    return iRes;
+}
+
+int ExprParser::ParseProduct()
+{
+    int iRes = ParseUnary();
+    while( iRes >= 0 )
+    {
+        if( Accept("*") )
+            iRes = Emit(ExprOp::Mul, iRes, ParseUnary());
+        else if( Accept("/") )
+            iRes = Emit(ExprOp::Div, iRes, ParseUnary());
+        else if( Accept("%") )
+            iRes = Emit(ExprOp::Mod, iRes, ParseUnary());
+        else
+            break;
+    }
+    return iRes;
+}
+
+int ExprParser::ParseUnary()
+{
+    RecLevelIncrementer oIncrementer(m_nRecLevel);
+    if( m_nRecLevel > MAX_REC_LEVEL )
+        return Error("expression too deeply nested");
+    if( Accept("-") )
+        return Emit(ExprOp::Neg, ParseUnary());
+    if( Accept("+") )
+        return ParseUnary();
+    if( Accept("!") )
+        return Emit(ExprOp::Not, ParseUnary());
+    return ParsePower();
+}
+
+int ExprParser::ParsePower()
+{
+    const int iRes = ParsePrimary();
+    if( iRes >= 0 && Accept("^") )
+        return Emit(ExprOp::Pow, iRes, ParseUnary());
+    return iRes;
+}
+
+int ExprParser::ParsePrimary()
+{
+    SkipSpaces();
+    if( Accept("(") )
+    {
+        const int iRes = ParseCond();
+        if( iRes >= 0 && !Accept(")") )
+            return Error("')' expected");
+        return iRes;
+    }
+
+    if( isdigit(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '.' )
+    {
+        char* pszEnd = nullptr;
+        const double dfValue = CPLStrtod(m_pszCur, &pszEnd);
+        if( pszEnd == m_pszCur )
+            return Error("invalid number");
+        m_pszCur = pszEnd;
+        return EmitConstant(dfValue);
+    }
+
+    if( !isalpha(static_cast<unsigned char>(*m_pszCur)) )
+        return Error(*m_pszCur == '\0' ? "unexpected end of expression" :
+                                         "unexpected character");
+
+    const char* pszStart = m_pszCur;
+    while( isalnum(static_cast<unsigned char>(*m_pszCur)) ||
+           *m_pszCur == '_' )
+        ++m_pszCur;
+    const std::string osName(pszStart, m_pszCur - pszStart);
+
+    // Source band: B1, B2, ...
+    if( (osName[0] == 'B' || osName[0] == 'b') && osName.size() > 1 &&
+        osName.find_first_not_of("0123456789", 1) == std::string::npos )
+    {
+        const int nBand = atoi(osName.c_str() + 1);
+        if( nBand < 1 || osName.size() > 6 )
+        {
+            m_pszCur = pszStart;
+            return Error("invalid source band");
+        }
+        const int iSource = nBand - 1;
+        const auto oIter = m_oMapSourceToInstr.find(iSource);
+        if( oIter != m_oMapSourceToInstr.end() )
+            return oIter->second;
+        const int iRes = Emit(ExprOp::Source);
+        m_oProgram.m_aoInstr[iRes].iSource = iSource;
+        m_oProgram.m_nSourceCount =
+            std::max(m_oProgram.m_nSourceCount, nBand);
+        m_oMapSourceToInstr[iSource] = iRes;
+        return iRes;
+    }
+
+    if( EQUAL(osName.c_str(), "pi") )
+        return EmitConstant(M_PI);
+    if( EQUAL(osName.c_str(), "nan") )
+        return EmitConstant(std::numeric_limits<double>::quiet_NaN());
+
+    static const struct
+    {
+        const char* pszName;
+        ExprOp eOp;
+        int nArgs;
+    } asFunctions[] = {
+        { "abs", ExprOp::Abs, 1 },
+        { "sqrt", ExprOp::Sqrt, 1 },
+        { "exp", ExprOp::Exp, 1 },
+        { "log", ExprOp::Log, 1 },
+        { "log10", ExprOp::Log10, 1 },
+        { "sin", ExprOp::Sin, 1 },
+        { "cos", ExprOp::Cos, 1 },
+        { "tan", ExprOp::Tan, 1 },
+        { "asin", ExprOp::Asin, 1 },
+        { "acos", ExprOp::Acos, 1 },
+        { "atan", ExprOp::Atan, 1 },
+        { "atan2", ExprOp::Atan2, 2 },
+        { "floor", ExprOp::Floor, 1 },
+        { "ceil", ExprOp::Ceil, 1 },
+        { "round", ExprOp::Round, 1 },
+        { "min", ExprOp::Min, 2 },
+        { "max", ExprOp::Max, 2 },
+        { "pow", ExprOp::Pow, 2 },
+        { "isnan", ExprOp::IsNan, 1 },
+    };
+    for( const auto& sFunction: asFunctions )
+    {
+        if( !EQUAL(osName.c_str(), sFunction.pszName) )
+            continue;
+        if( !Accept("(") )
+            return Error("'(' expected");
+        int aiArgs[2] = { -1, -1 };
+        for( int i = 0; i < sFunction.nArgs; ++i )
+        {
+            if( i > 0 && !Accept(",") )
+                return Error("',' expected");
+            aiArgs[i] = ParseCond();
+            if( aiArgs[i] < 0 )
+                return -1;
+        }
+        if( !Accept(")") )
+            return Error("')' expected");
+        return Emit(sFunction.eOp, aiArgs[0], aiArgs[1]);
+    }
+
+    m_pszCur = pszStart;
+    return Error("unknown identifier");
+}
+
+bool ExprParser::Parse()
+{
+    m_oProgram.m_iResult = ParseCond();
+    if( m_oProgram.m_iResult >= 0 )
+    {
+        SkipSpaces();
+        if( *m_pszCur != '\0' )
+            Error("unexpected character");
+    }
+    return !m_bError && m_oProgram.m_iResult >= 0;
+}
+
+/************************************************************************/
+/*                          ExprProgram::Get()                          */
+/************************************************************************/
+
+// Return the compiled version of an expression, or nullptr if it is
+// invalid. Programs are cached, so that an expression is only compiled
+// once for all the requests on a derived band.
+std::shared_ptr<const ExprProgram> ExprProgram::Get(const char* pszExpr)
+{
+    static std::mutex oMutex;
+    static lru11::Cache<std::string, std::shared_ptr<const ExprProgram>>
+                                                                oCache(64);
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        std::shared_ptr<const ExprProgram> poProgram;
+        if( oCache.tryGet(pszExpr, poProgram) )
+            return poProgram;
+    }
+
+    auto poProgram = std::make_shared<ExprProgram>();
+    if( !ExprParser(pszExpr, *poProgram).Parse() )
+        return nullptr;
+
+    std::lock_guard<std::mutex> oLock(oMutex);
+    oCache.insert(pszExpr, poProgram);
+    return poProgram;
+}
+
+/************************************************************************/
+/*                        ExprProgram::Evaluate()                       */
+/************************************************************************/
+
+CPLErr ExprProgram::Evaluate(void **papoSources, int nSources, void *pData,
+                             int nXSize, int nYSize,
+                             GDALDataType eSrcType, GDALDataType eBufType,
+                             int nPixelSpace, int nLineSpace) const
+{
+    if( m_nSourceCount > nSources )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression: B%d referenced, but only %d source(s) defined",
+                 m_nSourceCount, nSources);
+        return CE_Failure;
+    }
+
+    const int nInstr = static_cast<int>(m_aoInstr.size());
+    std::vector<double> adfRegisters;
+    try
+    {
+        adfRegisters.resize(static_cast<size_t>(nInstr) * EXPR_CHUNK_SIZE);
+    }
+    catch( const std::exception& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "expression: out of memory");
+        return CE_Failure;
+    }
+    const auto Reg = [&adfRegisters](int i)
+        { return adfRegisters.data() + static_cast<size_t>(i) * EXPR_CHUNK_SIZE; };
+
+    // Constants do not depend on the pixels.
+    for( int i = 0; i < nInstr; ++i )
+    {
+        if( m_aoInstr[i].eOp == ExprOp::Constant )
+            std::fill_n(Reg(i), EXPR_CHUNK_SIZE, m_aoInstr[i].dfValue);
+    }
+
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+    for( int iLine = 0; iLine < nYSize; ++iLine )
+    {
+        for( int iCol = 0; iCol < nXSize; iCol += EXPR_CHUNK_SIZE )
+        {
+            const int nCount = std::min(EXPR_CHUNK_SIZE, nXSize - iCol);
+            const size_t nSrcOffset =
+                static_cast<size_t>(iLine) * nXSize + iCol;
+            for( int i = 0; i < nInstr; ++i )
+            {
+                const ExprInstr& oInstr = m_aoInstr[i];
+                if( oInstr.eOp == ExprOp::Constant )
+                    continue;
+                if( oInstr.eOp == ExprOp::Source )
+                {
+                    GDALCopyWords(
+                        static_cast<const GByte*>(papoSources[oInstr.iSource]) +
+                            nSrcOffset * nSrcTypeSize,
+                        eSrcType, nSrcTypeSize,
+                        Reg(i), GDT_Float64, static_cast<int>(sizeof(double)),
+                        nCount);
+                    continue;
+                }
+                ExprExecute(oInstr.eOp, Reg(i),
+                            oInstr.iA >= 0 ? Reg(oInstr.iA) : nullptr,
+                            oInstr.iB >= 0 ? Reg(oInstr.iB) : nullptr,
+                            oInstr.iC >= 0 ? Reg(oInstr.iC) : nullptr,
+                            nCount);
+            }
+
+            GDALCopyWords(
+                Reg(m_iResult), GDT_Float64, static_cast<int>(sizeof(double)),
+                static_cast<GByte *>(pData) +
+                    static_cast<GSpacing>(nLineSpace) * iLine +
+                    static_cast<GSpacing>(nPixelSpace) * iCol,
+                eBufType, nPixelSpace, nCount);
+        }
+    }
+
+    return CE_None;
+}
+
+} // namespace
+
+static const char pszExpressionPixelFuncMetadata[] =
+"<PixelFunctionArgumentsList>"
+"   <Argument name='expression' description='Expression over the sources B1, B2, ...' type='string' mandatory='1' />"
+"</PixelFunctionArgumentsList>";
+
+static CPLErr ExpressionPixelFunc( void **papoSources, int nSources, void *pData,
+                                   int nXSize, int nYSize,
+                                   GDALDataType eSrcType, GDALDataType eBufType,
+                                   int nPixelSpace, int nLineSpace, CSLConstList papszArgs ) {
+    /* ---- Init ---- */
+    if( GDALDataTypeIsComplex( eSrcType ) )
+    {
+        CPLError(
+          CE_Failure, CPLE_AppDefined, "expression cannot by applied to complex data types");
+        return CE_Failure;
+    }
+
+    const char* pszExpr = CSLFetchNameValue(papszArgs, "expression");
+    if( pszExpr == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Missing pixel function argument: expression");
+        return CE_Failure;
+    }
+
+    const auto poProgram = ExprProgram::Get(pszExpr);
+    if( poProgram == nullptr )
+        return CE_Failure;
+
+    /* ---- Set pixels ---- */
+    return poProgram->Evaluate(papoSources, nSources, pData, nXSize, nYSize,
+                               eSrcType, eBufType, nPixelSpace, nLineSpace);
+}
+
 
 /************************************************************************/
 /*                     GDALRegisterDefaultPixelFunc()                   */
@@ -1369,6 +2101,8 @@ static CPLErr ScalePixelFunc( void **papoSources, int nSources, void *pData,
  *                      exponential interpolation
  * - "scale": Apply the RasterBand metadata values of "offset" and "scale"
  * - "nan": Convert incoming NoData values to IEEE 754 nan
+ * - "expression": evaluate an arithmetic, comparison and conditional
+ *                 expression over the sources B1, B2, ... (GDAL >= 3.7)
  *
  * @see GDALAddDerivedBandPixelFunc
  *
@@ -1404,6 +2138,7 @@ CPLErr GDALRegisterDefaultPixelFunc()
     GDALAddDerivedBandPixelFuncWithArgs("replace_nodata",
         ReplaceNoDataPixelFunc, pszReplaceNoDataPixelFuncMetadata);
     GDALAddDerivedBandPixelFuncWithArgs("scale", ScalePixelFunc, pszScalePixelFuncMetadata);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", ExpressionPixelFunc, pszExpressionPixelFuncMetadata);
 
     return CE_None;
 }
@@ -29,6 +29,7 @@
 
 #include "vrtdataset.h"
 
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
 #include "cpl_string.h"
 #include "gdal_frmts.h"
@@ -36,6 +37,8 @@
 #include "gdal_utils.h"
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
 #include "gdal_proxy.h"
 
@@ -763,6 +766,85 @@ int VRTDataset::Identify( GDALOpenInfo * poOpenInfo )
     return FALSE;
 }
 
+/************************************************************************/
+/*                           XML tree cache                             */
+/************************************************************************/
+
+// Parsed XML of a VRT file. When VRT_XML_CACHE_SIZE is set, the parsed XML
+// of the most recently opened files is kept in memory, so that opening again
+// a file that has not been modified since does not need to read and parse it
+// again. The tree is shared by the datasets being opened from it, and must
+// not be modified.
+namespace {
+struct VRTCachedXMLTree
+{
+    GIntBig          nMTime = 0;
+    vsi_l_offset     nSize = 0;
+    CPLXMLTreeCloser psTree{nullptr};
+};
+} // namespace
+
+static std::mutex g_oXMLCacheMutex;
+static std::unique_ptr<lru11::Cache<std::string,
+                       std::shared_ptr<VRTCachedXMLTree>>> g_poXMLCache;
+
+static int GetXMLCacheSize()
+{
+    return std::max(0, atoi(CPLGetConfigOption("VRT_XML_CACHE_SIZE", "0")));
+}
+
+static std::shared_ptr<VRTCachedXMLTree>
+GetCachedXMLTree( const std::string& osFilename, const VSIStatBufL& sStat )
+{
+    std::lock_guard<std::mutex> oLock(g_oXMLCacheMutex);
+    std::shared_ptr<VRTCachedXMLTree> poTree;
+    if( g_poXMLCache && g_poXMLCache->tryGet(osFilename, poTree) )
+    {
+        if( poTree->nMTime == static_cast<GIntBig>(sStat.st_mtime) &&
+            poTree->nSize == static_cast<vsi_l_offset>(sStat.st_size) )
+        {
+            return poTree;
+        }
+        g_poXMLCache->remove(osFilename);
+    }
+    return nullptr;
+}
+
+static void CacheXMLTree( const std::string& osFilename,
+                          const std::shared_ptr<VRTCachedXMLTree>& poTree,
+                          int nCacheSize )
+{
+    // Only cache plain raster VRTs, whose initialization is known to only
+    // read the tree.
+    const CPLXMLNode* psRoot = CPLGetXMLNode(poTree->psTree.get(),
+                                             "=VRTDataset");
+    if( psRoot == nullptr ||
+        CPLGetXMLValue(psRoot, "subClass", nullptr) != nullptr ||
+        CPLGetXMLNode(psRoot, "Group") != nullptr )
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> oLock(g_oXMLCacheMutex);
+    if( !g_poXMLCache ||
+        g_poXMLCache->getMaxSize() != static_cast<size_t>(nCacheSize) )
+    {
+        g_poXMLCache.reset(new lru11::Cache<std::string,
+                           std::shared_ptr<VRTCachedXMLTree>>(nCacheSize, 0));
+    }
+    g_poXMLCache->insert(osFilename, poTree);
+}
+
+/************************************************************************/
+/*                         ClearXMLTreeCache()                          */
+/************************************************************************/
+
+void VRTDataset::ClearXMLTreeCache()
+{
+    std::lock_guard<std::mutex> oLock(g_oXMLCacheMutex);
+    g_poXMLCache.reset();
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -787,25 +869,39 @@ GDALDataset *VRTDataset::Open( GDALOpenInfo * poOpenInfo )
     VSILFILE *fp = poOpenInfo->fpL;
 
     char *pszVRTPath = nullptr;
+    const int nXMLCacheSize = fp != nullptr ? GetXMLCacheSize() : 0;
+    VSIStatBufL sStat;
+    std::string osXMLCacheKey;
+    std::shared_ptr<VRTCachedXMLTree> poCachedTree;
     if( fp != nullptr )
     {
         poOpenInfo->fpL = nullptr;
 
-        GByte* pabyOut = nullptr;
-        if( !VSIIngestFile( fp, poOpenInfo->pszFilename, &pabyOut,
-                            nullptr, INT_MAX - 1 ) )
-        {
-            CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
-            return nullptr;
-        }
-        pszXML = reinterpret_cast<char*>(pabyOut);
-
         char* pszCurDir = CPLGetCurrentDir();
         const char *currentVrtFilename
             = CPLProjectRelativeFilename(pszCurDir, poOpenInfo->pszFilename);
         CPLString osInitialCurrentVrtFilename(currentVrtFilename);
         CPLFree(pszCurDir);
 
+        if( nXMLCacheSize > 0 &&
+            VSIStatL(poOpenInfo->pszFilename, &sStat) == 0 )
+        {
+            osXMLCacheKey = osInitialCurrentVrtFilename;
+            poCachedTree = GetCachedXMLTree(osXMLCacheKey, sStat);
+        }
+
+        if( poCachedTree == nullptr )
+        {
+            GByte* pabyOut = nullptr;
+            if( !VSIIngestFile( fp, poOpenInfo->pszFilename, &pabyOut,
+                                nullptr, INT_MAX - 1 ) )
+            {
+                CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+                return nullptr;
+            }
+            pszXML = reinterpret_cast<char*>(pabyOut);
+        }
+
 #if defined(HAVE_READLINK) && defined(HAVE_LSTAT)
         char filenameBuffer[2048];
 
@@ -885,8 +981,30 @@ GDALDataset *VRTDataset::Open( GDALOpenInfo * poOpenInfo )
 /* -------------------------------------------------------------------- */
 /*      Turn the XML representation into a VRTDataset.                  */
 /* -------------------------------------------------------------------- */
-    VRTDataset *poDS = static_cast<VRTDataset *>(
-        OpenXML( pszXML, pszVRTPath, poOpenInfo->eAccess ) );
+    VRTDataset *poDS = nullptr;
+    if( !osXMLCacheKey.empty() )
+    {
+        if( poCachedTree == nullptr )
+        {
+            poCachedTree = std::make_shared<VRTCachedXMLTree>();
+            poCachedTree->nMTime = static_cast<GIntBig>(sStat.st_mtime);
+            poCachedTree->nSize = static_cast<vsi_l_offset>(sStat.st_size);
+            poCachedTree->psTree.reset(CPLParseXMLString(pszXML));
+            if( poCachedTree->psTree )
+                CacheXMLTree(osXMLCacheKey, poCachedTree, nXMLCacheSize);
+        }
+        if( poCachedTree->psTree )
+        {
+            poDS = static_cast<VRTDataset *>(
+                OpenXMLTree( poCachedTree->psTree.get(), pszVRTPath,
+                             poOpenInfo->eAccess ) );
+        }
+    }
+    else
+    {
+        poDS = static_cast<VRTDataset *>(
+            OpenXML( pszXML, pszVRTPath, poOpenInfo->eAccess ) );
+    }
 
     if( poDS != nullptr )
         poDS->m_bNeedsFlush =false;
@@ -895,7 +1013,8 @@ GDALDataset *VRTDataset::Open( GDALOpenInfo * poOpenInfo )
     {
         if( poDS->GetRasterCount() == 0 &&
             (poOpenInfo->nOpenFlags & GDAL_OF_MULTIDIM_RASTER) == 0 &&
-            strstr(pszXML, "VRTPansharpenedDataset") == nullptr )
+            (pszXML == nullptr ||
+             strstr(pszXML, "VRTPansharpenedDataset") == nullptr) )
         {
             delete poDS;
             poDS = nullptr;
@@ -1082,7 +1201,22 @@ GDALDataset *VRTDataset::OpenXML( const char *pszXML, const char *pszVRTPath,
     if( psTree == nullptr )
         return nullptr;
 
-    CPLXMLNode *psRoot = CPLGetXMLNode( psTree.get(), "=VRTDataset" );
+    return OpenXMLTree( psTree.get(), pszVRTPath, eAccessIn );
+}
+
+/************************************************************************/
+/*                            OpenXMLTree()                             */
+/*                                                                      */
+/*      Create an open VRTDataset from a parsed XML representation of   */
+/*      the dataset. The tree is not modified.                          */
+/************************************************************************/
+
+GDALDataset *VRTDataset::OpenXMLTree( CPLXMLNode *psTree,
+                                      const char *pszVRTPath,
+                                      GDALAccess eAccessIn )
+
+{
+    CPLXMLNode *psRoot = CPLGetXMLNode( psTree, "=VRTDataset" );
     if( psRoot == nullptr )
     {
         CPLError( CE_Failure, CPLE_AppDefined,
@@ -1803,6 +1937,18 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
         }
     }
 
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if( psExtraArg->bFloatingPointWindowValidity )
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
     // If resampling with non-nearest neighbour, we need to be careful
     // if the VRT band exposes a nodata value, but the sources do not have it
     if( bLocalCompatibleForDatasetIO && eRWFlag == GF_Read &&
@@ -1818,7 +1964,8 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
             const double dfNoDataValue = poBand->GetNoDataValue(&bHasNoData);
             if( bHasNoData )
             {
-                for( int i = 0; i < poBand->nSources; i++ )
+                for( const int i: poBand->GetSourcesIntersectingWindow(
+                                        dfXOff, dfYOff, dfXSize, dfYSize) )
                 {
                     VRTSimpleSource* poSource
                         = static_cast<VRTSimpleSource *>(
@@ -1876,20 +2023,22 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand* poBand = static_cast<VRTSourcedRasterBand *>(
             papoBands[nBands - 1] );
-        for( int iSource = 0;
-             eErr == CE_None && iSource < poBand->nSources;
-             iSource++ )
+        const std::vector<int> anSources =
+            poBand->GetSourcesIntersectingWindow(dfXOff, dfYOff,
+                                                 dfXSize, dfYSize);
+        const int nCandidates = static_cast<int>(anSources.size());
+        for( int i = 0; eErr == CE_None && i < nCandidates; i++ )
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData =
                 GDALCreateScaledProgress(
-                    1.0 * iSource / poBand->nSources,
-                    1.0 * (iSource + 1) / poBand->nSources,
+                    1.0 * i / nCandidates,
+                    1.0 * (i + 1) / nCandidates,
                     pfnProgressGlobal,
                     pProgressDataGlobal );
 
             VRTSimpleSource* poSource = static_cast<VRTSimpleSource *>(
-                poBand->papoSources[iSource] );
+                poBand->papoSources[anSources[i]] );
 
             eErr = poSource->DatasetRasterIO( poBand->GetRasterDataType(),
                                               nXOff, nYOff, nXSize, nYSize,
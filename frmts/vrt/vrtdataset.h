@@ -35,6 +35,7 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -205,6 +206,9 @@ class CPL_DLL VRTDataset CPL_NON_FINAL: public GDALDataset
     VRTRasterBand*      InitBand(const char* pszSubclass, int nBand,
                                  bool bAllowPansharpened);
     static GDALDataset *OpenVRTProtocol( const char* pszSpec );
+    static GDALDataset *OpenXMLTree( CPLXMLNode *psTree,
+                                     const char *pszVRTPath,
+                                     GDALAccess eAccess );
     bool                AddVirtualOverview(int nOvFactor,
                                            const char* pszResampling);
 
@@ -293,6 +297,8 @@ class CPL_DLL VRTDataset CPL_NON_FINAL: public GDALDataset
                                                 CSLConstList papszRootGroupOptions,
                                                 CSLConstList papszOptions );
     static CPLErr       Delete( const char * pszFilename );
+
+    static void         ClearXMLTreeCache();
 };
 
 /************************************************************************/
@@ -580,10 +586,32 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL: public VRTRasterBand
     char         **m_papszSourceList = nullptr;
     int            m_nSkipBufferInitialization = -1;
 
+    // Spatial index of the destination windows of the sources, built on
+    // demand by GetSourcesIntersectingWindow() for bands with many sources.
+    CPLQuadTree   *m_hSourcesIndex = nullptr;
+    int            m_nSourcesIndexed = 0;
+    // Sources whose destination window is not known, and must always be
+    // considered.
+    std::vector<int> m_anSourcesNotIndexed{};
+
+    void           BuildSourcesIndex();
+    void           InvalidateSourcesIndex();
+
     bool           CanUseSourcesMinMaxImplementations();
 
     bool           IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(bool bAllowMaxValAdjustment) const;
 
+    bool           SourcesRasterIOMultiThreaded( const std::vector<int>& anSources,
+                                                 int nXOff, int nYOff,
+                                                 int nXSize, int nYSize,
+                                                 void *pData,
+                                                 int nBufXSize, int nBufYSize,
+                                                 GDALDataType eBufType,
+                                                 GSpacing nPixelSpace,
+                                                 GSpacing nLineSpace,
+                                                 GDALRasterIOExtraArg* psExtraArg,
+                                                 CPLErr& eErr );
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   protected:
@@ -643,6 +671,11 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL: public VRTRasterBand
                                   GDALProgressFunc pfnProgress,
                                   void *pProgressData ) override;
 
+    std::vector<int> GetSourcesIntersectingWindow( double dfXOff,
+                                                   double dfYOff,
+                                                   double dfXSize,
+                                                   double dfYSize );
+
     CPLErr         AddSource( VRTSource * );
 
     CPLErr         AddSimpleSource( const char* pszFilename,
@@ -1163,6 +1196,9 @@ public:
 
     bool           AreValuesUnchanged() const;
 
+    // Whether some pixels of the destination window may be left untouched
+    bool           HasNoDataOrMaskBand() const { return m_bNoDataSet || m_bUseMaskBand; }
+
     double  LookupValue( double dfInput );
 
     void    SetNoDataValue( double dfNoDataValue );
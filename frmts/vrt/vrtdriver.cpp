@@ -61,6 +61,7 @@ VRTDriver::~VRTDriver()
 {
     CSLDestroy( papszSourceParsers );
     VRTDerivedRasterBand::Cleanup();
+    VRTDataset::ClearXMLTreeCache();
 #if 0
     if(  pDeserializerData )
     {
@@ -38,6 +38,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <map>
 #include <mutex>
 #include <set>
 #include <string>
@@ -129,6 +130,7 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
 
 {
     VRTSourcedRasterBand::CloseDependentDatasets();
+    InvalidateSourcesIndex();
     CSLDestroy(m_papszSourceList);
 }
 
@@ -186,6 +188,22 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
             return CE_None;
     }
 
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if( psExtraArg->bFloatingPointWindowValidity )
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+    // Only consider the sources that may intersect the request
+    const std::vector<int> anSources =
+        GetSourcesIntersectingWindow(dfXOff, dfYOff, dfXSize, dfYSize);
+
     // If resampling with non-nearest neighbour, we need to be careful
     // if the VRT band exposes a nodata value, but the sources do not have it
     if( eRWFlag == GF_Read &&
@@ -193,7 +211,7 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
         psExtraArg->eResampleAlg != GRIORA_NearestNeighbour &&
         m_bNoDataValueSet )
     {
-        for( int i = 0; i < nSources; i++ )
+        for( const int i: anSources )
         {
             bool bFallbackToBase = false;
             if( !papoSources[i]->IsSimpleSource() )
@@ -205,18 +223,6 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
                 VRTSimpleSource* const poSource
                     = static_cast<VRTSimpleSource *>( papoSources[i] );
 
-                double dfXOff = nXOff;
-                double dfYOff = nYOff;
-                double dfXSize = nXSize;
-                double dfYSize = nYSize;
-                if( psExtraArg->bFloatingPointWindowValidity )
-                {
-                    dfXOff = psExtraArg->dfXOff;
-                    dfYOff = psExtraArg->dfYOff;
-                    dfXSize = psExtraArg->dfXSize;
-                    dfYSize = psExtraArg->dfYSize;
-                }
-
                 // The window we will actually request from the source raster band.
                 double dfReqXOff = 0.0;
                 double dfReqYOff = 0.0;
@@ -326,26 +332,39 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     void * const pProgressDataGlobal = psExtraArg->pProgressData;
 
 /* -------------------------------------------------------------------- */
-/*      Overlay each source in turn over top this.                      */
+/*      Read sources concurrently if allowed.                           */
 /* -------------------------------------------------------------------- */
     CPLErr eErr = CE_None;
-    for( int iSource = 0; eErr == CE_None && iSource < nSources; iSource++ )
+    if( SourcesRasterIOMultiThreaded( anSources,
+                                      nXOff, nYOff, nXSize, nYSize,
+                                      pData, nBufXSize, nBufYSize,
+                                      eBufType, nPixelSpace, nLineSpace,
+                                      psExtraArg, eErr ) )
+    {
+        return eErr;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Overlay each source in turn over top this.                      */
+/* -------------------------------------------------------------------- */
+    const int nCandidates = static_cast<int>(anSources.size());
+    for( int i = 0; eErr == CE_None && i < nCandidates; i++ )
     {
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData =
-            GDALCreateScaledProgress( 1.0 * iSource / nSources,
-                                      1.0 * (iSource + 1) / nSources,
+            GDALCreateScaledProgress( 1.0 * i / nCandidates,
+                                      1.0 * (i + 1) / nCandidates,
                                       pfnProgressGlobal,
                                       pProgressDataGlobal );
         if( psExtraArg->pProgressData == nullptr )
             psExtraArg->pfnProgress = nullptr;
 
         eErr =
-            papoSources[iSource]->RasterIO( eDataType,
-                                            nXOff, nYOff, nXSize, nYSize,
-                                            pData, nBufXSize, nBufYSize,
-                                            eBufType, nPixelSpace, nLineSpace,
-                                            psExtraArg);
+            papoSources[anSources[i]]->RasterIO( eDataType,
+                                                 nXOff, nYOff, nXSize, nYSize,
+                                                 pData, nBufXSize, nBufYSize,
+                                                 eBufType, nPixelSpace, nLineSpace,
+                                                 psExtraArg);
 
         GDALDestroyScaledProgress( psExtraArg->pProgressData );
     }
@@ -356,6 +375,448 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                      GetNumThreadsForSources()                       */
+/************************************************************************/
+
+static int GetNumThreadsForSources()
+{
+    const char* pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if( pszValue == nullptr )
+        return 1;
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if( nThreads > 1024 )
+        nThreads = 1024; // to please Coverity
+    return nThreads;
+}
+
+namespace {
+
+enum class VRTSourceReadMode
+{
+    SKIP,       // the source does not intersect the request
+    SEQUENTIAL, // read by the calling thread, in order
+    DIRECT,     // read by a worker thread, directly into the output buffer
+    TEMP        // read by a worker thread into a temporary buffer
+};
+
+struct VRTSourceReadPlan
+{
+    int               iSource = 0;
+    VRTSourceReadMode eMode = VRTSourceReadMode::SEQUENTIAL;
+    int               nOutXOff = 0;
+    int               nOutYOff = 0;
+    int               nOutXSize = 0;
+    int               nOutYSize = 0;
+    GByte            *pabyTemp = nullptr;
+};
+
+struct VRTSourcesReadContext
+{
+    VRTSource                     **papoSources = nullptr;
+    const std::vector<VRTSourceReadPlan>* pasPlans = nullptr;
+    GDALDataType                    eDataType = GDT_Unknown;
+    int                             nXOff = 0;
+    int                             nYOff = 0;
+    int                             nXSize = 0;
+    int                             nYSize = 0;
+    void                           *pData = nullptr;
+    int                             nBufXSize = 0;
+    int                             nBufYSize = 0;
+    GDALDataType                    eBufType = GDT_Unknown;
+    GSpacing                        nPixelSpace = 0;
+    GSpacing                        nLineSpace = 0;
+    GDALRasterIOExtraArg           *psExtraArg = nullptr;
+};
+
+struct VRTSourcesReadJob
+{
+    const VRTSourcesReadContext* psContext = nullptr;
+    // Indices in the plans of sources that refer to the same dataset, and
+    // are read in order.
+    std::vector<int>             anPlans{};
+    CPLErr                       eErr = CE_None;
+
+    static void Run( void* pData );
+};
+
+void VRTSourcesReadJob::Run( void* pData )
+{
+    auto psJob = static_cast<VRTSourcesReadJob*>(pData);
+    const VRTSourcesReadContext* psContext = psJob->psContext;
+    const int nDTSize = GDALGetDataTypeSizeBytes(psContext->eBufType);
+
+    for( const int iPlan: psJob->anPlans )
+    {
+        const VRTSourceReadPlan& sPlan = (*psContext->pasPlans)[iPlan];
+        GDALRasterIOExtraArg sExtraArg;
+        GDALCopyRasterIOExtraArg(&sExtraArg, psContext->psExtraArg);
+        sExtraArg.pfnProgress = nullptr;
+        sExtraArg.pProgressData = nullptr;
+
+        GByte* pabyData = static_cast<GByte*>(psContext->pData);
+        GSpacing nPixelSpace = psContext->nPixelSpace;
+        GSpacing nLineSpace = psContext->nLineSpace;
+        if( sPlan.eMode == VRTSourceReadMode::TEMP )
+        {
+            // The source only writes within its destination window, so
+            // offset the buffer such that this window maps to the temporary
+            // buffer.
+            nPixelSpace = nDTSize;
+            nLineSpace = static_cast<GSpacing>(nDTSize) * sPlan.nOutXSize;
+            pabyData = sPlan.pabyTemp
+                - static_cast<GPtrDiff_t>(sPlan.nOutYOff) * nLineSpace
+                - static_cast<GPtrDiff_t>(sPlan.nOutXOff) * nPixelSpace;
+        }
+        psJob->eErr = psContext->papoSources[sPlan.iSource]->RasterIO(
+            psContext->eDataType,
+            psContext->nXOff, psContext->nYOff,
+            psContext->nXSize, psContext->nYSize,
+            pabyData,
+            psContext->nBufXSize, psContext->nBufYSize,
+            psContext->eBufType,
+            nPixelSpace, nLineSpace,
+            &sExtraArg);
+        if( psJob->eErr != CE_None )
+            break;
+    }
+}
+
+} // namespace
+
+/************************************************************************/
+/*                    SourcesRasterIOMultiThreaded()                    */
+/************************************************************************/
+
+/* Reads the sources intersecting the request from worker threads of the
+ * global thread pool, when GDAL_NUM_THREADS is set. anSources are the
+ * indices of the candidate sources, in increasing order.
+ *
+ * Sources referring to the same dataset are read by the same job, one after
+ * the other, so that a dataset (or the underlying dataset of the proxy pool
+ * entry that backs it) is never accessed by two threads at the same time.
+ * Sources that do not overlap an earlier source are read directly into the
+ * output buffer. Other simple and complex sources that set all the pixels of
+ * their destination window are read into a temporary buffer, which is copied
+ * into the output buffer in source order once all jobs are done. Remaining
+ * sources (nodata value, mask band, other source types) are read in order by
+ * the calling thread during that composition, so that the last source still
+ * wins.
+ *
+ * Returns false if the request must be processed sequentially.
+ */
+bool VRTSourcedRasterBand::SourcesRasterIOMultiThreaded(
+                                        const std::vector<int>& anSources,
+                                        int nXOff, int nYOff,
+                                        int nXSize, int nYSize,
+                                        void *pData,
+                                        int nBufXSize, int nBufYSize,
+                                        GDALDataType eBufType,
+                                        GSpacing nPixelSpace,
+                                        GSpacing nLineSpace,
+                                        GDALRasterIOExtraArg* psExtraArg,
+                                        CPLErr& eErr )
+{
+    const int nCandidates = static_cast<int>(anSources.size());
+    if( nCandidates < 2 )
+        return false;
+    const int nThreads = GetNumThreadsForSources();
+    if( nThreads <= 1 )
+        return false;
+
+    // When called from a job of the global thread pool (sources of a VRT
+    // nested in a source being read by SourcesRasterIOMultiThreaded(), or
+    // any other user of that pool), waiting for our own jobs could deadlock
+    // once all worker threads wait the same way. This also keeps recursion
+    // bounded by the anti-recursion guards of the calling thread.
+    auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if( poThreadPool == nullptr || poThreadPool->IsCurrentThreadWorker() )
+        return false;
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if( psExtraArg->bFloatingPointWindowValidity )
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Establish how each source is going to be read.                  */
+/* -------------------------------------------------------------------- */
+    const int nDTSize = GDALGetDataTypeSizeBytes(eBufType);
+    const GIntBig nTempBudget = GDALGetCacheMax64();
+    GIntBig nTempSize = 0;
+    std::vector<VRTSourceReadPlan> asPlans(nCandidates);
+    std::vector<VRTSourcesReadJob> asJobs;
+    std::map<std::string, size_t> oMapDatasetToJob;
+    int nParallelSources = 0;
+
+    const auto IntersectsEarlierSource = [&asPlans](int iPlan)
+    {
+        const VRTSourceReadPlan& sPlan = asPlans[iPlan];
+        for( int i = 0; i < iPlan; ++i )
+        {
+            const VRTSourceReadPlan& sOther = asPlans[i];
+            if( sOther.eMode != VRTSourceReadMode::SKIP &&
+                sOther.nOutXOff < sPlan.nOutXOff + sPlan.nOutXSize &&
+                sPlan.nOutXOff < sOther.nOutXOff + sOther.nOutXSize &&
+                sOther.nOutYOff < sPlan.nOutYOff + sPlan.nOutYSize &&
+                sPlan.nOutYOff < sOther.nOutYOff + sOther.nOutYSize )
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for( int iPlan = 0; iPlan < nCandidates; ++iPlan )
+    {
+        const int iSource = anSources[iPlan];
+        VRTSourceReadPlan& sPlan = asPlans[iPlan];
+        sPlan.iSource = iSource;
+        // Until proven otherwise, a source may write anywhere.
+        sPlan.nOutXSize = nBufXSize;
+        sPlan.nOutYSize = nBufYSize;
+        if( !papoSources[iSource]->IsSimpleSource() )
+            continue;
+
+        auto poSimpleSource =
+            cpl::down_cast<VRTSimpleSource*>(papoSources[iSource]);
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        int nOutXOff = 0;
+        int nOutYOff = 0;
+        int nOutXSize = 0;
+        int nOutYSize = 0;
+        bool bError = false;
+        if( !poSimpleSource->GetSrcDstWindow(
+                dfXOff, dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize,
+                &dfReqXOff, &dfReqYOff, &dfReqXSize, &dfReqYSize,
+                &nReqXOff, &nReqYOff, &nReqXSize, &nReqYSize,
+                &nOutXOff, &nOutYOff, &nOutXSize, &nOutYSize,
+                bError ) )
+        {
+            if( !bError )
+                sPlan.eMode = VRTSourceReadMode::SKIP;
+            continue;
+        }
+        sPlan.nOutXOff = nOutXOff;
+        sPlan.nOutYOff = nOutYOff;
+        sPlan.nOutXSize = nOutXSize;
+        sPlan.nOutYSize = nOutYSize;
+
+        // This opens the source dataset if needed, which must be done by
+        // this thread.
+        auto poSourceBand = poSimpleSource->GetRasterBand();
+        auto poSourceDS = poSourceBand ? poSourceBand->GetDataset() : nullptr;
+        if( poSourceDS == nullptr )
+            continue;
+
+        if( !IntersectsEarlierSource(iPlan) )
+        {
+            sPlan.eMode = VRTSourceReadMode::DIRECT;
+        }
+        else
+        {
+            bool bSetsAllPixels;
+            auto poComplexSource =
+                dynamic_cast<VRTComplexSource*>(poSimpleSource);
+            if( poComplexSource )
+            {
+                bSetsAllPixels =
+                    EQUAL(poComplexSource->GetType(), "ComplexSource") &&
+                    dynamic_cast<VRTFilteredSource*>(poComplexSource) == nullptr &&
+                    !poComplexSource->HasNoDataOrMaskBand();
+            }
+            else
+            {
+                bSetsAllPixels =
+                    EQUAL(poSimpleSource->GetType(), "SimpleSource");
+            }
+            const GIntBig nSize =
+                static_cast<GIntBig>(nOutXSize) * nOutYSize * nDTSize;
+            if( !bSetsAllPixels || nTempSize + nSize > nTempBudget )
+                continue;
+            sPlan.eMode = VRTSourceReadMode::TEMP;
+            nTempSize += nSize;
+        }
+
+        // If the datasets belong to the MEM driver, or have no name, use
+        // GDALDataset* pointer values. Otherwise use the dataset name, as
+        // the proxy pool shares underlying datasets by name.
+        std::string osKey;
+        auto poDriver = poSourceDS->GetDriver();
+        if( (poDriver && EQUAL(poDriver->GetDescription(), "MEM")) ||
+            poSourceDS->GetDescription()[0] == '\0' )
+        {
+            osKey = CPLSPrintf("%p", poSourceDS);
+        }
+        else
+        {
+            osKey = std::string("name:") + poSourceDS->GetDescription();
+        }
+        auto oIter = oMapDatasetToJob.find(osKey);
+        if( oIter == oMapDatasetToJob.end() )
+        {
+            oIter = oMapDatasetToJob.insert(
+                std::make_pair(osKey, asJobs.size())).first;
+            asJobs.emplace_back(VRTSourcesReadJob());
+        }
+        asJobs[oIter->second].anPlans.push_back(iPlan);
+        ++nParallelSources;
+    }
+
+    if( asJobs.size() < 2 )
+        return false;
+
+    const auto FreeTempBuffers = [&asPlans]()
+    {
+        for( auto& sPlan: asPlans )
+        {
+            VSIFree(sPlan.pabyTemp);
+            sPlan.pabyTemp = nullptr;
+        }
+    };
+    for( auto& sPlan: asPlans )
+    {
+        if( sPlan.eMode == VRTSourceReadMode::TEMP )
+        {
+            sPlan.pabyTemp = static_cast<GByte*>(VSI_MALLOC3_VERBOSE(
+                sPlan.nOutXSize, sPlan.nOutYSize, nDTSize));
+            if( sPlan.pabyTemp == nullptr )
+            {
+                FreeTempBuffers();
+                eErr = CE_Failure;
+                return true;
+            }
+        }
+    }
+
+    CPLDebugOnly("VRT", "IRasterIO(): read %d sources out of %d with %d jobs",
+                 nParallelSources, nCandidates,
+                 static_cast<int>(asJobs.size()));
+
+/* -------------------------------------------------------------------- */
+/*      Read sources concurrently.                                      */
+/* -------------------------------------------------------------------- */
+    VRTSourcesReadContext sContext;
+    sContext.papoSources = papoSources;
+    sContext.pasPlans = &asPlans;
+    sContext.eDataType = eDataType;
+    sContext.nXOff = nXOff;
+    sContext.nYOff = nYOff;
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.pData = pData;
+    sContext.nBufXSize = nBufXSize;
+    sContext.nBufYSize = nBufYSize;
+    sContext.eBufType = eBufType;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    sContext.psExtraArg = psExtraArg;
+
+    eErr = CE_None;
+    auto poQueue = poThreadPool->CreateJobQueue();
+    for( auto& sJob: asJobs )
+    {
+        sJob.psContext = &sContext;
+        if( !poQueue->SubmitJob(VRTSourcesReadJob::Run, &sJob) )
+        {
+            eErr = CE_Failure;
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+    for( const auto& sJob: asJobs )
+    {
+        if( sJob.eErr != CE_None )
+            eErr = CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Composite sources in order.                                     */
+/* -------------------------------------------------------------------- */
+    GDALProgressFunc const pfnProgressGlobal = psExtraArg->pfnProgress;
+    void * const pProgressDataGlobal = psExtraArg->pProgressData;
+
+    for( int iPlan = 0; eErr == CE_None && iPlan < nCandidates; iPlan++ )
+    {
+        const VRTSourceReadPlan& sPlan = asPlans[iPlan];
+        if( sPlan.eMode == VRTSourceReadMode::SEQUENTIAL )
+        {
+            psExtraArg->pfnProgress = GDALScaledProgress;
+            psExtraArg->pProgressData =
+                GDALCreateScaledProgress( 1.0 * iPlan / nCandidates,
+                                          1.0 * (iPlan + 1) / nCandidates,
+                                          pfnProgressGlobal,
+                                          pProgressDataGlobal );
+            if( psExtraArg->pProgressData == nullptr )
+                psExtraArg->pfnProgress = nullptr;
+
+            eErr =
+                papoSources[sPlan.iSource]->RasterIO( eDataType,
+                                                      nXOff, nYOff,
+                                                      nXSize, nYSize,
+                                                      pData,
+                                                      nBufXSize, nBufYSize,
+                                                      eBufType, nPixelSpace,
+                                                      nLineSpace, psExtraArg );
+
+            GDALDestroyScaledProgress( psExtraArg->pProgressData );
+            psExtraArg->pfnProgress = pfnProgressGlobal;
+            psExtraArg->pProgressData = pProgressDataGlobal;
+            continue;
+        }
+
+        if( sPlan.eMode == VRTSourceReadMode::TEMP )
+        {
+            const size_t nTempLineSize =
+                static_cast<size_t>(nDTSize) * sPlan.nOutXSize;
+            for( int iY = 0; iY < sPlan.nOutYSize; iY++ )
+            {
+                GByte* pabyDst = static_cast<GByte *>(pData)
+                    + static_cast<GPtrDiff_t>(sPlan.nOutYOff + iY) * nLineSpace
+                    + static_cast<GPtrDiff_t>(sPlan.nOutXOff) * nPixelSpace;
+                const GByte* pabySrc = sPlan.pabyTemp + iY * nTempLineSize;
+                if( nPixelSpace == nDTSize )
+                {
+                    memcpy(pabyDst, pabySrc, nTempLineSize);
+                }
+                else
+                {
+                    GDALCopyWords(pabySrc, eBufType, nDTSize,
+                                  pabyDst, eBufType,
+                                  static_cast<int>(nPixelSpace),
+                                  sPlan.nOutXSize);
+                }
+            }
+        }
+
+        if( pfnProgressGlobal &&
+            !pfnProgressGlobal(1.0 * (iPlan + 1) / nCandidates, "",
+                               pProgressDataGlobal) )
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    FreeTempBuffers();
+    return true;
+}
+
 /************************************************************************/
 /*                         IGetDataCoverageStatus()                     */
 /************************************************************************/
@@ -394,7 +855,8 @@ int  VRTSourcedRasterBand::IGetDataCoverageStatus( int nXOff,
     poLR->addPoint( nXOff, nYOff );
     poPolyNonCoveredBySources->addRingDirectly(poLR);
 
-    for( int iSource = 0; iSource < nSources; iSource++ )
+    for( const int iSource: GetSourcesIntersectingWindow(nXOff, nYOff,
+                                                         nXSize, nYSize) )
     {
         if( !papoSources[iSource]->IsSimpleSource() )
         {
@@ -1347,6 +1809,10 @@ VRTSourcedRasterBand::ComputeStatistics( int bApproxOK,
                 if( nThreads > 1 )
                 {
                     poThreadPool = GDALGetGlobalThreadPool(nThreads);
+                    // Do not wait for jobs from a worker of the same pool
+                    // (VRT nested in a source of a VRT being processed here)
+                    if( poThreadPool && poThreadPool->IsCurrentThreadWorker() )
+                        poThreadPool = nullptr;
                 }
             }
         }
@@ -1591,6 +2057,7 @@ CPLErr VRTSourcedRasterBand::AddSource( VRTSource *poNewSource )
     papoSources = static_cast<VRTSource **>(
         CPLRealloc( papoSources, sizeof(void*) * nSources ) );
     papoSources[nSources-1] = poNewSource;
+    InvalidateSourcesIndex();
 
     static_cast<VRTDataset *>( poDS )->SetNeedsFlush();
 
@@ -1610,6 +2077,141 @@ CPLErr VRTSourcedRasterBand::AddSource( VRTSource *poNewSource )
     return CE_None;
 }
 
+/************************************************************************/
+/*                       InvalidateSourcesIndex()                       */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourcesIndex()
+
+{
+    if( m_hSourcesIndex )
+    {
+        CPLQuadTreeDestroy(m_hSourcesIndex);
+        m_hSourcesIndex = nullptr;
+    }
+    m_nSourcesIndexed = 0;
+    m_anSourcesNotIndexed.clear();
+}
+
+/************************************************************************/
+/*                         BuildSourcesIndex()                          */
+/************************************************************************/
+
+void VRTSourcedRasterBand::BuildSourcesIndex()
+
+{
+    InvalidateSourcesIndex();
+
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = 0;
+    sGlobalBounds.miny = 0;
+    sGlobalBounds.maxx = nRasterXSize;
+    sGlobalBounds.maxy = nRasterYSize;
+    std::vector<CPLRectObj> asRects(nSources);
+    std::vector<bool> abIndexed(nSources);
+    for( int i = 0; i < nSources; ++i )
+    {
+        if( !papoSources[i]->IsSimpleSource() )
+            continue;
+        auto poSimpleSource = cpl::down_cast<VRTSimpleSource*>(papoSources[i]);
+        // A source without destination window covers the whole band, but
+        // leave it to GetSrcDstWindow() to figure out.
+        if( poSimpleSource->m_dfDstXOff == -1 &&
+            poSimpleSource->m_dfDstYOff == -1 &&
+            poSimpleSource->m_dfDstXSize == -1 &&
+            poSimpleSource->m_dfDstYSize == -1 )
+        {
+            continue;
+        }
+        CPLRectObj& sRect = asRects[i];
+        sRect.minx = poSimpleSource->m_dfDstXOff;
+        sRect.miny = poSimpleSource->m_dfDstYOff;
+        sRect.maxx = poSimpleSource->m_dfDstXOff + poSimpleSource->m_dfDstXSize;
+        sRect.maxy = poSimpleSource->m_dfDstYOff + poSimpleSource->m_dfDstYSize;
+        // Also rejects NaN
+        if( !(sRect.maxx > sRect.minx) || !(sRect.maxy > sRect.miny) ||
+            !std::isfinite(sRect.maxx) || !std::isfinite(sRect.maxy) )
+        {
+            continue;
+        }
+        abIndexed[i] = true;
+        sGlobalBounds.minx = std::min(sGlobalBounds.minx, sRect.minx);
+        sGlobalBounds.miny = std::min(sGlobalBounds.miny, sRect.miny);
+        sGlobalBounds.maxx = std::max(sGlobalBounds.maxx, sRect.maxx);
+        sGlobalBounds.maxy = std::max(sGlobalBounds.maxy, sRect.maxy);
+    }
+
+    m_hSourcesIndex = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+    for( int i = 0; i < nSources; ++i )
+    {
+        if( abIndexed[i] )
+        {
+            CPLQuadTreeInsertWithBounds(m_hSourcesIndex,
+                reinterpret_cast<void*>(static_cast<uintptr_t>(i)),
+                &asRects[i]);
+        }
+        else
+        {
+            m_anSourcesNotIndexed.push_back(i);
+        }
+    }
+    m_nSourcesIndexed = nSources;
+}
+
+/************************************************************************/
+/*                    GetSourcesIntersectingWindow()                    */
+/************************************************************************/
+
+/* Returns, in increasing order, the indices of the sources whose destination
+ * window may intersect the given window, expressed in pixel coordinates of
+ * the band. Sources not returned are guaranteed not to contribute to it.
+ *
+ * For bands with many sources, such as large mosaics, this uses a spatial
+ * index that is built on the first call, and invalidated when sources are
+ * added or removed.
+ */
+std::vector<int> VRTSourcedRasterBand::GetSourcesIntersectingWindow(
+                                double dfXOff, double dfYOff,
+                                double dfXSize, double dfYSize )
+{
+    // Below that number of sources, a linear scan of the sources is cheap
+    // enough.
+    constexpr int MIN_SOURCES_FOR_INDEX = 64;
+
+    std::vector<int> anSources;
+    if( nSources < MIN_SOURCES_FOR_INDEX )
+    {
+        anSources.reserve(nSources);
+        for( int i = 0; i < nSources; ++i )
+            anSources.push_back(i);
+        return anSources;
+    }
+
+    if( m_hSourcesIndex == nullptr || m_nSourcesIndexed != nSources )
+        BuildSourcesIndex();
+
+    CPLRectObj sAoi;
+    sAoi.minx = dfXOff;
+    sAoi.miny = dfYOff;
+    sAoi.maxx = dfXOff + dfXSize;
+    sAoi.maxy = dfYOff + dfYSize;
+    int nFeatureCount = 0;
+    void** pahFeatures =
+        CPLQuadTreeSearch(m_hSourcesIndex, &sAoi, &nFeatureCount);
+    anSources.reserve(nFeatureCount + m_anSourcesNotIndexed.size());
+    for( int i = 0; i < nFeatureCount; ++i )
+    {
+        anSources.push_back(static_cast<int>(
+            reinterpret_cast<uintptr_t>(pahFeatures[i])));
+    }
+    CPLFree(pahFeatures);
+    anSources.insert(anSources.end(), m_anSourcesNotIndexed.begin(),
+                     m_anSourcesNotIndexed.end());
+    // Sources must be processed in their order of declaration
+    std::sort(anSources.begin(), anSources.end());
+    return anSources;
+}
+
 /*! @endcond */
 
 /************************************************************************/
@@ -2424,6 +3026,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem( const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourcesIndex();
             static_cast<VRTDataset *>( poDS )->SetNeedsFlush();
             return CE_None;
         }
@@ -2455,6 +3058,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata( char **papszNewMD, const char *pszDoma
             CPLFree( papoSources );
             papoSources = nullptr;
             nSources = 0;
+            InvalidateSourcesIndex();
         }
 
         for( int i = 0; i < CSLCount(papszNewMD); i++ )
@@ -2519,6 +3123,7 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
     CPLFree( papoSources );
     papoSources = nullptr;
     nSources = 0;
+    InvalidateSourcesIndex();
 
     return TRUE;
 }
@@ -2698,6 +3303,7 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
             papoSources[iDst++] = papoSources[iSrc];
     }
     nSources = iDst;
+    InvalidateSourcesIndex();
 
     CPLQuadTreeDestroy(hTree);
 #endif
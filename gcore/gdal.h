@@ -1759,6 +1759,13 @@ void CPL_DLL CPL_STDCALL GDALSetCacheMax64( GIntBig nBytes );
 GIntBig CPL_DLL CPL_STDCALL GDALGetCacheMax64(void);
 GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
+int CPL_DLL CPL_STDCALL GDALGetCacheShardCount(void);
+int CPL_DLL CPL_STDCALL GDALGetCacheShardStatistics( int iShard,
+                                                     GIntBig *pnUsed,
+                                                     GUIntBig *pnHits,
+                                                     GUIntBig *pnMisses,
+                                                     GUIntBig *pnEvictions );
+
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
 /* ==================================================================== */
@@ -950,6 +950,8 @@ class CPL_DLL GDALRasterBlock
 
     bool                 bMustDetach;
 
+    GUIntBig             nLRUTick;
+
     CPL_INTERNAL void        Detach_unlocked( void );
     CPL_INTERNAL void        Touch_unlocked( void );
 
@@ -298,9 +298,10 @@ GDALDriverManager::~GDALDriverManager()
     GDALRasterBlock::DestroyRBMutex();
 
 /* -------------------------------------------------------------------- */
-/*      Cleanup gdaltransformer.cpp mutex.                              */
+/*      Cleanup gdaltransformer.cpp mutex and grid cache.               */
 /* -------------------------------------------------------------------- */
     GDALCleanupTransformDeserializerMutex();
+    GDALCleanupTransformGridCache();
 
 /* -------------------------------------------------------------------- */
 /*      Cleanup cpl_error.cpp mutex.                                    */
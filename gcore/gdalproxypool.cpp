@@ -30,9 +30,12 @@
 #include "cpl_port.h"
 #include "gdal_proxy.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -64,16 +67,17 @@ void GDALNullifyProxyPoolSingleton() { singleton = nullptr; }
 
 struct _GDALProxyPoolCacheEntry
 {
-    GIntBig       responsiblePID;
-    char         *pszFileNameAndOpenOptions;
-    char         *pszOwner;
-    GDALDataset  *poDS;
+    GIntBig       responsiblePID = 0;
+    char         *pszFileNameAndOpenOptions = nullptr;
+    char         *pszOwner = nullptr;
+    GDALDataset  *poDS = nullptr;
 
-    /* Ref count of the cached dataset */
-    int           refCount;
+    /* Ref count of the cached dataset. Incremented under the pool mutex, */
+    /* but decremented without it. */
+    std::atomic<int> refCount{0};
 
-    GDALProxyPoolCacheEntry* prev;
-    GDALProxyPoolCacheEntry* next;
+    GDALProxyPoolCacheEntry* prev = nullptr;
+    GDALProxyPoolCacheEntry* next = nullptr;
 };
 
 class GDALDatasetPool
@@ -92,6 +96,15 @@ class GDALDatasetPool
         GDALProxyPoolCacheEntry* firstEntry = nullptr;
         GDALProxyPoolCacheEntry* lastEntry = nullptr;
 
+        /* Entries with a dataset name, indexed by pszFileNameAndOpenOptions, */
+        /* so that lookups do not need to walk the LRU list */
+        std::unordered_multimap<std::string, GDALProxyPoolCacheEntry*> oMapEntries{};
+
+        /* Statistics, reported in debug mode on destruction */
+        GIntBig nHits = 0;
+        GIntBig nOpens = 0;
+        GIntBig nEvictions = 0;
+
         /* This variable prevents a dataset that is going to be opened in GDALDatasetPool::_RefDataset */
         /* from increasing refCount if, during its opening, it creates a GDALProxyPoolDataset */
         /* We increment it before opening or closing a cached dataset and decrement it afterwards */
@@ -104,6 +117,7 @@ class GDALDatasetPool
         /* least greater or equal than the maximum number of threads */
         explicit GDALDatasetPool(int maxSize);
         ~GDALDatasetPool();
+        void RemoveFromIndex(GDALProxyPoolCacheEntry* entry);
         GDALProxyPoolCacheEntry* _RefDataset(const char* pszFileName,
                                              GDALAccess eAccess,
                                              CSLConstList papszOpenOptions,
@@ -159,6 +173,13 @@ GDALDatasetPool::GDALDatasetPool(int maxSizeIn): maxSize(maxSizeIn)
 GDALDatasetPool::~GDALDatasetPool()
 {
     bInDestruction = true;
+    if( nOpens > 0 )
+    {
+        CPLDebug("GDAL",
+                 "Dataset pool: " CPL_FRMT_GIB " hits, " CPL_FRMT_GIB
+                 " opens, " CPL_FRMT_GIB " evictions",
+                 nHits, nOpens, nEvictions);
+    }
     GDALProxyPoolCacheEntry* cur = firstEntry;
     GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
     while(cur)
@@ -172,7 +193,7 @@ GDALDatasetPool::~GDALDatasetPool()
             GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
             GDALClose(cur->poDS);
         }
-        CPLFree(cur);
+        delete cur;
         cur = next;
     }
     GDALSetResponsiblePIDForCurrentThread(responsiblePID);
@@ -192,7 +213,7 @@ void GDALDatasetPool::ShowContent()
         printf("[%d] pszFileName=%s, owner=%s, refCount=%d, responsiblePID=%d\n",/*ok*/
                i, cur->pszFileNameAndOpenOptions,
                cur->pszOwner ? cur->pszOwner : "(null)",
-               cur->refCount, (int)cur->responsiblePID);
+               cur->refCount.load(), (int)cur->responsiblePID);
         i++;
         cur = cur->next;
     }
@@ -235,6 +256,23 @@ static std::string GetFilenameAndOpenOptions(const char* pszFileName,
     return osFilenameAndOO;
 }
 
+/************************************************************************/
+/*                          RemoveFromIndex()                           */
+/************************************************************************/
+
+void GDALDatasetPool::RemoveFromIndex(GDALProxyPoolCacheEntry* entry)
+{
+    auto oRange = oMapEntries.equal_range(entry->pszFileNameAndOpenOptions);
+    for( auto oIter = oRange.first; oIter != oRange.second; ++oIter )
+    {
+        if( oIter->second == entry )
+        {
+            oMapEntries.erase(oIter);
+            break;
+        }
+    }
+}
+
 /************************************************************************/
 /*                            _RefDataset()                             */
 /************************************************************************/
@@ -249,23 +287,22 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
     if( bInDestruction )
         return nullptr;
 
-    GDALProxyPoolCacheEntry* cur = firstEntry;
+    GDALProxyPoolCacheEntry* cur = nullptr;
     GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-    GDALProxyPoolCacheEntry* lastEntryWithZeroRefCount = nullptr;
 
     const std::string osFilenameAndOO =
         GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
 
-    while(cur)
+    auto oRange = oMapEntries.equal_range(osFilenameAndOO);
+    for( auto oIter = oRange.first; oIter != oRange.second; ++oIter )
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
+        cur = oIter->second;
 
-        if (osFilenameAndOO == cur->pszFileNameAndOpenOptions &&
-            ((bShared && cur->responsiblePID == responsiblePID &&
-              ((cur->pszOwner == nullptr && pszOwner == nullptr) ||
-                (cur->pszOwner != nullptr && pszOwner != nullptr &&
-                 strcmp(cur->pszOwner, pszOwner) == 0))) ||
-             (!bShared && cur->refCount == 0)) )
+        if ((bShared && cur->responsiblePID == responsiblePID &&
+             ((cur->pszOwner == nullptr && pszOwner == nullptr) ||
+               (cur->pszOwner != nullptr && pszOwner != nullptr &&
+                strcmp(cur->pszOwner, pszOwner) == 0))) ||
+            (!bShared && cur->refCount == 0))
         {
             if (cur != firstEntry)
             {
@@ -286,13 +323,9 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
             }
 
             cur->refCount ++;
+            nHits ++;
             return cur;
         }
-
-        if (cur->refCount == 0)
-            lastEntryWithZeroRefCount = cur;
-
-        cur = next;
     }
 
     if( !bForceOpen )
@@ -300,6 +333,13 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
 
     if (currentSize == maxSize)
     {
+        /* Evict the least recently used entry that is not in use */
+        GDALProxyPoolCacheEntry* lastEntryWithZeroRefCount = lastEntry;
+        while( lastEntryWithZeroRefCount &&
+               lastEntryWithZeroRefCount->refCount != 0 )
+        {
+            lastEntryWithZeroRefCount = lastEntryWithZeroRefCount->prev;
+        }
         if (lastEntryWithZeroRefCount == nullptr)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -309,9 +349,11 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
             return nullptr;
         }
 
+        RemoveFromIndex(lastEntryWithZeroRefCount);
         lastEntryWithZeroRefCount->pszFileNameAndOpenOptions[0] = '\0';
         if (lastEntryWithZeroRefCount->poDS)
         {
+            nEvictions ++;
             /* Close by pretending we are the thread that GDALOpen'ed this */
             /* dataset */
             GDALSetResponsiblePIDForCurrentThread(lastEntryWithZeroRefCount->responsiblePID);
@@ -352,7 +394,7 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
     else
     {
         /* Prepend */
-        cur = static_cast<GDALProxyPoolCacheEntry*>(CPLMalloc(sizeof(GDALProxyPoolCacheEntry)));
+        cur = new GDALProxyPoolCacheEntry();
         if (lastEntry == nullptr)
             lastEntry = cur;
         cur->prev = nullptr;
@@ -370,6 +412,8 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
     cur->pszOwner = (pszOwner) ? CPLStrdup(pszOwner) : nullptr;
     cur->responsiblePID = responsiblePID;
     cur->refCount = 1;
+    oMapEntries.insert(std::make_pair(osFilenameAndOO, cur));
+    nOpens ++;
 
     refCountOfDisableRefCount ++;
     int nFlag = ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) | GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
@@ -394,19 +438,17 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount( const char* pszFileName,
     if( bInDestruction )
         return;
 
-    GDALProxyPoolCacheEntry* cur = firstEntry;
     GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
 
     const std::string osFilenameAndOO =
         GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
 
-    while(cur)
+    auto oRange = oMapEntries.equal_range(osFilenameAndOO);
+    for( auto oIter = oRange.first; oIter != oRange.second; ++oIter )
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
+        GDALProxyPoolCacheEntry* cur = oIter->second;
 
-        CPLAssert(cur->pszFileNameAndOpenOptions);
         if (cur->refCount == 0 &&
-            osFilenameAndOO == cur->pszFileNameAndOpenOptions &&
             ((pszOwner == nullptr && cur->pszOwner == nullptr) ||
              (pszOwner != nullptr && cur->pszOwner != nullptr &&
               strcmp(cur->pszOwner, pszOwner) == 0)) &&
@@ -418,6 +460,9 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount( const char* pszFileName,
 
             GDALDataset* poDS = cur->poDS;
 
+            /* GDALClose() may re-enter the pool, so do not use oIter */
+            /* afterwards */
+            oMapEntries.erase(oIter);
             cur->poDS = nullptr;
             cur->pszFileNameAndOpenOptions[0] = '\0';
             CPLFree(cur->pszOwner);
@@ -430,8 +475,6 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount( const char* pszFileName,
             GDALSetResponsiblePIDForCurrentThread(responsiblePID);
             break;
         }
-
-        cur = next;
     }
 }
 
@@ -536,7 +579,9 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName,
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    // No need to take the mutex: entries are only closed or recycled while
+    // holding it, once their reference count is zero, and the caller no
+    // longer uses the entry after this call.
     cacheEntry->refCount --;
 }
 
@@ -39,10 +39,15 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -50,9 +55,11 @@
 #include "cpl_string.h"
 #include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 
 /************************************************************************/
@@ -3239,6 +3246,439 @@ static inline void ComputeFloatNoDataValue( GDALDataType eDataType,
     }
 }
 
+/************************************************************************/
+/*                     GDALStatisticsBlockIterator                      */
+/************************************************************************/
+
+namespace {
+
+// Iterate over the sampled blocks of a band, on behalf of GetHistogram(),
+// ComputeStatistics() and ComputeRasterMinMax().
+//
+// Blocks are always fetched from the calling thread, since
+// GetLockedBlockRef() and the IReadBlock() implementation of drivers are not
+// thread-safe. When the GDAL_NUM_THREADS configuration option is set to a
+// value greater than 1, the per-block computation is then deferred to the
+// global thread pool, the block remaining locked until the job has completed.
+// The callback receives the index of the block among the sampled ones, so that
+// it can store its result in a dedicated slot and let the caller merge all
+// partial results in a deterministic order. It must thus be thread-safe.
+class GDALStatisticsBlockIterator
+{
+        CPL_DISALLOW_COPY_ASSIGN(GDALStatisticsBlockIterator)
+
+    public:
+        typedef std::function<void(const void* pData,
+                                   int nXCheck, int nYCheck,
+                                   int iSampledBlock)> BlockFunc;
+
+    private:
+        // Minimum number of pixels processed by a job, so that the cost of
+        // job scheduling remains negligible for small blocks (e.g. one-line
+        // strips).
+        static constexpr GUIntBig MIN_PIXELS_PER_JOB = 256 * 1024;
+
+        struct BlockRef
+        {
+            GDALRasterBlock* poBlock;
+            int nXCheck;
+            int nYCheck;
+            int iSampledBlock;
+        };
+
+        struct Job
+        {
+            GDALStatisticsBlockIterator* poIterator = nullptr;
+            std::vector<BlockRef> asBlocks{};
+            GUIntBig nPixels = 0;
+        };
+
+        GDALRasterBand* m_poBand;
+        int m_nSampleRate;
+        int m_nBlocksPerRow = 0;
+        int m_nTotalBlocks = 0;
+        int m_nThreads = 1;
+        const BlockFunc* m_poFunc = nullptr;
+        const std::atomic<bool>* m_pbStop = nullptr;
+
+        static void JobFunc(void* pData)
+        {
+            Job* psJob = static_cast<Job*>(pData);
+            const BlockFunc& oFunc = *(psJob->poIterator->m_poFunc);
+            for( const auto& sBlockRef: psJob->asBlocks )
+            {
+                oFunc(sBlockRef.poBlock->GetDataRef(),
+                      sBlockRef.nXCheck, sBlockRef.nYCheck,
+                      sBlockRef.iSampledBlock);
+                sBlockRef.poBlock->DropLock();
+            }
+        }
+
+    public:
+        GDALStatisticsBlockIterator( GDALRasterBand* poBand,
+                                     int nSampleRate ):
+            m_poBand(poBand), m_nSampleRate(nSampleRate)
+        {
+            int nBlockXSize = 0;
+            int nBlockYSize = 0;
+            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+            m_nBlocksPerRow =
+                DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+            m_nTotalBlocks = m_nBlocksPerRow *
+                DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+
+            const char* pszThreads =
+                CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+            m_nThreads = std::max(1, std::min(128,
+                EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() :
+                                                atoi(pszThreads)));
+            // No need for more threads than jobs
+            const GUIntBig nSampledPixels =
+                static_cast<GUIntBig>(GetSampledBlockCount()) *
+                nBlockXSize * nBlockYSize;
+            m_nThreads = static_cast<int>(std::min<GUIntBig>(m_nThreads,
+                std::max<GUIntBig>(1, nSampledPixels / MIN_PIXELS_PER_JOB)));
+            // When called from a job of the global thread pool (for example
+            // for a source of VRTSourcedRasterBand::ComputeStatistics()),
+            // waiting for our jobs could deadlock: process blocks
+            // sequentially.
+            if( m_nThreads > 1 )
+            {
+                CPLWorkerThreadPool* poThreadPool =
+                    GDALGetGlobalThreadPool(m_nThreads);
+                if( poThreadPool == nullptr ||
+                    poThreadPool->IsCurrentThreadWorker() )
+                {
+                    m_nThreads = 1;
+                }
+            }
+        }
+
+        int GetSampledBlockCount() const
+        {
+            return DIV_ROUND_UP(m_nTotalBlocks, m_nSampleRate);
+        }
+
+        int GetThreadCount() const { return m_nThreads; }
+
+        // Processing stops (successfully) as soon as *pbStop becomes true.
+        void SetStopFlag(const std::atomic<bool>* pbStop) { m_pbStop = pbStop; }
+
+        // Return false if a block could not be read, or if the progress
+        // function returned FALSE, in which case *pbInterrupted is set.
+        bool Run( const BlockFunc& oFunc,
+                  GDALProgressFunc pfnProgress, void* pProgressData,
+                  const char* pszMessage, bool* pbInterrupted );
+};
+
+constexpr GUIntBig GDALStatisticsBlockIterator::MIN_PIXELS_PER_JOB;
+
+bool GDALStatisticsBlockIterator::Run( const BlockFunc& oFunc,
+                                       GDALProgressFunc pfnProgress,
+                                       void* pProgressData,
+                                       const char* pszMessage,
+                                       bool* pbInterrupted )
+{
+    m_poFunc = &oFunc;
+    *pbInterrupted = false;
+
+    CPLWorkerThreadPool* poThreadPool =
+        m_nThreads > 1 ? GDALGetGlobalThreadPool(m_nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() :
+                            std::unique_ptr<CPLJobQueue>(nullptr);
+    // std::list, so that pointers to pending jobs remain valid
+    std::list<Job> aoJobs;
+    Job* psCurJob = nullptr;
+
+    const auto SubmitCurJob = [&poJobQueue, &psCurJob, this]()
+    {
+        if( !poJobQueue->SubmitJob(JobFunc, psCurJob) )
+            JobFunc(psCurJob);
+        psCurJob = nullptr;
+        // Bound the number of blocks locked at the same time.
+        poJobQueue->WaitCompletion(2 * m_nThreads);
+    };
+
+    bool bRet = true;
+    int iSampledBlock = 0;
+    for( int iSampleBlock = 0;
+         iSampleBlock < m_nTotalBlocks;
+         iSampleBlock += m_nSampleRate, ++iSampledBlock )
+    {
+        if( m_pbStop && *m_pbStop )
+            break;
+
+        const int iYBlock = iSampleBlock / m_nBlocksPerRow;
+        const int iXBlock = iSampleBlock - m_nBlocksPerRow * iYBlock;
+
+        GDALRasterBlock * const poBlock =
+            m_poBand->GetLockedBlockRef( iXBlock, iYBlock );
+        if( poBlock == nullptr )
+        {
+            bRet = false;
+            break;
+        }
+
+        int nXCheck = 0, nYCheck = 0;
+        m_poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+        if( poJobQueue )
+        {
+            if( psCurJob == nullptr )
+            {
+                aoJobs.emplace_back();
+                psCurJob = &aoJobs.back();
+                psCurJob->poIterator = this;
+            }
+            BlockRef sBlockRef;
+            sBlockRef.poBlock = poBlock;
+            sBlockRef.nXCheck = nXCheck;
+            sBlockRef.nYCheck = nYCheck;
+            sBlockRef.iSampledBlock = iSampledBlock;
+            psCurJob->asBlocks.push_back(sBlockRef);
+            psCurJob->nPixels += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            if( psCurJob->nPixels >= MIN_PIXELS_PER_JOB )
+                SubmitCurJob();
+        }
+        else
+        {
+            oFunc(poBlock->GetDataRef(), nXCheck, nYCheck, iSampledBlock);
+            poBlock->DropLock();
+        }
+
+        if( !pfnProgress( iSampleBlock
+                              / static_cast<double>(m_nTotalBlocks),
+                          pszMessage, pProgressData ) )
+        {
+            *pbInterrupted = true;
+            bRet = false;
+            break;
+        }
+    }
+
+    if( poJobQueue )
+    {
+        // Flush the last job, even on error, so that its blocks get unlocked.
+        if( psCurJob )
+            SubmitCurJob();
+        poJobQueue->WaitCompletion();
+    }
+
+    return bRet;
+}
+
+} // namespace
+
+/************************************************************************/
+/*                      ComputeHistogramForBlock()                      */
+/************************************************************************/
+
+namespace {
+
+struct GDALHistogramContext
+{
+    GDALDataType eDataType = GDT_Unknown;
+    bool bSignedByte = false;
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    double dfMin = 0;
+    double dfScale = 0;
+    int nBuckets = 0;
+    bool bIncludeOutOfRange = false;
+    bool bGotNoDataValue = false;
+    double dfNoDataValue = 0;
+    bool bGotFloatNoDataValue = false;
+    float fNoDataValue = 0;
+
+    // Histograms not currently used by a job. Counts are only summed, so
+    // the final result does not depend on which job used which histogram.
+    std::mutex oMutex{};
+    std::vector<GUIntBig*> apanAvailableHistograms{};
+};
+
+} // namespace
+
+static void ComputeHistogramForBlock( const GDALHistogramContext& sCtxt,
+                                      const void* pData,
+                                      int nXCheck, int nYCheck,
+                                      GUIntBig* panHistogram )
+{
+    const GDALDataType eDataType = sCtxt.eDataType;
+    const bool bSignedByte = sCtxt.bSignedByte;
+    const int nBlockXSize = sCtxt.nBlockXSize;
+    const int nBlockYSize = sCtxt.nBlockYSize;
+    const double dfMin = sCtxt.dfMin;
+    const double dfScale = sCtxt.dfScale;
+    const int nBuckets = sCtxt.nBuckets;
+    const bool bIncludeOutOfRange = sCtxt.bIncludeOutOfRange;
+    const bool bGotNoDataValue = sCtxt.bGotNoDataValue;
+    const double dfNoDataValue = sCtxt.dfNoDataValue;
+    const bool bGotFloatNoDataValue = sCtxt.bGotFloatNoDataValue;
+    const float fNoDataValue = sCtxt.fNoDataValue;
+
+    // this is a special case for a common situation.
+    if( eDataType == GDT_Byte && !bSignedByte
+        && dfScale == 1.0 && (dfMin >= -0.5 && dfMin <= 0.5)
+        && nYCheck == nBlockYSize && nXCheck == nBlockXSize
+        && nBuckets == 256 )
+    {
+        const GPtrDiff_t nPixels = static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+
+        for( GPtrDiff_t i = 0; i < nPixels; i++ )
+            if( ! (bGotNoDataValue &&
+                   (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
+            {
+                panHistogram[pabyData[i]]++;
+            }
+
+        return;
+    }
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for( int iY = 0; iY < nYCheck; iY++ )
+    {
+        for( int iX = 0; iX < nXCheck; iX++ )
+        {
+            const GPtrDiff_t iOffset = iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            double dfValue = 0.0;
+
+            switch( eDataType )
+            {
+              case GDT_Byte:
+              {
+                if( bSignedByte )
+                    dfValue =
+                        static_cast<const signed char *>(pData)[iOffset];
+                else
+                    dfValue = static_cast<const GByte *>(pData)[iOffset];
+                break;
+              }
+              case GDT_Int8:
+                dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+                break;
+              case GDT_UInt16:
+                dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+                break;
+              case GDT_Int16:
+                dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+                break;
+              case GDT_UInt32:
+                dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+                break;
+              case GDT_Int32:
+                dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+                break;
+              case GDT_UInt64:
+                dfValue = static_cast<double>(static_cast<const GUInt64 *>(pData)[iOffset]);
+                break;
+              case GDT_Int64:
+                dfValue = static_cast<double>(static_cast<const GInt64 *>(pData)[iOffset]);
+                break;
+              case GDT_Float32:
+              {
+                const float fValue = static_cast<const float *>(pData)[iOffset];
+                if( CPLIsNan(fValue) ||
+                    (bGotFloatNoDataValue && ARE_REAL_EQUAL(fValue, fNoDataValue)) )
+                    continue;
+                dfValue = fValue;
+                break;
+              }
+              case GDT_Float64:
+                dfValue = static_cast<const double *>(pData)[iOffset];
+                if( CPLIsNan(dfValue) )
+                    continue;
+                break;
+              case GDT_CInt16:
+                {
+                    double  dfReal =
+                        static_cast<const GInt16 *>(pData)[iOffset*2];
+                    double  dfImag =
+                        static_cast<const GInt16 *>(pData)[iOffset*2+1];
+                    dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
+                }
+                break;
+              case GDT_CInt32:
+                {
+                    double  dfReal =
+                        static_cast<const GInt32 *>(pData)[iOffset*2];
+                    double  dfImag =
+                        static_cast<const GInt32 *>(pData)[iOffset*2+1];
+                    dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
+                }
+                break;
+              case GDT_CFloat32:
+                {
+                    double  dfReal =
+                        static_cast<const float *>(pData)[iOffset*2];
+                    double  dfImag =
+                        static_cast<const float *>(pData)[iOffset*2+1];
+                    if ( CPLIsNan(dfReal) || CPLIsNan(dfImag) )
+                        continue;
+                    dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
+                }
+                break;
+              case GDT_CFloat64:
+                {
+                    double  dfReal =
+                        static_cast<const double *>(pData)[iOffset*2];
+                    double  dfImag =
+                        static_cast<const double *>(pData)[iOffset*2+1];
+                    if ( CPLIsNan(dfReal) || CPLIsNan(dfImag) )
+                        continue;
+                    dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
+                }
+                break;
+              case GDT_Unknown:
+              case GDT_TypeCount:
+                CPLAssert( false );
+                return;
+            }
+
+            if( eDataType != GDT_Float32 && bGotNoDataValue &&
+                ARE_REAL_EQUAL(dfValue, dfNoDataValue) )
+                continue;
+
+            // Given that dfValue and dfMin are not NaN, and dfScale > 0 and finite,
+            // the result of the multiplication cannot be NaN
+            const double dfIndex = floor((dfValue - dfMin) * dfScale);
+
+            if( dfIndex < 0 )
+            {
+                if( bIncludeOutOfRange )
+                    panHistogram[0]++;
+            }
+            else if( dfIndex >= nBuckets )
+            {
+                if( bIncludeOutOfRange )
+                    ++panHistogram[nBuckets-1];
+            }
+            else
+            {
+                ++panHistogram[static_cast<int>(dfIndex)];
+            }
+        }
+    }
+}
+
+static void ComputeHistogramBlockFunc( GDALHistogramContext* psCtxt,
+                                       const void* pData,
+                                       int nXCheck, int nYCheck )
+{
+    GUIntBig* panHistogram = nullptr;
+    {
+        std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+        CPLAssert( !psCtxt->apanAvailableHistograms.empty() );
+        panHistogram = psCtxt->apanAvailableHistograms.back();
+        psCtxt->apanAvailableHistograms.pop_back();
+    }
+    ComputeHistogramForBlock(*psCtxt, pData, nXCheck, nYCheck, panHistogram);
+    {
+        std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+        psCtxt->apanAvailableHistograms.push_back(panHistogram);
+    }
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -3265,6 +3705,10 @@ static inline void ComputeFloatNoDataValue( GDALDataType eDataType,
  * in generating histogram based luts for instance.  Generally bApproxOK is
  * much faster than an exactly computed histogram.
  *
+ * Starting with GDAL 3.7, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads used to
+ * process the blocks of the band.
+ *
  * This method is the same as the C functions GDALGetRasterHistogram() and
  * GDALGetRasterHistogramEx().
  *
@@ -3559,174 +4003,62 @@ CPLErr GDALRasterBand::GetHistogram( double dfMin, double dfMax,
 /* -------------------------------------------------------------------- */
 /*      Read the blocks, and add to histogram.                          */
 /* -------------------------------------------------------------------- */
-        for( int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate )
-        {
-            if( !pfnProgress(
-                    iSampleBlock /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData ) )
-                return CE_Failure;
-
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock *poBlock = GetLockedBlockRef( iXBlock, iYBlock );
-            if( poBlock == nullptr )
-                return CE_Failure;
-
-            void *pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            // this is a special case for a common situation.
-            if( eDataType == GDT_Byte && !bSignedByte
-                && dfScale == 1.0 && (dfMin >= -0.5 && dfMin <= 0.5)
-                && nYCheck == nBlockYSize && nXCheck == nBlockXSize
-                && nBuckets == 256 )
+        GDALStatisticsBlockIterator oIterator(this, nSampleRate);
+
+        GDALHistogramContext sCtxt;
+        sCtxt.eDataType = eDataType;
+        sCtxt.bSignedByte = bSignedByte;
+        sCtxt.nBlockXSize = nBlockXSize;
+        sCtxt.nBlockYSize = nBlockYSize;
+        sCtxt.dfMin = dfMin;
+        sCtxt.dfScale = dfScale;
+        sCtxt.nBuckets = nBuckets;
+        sCtxt.bIncludeOutOfRange = CPL_TO_BOOL(bIncludeOutOfRange);
+        sCtxt.bGotNoDataValue = CPL_TO_BOOL(bGotNoDataValue);
+        sCtxt.dfNoDataValue = dfNoDataValue;
+        sCtxt.bGotFloatNoDataValue = bGotFloatNoDataValue;
+        sCtxt.fNoDataValue = fNoDataValue;
+
+        // One histogram per job that may run concurrently: the worker
+        // threads, plus the calling thread if a job could not be submitted.
+        std::vector<std::vector<GUIntBig>> aanExtraHistograms;
+        sCtxt.apanAvailableHistograms.push_back(panHistogram);
+        if( oIterator.GetThreadCount() > 1 )
+        {
+            try
             {
-                const GPtrDiff_t nPixels = static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
-
-                for( GPtrDiff_t i = 0; i < nPixels; i++ )
-                    if( ! (bGotNoDataValue &&
-                           (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
-                    {
-                        panHistogram[pabyData[i]]++;
-                    }
-
-                poBlock->DropLock();
-                continue;  // To next sample block.
+                aanExtraHistograms.resize(oIterator.GetThreadCount());
+                for( auto& anHistogram: aanExtraHistograms )
+                {
+                    anHistogram.resize(nBuckets);
+                    sCtxt.apanAvailableHistograms.push_back(anHistogram.data());
+                }
             }
-
-            // This isn't the fastest way to do this, but is easier for now.
-            for( int iY = 0; iY < nYCheck; iY++ )
+            catch( const std::exception& )
             {
-                for( int iX = 0; iX < nXCheck; iX++ )
-                {
-                    const GPtrDiff_t iOffset = iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    double dfValue = 0.0;
-
-                    switch( eDataType )
-                    {
-                      case GDT_Byte:
-                      {
-                        if( bSignedByte )
-                            dfValue =
-                                static_cast<signed char *>(pData)[iOffset];
-                        else
-                            dfValue = static_cast<GByte *>(pData)[iOffset];
-                        break;
-                      }
-                      case GDT_Int8:
-                        dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                        break;
-                      case GDT_UInt16:
-                        dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                        break;
-                      case GDT_Int16:
-                        dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                        break;
-                      case GDT_UInt32:
-                        dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                        break;
-                      case GDT_Int32:
-                        dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                        break;
-                      case GDT_UInt64:
-                        dfValue = static_cast<double>(static_cast<GUInt64 *>(pData)[iOffset]);
-                        break;
-                      case GDT_Int64:
-                        dfValue = static_cast<double>(static_cast<GInt64 *>(pData)[iOffset]);
-                        break;
-                      case GDT_Float32:
-                      {
-                        const float fValue = static_cast<float *>(pData)[iOffset];
-                        if( CPLIsNan(fValue) ||
-                            (bGotFloatNoDataValue && ARE_REAL_EQUAL(fValue, fNoDataValue)) )
-                            continue;
-                        dfValue = fValue;
-                        break;
-                      }
-                      case GDT_Float64:
-                        dfValue = static_cast<double *>(pData)[iOffset];
-                        if( CPLIsNan(dfValue) )
-                            continue;
-                        break;
-                      case GDT_CInt16:
-                        {
-                            double  dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset*2];
-                            double  dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset*2+1];
-                            dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
-                        }
-                        break;
-                      case GDT_CInt32:
-                        {
-                            double  dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset*2];
-                            double  dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset*2+1];
-                            dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
-                        }
-                        break;
-                      case GDT_CFloat32:
-                        {
-                            double  dfReal =
-                                static_cast<float *>(pData)[iOffset*2];
-                            double  dfImag =
-                                static_cast<float *>(pData)[iOffset*2+1];
-                            if ( CPLIsNan(dfReal) || CPLIsNan(dfImag) )
-                                continue;
-                            dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
-                        }
-                        break;
-                      case GDT_CFloat64:
-                        {
-                            double  dfReal =
-                                static_cast<double *>(pData)[iOffset*2];
-                            double  dfImag =
-                                static_cast<double *>(pData)[iOffset*2+1];
-                            if ( CPLIsNan(dfReal) || CPLIsNan(dfImag) )
-                                continue;
-                            dfValue = sqrt( dfReal * dfReal + dfImag * dfImag );
-                        }
-                        break;
-                      case GDT_Unknown:
-                      case GDT_TypeCount:
-                        CPLAssert( false );
-                        return CE_Failure;
-                    }
-
-                    if( eDataType != GDT_Float32 && bGotNoDataValue &&
-                        ARE_REAL_EQUAL(dfValue, dfNoDataValue) )
-                        continue;
+                ReportError( CE_Failure, CPLE_OutOfMemory,
+                             "Out of memory in GetHistogram()" );
+                return CE_Failure;
+            }
+        }
 
-                    // Given that dfValue and dfMin are not NaN, and dfScale > 0 and finite,
-                    // the result of the multiplication cannot be NaN
-                    const double dfIndex = floor((dfValue - dfMin) * dfScale);
+        const auto oFunc = [&sCtxt](const void* pData, int nXCheck,
+                                    int nYCheck, int /* iSampledBlock */)
+        {
+            ComputeHistogramBlockFunc(&sCtxt, pData, nXCheck, nYCheck);
+        };
 
-                    if( dfIndex < 0 )
-                    {
-                        if( bIncludeOutOfRange )
-                            panHistogram[0]++;
-                    }
-                    else if( dfIndex >= nBuckets )
-                    {
-                        if( bIncludeOutOfRange )
-                            ++panHistogram[nBuckets-1];
-                    }
-                    else
-                    {
-                        ++panHistogram[static_cast<int>(dfIndex)];
-                    }
-                }
-            }
+        bool bInterrupted = false;
+        if( !oIterator.Run( oFunc, pfnProgress, pProgressData,
+                            "Compute Histogram", &bInterrupted ) )
+        {
+            return CE_Failure;
+        }
 
-            poBlock->DropLock();
+        for( const auto& anHistogram: aanExtraHistograms )
+        {
+            for( int i = 0; i < nBuckets; ++i )
+                panHistogram[i] += anHistogram[i];
         }
     }
 
@@ -5400,6 +5732,317 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount, GUIntBig nValidCount
 }
 //! @endcond
 
+/************************************************************************/
+/*                       GDALStatisticsPartial                          */
+/************************************************************************/
+
+namespace {
+
+// Statistics of the valid pixels of a block, kept as (count, sum, M2) so
+// that the statistics of several blocks can be merged without going back to
+// the pixel values (Chan et al. parallel variance algorithm).
+// The mean is derived from the sum, which is exact for integer data types.
+struct GDALStatisticsPartial
+{
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfSum = 0.0;
+    // Sum of square of differences to the mean.
+    double dfM2 = 0.0;
+    GUIntBig nValidCount = 0;
+    GUIntBig nSampleCount = 0;
+
+    double GetMean() const
+    {
+        return nValidCount > 0 ? dfSum / static_cast<double>(nValidCount) : 0.0;
+    }
+
+    void Merge( const GDALStatisticsPartial& other )
+    {
+        nSampleCount += other.nSampleCount;
+        if( other.nValidCount == 0 )
+            return;
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+        if( nValidCount > 0 )
+        {
+            const double dfDelta = other.GetMean() - GetMean();
+            const double dfOtherRatio = static_cast<double>(other.nValidCount) /
+                    static_cast<double>(nValidCount + other.nValidCount);
+            dfM2 += dfDelta * dfDelta * static_cast<double>(nValidCount) *
+                    dfOtherRatio;
+        }
+        dfM2 += other.dfM2;
+        dfSum += other.dfSum;
+        nValidCount += other.nValidCount;
+    }
+};
+
+#ifdef CPL_HAS_GINT64
+// Exact statistics of integer pixel values that fit on 16 bits.
+struct GDALIntegerStatisticsPartial
+{
+    GUInt32 nMin = 0;
+    GUInt32 nMax = 0;
+    GUIntBig nSum = 0;
+    GUIntBig nSumSquare = 0;
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+};
+#endif
+
+} // namespace
+
+/************************************************************************/
+/*                      ComputeStatisticsGeneric()                      */
+/************************************************************************/
+
+static void ComputeStatisticsGeneric( GDALDataType eDataType,
+                                      bool bSignedByte,
+                                      const void* pData,
+                                      int nXCheck, int nBlockXSize,
+                                      int nYCheck,
+                                      bool bGotNoDataValue,
+                                      double dfNoDataValue,
+                                      bool bGotFloatNoDataValue,
+                                      float fNoDataValue,
+                                      GDALStatisticsPartial& sPartial )
+{
+    // Using Welford algorithm:
+    // http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+    // to compute standard deviation in a more numerically robust way than
+    // the difference of the sum of square values with the square of the sum.
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfSum = 0.0;
+    double dfMean = 0.0;
+    double dfM2 = 0.0;
+    GUIntBig nValidCount = 0;
+    for( int iY = 0; iY < nYCheck; iY++ )
+    {
+        for( int iX = 0; iX < nXCheck; iX++ )
+        {
+            const GPtrDiff_t iOffset = iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            bool bValid = true;
+            double dfValue = GetPixelValue( eDataType,
+                                            bSignedByte,
+                                            pData,
+                                            iOffset,
+                                            bGotNoDataValue,
+                                            dfNoDataValue,
+                                            bGotFloatNoDataValue,
+                                            fNoDataValue,
+                                            bValid );
+
+            if( !bValid )
+                continue;
+
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+
+            nValidCount++;
+            dfSum += dfValue;
+            const double dfDelta = dfValue - dfMean;
+            dfMean += dfDelta / nValidCount;
+            dfM2 += dfDelta * (dfValue - dfMean);
+        }
+    }
+
+    GDALStatisticsPartial sBlock;
+    sBlock.dfMin = dfMin;
+    sBlock.dfMax = dfMax;
+    sBlock.dfSum = dfSum;
+    sBlock.dfM2 = dfM2;
+    sBlock.nValidCount = nValidCount;
+    sBlock.nSampleCount = static_cast<GUIntBig>(nXCheck) * nYCheck;
+    sPartial.Merge(sBlock);
+}
+
+/************************************************************************/
+/*                   ComputeStatisticsFloatingPoint()                   */
+/************************************************************************/
+
+// Statistics of a Float32 or Float64 block, with the same notion of valid
+// pixel as GetPixelValue().
+// The loops are written with independent accumulators, without dependency
+// from one iteration to the next, so that they can be vectorized / pipelined.
+// The mean is computed in a first pass, and the sum of square of differences
+// to the mean in a second one, which is as accurate as Welford algorithm,
+// but without its per-pixel division.
+template<class T, bool HAS_NODATA>
+static void ComputeStatisticsFloatingPoint( const T* pData,
+                                            int nXCheck, int nBlockXSize,
+                                            int nYCheck,
+                                            T noDataValue,
+                                            GDALStatisticsPartial& sPartial )
+{
+    constexpr int NLANES = 4;
+    double adfMin[NLANES];
+    double adfMax[NLANES];
+    double adfSum[NLANES];
+    GUIntBig anValidCount[NLANES];
+    for( int k = 0; k < NLANES; ++k )
+    {
+        adfMin[k] = std::numeric_limits<double>::max();
+        adfMax[k] = -std::numeric_limits<double>::max();
+        adfSum[k] = 0;
+        anValidCount[k] = 0;
+    }
+
+    const auto IsValid = [noDataValue](T value)
+    {
+        return !CPLIsNan(value) &&
+               !(HAS_NODATA && ARE_REAL_EQUAL(value, noDataValue));
+    };
+
+    for( int iY = 0; iY < nYCheck; iY++ )
+    {
+        const T* const pLine = pData + static_cast<size_t>(iY) * nBlockXSize;
+        int iX = 0;
+        for( ; iX + NLANES <= nXCheck; iX += NLANES )
+        {
+            for( int k = 0; k < NLANES; ++k )
+            {
+                const T value = pLine[iX + k];
+                if( IsValid(value) )
+                {
+                    const double dfValue = value;
+                    adfMin[k] = std::min(adfMin[k], dfValue);
+                    adfMax[k] = std::max(adfMax[k], dfValue);
+                    adfSum[k] += dfValue;
+                    anValidCount[k]++;
+                }
+            }
+        }
+        for( ; iX < nXCheck; ++iX )
+        {
+            const T value = pLine[iX];
+            if( IsValid(value) )
+            {
+                const double dfValue = value;
+                adfMin[0] = std::min(adfMin[0], dfValue);
+                adfMax[0] = std::max(adfMax[0], dfValue);
+                adfSum[0] += dfValue;
+                anValidCount[0]++;
+            }
+        }
+    }
+
+    GDALStatisticsPartial sBlock;
+    sBlock.nSampleCount = static_cast<GUIntBig>(nXCheck) * nYCheck;
+    double dfSum = 0;
+    for( int k = 0; k < NLANES; ++k )
+    {
+        sBlock.dfMin = std::min(sBlock.dfMin, adfMin[k]);
+        sBlock.dfMax = std::max(sBlock.dfMax, adfMax[k]);
+        dfSum += adfSum[k];
+        sBlock.nValidCount += anValidCount[k];
+    }
+
+    if( sBlock.nValidCount > 0 )
+    {
+        const double dfMean = dfSum / static_cast<double>(sBlock.nValidCount);
+        double adfM2[NLANES];
+        double adfDiff[NLANES];
+        for( int k = 0; k < NLANES; ++k )
+        {
+            adfM2[k] = 0;
+            adfDiff[k] = 0;
+        }
+        for( int iY = 0; iY < nYCheck; iY++ )
+        {
+            const T* const pLine = pData + static_cast<size_t>(iY) * nBlockXSize;
+            int iX = 0;
+            for( ; iX + NLANES <= nXCheck; iX += NLANES )
+            {
+                for( int k = 0; k < NLANES; ++k )
+                {
+                    const T value = pLine[iX + k];
+                    if( IsValid(value) )
+                    {
+                        const double dfDelta = value - dfMean;
+                        adfM2[k] += dfDelta * dfDelta;
+                        adfDiff[k] += dfDelta;
+                    }
+                }
+            }
+            for( ; iX < nXCheck; ++iX )
+            {
+                const T value = pLine[iX];
+                if( IsValid(value) )
+                {
+                    const double dfDelta = value - dfMean;
+                    adfM2[0] += dfDelta * dfDelta;
+                    adfDiff[0] += dfDelta;
+                }
+            }
+        }
+
+        double dfM2 = 0;
+        double dfDiff = 0;
+        for( int k = 0; k < NLANES; ++k )
+        {
+            dfM2 += adfM2[k];
+            dfDiff += adfDiff[k];
+        }
+        sBlock.dfSum = dfSum;
+        // Correct the rounding error made on the mean ("corrected two-pass
+        // algorithm").
+        sBlock.dfM2 = dfM2 - dfDiff * dfDiff / static_cast<double>(sBlock.nValidCount);
+        if( sBlock.dfM2 < 0 )
+            sBlock.dfM2 = 0;
+    }
+
+    sPartial.Merge(sBlock);
+}
+
+#ifdef CPL_HAS_GINT64
+
+/************************************************************************/
+/*                     ComputeStatisticsInt16()                         */
+/************************************************************************/
+
+// Statistics of a Int16 block, on values shifted by 32768 so as to share the
+// exact unsigned integer computations of the UInt16 case.
+template<bool HAS_NODATA>
+static void ComputeStatisticsInt16( const GInt16* pData,
+                                    int nXCheck, int nBlockXSize,
+                                    int nYCheck,
+                                    GInt16 nNoDataValue,
+                                    GDALIntegerStatisticsPartial& sPartial )
+{
+    GUInt32 nMin = sPartial.nMin;
+    GUInt32 nMax = sPartial.nMax;
+    GUIntBig nSum = 0;
+    GUIntBig nSumSquare = 0;
+    GUIntBig nValidCount = 0;
+    for( int iY = 0; iY < nYCheck; iY++ )
+    {
+        const GInt16* const pLine = pData + static_cast<size_t>(iY) * nBlockXSize;
+        for( int iX = 0; iX < nXCheck; iX++ )
+        {
+            if( HAS_NODATA && pLine[iX] == nNoDataValue )
+                continue;
+            const GUInt32 nValue = static_cast<GUInt32>(pLine[iX] + 32768);
+            nMin = std::min(nMin, nValue);
+            nMax = std::max(nMax, nValue);
+            nSum += nValue;
+            nSumSquare += static_cast<GUIntBig>(nValue) * nValue;
+            if( HAS_NODATA )
+                nValidCount++;
+        }
+    }
+    const GUIntBig nSampleCount = static_cast<GUIntBig>(nXCheck) * nYCheck;
+    sPartial.nMin = nMin;
+    sPartial.nMax = nMax;
+    sPartial.nSum += nSum;
+    sPartial.nSumSquare += nSumSquare;
+    sPartial.nSampleCount += nSampleCount;
+    sPartial.nValidCount += HAS_NODATA ? nValidCount : nSampleCount;
+}
+
+#endif // CPL_HAS_GINT64
+
 /************************************************************************/
 /*                         ComputeStatistics()                          */
 /************************************************************************/
@@ -5417,6 +6060,11 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount, GUIntBig nValidCount
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.7, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads used to
+ * process the blocks of the band. Blocks are still read by the calling thread.
+ * The result does not depend on the number of threads.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -5493,16 +6141,9 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
 /* -------------------------------------------------------------------- */
 /*      Read actual data and compute statistics.                        */
 /* -------------------------------------------------------------------- */
-    // Using Welford algorithm:
-    // http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
-    // to compute standard deviation in a more numerically robust way than
-    // the difference of the sum of square values with the square of the sum.
-    // dfMean and dfM2 are updated at each sample.
-    // dfM2 is the sum of square of differences to the current mean.
-    double dfMin = std::numeric_limits<double>::max();
-    double dfMax = -std::numeric_limits<double>::max();
-    double dfMean = 0.0;
-    double dfM2 = 0.0;
+    // Statistics are computed per block (or chunk), and then merged.
+    // See GDALStatisticsPartial.
+    GDALStatisticsPartial sStats;
 
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
@@ -5525,9 +6166,6 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
             pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
     }
 
-    GUIntBig nSampleCount = 0;
-    GUIntBig nValidCount = 0;
-
     if ( bApproxOK && HasArbitraryOverviews() )
     {
 /* -------------------------------------------------------------------- */
@@ -5565,36 +6203,11 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
             return eErr;
         }
 
-        /* this isn't the fastest way to do this, but is easier for now */
-        for( int iY = 0; iY < nYReduced; iY++ )
-        {
-            for( int iX = 0; iX < nXReduced; iX++ )
-            {
-                const int iOffset = iX + iY * nXReduced;
-                bool bValid = true;
-                double dfValue = GetPixelValue( eDataType,
-                                                bSignedByte,
-                                                pData,
-                                                iOffset,
-                                                CPL_TO_BOOL(bGotNoDataValue),
-                                                dfNoDataValue,
-                                                bGotFloatNoDataValue,
-                                                fNoDataValue,
-                                                bValid );
-                if( !bValid )
-                    continue;
-
-                dfMin = std::min(dfMin, dfValue);
-                dfMax = std::max(dfMax, dfValue);
-
-                nValidCount++;
-                const double dfDelta = dfValue - dfMean;
-                dfMean += dfDelta / nValidCount;
-                dfM2 += dfDelta * (dfValue - dfMean);
-            }
-        }
-
-        nSampleCount = static_cast<GUIntBig>(nXReduced) * nYReduced;
+        ComputeStatisticsGeneric( eDataType, bSignedByte, pData,
+                                  nXReduced, nXReduced, nYReduced,
+                                  CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                                  bGotFloatNoDataValue, fNoDataValue,
+                                  sStats );
 
         CPLFree( pData );
     }
@@ -5624,91 +6237,127 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
         if( nSampleRate == 1 )
             bApproxOK = false;
 
+        // Blocks are processed in parallel if GDAL_NUM_THREADS is set.
+        GDALStatisticsBlockIterator oIterator(this, nSampleRate);
+        bool bInterrupted = false;
+
 #ifdef CPL_HAS_GINT64
-        // Particular case for GDT_Byte that only use integral types for all
-        // intermediate computations. Only possible if the number of pixels
-        // explored is lower than GUINTBIG_MAX / (255*255), so that nSumSquare
-        // can fit on a uint64. Should be 99.99999% of cases.
-        // For GUInt16, this limits to raster of 4 giga pixels
+        // Particular case for GDT_Byte, GDT_UInt16 and GDT_Int16 that only use
+        // integral types for all intermediate computations. Only possible if
+        // the number of pixels explored is lower than
+        // GUINTBIG_MAX / (255*255), so that nSumSquare can fit on a uint64.
+        // Should be 99.99999% of cases.
+        // For GUInt16 and GInt16, this limits to raster of 4 giga pixels
         if( (eDataType == GDT_Byte && !bSignedByte &&
              static_cast<GUIntBig>(nBlocksPerRow)*nBlocksPerColumn/nSampleRate <
                 GUINTBIG_MAX / (255U * 255U) /
                         (static_cast<GUInt64>(nBlockXSize) * static_cast<GUInt64>(nBlockYSize))) ||
-            (eDataType == GDT_UInt16 &&
+            ((eDataType == GDT_UInt16 || eDataType == GDT_Int16) &&
              static_cast<GUIntBig>(nBlocksPerRow)*nBlocksPerColumn/nSampleRate <
                 GUINTBIG_MAX / (65535U * 65535U) /
                         (static_cast<GUInt64>(nBlockXSize) * static_cast<GUInt64>(nBlockYSize))) )
         {
             const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
-            GUInt32 nMin = nMaxValueType;
-            GUInt32 nMax = 0;
-            GUIntBig nSum = 0;
-            GUIntBig nSumSquare = 0;
             // If no valid nodata, map to invalid value (256 for Byte)
             const GUInt32 nNoDataValue =
-                (bGotNoDataValue && dfNoDataValue >= 0 &&
+                (eDataType != GDT_Int16 && bGotNoDataValue &&
+                 dfNoDataValue >= 0 &&
                  dfNoDataValue <= nMaxValueType &&
                  fabs(dfNoDataValue -
                       static_cast<GUInt32>(dfNoDataValue + 1e-10)) < 1e-10 ) ?
                             static_cast<GUInt32>(dfNoDataValue + 1e-10) :
                             nMaxValueType+1;
-
-            for( int iSampleBlock = 0;
-                iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                iSampleBlock += nSampleRate )
+            // For Int16, the only value that GetPixelValue() would consider
+            // equal to the nodata value.
+            const double dfNoDataValueRounded =
+                bGotNoDataValue ? std::round(dfNoDataValue) : 0.0;
+            const bool bHasNoDataInt16 =
+                eDataType == GDT_Int16 && bGotNoDataValue &&
+                GDALIsValueInRange<GInt16>(dfNoDataValueRounded) &&
+                ARE_REAL_EQUAL(dfNoDataValueRounded, dfNoDataValue);
+            const GInt16 nNoDataValueInt16 = bHasNoDataInt16 ?
+                static_cast<GInt16>(dfNoDataValueRounded) : 0;
+
+            GDALIntegerStatisticsPartial sInitPartial;
+            sInitPartial.nMin = nMaxValueType;
+            std::vector<GDALIntegerStatisticsPartial> asPartials(
+                oIterator.GetSampledBlockCount(), sInitPartial);
+
+            const GDALDataType eDT = eDataType;
+            const int nBufferWidth = nBlockXSize;
+            const auto oFunc = [eDT, nBufferWidth, nMaxValueType, nNoDataValue,
+                                bHasNoDataInt16, nNoDataValueInt16,
+                                &asPartials]
+                (const void* pData, int nXCheck, int nYCheck, int iSampledBlock)
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock * const poBlock =
-                    GetLockedBlockRef( iXBlock, iYBlock );
-                if( poBlock == nullptr )
-                    return CE_Failure;
-
-                void* const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                if( eDataType == GDT_Byte )
+                GDALIntegerStatisticsPartial& s = asPartials[iSampledBlock];
+                if( eDT == GDT_Byte )
                 {
                     ComputeStatisticsInternal<GByte, /* COMPUTE_OTHER_STATS = */ true>::f(
                                                nXCheck,
-                                               nBlockXSize,
+                                               nBufferWidth,
                                                nYCheck,
                                                static_cast<const GByte*>(pData),
                                                nNoDataValue <= nMaxValueType,
                                                nNoDataValue,
-                                               nMin, nMax, nSum,
-                                               nSumSquare,
-                                               nSampleCount,
-                                               nValidCount );
+                                               s.nMin, s.nMax, s.nSum,
+                                               s.nSumSquare,
+                                               s.nSampleCount,
+                                               s.nValidCount );
                 }
-                else
+                else if( eDT == GDT_UInt16 )
                 {
                     ComputeStatisticsInternal<GUInt16, /* COMPUTE_OTHER_STATS = */ true>::f(
                                                nXCheck,
-                                               nBlockXSize,
+                                               nBufferWidth,
                                                nYCheck,
                                                static_cast<const GUInt16*>(pData),
                                                nNoDataValue <= nMaxValueType,
                                                nNoDataValue,
-                                               nMin, nMax, nSum,
-                                               nSumSquare,
-                                               nSampleCount,
-                                               nValidCount );
+                                               s.nMin, s.nMax, s.nSum,
+                                               s.nSumSquare,
+                                               s.nSampleCount,
+                                               s.nValidCount );
                 }
-
-                poBlock->DropLock();
-
-                if ( !pfnProgress( iSampleBlock
-                        / static_cast<double>(nBlocksPerRow*nBlocksPerColumn),
-                        "Compute Statistics", pProgressData) )
+                else if( bHasNoDataInt16 )
+                {
+                    ComputeStatisticsInt16<true>(
+                        static_cast<const GInt16*>(pData),
+                        nXCheck, nBufferWidth, nYCheck,
+                        nNoDataValueInt16, s);
+                }
+                else
                 {
+                    ComputeStatisticsInt16<false>(
+                        static_cast<const GInt16*>(pData),
+                        nXCheck, nBufferWidth, nYCheck,
+                        0, s);
+                }
+            };
+
+            if( !oIterator.Run( oFunc, pfnProgress, pProgressData,
+                                "Compute Statistics", &bInterrupted ) )
+            {
+                if( bInterrupted )
                     ReportError( CE_Failure, CPLE_UserInterrupt,
                                  "User terminated" );
-                    return CE_Failure;
-                }
+                return CE_Failure;
+            }
+
+            GUInt32 nMin = nMaxValueType;
+            GUInt32 nMax = 0;
+            GUIntBig nSum = 0;
+            GUIntBig nSumSquare = 0;
+            GUIntBig nSampleCount = 0;
+            GUIntBig nValidCount = 0;
+            for( const auto& s: asPartials )
+            {
+                nMin = std::min(nMin, s.nMin);
+                nMax = std::max(nMax, s.nMax);
+                nSum += s.nSum;
+                nSumSquare += s.nSumSquare;
+                nSampleCount += s.nSampleCount;
+                nValidCount += s.nValidCount;
             }
 
             if( !pfnProgress( 1.0, "Compute Statistics", pProgressData ) )
@@ -5721,8 +6370,11 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
 /* -------------------------------------------------------------------- */
 /*      Save computed information.                                      */
 /* -------------------------------------------------------------------- */
+            // Int16 values have been shifted by 32768.
+            const double dfOffset = (eDataType == GDT_Int16) ? -32768.0 : 0.0;
+            double dfMean = 0.0;
             if( nValidCount )
-                dfMean = static_cast<double>(nSum) / nValidCount;
+                dfMean = static_cast<double>(nSum) / nValidCount + dfOffset;
 
             // To avoid potential precision issues when doing the difference,
             // we need to do that computation on 128 bit rather than casting
@@ -5745,7 +6397,8 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
                 {
                     SetMetadataItem( "STATISTICS_APPROXIMATE",  nullptr );
                 }
-                SetStatistics( nMin, nMax, dfMean, dfStdDev );
+                SetStatistics( nMin + dfOffset, nMax + dfOffset,
+                               dfMean, dfStdDev );
             }
 
             SetValidPercent( nSampleCount, nValidCount );
@@ -5754,9 +6407,9 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
 /*      Record results.                                                 */
 /* -------------------------------------------------------------------- */
             if( pdfMin != nullptr )
-                *pdfMin = nValidCount ? nMin : 0;
+                *pdfMin = nValidCount ? nMin + dfOffset : 0;
             if( pdfMax != nullptr )
-                *pdfMax = nValidCount ? nMax : 0;
+                *pdfMax = nValidCount ? nMax + dfOffset : 0;
 
             if( pdfMean != nullptr )
                 *pdfMean = dfMean;
@@ -5774,65 +6427,64 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
         }
 #endif
 
-        for( int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate )
+        std::vector<GDALStatisticsPartial> asPartials(
+                                        oIterator.GetSampledBlockCount());
+
+        const GDALDataType eDT = eDataType;
+        const int nBufferWidth = nBlockXSize;
+        const bool bHasNoData = CPL_TO_BOOL(bGotNoDataValue);
+        const auto oFunc = [eDT, bSignedByte, nBufferWidth,
+                            bHasNoData, dfNoDataValue,
+                            bGotFloatNoDataValue, fNoDataValue,
+                            &asPartials]
+            (const void* pData, int nXCheck, int nYCheck, int iSampledBlock)
         {
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock * const poBlock = GetLockedBlockRef( iXBlock, iYBlock );
-            if( poBlock == nullptr )
-                return CE_Failure;
-
-            void* const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            // This isn't the fastest way to do this, but is easier for now.
-            for( int iY = 0; iY < nYCheck; iY++ )
+            GDALStatisticsPartial& s = asPartials[iSampledBlock];
+            if( eDT == GDT_Float32 )
             {
-                for( int iX = 0; iX < nXCheck; iX++ )
-                {
-                    const GPtrDiff_t iOffset = iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    bool bValid = true;
-                    double dfValue = GetPixelValue( eDataType,
-                                                    bSignedByte,
-                                                    pData,
-                                                    iOffset,
-                                                    CPL_TO_BOOL(bGotNoDataValue),
-                                                    dfNoDataValue,
-                                                    bGotFloatNoDataValue,
-                                                    fNoDataValue,
-                                                    bValid );
-
-                    if( !bValid )
-                        continue;
-
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
-
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
-                }
+                if( bGotFloatNoDataValue )
+                    ComputeStatisticsFloatingPoint<float, true>(
+                        static_cast<const float*>(pData),
+                        nXCheck, nBufferWidth, nYCheck, fNoDataValue, s);
+                else
+                    ComputeStatisticsFloatingPoint<float, false>(
+                        static_cast<const float*>(pData),
+                        nXCheck, nBufferWidth, nYCheck, 0.0f, s);
             }
-
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-
-            poBlock->DropLock();
-
-            if ( !pfnProgress(
-                     iSampleBlock
-                         / static_cast<double>(nBlocksPerRow*nBlocksPerColumn),
-                     "Compute Statistics", pProgressData) )
+            else if( eDT == GDT_Float64 )
             {
-                ReportError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
-                return CE_Failure;
+                if( bHasNoData )
+                    ComputeStatisticsFloatingPoint<double, true>(
+                        static_cast<const double*>(pData),
+                        nXCheck, nBufferWidth, nYCheck, dfNoDataValue, s);
+                else
+                    ComputeStatisticsFloatingPoint<double, false>(
+                        static_cast<const double*>(pData),
+                        nXCheck, nBufferWidth, nYCheck, 0.0, s);
             }
+            else
+            {
+                ComputeStatisticsGeneric( eDT, bSignedByte, pData,
+                                          nXCheck, nBufferWidth, nYCheck,
+                                          bHasNoData, dfNoDataValue,
+                                          bGotFloatNoDataValue, fNoDataValue,
+                                          s );
+            }
+        };
+
+        if( !oIterator.Run( oFunc, pfnProgress, pProgressData,
+                            "Compute Statistics", &bInterrupted ) )
+        {
+            if( bInterrupted )
+                ReportError( CE_Failure, CPLE_UserInterrupt,
+                             "User terminated" );
+            return CE_Failure;
         }
+
+        // Merge in block order, so that the result does not depend on the
+        // number of threads.
+        for( const auto& s: asPartials )
+            sStats.Merge(s);
     }
 
     if( !pfnProgress( 1.0, "Compute Statistics", pProgressData ) )
@@ -5844,8 +6496,13 @@ GDALRasterBand::ComputeStatistics( int bApproxOK,
 /* -------------------------------------------------------------------- */
 /*      Save computed information.                                      */
 /* -------------------------------------------------------------------- */
+    double dfMin = sStats.dfMin;
+    double dfMax = sStats.dfMax;
+    const double dfMean = sStats.GetMean();
+    const GUIntBig nSampleCount = sStats.nSampleCount;
+    const GUIntBig nValidCount = sStats.nValidCount;
     const double dfStdDev =
-        nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
+        nValidCount > 0 ? sqrt(sStats.dfM2 / nValidCount) : 0.0;
 
     if( nValidCount > 0 )
     {
@@ -6157,52 +6814,6 @@ static void ComputeMinMaxGeneric(const void* pData,
     }
 }
 
-static bool
-ComputeMinMaxGenericIterBlocks(GDALRasterBand* poBand,
-                               GDALDataType eDataType,
-                               bool bSignedByte,
-                                           int nTotalBlocks,
-                                           int nSampleRate,
-                                           int nBlocksPerRow,
-                                           bool bGotNoDataValue,
-                                           double dfNoDataValue,
-                                           bool bGotFloatNoDataValue,
-                                           float fNoDataValue,
-                                           double& dfMin,
-                                           double& dfMax)
-
-{
-    int nBlockXSize, nBlockYSize;
-    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-    for( int iSampleBlock = 0;
-         iSampleBlock < nTotalBlocks;
-         iSampleBlock += nSampleRate )
-    {
-        const int iYBlock = iSampleBlock / nBlocksPerRow;
-        const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef( iXBlock, iYBlock );
-        if( poBlock == nullptr )
-            return false;
-
-        void * const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        ComputeMinMaxGeneric(pData, eDataType, bSignedByte,
-                             nXCheck, nYCheck, nBlockXSize,
-                             CPL_TO_BOOL(bGotNoDataValue),
-                             dfNoDataValue,
-                             bGotFloatNoDataValue,
-                             fNoDataValue,
-                             dfMin, dfMax);
-
-        poBlock->DropLock();
-    }
-    return true;
-}
-
 /**
  * \brief Compute the min/max values for a band.
  *
@@ -6214,6 +6825,10 @@ ComputeMinMaxGenericIterBlocks(GDALRasterBand* poBand,
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.7, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads used to
+ * process the blocks of the band.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -6293,13 +6908,15 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
                                      eDataType == GDT_Int16 ||
                                      eDataType == GDT_UInt16;
 
+    const GDALDataType eDT = eDataType;
     const auto ComputeMinMaxForBlock = [
-        this, bSignedByte,
-        bGotNoDataValue, dfNoDataValue,
-        &nMin, &nMax, &nMinInt16, &nMaxInt16]
-        (const void* pData, int nXCheck, int nBufferWidth, int nYCheck)
+        eDT, bSignedByte,
+        bGotNoDataValue, dfNoDataValue]
+        (const void* pData, int nXCheck, int nBufferWidth, int nYCheck,
+         GUInt32& nBlockMin, GUInt32& nBlockMax,
+         GInt16& nBlockMinInt16, GInt16& nBlockMaxInt16)
     {
-        if( eDataType == GDT_Byte && !bSignedByte )
+        if( eDT == GDT_Byte && !bSignedByte )
         {
             const bool bHasNoData =
                 bGotNoDataValue &&
@@ -6312,11 +6929,11 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
                 static_cast<const GByte*>(pData),
                 bHasNoData,
                 nNoDataValue,
-                nMin,
-                nMax,
+                nBlockMin,
+                nBlockMax,
                 nSum, nSumSquare, nSampleCount, nValidCount);
         }
-        else if( eDataType == GDT_UInt16 )
+        else if( eDT == GDT_UInt16 )
         {
             const bool bHasNoData =
                 bGotNoDataValue &&
@@ -6329,11 +6946,11 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
                 static_cast<const GUInt16*>(pData),
                 bHasNoData,
                 nNoDataValue,
-                nMin,
-                nMax,
+                nBlockMin,
+                nBlockMax,
                 nSum, nSumSquare, nSampleCount, nValidCount);
         }
-        else if( eDataType == GDT_Int16 )
+        else if( eDT == GDT_Int16 )
         {
             const bool bHasNoData =
                 bGotNoDataValue &&
@@ -6348,8 +6965,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
                         static_cast<const int16_t*>(pData) + static_cast<size_t>(iY) * nBufferWidth,
                         nXCheck,
                         nNoDataValue,
-                        &nMinInt16,
-                        &nMaxInt16);
+                        &nBlockMinInt16,
+                        &nBlockMaxInt16);
                 }
             }
             else
@@ -6360,8 +6977,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
                         static_cast<const int16_t*>(pData) + static_cast<size_t>(iY) * nBufferWidth,
                         nXCheck,
                         0,
-                        &nMinInt16,
-                        &nMaxInt16);
+                        &nBlockMinInt16,
+                        &nBlockMaxInt16);
                 }
             }
         }
@@ -6406,7 +7023,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
 
         if( bUseOptimizedPath )
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced,
+                                  nMin, nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -6447,49 +7065,74 @@ CPLErr GDALRasterBand::ComputeRasterMinMax( int bApproxOK,
               nSampleRate += 1;
         }
 
-        if( bUseOptimizedPath )
+        // Blocks are processed in parallel if GDAL_NUM_THREADS is set.
+        GDALStatisticsBlockIterator oIterator(this, nSampleRate);
+
+        struct MinMaxPartial
+        {
+            GUInt32 nMin;
+            GUInt32 nMax;
+            GInt16 nMinInt16;
+            GInt16 nMaxInt16;
+            double dfMin;
+            double dfMax;
+        };
+        const MinMaxPartial sInitPartial =
+            { nMin, nMax, nMinInt16, nMaxInt16, dfMin, dfMax };
+        std::vector<MinMaxPartial> asPartials(
+            oIterator.GetSampledBlockCount(), sInitPartial);
+
+        // For Byte, no need to go further once the full range is reached.
+        std::atomic<bool> bFullRange{false};
+        oIterator.SetStopFlag(&bFullRange);
+
+        const int nBufferWidth = nBlockXSize;
+        const bool bHasNoData = CPL_TO_BOOL(bGotNoDataValue);
+        const auto oFunc = [eDT, bSignedByte, bUseOptimizedPath,
+                            nBufferWidth, bHasNoData, dfNoDataValue,
+                            bGotFloatNoDataValue, fNoDataValue,
+                            &ComputeMinMaxForBlock, &asPartials, &bFullRange]
+            (const void* pData, int nXCheck, int nYCheck, int iSampledBlock)
         {
-            for( int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate )
+            MinMaxPartial& s = asPartials[iSampledBlock];
+            if( bUseOptimizedPath )
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *poBlock = GetLockedBlockRef( iXBlock, iYBlock );
-                if( poBlock == nullptr )
-                    return CE_Failure;
-
-                void * const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
-
-                poBlock->DropLock();
-
-                if( eDataType == GDT_Byte && !bSignedByte && nMin == 0 && nMax == 255 )
-                    break;
+                ComputeMinMaxForBlock(pData, nXCheck, nBufferWidth, nYCheck,
+                                      s.nMin, s.nMax,
+                                      s.nMinInt16, s.nMaxInt16);
+                if( eDT == GDT_Byte && !bSignedByte &&
+                    s.nMin == 0 && s.nMax == 255 )
+                {
+                    bFullRange = true;
+                }
             }
-        }
-        else
-        {
-            const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
-            if( !ComputeMinMaxGenericIterBlocks(this, eDataType,
-                                                bSignedByte,
-                                                nTotalBlocks,
-                                                nSampleRate,
-                                                nBlocksPerRow,
-                                                CPL_TO_BOOL(bGotNoDataValue),
-                                                dfNoDataValue,
-                                                bGotFloatNoDataValue,
-                                                fNoDataValue,
-                                                dfMin,
-                                                dfMax) )
+            else
             {
-                return CE_Failure;
+                ComputeMinMaxGeneric(pData, eDT, bSignedByte,
+                                     nXCheck, nYCheck, nBufferWidth,
+                                     bHasNoData,
+                                     dfNoDataValue,
+                                     bGotFloatNoDataValue,
+                                     fNoDataValue,
+                                     s.dfMin, s.dfMax);
             }
+        };
+
+        bool bInterrupted = false;
+        if( !oIterator.Run( oFunc, GDALDummyProgress, nullptr, nullptr,
+                            &bInterrupted ) )
+        {
+            return CE_Failure;
+        }
+
+        for( const auto& s: asPartials )
+        {
+            nMin = std::min(nMin, s.nMin);
+            nMax = std::max(nMax, s.nMax);
+            nMinInt16 = std::min(nMinInt16, s.nMinInt16);
+            nMaxInt16 = std::max(nMaxInt16, s.nMaxInt16);
+            dfMin = std::min(dfMin, s.dfMin);
+            dfMax = std::max(dfMax, s.dfMax);
         }
     }
 
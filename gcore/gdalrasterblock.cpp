@@ -33,8 +33,10 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
 #include <cstring>
+#include <limits>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -47,21 +49,50 @@
 static bool bCacheMaxInitialized = false;
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD( &hRBLock )
-#define TAKE_LOCK       CPLMutexHolderOptionalLockD( hRBLock )
-#define DESTROY_LOCK    CPLDestroyMutex( hRBLock )
-#else
+/************************************************************************/
+/*                          Cache shards                                */
+/*                                                                      */
+/*      The LRU list of cached blocks is split into several shards,     */
+/*      each protected by its own lock, so that threads working on      */
+/*      different blocks do not contend on a single lock. A block       */
+/*      belongs to the shard selected by a hash of its band and block   */
+/*      coordinates. The GDAL_CACHEMAX budget (nCacheUsed) is global.   */
+/*      Each touch stamps the block with a global sequence number, so   */
+/*      that eviction can pick the shard holding the least recently     */
+/*      used block of the whole cache.                                  */
+/************************************************************************/
+
+constexpr int MAX_RB_SHARD_COUNT = 64;
+constexpr GUIntBig NO_LRU_TICK = std::numeric_limits<GUIntBig>::max();
+
+namespace {
+struct alignas(64) GDALRasterBlockCacheShard
+{
+    CPLLock                *hLock = nullptr;
+
+    GDALRasterBlock        *poOldest = nullptr;  // Tail.
+    GDALRasterBlock        *poNewest = nullptr;  // Head.
+
+    // LRU tick of poOldest, so that it can be read without taking hLock.
+    std::atomic<GUIntBig>   nOldestTick{NO_LRU_TICK};
+
+    std::atomic<GIntBig>    nUsed{0};
+    std::atomic<GUIntBig>   nHits{0};
+    std::atomic<GUIntBig>   nMisses{0};
+    std::atomic<GUIntBig>   nEvictions{0};
+};
+}  // namespace
+
+static GDALRasterBlockCacheShard aoShards[MAX_RB_SHARD_COUNT];
+// Always a power of two. Set once by InitializeShards().
+static int nShardCount = 1;
+static bool bShardCountInitialized = false;
+static std::atomic<GUIntBig> nLastLRUTick{0};
 
-static CPLLock* hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -91,12 +122,124 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK         CPLLockHolderD( &hRBLock, GetLockType() ); \
-                                CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK               CPLLockHolderOptionalLockD( hRBLock )
-#define DESTROY_LOCK            CPLDestroyLock( hRBLock )
+/************************************************************************/
+/*                          GetShardCountOption()                       */
+/************************************************************************/
 
-#endif
+static int GetShardCountOption()
+{
+    const char* pszShardCount =
+        CPLGetConfigOption("GDAL_RB_SHARD_COUNT", "AUTO");
+    int nCount = EQUAL(pszShardCount, "AUTO") ? CPLGetNumCPUs()
+                                                : atoi(pszShardCount);
+    if( nCount < 1 )
+    {
+        if( !EQUAL(pszShardCount, "AUTO") )
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for GDAL_RB_SHARD_COUNT: %s. Using 1",
+                     pszShardCount);
+        }
+        nCount = 1;
+    }
+    nCount = std::min(nCount, MAX_RB_SHARD_COUNT);
+
+    // Round up to the next power of two.
+    int nPow2 = 1;
+    while( nPow2 < nCount )
+        nPow2 *= 2;
+    return nPow2;
+}
+
+/************************************************************************/
+/*                          InitializeShards()                          */
+/************************************************************************/
+
+static void InitializeShards()
+{
+    // The lock of the first shard also protects the initialization.
+    CPLLockHolderD( &aoShards[0].hLock, GetLockType() );
+    CPLLockSetDebugPerf(aoShards[0].hLock, bDebugContention);
+
+    // The number of shards cannot change once blocks have been cached.
+    if( !bShardCountInitialized )
+    {
+        nShardCount = GetShardCountOption();
+        bShardCountInitialized = true;
+        CPLDebug("GDAL", "Using %d block cache shard(s)", nShardCount);
+    }
+
+    for( int i = 1; i < nShardCount; ++i )
+    {
+        if( aoShards[i].hLock == nullptr )
+        {
+            aoShards[i].hLock = CPLCreateLock(GetLockType());
+            CPLLockSetDebugPerf(aoShards[i].hLock, bDebugContention);
+        }
+    }
+}
+
+/************************************************************************/
+/*                              GetShard()                              */
+/************************************************************************/
+
+static GDALRasterBlockCacheShard& GetShard( const GDALRasterBand* poBand,
+                                            int nXOff, int nYOff )
+{
+    if( nShardCount == 1 )
+        return aoShards[0];
+
+    GUIntBig nHash =
+        static_cast<GUIntBig>(reinterpret_cast<uintptr_t>(poBand)) >> 4;
+    nHash = nHash * 31 + static_cast<unsigned>(nXOff);
+    nHash = nHash * 31 + static_cast<unsigned>(nYOff);
+    // Final mix of splitmix64, so that neighbouring blocks spread over
+    // the shards.
+    nHash ^= nHash >> 30;
+    nHash *= 0xbf58476d1ce4e5b9ULL;
+    nHash ^= nHash >> 27;
+    nHash *= 0x94d049bb133111ebULL;
+    nHash ^= nHash >> 31;
+    return aoShards[nHash & static_cast<unsigned>(nShardCount - 1)];
+}
+
+/************************************************************************/
+/*                          GetOldestShard()                            */
+/************************************************************************/
+
+// Returns the index of the shard, not in pabExcluded, whose oldest block
+// is the least recently used one, or -1 if all those shards are empty.
+// *pnOtherOldestTick is set to the LRU tick of the oldest block of the other
+// shards.
+static int GetOldestShard( const bool* pabExcluded,
+                           GUIntBig* pnOtherOldestTick )
+{
+    int iOldest = -1;
+    GUIntBig nOldestTick = NO_LRU_TICK;
+    GUIntBig nOtherOldestTick = NO_LRU_TICK;
+    for( int i = 0; i < nShardCount; ++i )
+    {
+        const GUIntBig nTick =
+            aoShards[i].nOldestTick.load(std::memory_order_relaxed);
+        if( nTick < nOldestTick && !pabExcluded[i] )
+        {
+            nOtherOldestTick = std::min(nOtherOldestTick, nOldestTick);
+            nOldestTick = nTick;
+            iOldest = i;
+        }
+        else if( nTick < nOtherOldestTick )
+        {
+            nOtherOldestTick = nTick;
+        }
+    }
+    if( pnOtherOldestTick )
+        *pnOtherOldestTick = nOtherOldestTick;
+    return iOldest;
+}
+
+#define INITIALIZE_LOCK         InitializeShards()
+#define TAKE_LOCK(oShard)       CPLLockHolderOptionalLockD( (oShard).hLock )
+#define DESTROY_LOCK(oShard)    CPLDestroyLock( (oShard).hLock )
 
 //#define ENABLE_DEBUG
 
@@ -353,6 +496,80 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64() { return nCacheUsed; }
 
+/************************************************************************/
+/*                       GDALGetCacheShardCount()                       */
+/************************************************************************/
+
+/**
+ * \brief Get the number of shards of the block cache.
+ *
+ * The least-recently-used list of the block cache is split into several
+ * shards, each with its own lock, to reduce lock contention when several
+ * threads access the cache. The number of shards is determined by the
+ * GDAL_RB_SHARD_COUNT configuration option (default: AUTO, that is the
+ * number of CPUs rounded up to a power of two, capped to 64) when the cache
+ * is first used. The GDAL_CACHEMAX limit applies to the sum of all shards.
+ *
+ * @return the number of shards.
+ *
+ * @since GDAL 3.7
+ */
+
+int CPL_STDCALL GDALGetCacheShardCount()
+{
+    // Makes sure the shards are initialized.
+    GDALGetCacheMax64();
+    return nShardCount;
+}
+
+/************************************************************************/
+/*                    GDALGetCacheShardStatistics()                     */
+/************************************************************************/
+
+/**
+ * \brief Get statistics of a shard of the block cache.
+ *
+ * Hits are counted when a cached block is reacquired, misses when a new
+ * block is allocated in the cache, and evictions when a block is removed
+ * from the cache to honour the GDAL_CACHEMAX limit or by
+ * GDALFlushCacheBlock().
+ *
+ * @param iShard shard index, between 0 and GDALGetCacheShardCount() - 1.
+ * @param pnUsed pointer to the number of bytes used by the cached blocks
+ *               of the shard, or NULL.
+ * @param pnHits pointer to the number of hits, or NULL.
+ * @param pnMisses pointer to the number of misses, or NULL.
+ * @param pnEvictions pointer to the number of evictions, or NULL.
+ *
+ * @return TRUE in case of success, FALSE if iShard is invalid.
+ *
+ * @since GDAL 3.7
+ */
+
+int CPL_STDCALL GDALGetCacheShardStatistics( int iShard,
+                                             GIntBig *pnUsed,
+                                             GUIntBig *pnHits,
+                                             GUIntBig *pnMisses,
+                                             GUIntBig *pnEvictions )
+{
+    if( iShard < 0 || iShard >= GDALGetCacheShardCount() )
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid shard index: %d", iShard);
+        return FALSE;
+    }
+    const auto& oShard = aoShards[iShard];
+    if( pnUsed )
+        *pnUsed = oShard.nUsed;
+    if( pnHits )
+        *pnHits = oShard.nHits;
+    if( pnMisses )
+        *pnMisses = oShard.nMisses;
+    if( pnEvictions )
+        *pnEvictions = oShard.nEvictions;
+    return TRUE;
+}
+
 /************************************************************************/
 /*                        GDALFlushCacheBlock()                         */
 /*                                                                      */
@@ -430,11 +647,21 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
 
 {
-    GDALRasterBlock *poTarget;
+    INITIALIZE_LOCK;
+
+    GDALRasterBlock *poTarget = nullptr;
 
+    // Shards in which no block can be flushed.
+    bool abExhausted[MAX_RB_SHARD_COUNT] = { false };
+    while( poTarget == nullptr )
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        const int iShard = GetOldestShard(abExhausted, nullptr);
+        if( iShard < 0 )
+            return FALSE;
+        auto& oShard = aoShards[iShard];
+
+        TAKE_LOCK(oShard);
+        poTarget = oShard.poOldest;
 
         while( poTarget != nullptr )
         {
@@ -449,7 +676,10 @@ int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
         }
 
         if( poTarget == nullptr )
-            return FALSE;
+        {
+            abExhausted[iShard] = true;
+            continue;
+        }
         if( bSleepsForBockCacheDebug )
         {
             // coverity[tainted_data]
@@ -462,6 +692,7 @@ int GDALRasterBlock::FlushCacheBlock( int bDirtyBlocksOnly )
 
         poTarget->Detach_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
+        ++oShard.nEvictions;
     }
 
     if( bSleepsForBockCacheDebug )
@@ -592,7 +823,8 @@ GDALRasterBlock::GDALRasterBlock( GDALRasterBand *poBandIn,
     poBand(poBandIn),
     poNext(nullptr),
     poPrevious(nullptr),
-    bMustDetach(true)
+    bMustDetach(true),
+    nLRUTick(0)
 {
     CPLAssert( poBandIn != nullptr );
     poBand->GetBlockSize( &nXSize, &nYSize );
@@ -628,7 +860,8 @@ GDALRasterBlock::GDALRasterBlock( int nXOffIn, int nYOffIn ) :
     poBand(nullptr),
     poNext(nullptr),
     poPrevious(nullptr),
-    bMustDetach(false)
+    bMustDetach(false),
+    nLRUTick(0)
 {}
 
 /************************************************************************/
@@ -654,6 +887,7 @@ void GDALRasterBlock::RecycleFor( int nXOffIn, int nYOffIn )
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = true;
+    nLRUTick = 0;
 }
 
 /************************************************************************/
@@ -716,19 +950,24 @@ void GDALRasterBlock::Detach()
 {
     if( bMustDetach )
     {
-        TAKE_LOCK;
+        TAKE_LOCK(GetShard(poBand, nXOff, nYOff));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if( poOldest == this )
-        poOldest = poPrevious;
+    auto& oShard = GetShard(poBand, nXOff, nYOff);
+    if( oShard.poOldest == this )
+    {
+        oShard.poOldest = poPrevious;
+        oShard.nOldestTick = oShard.poOldest ? oShard.poOldest->nLRUTick
+                                             : NO_LRU_TICK;
+    }
 
-    if( poNewest == this )
+    if( oShard.poNewest == this )
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if( poPrevious != nullptr )
@@ -742,7 +981,12 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = false;
 
     if( pData )
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+    {
+        const GIntBig nEffectiveSize =
+            GetEffectiveBlockSize(GetBlockSize());
+        nCacheUsed -= nEffectiveSize;
+        oShard.nUsed -= nEffectiveSize;
+    }
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -762,27 +1006,35 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert( (poNewest == nullptr && poOldest == nullptr)
-               || (poNewest != nullptr && poOldest != nullptr) );
-
-    if( poNewest != nullptr )
+    for( int iShard = 0; iShard < nShardCount; ++iShard )
     {
-        CPLAssert( poNewest->poPrevious == nullptr );
-        CPLAssert( poOldest->poNext == nullptr );
+        auto& oShard = aoShards[iShard];
+        TAKE_LOCK(oShard);
 
-        GDALRasterBlock* poLast = nullptr;
-        for( GDALRasterBlock *poBlock = poNewest;
-             poBlock != nullptr;
-             poBlock = poBlock->poNext )
+        CPLAssert( (oShard.poNewest == nullptr && oShard.poOldest == nullptr)
+                   || (oShard.poNewest != nullptr &&
+                       oShard.poOldest != nullptr) );
+
+        if( oShard.poNewest != nullptr )
         {
-            CPLAssert( poBlock->poPrevious == poLast );
+            CPLAssert( oShard.poNewest->poPrevious == nullptr );
+            CPLAssert( oShard.poOldest->poNext == nullptr );
+            CPLAssert( oShard.nOldestTick == oShard.poOldest->nLRUTick );
+
+            GDALRasterBlock* poLast = nullptr;
+            for( GDALRasterBlock *poBlock = oShard.poNewest;
+                 poBlock != nullptr;
+                 poBlock = poBlock->poNext )
+            {
+                CPLAssert( poBlock->poPrevious == poLast );
+                CPLAssert( &GetShard(poBlock->poBand, poBlock->nXOff,
+                                     poBlock->nYOff) == &oShard );
 
-            poLast = poBlock;
-        }
+                poLast = poBlock;
+            }
 
-        CPLAssert( poOldest == poLast );
+            CPLAssert( oShard.poOldest == poLast );
+        }
     }
 }
 
@@ -793,8 +1045,10 @@ void GDALRasterBlock::Verify() {}
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks( GDALRasterBand* poBand )
 {
-    TAKE_LOCK;
-    for( GDALRasterBlock *poBlock = poNewest;
+    for( int iShard = 0; iShard < nShardCount; ++iShard )
+    {
+    TAKE_LOCK(aoShards[iShard]);
+    for( GDALRasterBlock *poBlock = aoShards[iShard].poNewest;
                           poBlock != nullptr;
                           poBlock = poBlock->poNext )
     {
@@ -814,6 +1068,7 @@ void GDALRasterBlock::CheckNonOrphanedBlocks( GDALRasterBand* poBand )
                        poBand->GetDataset()->GetDescription());
         }
     }
+    }
 }
 #endif
 
@@ -867,32 +1122,48 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
-    // Can be safely tested outside the lock
-    if( poNewest == this )
+    auto& oShard = GetShard(poBand, nXOff, nYOff);
+
+    // Can be safely tested outside the lock. With several shards, the LRU
+    // tick of the newest block of a shard must still be refreshed, as
+    // blocks of other shards may have been touched since.
+    if( nShardCount == 1 && oShard.poNewest == this )
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    auto& oShard = GetShard(poBand, nXOff, nYOff);
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if( poNewest == this )
+    if( oShard.poNewest == this )
+    {
+        if( nShardCount > 1 )
+        {
+            nLRUTick = ++nLastLRUTick;
+            if( oShard.poOldest == this )
+                oShard.nOldestTick = nLRUTick;
+        }
         return;
+    }
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if( poOldest == this )
-        poOldest = this->poPrevious;
+    nLRUTick = ++nLastLRUTick;
+
+    if( oShard.poOldest == this )
+        oShard.poOldest = this->poPrevious;
 
     if( poPrevious != nullptr )
         poPrevious->poNext = poNext;
@@ -901,20 +1172,21 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if( poNewest != nullptr )
+    if( oShard.poNewest != nullptr )
     {
-        CPLAssert( poNewest->poPrevious == nullptr );
-        poNewest->poPrevious = this;
+        CPLAssert( oShard.poNewest->poPrevious == nullptr );
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if( poOldest == nullptr )
+    if( oShard.poOldest == nullptr )
     {
         CPLAssert( poPrevious == nullptr && poNext == nullptr );
-        poOldest = this;
+        oShard.poOldest = this;
     }
+    oShard.nOldestTick = oShard.poOldest->nLRUTick;
 #ifdef ENABLE_DEBUG
     Verify();
 #endif
@@ -942,17 +1214,22 @@ CPLErr GDALRasterBlock::Internalize()
 
     void        *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the shard locks. Other call places can
     // only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
+    const GIntBig nEffectiveSize = GetEffectiveBlockSize(nSizeInBytes);
+
+    auto& oThisShard = GetShard(poBand, nXOff, nYOff);
+    nCacheUsed += nEffectiveSize;
+    oThisShard.nUsed += nEffectiveSize;
+    ++oThisShard.nMisses;
 
 /* -------------------------------------------------------------------- */
 /*      Flush old blocks if we are nearing our memory limit.            */
 /* -------------------------------------------------------------------- */
-    bool bFirstIter = true;
     bool bLoopAgain = false;
     GDALDataset* poThisDS = poBand->GetDataset();
     do
@@ -960,12 +1237,31 @@ CPLErr GDALRasterBlock::Internalize()
         bLoopAgain = false;
         GDALRasterBlock* apoBlocksToFree[64] = { nullptr };
         int nBlocksToFree = 0;
+
+        // Shards in which no block could be evicted in this pass.
+        bool abExhausted[MAX_RB_SHARD_COUNT] = { false };
+        // Dirty blocks of other datasets are only evicted once no other
+        // candidate has been found in any shard.
+        bool bAllowDirtyBlockOtherDataset = false;
+        while( !bLoopAgain && nCacheUsed > nCurCacheMax )
         {
-            TAKE_LOCK;
+            GUIntBig nOtherShardsOldestTick = NO_LRU_TICK;
+            const int iShard =
+                GetOldestShard(abExhausted, &nOtherShardsOldestTick);
+            if( iShard < 0 )
+            {
+                if( bAllowDirtyBlockOtherDataset )
+                    break;
+                bAllowDirtyBlockOtherDataset = true;
+                std::fill_n(abExhausted, MAX_RB_SHARD_COUNT, false);
+                continue;
+            }
+            auto& oShard = aoShards[iShard];
 
-            if( bFirstIter )
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
+            TAKE_LOCK(oShard);
+
+            bool bEvictedFromShard = false;
+            GDALRasterBlock *poTarget = oShard.poOldest;
             while( nCacheUsed > nCurCacheMax )
             {
                 GDALRasterBlock* poDirtyBlockOtherDataset = nullptr;
@@ -980,6 +1276,14 @@ CPLErr GDALRasterBlock::Internalize()
                 //    so gets the old value.
                 while( poTarget != nullptr )
                 {
+                    // Once a block has been evicted from this shard, go on
+                    // only with blocks older than the ones of other shards.
+                    if( bEvictedFromShard &&
+                        poTarget->nLRUTick > nOtherShardsOldestTick )
+                    {
+                        poTarget = nullptr;
+                        break;
+                    }
                     if( !poTarget->GetDirty() )
                     {
                         if( CPLAtomicCompareAndExchange(
@@ -1001,7 +1305,8 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     poTarget = poTarget->poPrevious;
                 }
-                if( poTarget == nullptr && poDirtyBlockOtherDataset )
+                if( poTarget == nullptr && poDirtyBlockOtherDataset &&
+                    bAllowDirtyBlockOtherDataset && !bEvictedFromShard )
                 {
                     if( CPLAtomicCompareAndExchange(
                             &(poDirtyBlockOtherDataset->nLockCount), 0, -1) )
@@ -1011,7 +1316,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oShard.poOldest;
                         while( poTarget != nullptr )
                         {
                             if( CPLAtomicCompareAndExchange(
@@ -1042,6 +1347,8 @@ CPLErr GDALRasterBlock::Internalize()
 
                     poTarget->Detach_unlocked();
                     poTarget->GetBand()->UnreferenceBlock(poTarget);
+                    ++oShard.nEvictions;
+                    bEvictedFromShard = true;
 
                     apoBlocksToFree[nBlocksToFree++] = poTarget;
                     if( poTarget->GetDirty() )
@@ -1066,14 +1373,18 @@ CPLErr GDALRasterBlock::Internalize()
                 }
             }
 
-        /* ------------------------------------------------------------------ */
-        /*      Add this block to the list.                                   */
-        /* ------------------------------------------------------------------ */
-            if( !bLoopAgain )
-                Touch_unlocked();
+            if( !bEvictedFromShard )
+                abExhausted[iShard] = true;
         }
 
-        bFirstIter = false;
+    /* ------------------------------------------------------------------ */
+    /*      Add this block to the list.                                   */
+    /* ------------------------------------------------------------------ */
+        if( !bLoopAgain )
+        {
+            TAKE_LOCK(oThisShard);
+            Touch_unlocked();
+        }
 
         // Now free blocks we have detached and removed from their band.
         for( int i = 0; i < nBlocksToFree; ++i)
@@ -1124,6 +1435,15 @@ CPLErr GDALRasterBlock::Internalize()
         pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE( nSizeInBytes );
         if( pNewData == nullptr )
         {
+            // Remove the block from the cache, and give back its size to the
+            // cache budget, as Detach_unlocked() will not do it since pData
+            // is not set.
+            {
+                TAKE_LOCK(oThisShard);
+                Detach_unlocked();
+            }
+            nCacheUsed -= nEffectiveSize;
+            oThisShard.nUsed -= nEffectiveSize;
             return( CE_Failure );
         }
     }
@@ -1180,9 +1500,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if( hRBLock != nullptr )
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for( auto& oShard: aoShards )
+    {
+        if( oShard.hLock != nullptr )
+            DESTROY_LOCK(oShard);
+        oShard.hLock = nullptr;
+    }
 }
 /*! @endcond */
 
@@ -1230,6 +1553,7 @@ int GDALRasterBlock::TakeLock()
         return FALSE;
     }
     Touch();
+    ++GetShard(poBand, nXOff, nYOff).nHits;
     return TRUE;
 }
 
@@ -1261,7 +1585,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(GetShard(poBand, nXOff, nYOff));
 
     return FALSE;
 }
@@ -1270,14 +1594,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int iShard = 0; iShard < nShardCount; ++iShard )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = aoShards[iShard].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d (shard %d)\n", iBlock, iShard);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
@@ -427,716 +427,134 @@ template<> inline GUInt16 ComputeIntegerRMS_4values<GUInt16, double>(double sumS
 
 #ifdef USE_SSE2
 
+#include "overview_sse2_avx2_kernels.hpp"
+
+// When the compiler can generate AVX2 code but it is not enabled for this
+// file, an AVX2 build of the kernels is available in overview_avx2.cpp and
+// selected at runtime.
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && !defined(__AVX2__)
+#define USE_RUNTIME_AVX2_DISPATCH
+#include "cpl_cpu_features.h"
+#include "overview_avx2.h"
+#endif
+
 /************************************************************************/
-/*                   QuadraticMeanByteSSE2OrAVX2()                      */
+/*                         QuadraticMeanByteSIMD()                      */
 /************************************************************************/
 
-#ifdef __SSE4_1__
-#define sse2_packus_epi32    _mm_packus_epi32
-#else
-inline __m128i sse2_packus_epi32(__m128i a, __m128i b)
+template<class T> static inline int QuadraticMeanByteSIMD(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        T* CPL_RESTRICT pDstScanline)
 {
-    const auto minus32768_32 = _mm_set1_epi32(-32768);
-    const auto minus32768_16 = _mm_set1_epi16(-32768);
-    a = _mm_add_epi32(a, minus32768_32);
-    b = _mm_add_epi32(b, minus32768_32);
-    a = _mm_packs_epi32(a, b);
-    a = _mm_sub_epi16(a, minus32768_16);
-    return a;
+    return QuadraticMeanByteSSE2OrAVX2(nDstXWidth, nChunkXSize,
+                                       pSrcScanlineShiftedInOut, pDstScanline);
 }
-#endif
 
-#ifdef __SSSE3__
-#define sse2_hadd_epi16     _mm_hadd_epi16
-#else
-inline __m128i sse2_hadd_epi16(__m128i a, __m128i b)
+#ifdef USE_RUNTIME_AVX2_DISPATCH
+template<> inline int QuadraticMeanByteSIMD<GByte>(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const GByte*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        GByte* CPL_RESTRICT pDstScanline)
 {
-    // Horizontal addition of adjacent pairs
-    const auto mask = _mm_set1_epi32(0xFFFF);
-    const auto horizLo = _mm_add_epi32(_mm_and_si128(a, mask), _mm_srli_epi32(a, 16));
-    const auto horizHi = _mm_add_epi32(_mm_and_si128(b, mask), _mm_srli_epi32(b, 16));
-
-    // Recombine low and high parts
-    return _mm_packs_epi32(horizLo, horizHi);
+    if( CPLHaveRuntimeAVX2() )
+        return GDALQuadraticMeanByte_AVX2(nDstXWidth, nChunkXSize,
+                                          pSrcScanlineShiftedInOut, pDstScanline);
+    return QuadraticMeanByteSSE2OrAVX2(nDstXWidth, nChunkXSize,
+                                       pSrcScanlineShiftedInOut, pDstScanline);
 }
 #endif
 
-
-#ifdef __AVX2__
-#define DEST_ELTS       16
-#define set1_epi16      _mm256_set1_epi16
-#define set1_epi32      _mm256_set1_epi32
-#define setzero         _mm256_setzero_si256
-#define set1_ps         _mm256_set1_ps
-#define loadu_int(x)    _mm256_loadu_si256(reinterpret_cast<__m256i const*>(x))
-#define unpacklo_epi8   _mm256_unpacklo_epi8
-#define unpackhi_epi8   _mm256_unpackhi_epi8
-#define madd_epi16      _mm256_madd_epi16
-#define add_epi32       _mm256_add_epi32
-#define mul_ps          _mm256_mul_ps
-#define cvtepi32_ps     _mm256_cvtepi32_ps
-#define sqrt_ps         _mm256_sqrt_ps
-#define cvttps_epi32    _mm256_cvttps_epi32
-#define packs_epi32     _mm256_packs_epi32
-#define packus_epi32    _mm256_packus_epi32
-#define srli_epi32      _mm256_srli_epi32
-#define mullo_epi16     _mm256_mullo_epi16
-#define srli_epi16      _mm256_srli_epi16
-#define cmpgt_epi16     _mm256_cmpgt_epi16
-#define add_epi16       _mm256_add_epi16
-#define sub_epi16       _mm256_sub_epi16
-#define packus_epi16    _mm256_packus_epi16
-/* AVX2 operates on 2 separate 128-bit lanes, so we have to do shuffling */
-/* to get the lower 128-bit bits of what would be a true 256-bit vector register */
-#define store_lo(x,y)   _mm_storeu_si128(reinterpret_cast<__m128i*>(x), \
-                            _mm256_extracti128_si256(_mm256_permute4x64_epi64((y), 0 | (2 << 2)), 0))
-#define hadd_epi16      _mm256_hadd_epi16
-#define zeroupper()     _mm256_zeroupper()
-#else
-#define DEST_ELTS       8
-#define set1_epi16      _mm_set1_epi16
-#define set1_epi32      _mm_set1_epi32
-#define setzero         _mm_setzero_si128
-#define set1_ps         _mm_set1_ps
-#define loadu_int(x)    _mm_loadu_si128(reinterpret_cast<__m128i const*>(x))
-#define unpacklo_epi8   _mm_unpacklo_epi8
-#define unpackhi_epi8   _mm_unpackhi_epi8
-#define madd_epi16      _mm_madd_epi16
-#define add_epi32       _mm_add_epi32
-#define mul_ps          _mm_mul_ps
-#define cvtepi32_ps     _mm_cvtepi32_ps
-#define sqrt_ps         _mm_sqrt_ps
-#define cvttps_epi32    _mm_cvttps_epi32
-#define packs_epi32     _mm_packs_epi32
-#define packus_epi32    sse2_packus_epi32
-#define srli_epi32      _mm_srli_epi32
-#define mullo_epi16     _mm_mullo_epi16
-#define srli_epi16      _mm_srli_epi16
-#define cmpgt_epi16     _mm_cmpgt_epi16
-#define add_epi16       _mm_add_epi16
-#define sub_epi16       _mm_sub_epi16
-#define packus_epi16    _mm_packus_epi16
-#define store_lo(x,y)   _mm_storel_epi64(reinterpret_cast<__m128i*>(x), (y))
-#define hadd_epi16      sse2_hadd_epi16
-#define zeroupper()     (void)0
-#endif
-
-template<class T> static int QuadraticMeanByteSSE2OrAVX2(
-                                                   int nDstXWidth,
-                                                   int nChunkXSize,
-                                                   const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
-                                                   T* CPL_RESTRICT pDstScanline)
-{
-    // Optimized implementation for RMS on Byte by
-    // processing by group of 8 output pixels, so as to use
-    // a single _mm_sqrt_ps() call for 4 output pixels
-    const T* CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
-
-    int iDstPixel = 0;
-    const auto one16 = set1_epi16(1);
-    const auto one32 = set1_epi32(1);
-    const auto zero = setzero();
-    const auto minus32768 = set1_epi16(-32768);
-
-    for( ; iDstPixel < nDstXWidth - (DEST_ELTS-1); iDstPixel += DEST_ELTS )
-    {
-        // Load 2 * DEST_ELTS bytes from each line
-        auto firstLine = loadu_int(pSrcScanlineShifted);
-        auto secondLine = loadu_int(pSrcScanlineShifted + nChunkXSize);
-        // Extend those Bytes as UInt16s
-        auto firstLineLo = unpacklo_epi8(firstLine, zero);
-        auto firstLineHi = unpackhi_epi8(firstLine, zero);
-        auto secondLineLo = unpacklo_epi8(secondLine, zero);
-        auto secondLineHi = unpackhi_epi8(secondLine, zero);
-
-        // Multiplication of 16 bit values and horizontal
-        // addition of 32 bit results
-        // [ src[2*i+0]^2 + src[2*i+1]^2 for i in range(4) ]
-        firstLineLo = madd_epi16(firstLineLo, firstLineLo);
-        firstLineHi = madd_epi16(firstLineHi, firstLineHi);
-        secondLineLo = madd_epi16(secondLineLo, secondLineLo);
-        secondLineHi = madd_epi16(secondLineHi, secondLineHi);
-
-        // Vertical addition
-        const auto sumSquaresLo = add_epi32(firstLineLo, secondLineLo);
-        const auto sumSquaresHi = add_epi32(firstLineHi, secondLineHi);
-
-        const auto sumSquaresPlusOneDiv4Lo =
-            srli_epi32(add_epi32(sumSquaresLo, one32), 2);
-        const auto sumSquaresPlusOneDiv4Hi =
-            srli_epi32(add_epi32(sumSquaresHi, one32), 2);
-
-        // Take square root and truncate/floor to int32
-        const auto rmsLo = cvttps_epi32(sqrt_ps(cvtepi32_ps(sumSquaresPlusOneDiv4Lo)));
-        const auto rmsHi = cvttps_epi32(sqrt_ps(cvtepi32_ps(sumSquaresPlusOneDiv4Hi)));
-
-        // Merge back low and high registers with each RMS value
-        // as a 16 bit value.
-        auto rms = packs_epi32(rmsLo, rmsHi);
-
-        // Round to upper value if it minimizes the
-        // error |rms^2 - sumSquares/4|
-        // if( 2 * (2 * rms * (rms + 1) + 1) < sumSquares )
-        //    rms += 1;
-        // which is equivalent to:
-        // if( rms * (rms + 1) < (sumSquares+1) / 4 )
-        //    rms += 1;
-        // And both left and right parts fit on 16 (unsigned) bits
-        const auto sumSquaresPlusOneDiv4 = packus_epi32(
-            sumSquaresPlusOneDiv4Lo, sumSquaresPlusOneDiv4Hi);
-        // cmpgt_epi16 operates on signed int16, but here
-        // we have unsigned values, so shift them by -32768 before
-        auto mask = cmpgt_epi16(
-            add_epi16(sumSquaresPlusOneDiv4, minus32768),
-            add_epi16(mullo_epi16(rms, add_epi16(rms, one16)), minus32768));
-        // The value of the mask will be -1 when the correction needs to be applied
-        rms = sub_epi16(rms, mask);
-
-        // Pack each 16 bit RMS value to 8 bits
-        rms = packus_epi16(rms, rms /* could be anything */);
-        store_lo(&pDstScanline[iDstPixel], rms);
-        pSrcScanlineShifted += 2 * DEST_ELTS;
-    }
-    zeroupper();
-
-    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
-    return iDstPixel;
-}
-
 /************************************************************************/
-/*                      AverageByteSSE2OrAVX2()                         */
+/*                            AverageByteSIMD()                         */
 /************************************************************************/
 
-template<class T> static int AverageByteSSE2OrAVX2(
-                                             int nDstXWidth,
-                                             int nChunkXSize,
-                                             const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
-                                             T* CPL_RESTRICT pDstScanline)
+template<class T> static inline int AverageByteSIMD(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        T* CPL_RESTRICT pDstScanline)
 {
-    // Optimized implementation for average on Byte by
-    // processing by group of 8 output pixels.
-
-    const auto zero = setzero();
-    const auto two16 = set1_epi16(2);
-    const T* CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
-
-    int iDstPixel = 0;
-    for( ; iDstPixel < nDstXWidth - (DEST_ELTS-1); iDstPixel += DEST_ELTS )
-    {
-        // Load 2 * DEST_ELTS bytes from each line
-        const auto firstLine = loadu_int(pSrcScanlineShifted);
-        const auto secondLine = loadu_int(pSrcScanlineShifted + nChunkXSize);
-        // Extend those Bytes as UInt16s
-        const auto firstLineLo = unpacklo_epi8(firstLine, zero);
-        const auto firstLineHi = unpackhi_epi8(firstLine, zero);
-        const auto secondLineLo = unpacklo_epi8(secondLine, zero);
-        const auto secondLineHi = unpackhi_epi8(secondLine, zero);
-
-        // Vertical addition
-        const auto sumLo = add_epi16(firstLineLo, secondLineLo);
-        const auto sumHi = add_epi16(firstLineHi, secondLineHi);
-
-        // Horizontal addition of adjacent pairs, and recombine low and high parts
-        const auto sum = hadd_epi16(sumLo, sumHi);
-
-        // average = (sum + 2) / 4
-        auto average = srli_epi16(add_epi16(sum, two16), 2);
-
-        // Pack each 16 bit average value to 8 bits
-        average = packus_epi16(average, average /* could be anything */);
-        store_lo(&pDstScanline[iDstPixel], average);
-        pSrcScanlineShifted += 2 * DEST_ELTS;
-    }
-    zeroupper();
-
-    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
-    return iDstPixel;
+    return AverageByteSSE2OrAVX2(nDstXWidth, nChunkXSize,
+                                 pSrcScanlineShiftedInOut, pDstScanline);
 }
 
-/************************************************************************/
-/*                     QuadraticMeanUInt16SSE2()                        */
-/************************************************************************/
-
-#ifdef __SSE3__
-#define sse2_hadd_pd _mm_hadd_pd
-#else
-inline __m128d sse2_hadd_pd(__m128d a, __m128d b)
+#ifdef USE_RUNTIME_AVX2_DISPATCH
+template<> inline int AverageByteSIMD<GByte>(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const GByte*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        GByte* CPL_RESTRICT pDstScanline)
 {
-    auto aLo_bLo = _mm_castps_pd(_mm_movelh_ps(_mm_castpd_ps(a), _mm_castpd_ps(b)));
-    auto aHi_bHi = _mm_castps_pd(_mm_movehl_ps(_mm_castpd_ps(b), _mm_castpd_ps(a)));
-    return _mm_add_pd(aLo_bLo, aHi_bHi); // (aLo + aHi, bLo + bHi)
+    if( CPLHaveRuntimeAVX2() )
+        return GDALAverageByte_AVX2(nDstXWidth, nChunkXSize,
+                                    pSrcScanlineShiftedInOut, pDstScanline);
+    return AverageByteSSE2OrAVX2(nDstXWidth, nChunkXSize,
+                                 pSrcScanlineShiftedInOut, pDstScanline);
 }
 #endif
 
-inline __m128d SQUARE(__m128d x)
-{
-    return _mm_mul_pd(x, x);
-}
-
-#ifdef __AVX2__
+/************************************************************************/
+/*                        QuadraticMeanUInt16SIMD()                     */
+/************************************************************************/
 
-inline __m256d FIXUP_LANES(__m256d x)
+template<class T> static inline int QuadraticMeanUInt16SIMD(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        T* CPL_RESTRICT pDstScanline)
 {
-    return _mm256_permute4x64_pd(x, _MM_SHUFFLE(3,1,2,0));
+    return QuadraticMeanUInt16SSE2(nDstXWidth, nChunkXSize,
+                                   pSrcScanlineShiftedInOut, pDstScanline);
 }
 
-inline __m256 FIXUP_LANES(__m256 x)
+#ifdef USE_RUNTIME_AVX2_DISPATCH
+template<> inline int QuadraticMeanUInt16SIMD<GUInt16>(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const GUInt16*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        GUInt16* CPL_RESTRICT pDstScanline)
 {
-    return _mm256_castpd_ps(FIXUP_LANES(_mm256_castps_pd(x)));
+    if( CPLHaveRuntimeAVX2() )
+        return GDALQuadraticMeanUInt16_AVX2(nDstXWidth, nChunkXSize,
+                                            pSrcScanlineShiftedInOut, pDstScanline);
+    return QuadraticMeanUInt16SSE2(nDstXWidth, nChunkXSize,
+                                   pSrcScanlineShiftedInOut, pDstScanline);
 }
-
-#endif
-
-template<class T> static int QuadraticMeanUInt16SSE2(int nDstXWidth,
-                                                     int nChunkXSize,
-                                                     const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
-                                                     T* CPL_RESTRICT pDstScanline)
-{
-    // Optimized implementation for RMS on UInt16 by
-    // processing by group of 4 output pixels.
-    const T* CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
-
-    int iDstPixel = 0;
-    const auto zero = _mm_setzero_si128();
-
-#ifdef __AVX2__
-    const auto zeroDot25 = _mm256_set1_pd(0.25);
-    const auto zeroDot5 = _mm256_set1_pd(0.5);
-
-    // The first four 0's could be anything, as we only take the bottom
-    // 128 bits.
-    const auto permutation =  _mm256_set_epi32(0,0,0,0,6,4,2,0);
-#else
-    const auto zeroDot25 = _mm_set1_pd(0.25);
-    const auto zeroDot5 = _mm_set1_pd(0.5);
-#endif
-
-    for( ; iDstPixel < nDstXWidth - 3; iDstPixel += 4 )
-    {
-        // Load 8 UInt16 from each line
-        const auto firstLine = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrcScanlineShifted));
-        const auto secondLine = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrcScanlineShifted + nChunkXSize));
-
-        // Detect if all of the source values fit in 14 bits.
-        // because if x < 2^14, then 4 * x^2 < 2^30 which fits in a signed int32
-        // and we can do a much faster implementation.
-        const auto maskTmp = _mm_srli_epi16(_mm_or_si128(firstLine, secondLine), 14);
-        const auto nMaskFitsIn14Bits = _mm_cvtsi128_si64(
-            _mm_packus_epi16(maskTmp, maskTmp /* could be anything */));
-        if( nMaskFitsIn14Bits == 0 )
-        {
-            // Multiplication of 16 bit values and horizontal
-            // addition of 32 bit results
-            const auto firstLineHSumSquare = _mm_madd_epi16(firstLine, firstLine);
-            const auto secondLineHSumSquare = _mm_madd_epi16(secondLine, secondLine);
-            // Vertical addition
-            const auto sumSquares = _mm_add_epi32(firstLineHSumSquare,
-                                                  secondLineHSumSquare);
-            // In theory we should take sqrt(sumSquares * 0.25f)
-            // but given the rounding we do, this is equivalent to
-            // sqrt((sumSquares + 1)/4). This has been verified exhaustively for
-            // sumSquares <= 4 * 16383^2
-            const auto one32 = _mm_set1_epi32(1);
-            const auto sumSquaresPlusOneDiv4 =
-                _mm_srli_epi32(_mm_add_epi32(sumSquares, one32), 2);
-            // Take square root and truncate/floor to int32
-            auto rms = _mm_cvttps_epi32(_mm_sqrt_ps(_mm_cvtepi32_ps(sumSquaresPlusOneDiv4)));
-
-            // Round to upper value if it minimizes the
-            // error |rms^2 - sumSquares/4|
-            // if( 2 * (2 * rms * (rms + 1) + 1) < sumSquares )
-            //    rms += 1;
-            // which is equivalent to:
-            // if( rms * rms + rms < (sumSquares+1) / 4 )
-            //    rms += 1;
-            auto mask = _mm_cmpgt_epi32(
-                sumSquaresPlusOneDiv4,
-                _mm_add_epi32(_mm_madd_epi16(rms, rms), rms));
-            rms = _mm_sub_epi32(rms, mask);
-            // Pack each 32 bit RMS value to 16 bits
-            rms = _mm_packs_epi32(rms, rms /* could be anything */);
-            _mm_storel_epi64(reinterpret_cast<__m128i*>(&pDstScanline[iDstPixel]), rms);
-            pSrcScanlineShifted += 8;
-            continue;
-        }
-
-        // An approach using _mm_mullo_epi16, _mm_mulhi_epu16 before extending
-        // to 32 bit would result in 4 multiplications instead of 8, but mullo/mulhi
-        // have a worse throughput than mul_pd.
-
-        // Extend those UInt16s as UInt32s
-        const auto firstLineLo = _mm_unpacklo_epi16(firstLine, zero);
-        const auto firstLineHi = _mm_unpackhi_epi16(firstLine, zero);
-        const auto secondLineLo = _mm_unpacklo_epi16(secondLine, zero);
-        const auto secondLineHi = _mm_unpackhi_epi16(secondLine, zero);
-
-#ifdef __AVX2__
-        // Multiplication of 32 bit values previously converted to 64 bit double
-        const auto firstLineLoDbl = SQUARE(_mm256_cvtepi32_pd(firstLineLo));
-        const auto firstLineHiDbl = SQUARE(_mm256_cvtepi32_pd(firstLineHi));
-        const auto secondLineLoDbl = SQUARE(_mm256_cvtepi32_pd(secondLineLo));
-        const auto secondLineHiDbl = SQUARE(_mm256_cvtepi32_pd(secondLineHi));
-
-        // Vertical addition of squares
-        const auto sumSquaresLo = _mm256_add_pd(firstLineLoDbl, secondLineLoDbl);
-        const auto sumSquaresHi = _mm256_add_pd(firstLineHiDbl, secondLineHiDbl);
-
-        // Horizontal addition of squares
-        const auto sumSquares = FIXUP_LANES(_mm256_hadd_pd(sumSquaresLo, sumSquaresHi));
-
-        const auto sumDivWeight = _mm256_mul_pd(sumSquares, zeroDot25);
-
-        // Take square root and truncate/floor to int32
-        auto rms = _mm256_cvttpd_epi32(_mm256_sqrt_pd(sumDivWeight));
-        const auto rmsDouble = _mm256_cvtepi32_pd(rms);
-        const auto right = _mm256_sub_pd(sumDivWeight,
-                                _mm256_add_pd(SQUARE(rmsDouble), rmsDouble));
-
-        auto mask = _mm256_castpd_ps(_mm256_cmp_pd(zeroDot5, right, _CMP_LT_OS));
-        // Extract 32-bit from each of the 4 64-bit masks
-        //mask = FIXUP_LANES(_mm256_shuffle_ps(mask, mask, _MM_SHUFFLE(2,0,2,0)));
-        mask = _mm256_permutevar8x32_ps(mask, permutation);
-        const auto maskI = _mm_castps_si128(_mm256_extractf128_ps(mask, 0));
-
-        // Apply the correction
-        rms = _mm_sub_epi32(rms, maskI);
-
-        // Pack each 32 bit RMS value to 16 bits
-        rms = _mm_packus_epi32(rms, rms /* could be anything */);
-#else
-        // Multiplication of 32 bit values previously converted to 64 bit double
-        const auto firstLineLoLo = SQUARE(_mm_cvtepi32_pd(firstLineLo));
-        const auto firstLineLoHi = SQUARE(_mm_cvtepi32_pd(_mm_srli_si128(firstLineLo,8)));
-        const auto firstLineHiLo = SQUARE(_mm_cvtepi32_pd(firstLineHi));
-        const auto firstLineHiHi = SQUARE(_mm_cvtepi32_pd(_mm_srli_si128(firstLineHi,8)));
-
-        const auto secondLineLoLo = SQUARE(_mm_cvtepi32_pd(secondLineLo));
-        const auto secondLineLoHi = SQUARE(_mm_cvtepi32_pd(_mm_srli_si128(secondLineLo,8)));
-        const auto secondLineHiLo = SQUARE(_mm_cvtepi32_pd(secondLineHi));
-        const auto secondLineHiHi = SQUARE(_mm_cvtepi32_pd(_mm_srli_si128(secondLineHi,8)));
-
-        // Vertical addition of squares
-        const auto sumSquaresLoLo = _mm_add_pd(firstLineLoLo, secondLineLoLo);
-        const auto sumSquaresLoHi = _mm_add_pd(firstLineLoHi, secondLineLoHi);
-        const auto sumSquaresHiLo = _mm_add_pd(firstLineHiLo, secondLineHiLo);
-        const auto sumSquaresHiHi = _mm_add_pd(firstLineHiHi, secondLineHiHi);
-
-        // Horizontal addition of squares
-        const auto sumSquaresLo = sse2_hadd_pd(sumSquaresLoLo, sumSquaresLoHi);
-        const auto sumSquaresHi = sse2_hadd_pd(sumSquaresHiLo, sumSquaresHiHi);
-
-        const auto sumDivWeightLo = _mm_mul_pd(sumSquaresLo, zeroDot25);
-        const auto sumDivWeightHi = _mm_mul_pd(sumSquaresHi, zeroDot25);
-        // Take square root and truncate/floor to int32
-        const auto rmsLo = _mm_cvttpd_epi32(_mm_sqrt_pd(sumDivWeightLo));
-        const auto rmsHi = _mm_cvttpd_epi32(_mm_sqrt_pd(sumDivWeightHi));
-
-        // Correctly round rms to minimize | rms^2 - sumSquares / 4 |
-        // if( 0.5 < sumDivWeight - (rms * rms + rms) )
-        //     rms += 1;
-        const auto rmsLoDouble = _mm_cvtepi32_pd(rmsLo);
-        const auto rmsHiDouble = _mm_cvtepi32_pd(rmsHi);
-        const auto rightLo = _mm_sub_pd(sumDivWeightLo,
-                                _mm_add_pd(SQUARE(rmsLoDouble), rmsLoDouble));
-        const auto rightHi = _mm_sub_pd(sumDivWeightHi,
-                                _mm_add_pd(SQUARE(rmsHiDouble), rmsHiDouble));
-
-        const auto maskLo = _mm_castpd_ps(_mm_cmplt_pd(zeroDot5, rightLo));
-        const auto maskHi = _mm_castpd_ps(_mm_cmplt_pd(zeroDot5, rightHi));
-        // The value of the mask will be -1 when the correction needs to be applied
-        const auto mask = _mm_castps_si128(_mm_shuffle_ps(
-            maskLo, maskHi, (0 << 0) | (2 << 2) | (0 << 4) | (2 << 6)));
-
-        auto rms = _mm_castps_si128(_mm_movelh_ps(
-            _mm_castsi128_ps(rmsLo), _mm_castsi128_ps(rmsHi)));
-        // Apply the correction
-        rms = _mm_sub_epi32(rms, mask);
-
-        // Pack each 32 bit RMS value to 16 bits
-        rms = sse2_packus_epi32(rms, rms /* could be anything */);
 #endif
 
-        _mm_storel_epi64(reinterpret_cast<__m128i*>(&pDstScanline[iDstPixel]), rms);
-        pSrcScanlineShifted += 8;
-    }
-
-    zeroupper();
-
-    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
-    return iDstPixel;
-}
-
-/************************************************************************/
-/*                         AverageUInt16SSE2()                          */
-/************************************************************************/
-
-template<class T> static int AverageUInt16SSE2(
-                                             int nDstXWidth,
-                                             int nChunkXSize,
-                                             const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
-                                             T* CPL_RESTRICT pDstScanline)
-{
-    // Optimized implementation for average on UInt16 by
-    // processing by group of 8 output pixels.
-
-    const auto mask = _mm_set1_epi32(0xFFFF);
-    const auto two = _mm_set1_epi32(2);
-    const T* CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
-
-    int iDstPixel = 0;
-    for( ; iDstPixel < nDstXWidth - 7; iDstPixel += 8 )
-    {
-        __m128i averageLow;
-        // Load 8 UInt16 from each line
-        {
-        const auto firstLine = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrcScanlineShifted));
-        const auto secondLine = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrcScanlineShifted + nChunkXSize));
-
-        // Horizontal addition and extension to 32 bit
-        const auto horizAddFirstLine = _mm_add_epi32(_mm_and_si128(firstLine, mask), _mm_srli_epi32(firstLine, 16));
-        const auto horizAddSecondLine = _mm_add_epi32(_mm_and_si128(secondLine, mask), _mm_srli_epi32(secondLine, 16));
-
-        // Vertical addition and average computation
-        // average = (sum + 2) >> 2
-        const auto sum = _mm_add_epi32(_mm_add_epi32(horizAddFirstLine, horizAddSecondLine), two);
-        averageLow = _mm_srli_epi32(sum, 2);
-        }
-        // Load 8 UInt16 from each line
-        __m128i averageHigh;
-        {
-        const auto firstLine = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrcScanlineShifted + 8));
-        const auto secondLine = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrcScanlineShifted + 8 + nChunkXSize));
-
-        // Horizontal addition and extension to 32 bit
-        const auto horizAddFirstLine = _mm_add_epi32(_mm_and_si128(firstLine, mask), _mm_srli_epi32(firstLine, 16));
-        const auto horizAddSecondLine = _mm_add_epi32(_mm_and_si128(secondLine, mask), _mm_srli_epi32(secondLine, 16));
-
-        // Vertical addition and average computation
-        // average = (sum + 2) >> 2
-        const auto sum = _mm_add_epi32(_mm_add_epi32(horizAddFirstLine, horizAddSecondLine), two);
-        averageHigh = _mm_srli_epi32(sum, 2);
-        }
-
-        // Pack each 32 bit average value to 16 bits
-        auto average = sse2_packus_epi32(averageLow, averageHigh);
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDstScanline[iDstPixel]), average);
-        pSrcScanlineShifted += 16;
-    }
-
-    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
-    return iDstPixel;
-}
-
 /************************************************************************/
-/*                      QuadraticMeanFloatSSE2()                        */
+/*                         QuadraticMeanFloatSIMD()                     */
 /************************************************************************/
 
-#ifdef __AVX2__
-#define RMS_FLOAT_ELTS 8
-#define set1_ps     _mm256_set1_ps
-#define loadu_ps    _mm256_loadu_ps
-#define andnot_ps   _mm256_andnot_ps
-#define and_ps      _mm256_and_ps
-#define max_ps      _mm256_max_ps
-#define shuffle_ps  _mm256_shuffle_ps
-#define div_ps      _mm256_div_ps
-#define cmpeq_ps(x,y) _mm256_cmp_ps(x,y,_CMP_EQ_OQ)
-#define mul_ps      _mm256_mul_ps
-#define add_ps      _mm256_add_ps
-#define hadd_ps     _mm256_hadd_ps
-#define sqrt_ps     _mm256_sqrt_ps
-#define or_ps       _mm256_or_ps
-#define unpacklo_ps _mm256_unpacklo_ps
-#define unpackhi_ps _mm256_unpackhi_ps
-#define storeu_ps   _mm256_storeu_ps
-
-inline __m256 SQUARE(__m256 x)
+template<class T> static inline int QuadraticMeanFloatSIMD(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        T* CPL_RESTRICT pDstScanline)
 {
-    return _mm256_mul_ps(x, x);
+    return QuadraticMeanFloatSSE2(nDstXWidth, nChunkXSize,
+                                  pSrcScanlineShiftedInOut, pDstScanline);
 }
 
-#else
-
-#ifdef __SSE3__
-#define sse2_hadd_ps _mm_hadd_ps
-#else
-inline __m128 sse2_hadd_ps(__m128 a, __m128 b)
+#ifdef USE_RUNTIME_AVX2_DISPATCH
+template<> inline int QuadraticMeanFloatSIMD<float>(
+                                        int nDstXWidth,
+                                        int nChunkXSize,
+                                        const float*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                        float* CPL_RESTRICT pDstScanline)
 {
-    auto aEven_bEven = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
-    auto aOdd_bOdd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
-    return _mm_add_ps(aEven_bEven, aOdd_bOdd); // (aEven + aOdd, bEven + bOdd)
+    if( CPLHaveRuntimeAVX2() )
+        return GDALQuadraticMeanFloat_AVX2(nDstXWidth, nChunkXSize,
+                                           pSrcScanlineShiftedInOut, pDstScanline);
+    return QuadraticMeanFloatSSE2(nDstXWidth, nChunkXSize,
+                                  pSrcScanlineShiftedInOut, pDstScanline);
 }
 #endif
 
-#define RMS_FLOAT_ELTS 4
-#define set1_ps     _mm_set1_ps
-#define loadu_ps    _mm_loadu_ps
-#define andnot_ps   _mm_andnot_ps
-#define and_ps      _mm_and_ps
-#define max_ps      _mm_max_ps
-#define shuffle_ps  _mm_shuffle_ps
-#define div_ps      _mm_div_ps
-#define cmpeq_ps    _mm_cmpeq_ps
-#define mul_ps      _mm_mul_ps
-#define add_ps      _mm_add_ps
-#define hadd_ps     sse2_hadd_ps
-#define sqrt_ps     _mm_sqrt_ps
-#define or_ps       _mm_or_ps
-#define unpacklo_ps _mm_unpacklo_ps
-#define unpackhi_ps _mm_unpackhi_ps
-#define storeu_ps   _mm_storeu_ps
-
-inline __m128 SQUARE(__m128 x)
-{
-    return _mm_mul_ps(x, x);
-}
-
-inline __m128 FIXUP_LANES(__m128 x)
-{
-    return x;
-}
-
-#endif
-
-#if defined(__GNUC__) && defined(__AVX2__)
-// Disabling inlining works around a bug with gcc 9.3 (Ubuntu 20.04) in
-// -O2 -mavx2 mode, where the registry that contains minus_zero is correctly
-// loaded the first time the function is called (looking at the disassembly,
-// one sees it is loaded much earlier than the function), but gets corrupted
-// (zeroed) in following iterations.
-// It appears the bug is due to the explicit zeroupper() call at the end of
-// the function.
-// The bug is at least solved in gcc 10.2.
-// Inlining doesn't bring much here to performance.
-#define NOINLINE __attribute__ ((noinline))
-#else
-#define NOINLINE
-#endif
-
-template<class T> static int NOINLINE QuadraticMeanFloatSSE2(int nDstXWidth,
-                                                    int nChunkXSize,
-                                                    const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
-                                                    T* CPL_RESTRICT pDstScanline)
-{
-    // Optimized implementation for RMS on Float32 by
-    // processing by group of RMS_FLOAT_ELTS output pixels.
-    const T* CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
-
-    int iDstPixel = 0;
-    const auto minus_zero = set1_ps(-0.0f);
-    const auto zeroDot25 = set1_ps(0.25f);
-    const auto one = set1_ps(1.0f);
-    const auto infv = set1_ps(std::numeric_limits<float>::infinity());
-
-    for( ; iDstPixel < nDstXWidth - (RMS_FLOAT_ELTS-1); iDstPixel += RMS_FLOAT_ELTS )
-    {
-        // Load 2*RMS_FLOAT_ELTS Float32 from each line
-        auto firstLineLo = loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted));
-        auto firstLineHi = loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted + RMS_FLOAT_ELTS));
-        auto secondLineLo = loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted + nChunkXSize));
-        auto secondLineHi = loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted + RMS_FLOAT_ELTS + nChunkXSize));
-
-        // Take the absolute value
-        firstLineLo = andnot_ps(minus_zero, firstLineLo);
-        firstLineHi = andnot_ps(minus_zero, firstLineHi);
-        secondLineLo = andnot_ps(minus_zero, secondLineLo);
-        secondLineHi = andnot_ps(minus_zero, secondLineHi);
-
-        auto firstLineEven = shuffle_ps(firstLineLo, firstLineHi, _MM_SHUFFLE(2,0,2,0));
-        auto firstLineOdd = shuffle_ps(firstLineLo, firstLineHi, _MM_SHUFFLE(3,1,3,1));
-        auto secondLineEven = shuffle_ps(secondLineLo, secondLineHi, _MM_SHUFFLE(2,0,2,0));
-        auto secondLineOdd = shuffle_ps(secondLineLo, secondLineHi, _MM_SHUFFLE(3,1,3,1));
-
-        // Compute the maximum of each RMS_FLOAT_ELTS value to RMS-average
-        const auto maxV = max_ps(max_ps(firstLineEven,firstLineOdd),
-                                 max_ps(secondLineEven, secondLineEven));
-
-        // Normalize each value by the maximum of the RMS_FLOAT_ELTS ones.
-        // This step is important to avoid that the square evaluates to infinity
-        // for sufficiently big input.
-        auto invMax = div_ps(one, maxV);
-        // Deal with 0 being the maximum to correct division by zero
-        // note: comparing to -0 leads to identical results as to comparing with 0
-        invMax = andnot_ps(cmpeq_ps(maxV, minus_zero), invMax);
-
-        firstLineEven = mul_ps(firstLineEven, invMax);
-        firstLineOdd = mul_ps(firstLineOdd, invMax);
-        secondLineEven = mul_ps(secondLineEven, invMax);
-        secondLineOdd = mul_ps(secondLineOdd, invMax);
-
-        // Compute squares
-        firstLineEven = SQUARE(firstLineEven);
-        firstLineOdd = SQUARE(firstLineOdd);
-        secondLineEven = SQUARE(secondLineEven);
-        secondLineOdd = SQUARE(secondLineOdd);
-
-        const auto sumSquares = add_ps(add_ps(firstLineEven, firstLineOdd),
-                                       add_ps(secondLineEven, secondLineOdd));
-
-        auto rms = mul_ps(maxV, sqrt_ps(mul_ps(sumSquares, zeroDot25)));
-
-        // Deal with infinity being the maximum
-        const auto maskIsInf = cmpeq_ps(maxV, infv);
-        rms = or_ps(andnot_ps(maskIsInf, rms), and_ps(maskIsInf, infv));
-
-        rms = FIXUP_LANES(rms);
-
-        // coverity[incompatible_cast]
-        storeu_ps(reinterpret_cast<float*>(&pDstScanline[iDstPixel]), rms);
-        pSrcScanlineShifted += RMS_FLOAT_ELTS * 2;
-    }
-
-    zeroupper();
-
-    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
-    return iDstPixel;
-}
-
-/************************************************************************/
-/*                        AverageFloatSSE2()                            */
-/************************************************************************/
-
-template<class T> static int AverageFloatSSE2(int nDstXWidth,
-                                              int nChunkXSize,
-                                              const T*& CPL_RESTRICT pSrcScanlineShiftedInOut,
-                                              T* CPL_RESTRICT pDstScanline)
-{
-    // Optimized implementation for average on Float32 by
-    // processing by group of 4 output pixels.
-    const T* CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
-
-    int iDstPixel = 0;
-    const auto zeroDot25 = _mm_set1_ps(0.25f);
-
-    for( ; iDstPixel < nDstXWidth - 3; iDstPixel += 4 )
-    {
-        // Load 8 Float32 from each line
-        const auto firstLineLo = _mm_loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted));
-        const auto firstLineHi = _mm_loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted + 4));
-        const auto secondLineLo = _mm_loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted + nChunkXSize));
-        const auto secondLineHi = _mm_loadu_ps(reinterpret_cast<float const*>(pSrcScanlineShifted + 4 + nChunkXSize));
-
-        // Vertical addition
-        const auto sumLo = _mm_add_ps(firstLineLo, secondLineLo);
-        const auto sumHi = _mm_add_ps(firstLineHi, secondLineHi);
-
-        // Horizontal addition
-        const auto A = _mm_shuffle_ps(sumLo, sumHi, 0 | (2 << 2) | (0 << 4) | (2 << 6));
-        const auto B = _mm_shuffle_ps(sumLo, sumHi, 1 | (3 << 2) | (1 << 4) | (3 << 6));
-        const auto sum = _mm_add_ps(A, B);
-
-        const auto average = _mm_mul_ps(sum, zeroDot25);
-
-        // coverity[incompatible_cast]
-        _mm_storeu_ps(reinterpret_cast<float*>(&pDstScanline[iDstPixel]), average);
-        pSrcScanlineShifted += 8;
-    }
-
-    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
-    return iDstPixel;
-}
-
-#endif
+#endif  // USE_SSE2
 
 /************************************************************************/
 /*                    GDALResampleChunk32R_AverageOrRMS()               */
@@ -1306,24 +724,24 @@ GDALResampleChunk32R_AverageOrRMS_T( double dfXRatioDstToSrc,
 #ifdef USE_SSE2
                 if( bQuadraticMean && eWrkDataType == GDT_Byte )
                 {
-                    iDstPixel = QuadraticMeanByteSSE2OrAVX2(nDstXWidth,
-                                                            nChunkXSize,
-                                                            pSrcScanlineShifted,
-                                                            pDstScanline);
+                    iDstPixel = QuadraticMeanByteSIMD(nDstXWidth,
+                                                      nChunkXSize,
+                                                      pSrcScanlineShifted,
+                                                      pDstScanline);
                 }
                 else if( bQuadraticMean /* && eWrkDataType == GDT_UInt16 */ )
                 {
-                    iDstPixel = QuadraticMeanUInt16SSE2(nDstXWidth,
+                    iDstPixel = QuadraticMeanUInt16SIMD(nDstXWidth,
                                                         nChunkXSize,
                                                         pSrcScanlineShifted,
                                                         pDstScanline);
                 }
                 else if( /* !bQuadraticMean && */ eWrkDataType == GDT_Byte )
                 {
-                    iDstPixel = AverageByteSSE2OrAVX2(nDstXWidth,
-                                                      nChunkXSize,
-                                                      pSrcScanlineShifted,
-                                                      pDstScanline);
+                    iDstPixel = AverageByteSIMD(nDstXWidth,
+                                                nChunkXSize,
+                                                pSrcScanlineShifted,
+                                                pDstScanline);
                 }
                 else /* if( !bQuadraticMean && eWrkDataType == GDT_UInt16 ) */
                 {
@@ -1373,7 +791,7 @@ GDALResampleChunk32R_AverageOrRMS_T( double dfXRatioDstToSrc,
 #ifdef USE_SSE2
                 if( bQuadraticMean )
                 {
-                    iDstPixel = QuadraticMeanFloatSSE2(nDstXWidth,
+                    iDstPixel = QuadraticMeanFloatSIMD(nDstXWidth,
                                                        nChunkXSize,
                                                        pSrcScanlineShifted,
                                                        pDstScanline);
@@ -4840,6 +4258,14 @@ GDALRegenerateOverviewsEx( GDALRasterBandH hSrcBand,
  * to "ALL_CPUS" or a integer value to specify the number of threads to use for
  * overview computation.
  *
+ * Starting with GDAL 3.7, when the CASCADE=YES option is specified, which
+ * drivers do when the overview bands read back unaltered what is written to
+ * them, an overview level that is computed from the previous one uses its
+ * in-memory result instead of reading it back, so that all the levels are
+ * computed in a single pass over the source bands. This is not done when a
+ * nodata mask must be taken into account, and can be disabled with the
+ * GDAL_OVR_CASCADE=NO configuration option.
+ *
  * @param nBands the number of bands, size of papoSrcBands and size of
  *               first dimension of papapoOverviewBands
  * @param papoSrcBands the list of source bands to downsample
@@ -4852,7 +4278,8 @@ GDALRegenerateOverviewsEx( GDALRasterBandH hSrcBand,
  * @param pfnProgress progress report function.
  * @param pProgressData progress function callback data.
  * @param papszOptions (GDAL >= 3.6) NULL terminated list of options as
- *                     key=value pairs, or NULL
+ *                     key=value pairs, or NULL. Starting with GDAL 3.7,
+ *                     CASCADE=YES/NO is supported.
  * @return CE_None on success or CE_Failure on failure.
  */
 
@@ -4865,8 +4292,6 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand* const* papoSrcBand
                                   void * pProgressData,
                                   CSLConstList papszOptions )
 {
-    CPL_IGNORE_RET_VAL(papszOptions);
-
     if( pfnProgress == nullptr )
         pfnProgress = GDALDummyProgress;
 
@@ -5011,14 +4436,68 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand* const* papoSrcBand
     const int nChunkMaxSize =
         atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760"));
 
-    // Second pass to do the real job.
+    // When the caller knows that what is written in the overview bands can
+    // be read back unaltered (lossless compression, no NBITS reduction), the
+    // levels that would be computed from the previous one are rather computed
+    // from its in-memory result, so that all the levels of a cascade are
+    // built in a single pass over the source.
+    const bool bCascade =
+        !bUseNoDataMask &&
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "CASCADE", "NO")) &&
+        CPLTestBool(CPLGetConfigOption("GDAL_OVR_CASCADE", "YES"));
+    const GIntBig nCascadeMaxMemory = GDALGetCacheMax64();
+    GIntBig nCascadeMemory = 0;
+
+    const int nWrkDataTypeSize = GDALGetDataTypeSizeBytes(eWrkDataType);
     double dfCurPixelCount = 0;
-    CPLErr eErr = CE_None;
-    for( int iOverview = 0;
-         iOverview < nOverviews && eErr == CE_None;
-         ++iOverview )
+
+    // Structure describing how an overview level is computed, and the
+    // progress of its computation.
+    struct OvrLevel
     {
+        int iOverview = 0;
         int iSrcOverview = -1;  // -1 means the source bands.
+        // Whether the level is computed from the in-memory result of the
+        // previous level.
+        bool bCascaded = false;
+        // Whether the next level is computed from the in-memory result of
+        // this level.
+        bool bHasWindow = false;
+
+        int nSrcWidth = 0;
+        int nSrcHeight = 0;
+        int nDstWidth = 0;
+        int nDstHeight = 0;
+        int nDstChunkXSize = 0;
+        int nDstChunkYSize = 0;
+        double dfXRatioDstToSrc = 0;
+        double dfYRatioDstToSrc = 0;
+        int nOvrFactor = 1;
+        int nFullResXChunk = 0;
+        int nFullResXChunkQueried = 0;
+        int nFullResYChunk = 0;
+        int nFullResYChunkQueried = 0;
+
+        // Next row of chunks to compute
+        int nDstYOff = 0;
+        std::vector<void*> apaChunk{};
+        std::vector<GByte*> apabyChunkNoDataMask{};
+
+        // Full width rows of the result of this level, in the working data
+        // type, starting at row nWindowYOff, when bHasWindow is set.
+        std::vector<std::vector<GByte>> aabyWindow{};
+        int nWindowYOff = 0;
+        // Number of rows whose computation has been completed
+        int nRowsCompleted = 0;
+    };
+
+    std::vector<OvrLevel> aoLevels(nOverviews);
+    for( int iOverview = 0; iOverview < nOverviews; ++iOverview )
+    {
+        OvrLevel& oLevel = aoLevels[iOverview];
+        oLevel.iOverview = iOverview;
+        oLevel.apaChunk.resize(nBands);
+        oLevel.apabyChunkNoDataMask.resize(nBands);
 
         int nDstChunkXSize = 0;
         int nDstChunkYSize = 0;
@@ -5037,7 +4516,7 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand* const* papoSrcBand
         {
             nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
             nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
-            iSrcOverview = iOverview - 1;
+            oLevel.iSrcOverview = iOverview - 1;
         }
 
         const double dfXRatioDstToSrc =
@@ -5066,7 +4545,7 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand* const* papoSrcBand
 
             if( static_cast<GIntBig>(nFullResXChunkQueried) *
                   nFullResYChunkQueried * nBands *
-                    GDALGetDataTypeSizeBytes(eWrkDataType) > nChunkMaxSize )
+                    nWrkDataTypeSize > nChunkMaxSize )
             {
                 break;
             }
@@ -5080,348 +4559,632 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand* const* papoSrcBand
         const int nFullResXChunkQueried =
             nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
 
-        // Structure describing a resampling job
-        struct OvrJob
+        oLevel.nSrcWidth = nSrcWidth;
+        oLevel.nSrcHeight = nSrcHeight;
+        oLevel.nDstWidth = nDstWidth;
+        oLevel.nDstHeight = nDstHeight;
+        oLevel.nDstChunkXSize = nDstChunkXSize;
+        oLevel.nDstChunkYSize = nDstChunkYSize;
+        oLevel.dfXRatioDstToSrc = dfXRatioDstToSrc;
+        oLevel.dfYRatioDstToSrc = dfYRatioDstToSrc;
+        oLevel.nOvrFactor = nOvrFactor;
+        oLevel.nFullResXChunk = nFullResXChunk;
+        oLevel.nFullResXChunkQueried = nFullResXChunkQueried;
+        oLevel.nFullResYChunk = nFullResYChunk;
+        oLevel.nFullResYChunkQueried = nFullResYChunkQueried;
+
+        if( bCascade && oLevel.iSrcOverview >= 0 )
         {
-            // Buffers to free when job is finished
-            std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
-            std::unique_ptr<PointerHolder> oSrcBufferHolder{};
-            std::unique_ptr<PointerHolder> oDstBufferHolder{};
-
-            // Input parameters of pfnResampleFn
-            GDALResampleFunction pfnResampleFn = nullptr;
-            double dfXRatioDstToSrc{};
-            double dfYRatioDstToSrc{};
-            GDALDataType eWrkDataType = GDT_Unknown;
-            const void * pChunk = nullptr;
-            const GByte * pabyChunkNodataMask = nullptr;
-            int nChunkXOff = 0;
-            int nChunkXSize = 0;
-            int nChunkYOff = 0;
-            int nChunkYSize = 0;
-            int nDstXOff = 0;
-            int nDstXOff2 = 0;
-            int nDstYOff = 0;
-            int nDstYOff2 = 0;
-            GDALRasterBand* poOverview = nullptr;
-            const char * pszResampling = nullptr;
-            int bHasNoData = 0;
-            float fNoDataValue = 0.0f;
-            GDALDataType eSrcDataType = GDT_Unknown;
-            bool bPropagateNoData = false;
-
-            // Output values of resampling function
-            CPLErr eErr = CE_Failure;
-            void* pDstBuffer = nullptr;
-            GDALDataType eDstBufferDataType = GDT_Unknown;
-
-            // Synchronization
-            bool                    bFinished = false;
-            std::mutex              mutex{};
-            std::condition_variable cv{};
-        };
-
-        // Thread function to resample
-        const auto JobResampleFunc = [](void* pData)
+            // The previous level must keep the rows needed by one row of
+            // chunks of this level, plus one row of its own chunks.
+            OvrLevel& oPrevLevel = aoLevels[iOverview - 1];
+            const GIntBig nWindowMemory =
+                static_cast<GIntBig>(nSrcWidth) *
+                    (nFullResYChunkQueried + oPrevLevel.nDstChunkYSize) *
+                        nBands * nWrkDataTypeSize;
+            if( nCascadeMemory + nWindowMemory <= nCascadeMaxMemory )
+            {
+                nCascadeMemory += nWindowMemory;
+                oLevel.bCascaded = true;
+                oPrevLevel.bHasWindow = true;
+                oPrevLevel.aabyWindow.resize(nBands);
+            }
+        }
+    }
+
+    // Structure describing a row of chunks of an overview level
+    struct ChunkRow
+    {
+        int nDstYCount = 0;
+        int nYCount = 0;
+        int nChunkYOffQueried = 0;
+        int nChunkYSizeQueried = 0;
+    };
+
+    const auto GetChunkRow = [nKernelRadius](const OvrLevel& oLevel,
+                                             int nDstYOff)
+    {
+        ChunkRow oRow;
+        if( nDstYOff + oLevel.nDstChunkYSize <= oLevel.nDstHeight )
+            oRow.nDstYCount = oLevel.nDstChunkYSize;
+        else
+            oRow.nDstYCount = oLevel.nDstHeight - nDstYOff;
+
+        int nChunkYOff =
+            static_cast<int>(nDstYOff * oLevel.dfYRatioDstToSrc);
+        int nChunkYOff2 =
+            static_cast<int>(
+                ceil((nDstYOff + oRow.nDstYCount) * oLevel.dfYRatioDstToSrc) );
+        if( nChunkYOff2 > oLevel.nSrcHeight ||
+            nDstYOff + oRow.nDstYCount == oLevel.nDstHeight)
+            nChunkYOff2 = oLevel.nSrcHeight;
+        oRow.nYCount = nChunkYOff2 - nChunkYOff;
+        CPLAssert(oRow.nYCount <= oLevel.nFullResYChunk);
+
+        oRow.nChunkYOffQueried =
+            nChunkYOff - nKernelRadius * oLevel.nOvrFactor;
+        oRow.nChunkYSizeQueried =
+            oRow.nYCount + 2 * nKernelRadius * oLevel.nOvrFactor;
+        if( oRow.nChunkYOffQueried < 0 )
         {
-            OvrJob* poJob = static_cast<OvrJob*>(pData);
+            oRow.nChunkYSizeQueried += oRow.nChunkYOffQueried;
+            oRow.nChunkYOffQueried = 0;
+        }
+        if( oRow.nChunkYSizeQueried + oRow.nChunkYOffQueried >
+                                                        oLevel.nSrcHeight )
+            oRow.nChunkYSizeQueried =
+                oLevel.nSrcHeight - oRow.nChunkYOffQueried;
+        CPLAssert(oRow.nChunkYSizeQueried <= oLevel.nFullResYChunkQueried);
+        return oRow;
+    };
 
-            poJob->eErr = poJob->pfnResampleFn(
-                poJob->dfXRatioDstToSrc,
-                poJob->dfYRatioDstToSrc,
-                0.0, 0.0,
-                poJob->eWrkDataType,
-                poJob->pChunk,
-                poJob->pabyChunkNodataMask,
-                poJob->nChunkXOff,
-                poJob->nChunkXSize,
-                poJob->nChunkYOff,
-                poJob->nChunkYSize,
-                poJob->nDstXOff,
-                poJob->nDstXOff2,
-                poJob->nDstYOff,
-                poJob->nDstYOff2,
-                poJob->poOverview,
-                &(poJob->pDstBuffer),
-                &(poJob->eDstBufferDataType),
-                poJob->pszResampling,
-                poJob->bHasNoData,
-                poJob->fNoDataValue,
-                nullptr,
-                poJob->eSrcDataType,
-                poJob->bPropagateNoData);
+    // Structure describing a resampling job
+    struct OvrJob
+    {
+        // Buffers to free when job is finished
+        std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
+        std::unique_ptr<PointerHolder> oSrcBufferHolder{};
+        std::unique_ptr<PointerHolder> oDstBufferHolder{};
+
+        // Input parameters of pfnResampleFn
+        GDALResampleFunction pfnResampleFn = nullptr;
+        double dfXRatioDstToSrc{};
+        double dfYRatioDstToSrc{};
+        GDALDataType eWrkDataType = GDT_Unknown;
+        const void * pChunk = nullptr;
+        const GByte * pabyChunkNodataMask = nullptr;
+        int nChunkXOff = 0;
+        int nChunkXSize = 0;
+        int nChunkYOff = 0;
+        int nChunkYSize = 0;
+        int nDstXOff = 0;
+        int nDstXOff2 = 0;
+        int nDstYOff = 0;
+        int nDstYOff2 = 0;
+        GDALRasterBand* poOverview = nullptr;
+        const char * pszResampling = nullptr;
+        int bHasNoData = 0;
+        float fNoDataValue = 0.0f;
+        GDALDataType eSrcDataType = GDT_Unknown;
+        bool bPropagateNoData = false;
 
-            poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
+        // Level and band being computed
+        OvrLevel* poLevel = nullptr;
+        int iBand = 0;
+        // Whether this is the last job of a row of chunks of the level
+        bool bCompletesRow = false;
 
-            {
-                std::lock_guard<std::mutex> guard(poJob->mutex);
-                poJob->bFinished = true;
-                poJob->cv.notify_one();
-            }
-        };
+        // Output values of resampling function
+        CPLErr eErr = CE_Failure;
+        void* pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+
+        // Synchronization
+        bool                    bFinished = false;
+        std::mutex              mutex{};
+        std::condition_variable cv{};
+    };
+
+    // Thread function to resample
+    const auto JobResampleFunc = [](void* pData)
+    {
+        OvrJob* poJob = static_cast<OvrJob*>(pData);
+
+        poJob->eErr = poJob->pfnResampleFn(
+            poJob->dfXRatioDstToSrc,
+            poJob->dfYRatioDstToSrc,
+            0.0, 0.0,
+            poJob->eWrkDataType,
+            poJob->pChunk,
+            poJob->pabyChunkNodataMask,
+            poJob->nChunkXOff,
+            poJob->nChunkXSize,
+            poJob->nChunkYOff,
+            poJob->nChunkYSize,
+            poJob->nDstXOff,
+            poJob->nDstXOff2,
+            poJob->nDstYOff,
+            poJob->nDstYOff2,
+            poJob->poOverview,
+            &(poJob->pDstBuffer),
+            &(poJob->eDstBufferDataType),
+            poJob->pszResampling,
+            poJob->bHasNoData,
+            poJob->fNoDataValue,
+            nullptr,
+            poJob->eSrcDataType,
+            poJob->bPropagateNoData);
+
+        poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
 
-        // Function to write resample data to target band
-        const auto WriteJobData = [](const OvrJob* poJob)
         {
-            return poJob->poOverview->RasterIO(
-                                GF_Write,
-                                poJob->nDstXOff,
-                                poJob->nDstYOff,
-                                poJob->nDstXOff2 - poJob->nDstXOff,
-                                poJob->nDstYOff2 - poJob->nDstYOff,
-                                poJob->pDstBuffer,
-                                poJob->nDstXOff2 - poJob->nDstXOff,
-                                poJob->nDstYOff2 - poJob->nDstYOff,
-                                poJob->eDstBufferDataType,
-                                0, 0, nullptr );
-        };
-
-        // Wait for completion of oldest job and serialize it
-        const auto WaitAndFinalizeOldestJob = [WriteJobData](
-                            std::list<std::unique_ptr<OvrJob>>& jobList)
+            std::lock_guard<std::mutex> guard(poJob->mutex);
+            poJob->bFinished = true;
+            poJob->cv.notify_one();
+        }
+    };
+
+    // Function to write resample data to target band
+    const auto WriteJobData = [](const OvrJob* poJob)
+    {
+        return poJob->poOverview->RasterIO(
+                            GF_Write,
+                            poJob->nDstXOff,
+                            poJob->nDstYOff,
+                            poJob->nDstXOff2 - poJob->nDstXOff,
+                            poJob->nDstYOff2 - poJob->nDstYOff,
+                            poJob->pDstBuffer,
+                            poJob->nDstXOff2 - poJob->nDstXOff,
+                            poJob->nDstYOff2 - poJob->nDstYOff,
+                            poJob->eDstBufferDataType,
+                            0, 0, nullptr );
+    };
+
+    // Function to store resample data in the window of rows of its level,
+    // with the same conversions as writing it to the target band and
+    // reading it back in the working data type.
+    const auto StoreJobDataInWindow = [eDataType, eWrkDataType,
+                                       nWrkDataTypeSize](const OvrJob* poJob)
+    {
+        OvrLevel* poLevel = poJob->poLevel;
+        std::vector<GByte>& abyWindow = poLevel->aabyWindow[poJob->iBand];
+        const size_t nRowSize =
+            static_cast<size_t>(poLevel->nDstWidth) * nWrkDataTypeSize;
+        const int nXCount = poJob->nDstXOff2 - poJob->nDstXOff;
+        const int nDstBufferDTSize =
+            GDALGetDataTypeSizeBytes(poJob->eDstBufferDataType);
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        CPLAssert(poJob->nDstYOff >= poLevel->nWindowYOff);
+        try
         {
-            auto poOldestJob = jobList.front().get();
+            const size_t nNeededSize =
+                (poJob->nDstYOff2 - poLevel->nWindowYOff) * nRowSize;
+            if( abyWindow.size() < nNeededSize )
+                abyWindow.resize(nNeededSize);
+            std::vector<GByte> abyTmp;
+            if( poJob->eDstBufferDataType != eDataType )
+                abyTmp.resize(static_cast<size_t>(nXCount) * nDTSize);
+
+            for( int iY = poJob->nDstYOff; iY < poJob->nDstYOff2; ++iY )
             {
-                std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
-                while( !poOldestJob->bFinished )
+                const GByte* pabySrc =
+                    static_cast<const GByte*>(poJob->pDstBuffer) +
+                    static_cast<size_t>(iY - poJob->nDstYOff) * nXCount *
+                        nDstBufferDTSize;
+                GByte* pabyDst =
+                    abyWindow.data() +
+                    (iY - poLevel->nWindowYOff) * nRowSize +
+                    static_cast<size_t>(poJob->nDstXOff) * nWrkDataTypeSize;
+                if( poJob->eDstBufferDataType != eDataType )
                 {
-                    poOldestJob->cv.wait(oGuard);
+                    GDALCopyWords64(pabySrc, poJob->eDstBufferDataType,
+                                    nDstBufferDTSize,
+                                    abyTmp.data(), eDataType, nDTSize,
+                                    nXCount);
+                    pabySrc = abyTmp.data();
                 }
+                GDALCopyWords64(pabySrc, eDataType, nDTSize,
+                                pabyDst, eWrkDataType, nWrkDataTypeSize,
+                                nXCount);
             }
-            CPLErr l_eErr = poOldestJob->eErr;
-            if( l_eErr == CE_None )
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in overview computation");
+            return CE_Failure;
+        }
+        return CE_None;
+    };
+
+    // Function to write resample data to target band, and make it available
+    // to the next level if it is cascaded from this one.
+    const auto FinalizeJob = [WriteJobData, StoreJobDataInWindow](
+                                                        const OvrJob* poJob)
+    {
+        CPLErr l_eErr = poJob->eErr;
+        if( l_eErr == CE_None )
+        {
+            l_eErr = WriteJobData(poJob);
+        }
+        if( l_eErr == CE_None && poJob->poLevel->bHasWindow )
+        {
+            l_eErr = StoreJobDataInWindow(poJob);
+        }
+        if( l_eErr == CE_None && poJob->bCompletesRow )
+        {
+            poJob->poLevel->nRowsCompleted = poJob->nDstYOff2;
+        }
+        return l_eErr;
+    };
+
+    // Wait for completion of oldest job and serialize it
+    const auto WaitAndFinalizeOldestJob = [FinalizeJob](
+                        std::list<std::unique_ptr<OvrJob>>& jobList)
+    {
+        auto poOldestJob = jobList.front().get();
+        {
+            std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
+            while( !poOldestJob->bFinished )
             {
-                l_eErr = WriteJobData(poOldestJob);
+                poOldestJob->cv.wait(oGuard);
             }
+        }
+        const CPLErr l_eErr = FinalizeJob(poOldestJob);
 
-            jobList.pop_front();
-            return l_eErr;
-        };
+        jobList.pop_front();
+        return l_eErr;
+    };
 
-        // Queue of jobs
-        std::list<std::unique_ptr<OvrJob>> jobList;
+    // Whether the next row of chunks of a level can be computed now
+    const auto CanComputeChunkRow = [&aoLevels, GetChunkRow](
+                                                    const OvrLevel& oLevel)
+    {
+        if( oLevel.nDstYOff >= oLevel.nDstHeight )
+            return false;
+        if( oLevel.bCascaded )
+        {
+            // All the source rows must have been computed
+            const ChunkRow oRow = GetChunkRow(oLevel, oLevel.nDstYOff);
+            if( aoLevels[oLevel.iOverview - 1].nRowsCompleted <
+                    oRow.nChunkYOffQueried + oRow.nChunkYSizeQueried )
+            {
+                return false;
+            }
+        }
+        if( oLevel.bHasWindow )
+        {
+            // Do not get further ahead of the next level than what it needs
+            // for its next row of chunks, to bound the size of the window.
+            const OvrLevel& oNextLevel = aoLevels[oLevel.iOverview + 1];
+            if( oNextLevel.nDstYOff < oNextLevel.nDstHeight )
+            {
+                const ChunkRow oNextRow =
+                    GetChunkRow(oNextLevel, oNextLevel.nDstYOff);
+                if( oLevel.nDstYOff >= oNextRow.nChunkYOffQueried +
+                                        oNextLevel.nFullResYChunkQueried )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
 
-        std::vector<void*> apaChunk(nBands);
-        std::vector<GByte*> apabyChunkNoDataMask(nBands);
+    // Compute a row of chunks of a level: acquire the source pixels, from
+    // the source bands or the window of rows of the previous level, and
+    // resample them.
+    const auto ComputeChunkRow = [&](OvrLevel& oLevel,
+                            std::list<std::unique_ptr<OvrJob>>& jobList)
+    {
+        CPLErr l_eErr = CE_None;
+        const int nDstYOff = oLevel.nDstYOff;
+        const ChunkRow oRow = GetChunkRow(oLevel, nDstYOff);
+        const int nDstYCount = oRow.nDstYCount;
+        const int nChunkYOffQueried = oRow.nChunkYOffQueried;
+        const int nChunkYSizeQueried = oRow.nChunkYSizeQueried;
+        const int nDstWidth = oLevel.nDstWidth;
+        const int nDstChunkXSize = oLevel.nDstChunkXSize;
+        const int nSrcWidth = oLevel.nSrcWidth;
+        const double dfXRatioDstToSrc = oLevel.dfXRatioDstToSrc;
+        const int iOverview = oLevel.iOverview;
+        const int iSrcOverview = oLevel.iSrcOverview;
+
+        if( !pfnProgress( dfCurPixelCount / dfTotalPixelCount,
+                          nullptr, pProgressData ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            l_eErr = CE_Failure;
+        }
 
-        int nDstYOff = 0;
+        int nDstXOff = 0;
         // Iterate on destination overview, block by block.
-        for( nDstYOff = 0;
-             nDstYOff < nDstHeight && eErr == CE_None;
-             nDstYOff += nDstChunkYSize )
+        for( nDstXOff = 0;
+             nDstXOff < nDstWidth && l_eErr == CE_None;
+             nDstXOff += nDstChunkXSize )
         {
-            int nDstYCount;
-            if( nDstYOff + nDstChunkYSize <= nDstHeight )
-                nDstYCount = nDstChunkYSize;
+            int nDstXCount = 0;
+            if( nDstXOff + nDstChunkXSize <= nDstWidth )
+                nDstXCount = nDstChunkXSize;
             else
-                nDstYCount = nDstHeight - nDstYOff;
+                nDstXCount = nDstWidth - nDstXOff;
 
-            int nChunkYOff =
-                static_cast<int>(nDstYOff * dfYRatioDstToSrc);
-            int nChunkYOff2 =
+            int nChunkXOff =
+                static_cast<int>(nDstXOff * dfXRatioDstToSrc);
+            int nChunkXOff2 =
                 static_cast<int>(
-                    ceil((nDstYOff + nDstYCount) * dfYRatioDstToSrc) );
-            if( nChunkYOff2 > nSrcHeight || nDstYOff + nDstYCount == nDstHeight)
-                nChunkYOff2 = nSrcHeight;
-            int nYCount = nChunkYOff2 - nChunkYOff;
-            CPLAssert(nYCount <= nFullResYChunk);
-
-            int nChunkYOffQueried = nChunkYOff - nKernelRadius * nOvrFactor;
-            int nChunkYSizeQueried = nYCount + 2 * nKernelRadius * nOvrFactor;
-            if( nChunkYOffQueried < 0 )
+                    ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc) );
+            if( nChunkXOff2 > nSrcWidth ||
+                nDstXOff + nDstXCount == nDstWidth )
+                nChunkXOff2 = nSrcWidth;
+            const int nXCount = nChunkXOff2 - nChunkXOff;
+            CPLAssert(nXCount <= oLevel.nFullResXChunk);
+
+            int nChunkXOffQueried =
+                nChunkXOff - nKernelRadius * oLevel.nOvrFactor;
+            int nChunkXSizeQueried =
+                nXCount + 2 * nKernelRadius * oLevel.nOvrFactor;
+            if( nChunkXOffQueried < 0 )
             {
-                nChunkYSizeQueried += nChunkYOffQueried;
-                nChunkYOffQueried = 0;
+                nChunkXSizeQueried += nChunkXOffQueried;
+                nChunkXOffQueried = 0;
             }
-            if( nChunkYSizeQueried + nChunkYOffQueried > nSrcHeight )
-                nChunkYSizeQueried = nSrcHeight - nChunkYOffQueried;
-            CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
+            if( nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth )
+                nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
+            CPLAssert(nChunkXSizeQueried <= oLevel.nFullResXChunkQueried);
+#if DEBUG_VERBOSE
+            CPLDebug(
+                "GDAL",
+                "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
+                nChunkXOffQueried, nChunkYOffQueried, nChunkXSizeQueried, nChunkYSizeQueried,
+                nDstXOff, nDstYOff, nDstXCount, nDstYCount );
+#endif
 
-            if( !pfnProgress( dfCurPixelCount / dfTotalPixelCount,
-                              nullptr, pProgressData ) )
-            {
-                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
-                eErr = CE_Failure;
-            }
+            // Avoid accumulating too many tasks and exhaust RAM
 
-            int nDstXOff = 0;
-            // Iterate on destination overview, block by block.
-            for( nDstXOff = 0;
-                 nDstXOff < nDstWidth && eErr == CE_None;
-                 nDstXOff += nDstChunkXSize )
+            // Try to complete already finished jobs
+            while( l_eErr == CE_None && !jobList.empty() )
             {
-                int nDstXCount = 0;
-                if( nDstXOff + nDstChunkXSize <= nDstWidth )
-                    nDstXCount = nDstChunkXSize;
-                else
-                    nDstXCount = nDstWidth - nDstXOff;
-
-                int nChunkXOff =
-                    static_cast<int>(nDstXOff * dfXRatioDstToSrc);
-                int nChunkXOff2 =
-                    static_cast<int>(
-                        ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc) );
-                if( nChunkXOff2 > nSrcWidth ||
-                    nDstXOff + nDstXCount == nDstWidth )
-                    nChunkXOff2 = nSrcWidth;
-                const int nXCount = nChunkXOff2 - nChunkXOff;
-                CPLAssert(nXCount <= nFullResXChunk);
-
-                int nChunkXOffQueried = nChunkXOff - nKernelRadius * nOvrFactor;
-                int nChunkXSizeQueried =
-                    nXCount + 2 * nKernelRadius * nOvrFactor;
-                if( nChunkXOffQueried < 0 )
+                auto poOldestJob = jobList.front().get();
                 {
-                    nChunkXSizeQueried += nChunkXOffQueried;
-                    nChunkXOffQueried = 0;
+                    std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
+                    if( !poOldestJob->bFinished )
+                    {
+                        break;
+                    }
                 }
-                if( nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth )
-                    nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
-                CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
-#if DEBUG_VERBOSE
-                CPLDebug(
-                    "GDAL",
-                    "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
-                    nChunkXOffQueried, nChunkYOffQueried, nChunkXSizeQueried, nChunkYSizeQueried,
-                    nDstXOff, nDstYOff, nDstXCount, nDstYCount );
-#endif
+                l_eErr = FinalizeJob(poOldestJob);
 
-                // Avoid accumulating too many tasks and exhaust RAM
+                jobList.pop_front();
+            }
 
-                // Try to complete already finished jobs
-                while( eErr == CE_None && !jobList.empty() )
+            // And in case we have saturated the number of threads,
+            // wait for completion of tasks to go below the threshold.
+            while( l_eErr == CE_None &&
+                   jobList.size() >= static_cast<size_t>(nThreads) )
+            {
+                l_eErr = WaitAndFinalizeOldestJob(jobList);
+            }
+
+            // (Re)allocate buffers if needed
+            for( int iBand = 0; iBand < nBands; ++iBand )
+            {
+                if( oLevel.apaChunk[iBand] == nullptr )
                 {
-                    auto poOldestJob = jobList.front().get();
+                    oLevel.apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
+                        oLevel.nFullResXChunkQueried,
+                        oLevel.nFullResYChunkQueried,
+                        nWrkDataTypeSize );
+                    if( oLevel.apaChunk[iBand] == nullptr )
                     {
-                        std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
-                        if( !poOldestJob->bFinished )
-                        {
-                            break;
-                        }
+                        l_eErr = CE_Failure;
                     }
-                    eErr = poOldestJob->eErr;
-                    if( eErr == CE_None )
-                    {
-                        eErr = WriteJobData(poOldestJob);
-                    }
-
-                    jobList.pop_front();
                 }
-
-                // And in case we have saturated the number of threads,
-                // wait for completion of tasks to go below the threshold.
-                while( eErr == CE_None &&
-                       jobList.size() >= static_cast<size_t>(nThreads) )
+                if( bUseNoDataMask &&
+                    oLevel.apabyChunkNoDataMask[iBand] == nullptr  )
                 {
-                    eErr = WaitAndFinalizeOldestJob(jobList);
+                    oLevel.apabyChunkNoDataMask[iBand] = static_cast<GByte *>(
+                        VSI_MALLOC2_VERBOSE( oLevel.nFullResXChunkQueried,
+                                             oLevel.nFullResYChunkQueried ) );
+                    if( oLevel.apabyChunkNoDataMask[iBand] == nullptr )
+                    {
+                        l_eErr = CE_Failure;
+                    }
                 }
+            }
 
-                // (Re)allocate buffers if needed
-                for( int iBand = 0; iBand < nBands; ++iBand )
+            if( oLevel.bCascaded )
+            {
+                // Extract the source buffers from the rows computed for the
+                // previous level.
+                const OvrLevel& oPrevLevel = aoLevels[iOverview - 1];
+                const size_t nLineSize =
+                    static_cast<size_t>(nChunkXSizeQueried) * nWrkDataTypeSize;
+                for( int iBand = 0; iBand < nBands && l_eErr == CE_None;
+                     ++iBand )
                 {
-                    if( apaChunk[iBand] == nullptr )
-                    {
-                        apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
-                            nFullResXChunkQueried,
-                            nFullResYChunkQueried,
-                            GDALGetDataTypeSizeBytes(eWrkDataType) );
-                        if( apaChunk[iBand] == nullptr )
-                        {
-                            eErr = CE_Failure;
-                        }
-                    }
-                    if( bUseNoDataMask && apabyChunkNoDataMask[iBand] == nullptr  )
+                    const GByte* pabyWindow =
+                        oPrevLevel.aabyWindow[iBand].data();
+                    GByte* pabyChunk =
+                        static_cast<GByte*>(oLevel.apaChunk[iBand]);
+                    for( int iY = 0; iY < nChunkYSizeQueried; ++iY )
                     {
-                        apabyChunkNoDataMask[iBand] = static_cast<GByte *>(
-                            VSI_MALLOC2_VERBOSE( nFullResXChunkQueried,
-                                                nFullResYChunkQueried ) );
-                        if( apabyChunkNoDataMask[iBand] == nullptr )
-                        {
-                            eErr = CE_Failure;
-                        }
+                        memcpy(pabyChunk + iY * nLineSize,
+                               pabyWindow +
+                                (static_cast<size_t>(nChunkYOffQueried + iY -
+                                                 oPrevLevel.nWindowYOff) *
+                                    nSrcWidth + nChunkXOffQueried) *
+                                        nWrkDataTypeSize,
+                               nLineSize);
                     }
                 }
-
+            }
+            else
+            {
                 // Read the source buffers for all the bands.
-                for( int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand )
+                for( int iBand = 0; iBand < nBands && l_eErr == CE_None;
+                     ++iBand )
                 {
                     GDALRasterBand* poSrcBand = nullptr;
                     if( iSrcOverview == -1 )
                         poSrcBand = papoSrcBands[iBand];
                     else
                         poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
-                    eErr = poSrcBand->RasterIO(
+                    l_eErr = poSrcBand->RasterIO(
                         GF_Read,
                         nChunkXOffQueried, nChunkYOffQueried,
                         nChunkXSizeQueried, nChunkYSizeQueried,
-                        apaChunk[iBand],
+                        oLevel.apaChunk[iBand],
                         nChunkXSizeQueried, nChunkYSizeQueried,
                         eWrkDataType, 0, 0, nullptr );
 
-                    if( bUseNoDataMask && eErr == CE_None )
+                    if( bUseNoDataMask && l_eErr == CE_None )
                     {
                         auto poMaskBand = poSrcBand->IsMaskBand() ? poSrcBand : poSrcBand->GetMaskBand();
-                        eErr = poMaskBand->RasterIO(
+                        l_eErr = poMaskBand->RasterIO(
                             GF_Read,
                             nChunkXOffQueried, nChunkYOffQueried,
                             nChunkXSizeQueried, nChunkYSizeQueried,
-                            apabyChunkNoDataMask[iBand],
+                            oLevel.apabyChunkNoDataMask[iBand],
                             nChunkXSizeQueried, nChunkYSizeQueried,
                             GDT_Byte, 0, 0, nullptr );
                     }
                 }
+            }
 
-                // Compute the resulting overview block.
-                for( int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand )
+            // Compute the resulting overview block.
+            for( int iBand = 0; iBand < nBands && l_eErr == CE_None; ++iBand )
+            {
+                auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
+                poJob->dfYRatioDstToSrc = oLevel.dfYRatioDstToSrc;
+                poJob->eWrkDataType = eWrkDataType;
+                poJob->pChunk = oLevel.apaChunk[iBand];
+                poJob->pabyChunkNodataMask =
+                    oLevel.apabyChunkNoDataMask[iBand];
+                poJob->nChunkXOff = nChunkXOffQueried;
+                poJob->nChunkXSize = nChunkXSizeQueried;
+                poJob->nChunkYOff = nChunkYOffQueried;
+                poJob->nChunkYSize = nChunkYSizeQueried;
+                poJob->nDstXOff = nDstXOff;
+                poJob->nDstXOff2 = nDstXOff + nDstXCount;
+                poJob->nDstYOff = nDstYOff;
+                poJob->nDstYOff2 = nDstYOff + nDstYCount;
+                poJob->poOverview = papapoOverviewBands[iBand][iOverview];
+                poJob->pszResampling = pszResampling;
+                poJob->bHasNoData = pabHasNoData[iBand];
+                poJob->fNoDataValue = pafNoDataValue[iBand];
+                poJob->eSrcDataType = eDataType;
+                poJob->bPropagateNoData = bPropagateNoData;
+                poJob->poLevel = &oLevel;
+                poJob->iBand = iBand;
+                poJob->bCompletesRow =
+                    nDstXOff + nDstXCount == nDstWidth && iBand == nBands - 1;
+
+                if( poJobQueue )
                 {
-                    auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
-                    poJob->pfnResampleFn = pfnResampleFn;
-                    poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
-                    poJob->dfYRatioDstToSrc = dfYRatioDstToSrc;
-                    poJob->eWrkDataType = eWrkDataType;
-                    poJob->pChunk = apaChunk[iBand];
-                    poJob->pabyChunkNodataMask = apabyChunkNoDataMask[iBand];
-                    poJob->nChunkXOff = nChunkXOffQueried;
-                    poJob->nChunkXSize = nChunkXSizeQueried;
-                    poJob->nChunkYOff = nChunkYOffQueried;
-                    poJob->nChunkYSize = nChunkYSizeQueried;
-                    poJob->nDstXOff = nDstXOff;
-                    poJob->nDstXOff2 = nDstXOff + nDstXCount;
-                    poJob->nDstYOff = nDstYOff;
-                    poJob->nDstYOff2 = nDstYOff + nDstYCount;
-                    poJob->poOverview = papapoOverviewBands[iBand][iOverview];
-                    poJob->pszResampling = pszResampling;
-                    poJob->bHasNoData = pabHasNoData[iBand];
-                    poJob->fNoDataValue = pafNoDataValue[iBand];
-                    poJob->eSrcDataType = eDataType;
-                    poJob->bPropagateNoData = bPropagateNoData;
-
-                    if( poJobQueue )
-                    {
-                        poJob->oSrcMaskBufferHolder.reset(
-                            new PointerHolder(apabyChunkNoDataMask[iBand]));
-                        apabyChunkNoDataMask[iBand] = nullptr;
+                    poJob->oSrcMaskBufferHolder.reset(
+                        new PointerHolder(oLevel.apabyChunkNoDataMask[iBand]));
+                    oLevel.apabyChunkNoDataMask[iBand] = nullptr;
 
-                        poJob->oSrcBufferHolder.reset(
-                            new PointerHolder(apaChunk[iBand]));
-                        apaChunk[iBand] = nullptr;
+                    poJob->oSrcBufferHolder.reset(
+                        new PointerHolder(oLevel.apaChunk[iBand]));
+                    oLevel.apaChunk[iBand] = nullptr;
 
-                        poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
-                        jobList.emplace_back(std::move(poJob));
-                    }
-                    else
-                    {
-                        JobResampleFunc(poJob.get());
-                        eErr = poJob->eErr;
-                        if( eErr == CE_None )
-                        {
-                            eErr = WriteJobData(poJob.get());
-                        }
-                    }
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                    jobList.emplace_back(std::move(poJob));
+                }
+                else
+                {
+                    JobResampleFunc(poJob.get());
+                    l_eErr = FinalizeJob(poJob.get());
+                }
+            }
+        }
+
+        dfCurPixelCount += static_cast<double>(oRow.nYCount) * nSrcWidth;
+        oLevel.nDstYOff += oLevel.nDstChunkYSize;
+
+        if( oLevel.bCascaded )
+        {
+            // Discard the rows of the previous level that are no longer
+            // needed.
+            OvrLevel& oPrevLevel = aoLevels[iOverview - 1];
+            if( oLevel.nDstYOff < oLevel.nDstHeight )
+            {
+                const ChunkRow oNextRow =
+                    GetChunkRow(oLevel, oLevel.nDstYOff);
+                const size_t nDiscardedSize =
+                    static_cast<size_t>(oNextRow.nChunkYOffQueried -
+                                        oPrevLevel.nWindowYOff) *
+                        nSrcWidth * nWrkDataTypeSize;
+                for( auto& abyWindow: oPrevLevel.aabyWindow )
+                {
+                    abyWindow.erase(abyWindow.begin(),
+                        abyWindow.begin() +
+                            std::min(nDiscardedSize, abyWindow.size()));
+                }
+                oPrevLevel.nWindowYOff = oNextRow.nChunkYOffQueried;
+            }
+            else
+            {
+                for( auto& abyWindow: oPrevLevel.aabyWindow )
+                {
+                    std::vector<GByte>().swap(abyWindow);
+                }
+            }
+        }
+
+        return l_eErr;
+    };
+
+    // Second pass to do the real job.
+    CPLErr eErr = CE_None;
+    for( int iOverview = 0;
+         iOverview < nOverviews && eErr == CE_None; )
+    {
+        // Levels that are computed in the same pass
+        int iLastOverview = iOverview;
+        while( iLastOverview + 1 < nOverviews &&
+               aoLevels[iLastOverview + 1].bCascaded )
+        {
+            ++iLastOverview;
+        }
+
+        // Queue of jobs
+        std::list<std::unique_ptr<OvrJob>> jobList;
+
+        while( eErr == CE_None )
+        {
+            // Favor the deepest levels, so that the rows of the previous
+            // levels are discarded as soon as possible.
+            bool bAllScheduled = true;
+            bool bHasComputed = false;
+            for( int i = iLastOverview; i >= iOverview; --i )
+            {
+                if( aoLevels[i].nDstYOff < aoLevels[i].nDstHeight )
+                    bAllScheduled = false;
+                if( CanComputeChunkRow(aoLevels[i]) )
+                {
+                    eErr = ComputeChunkRow(aoLevels[i], jobList);
+                    bHasComputed = true;
+                    break;
                 }
             }
+            if( bHasComputed )
+                continue;
+            if( bAllScheduled )
+                break;
 
-            dfCurPixelCount += static_cast<double>(nYCount) * nSrcWidth;
+            // Wait for rows of a previous level to be completed.
+            if( jobList.empty() )
+            {
+                CPLAssert(false);
+                eErr = CE_Failure;
+                break;
+            }
+            eErr = WaitAndFinalizeOldestJob(jobList);
         }
 
         // Wait for all pending jobs to complete
@@ -5433,13 +5196,22 @@ GDALRegenerateOverviewsMultiBand( int nBands, GDALRasterBand* const* papoSrcBand
         }
 
         // Flush the data to overviews.
-        for( int iBand = 0; iBand < nBands; ++iBand )
+        for( int i = iOverview; i <= iLastOverview; ++i )
         {
-            CPLFree(apaChunk[iBand]);
-            papapoOverviewBands[iBand][iOverview]->FlushCache(false);
+            OvrLevel& oLevel = aoLevels[i];
+            for( int iBand = 0; iBand < nBands; ++iBand )
+            {
+                CPLFree(oLevel.apaChunk[iBand]);
+                oLevel.apaChunk[iBand] = nullptr;
+                papapoOverviewBands[iBand][i]->FlushCache(false);
 
-            CPLFree(apabyChunkNoDataMask[iBand]);
+                CPLFree(oLevel.apabyChunkNoDataMask[iBand]);
+                oLevel.apabyChunkNoDataMask[iBand] = nullptr;
+            }
+            oLevel.aabyWindow.clear();
         }
+
+        iOverview = iLastOverview + 1;
     }
 
     CPLFree(pabHasNoData);
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of overview computation
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && ( defined(__x86_64) || defined(_M_X64) )
+
+#include "overview_avx2.h"
+
+// This file is compiled with AVX2 enabled, so the kernels use their
+// __AVX2__ code paths.
+#include "overview_sse2_avx2_kernels.hpp"
+
+/************************************************************************/
+/*                      GDALQuadraticMeanByte_AVX2()                    */
+/************************************************************************/
+
+int GDALQuadraticMeanByte_AVX2(int nDstXWidth,
+                               int nChunkXSize,
+                               const GByte*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                               GByte* CPL_RESTRICT pDstScanline)
+{
+    return QuadraticMeanByteSSE2OrAVX2(nDstXWidth, nChunkXSize,
+                                       pSrcScanlineShiftedInOut,
+                                       pDstScanline);
+}
+
+/************************************************************************/
+/*                         GDALAverageByte_AVX2()                       */
+/************************************************************************/
+
+int GDALAverageByte_AVX2(int nDstXWidth,
+                         int nChunkXSize,
+                         const GByte*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                         GByte* CPL_RESTRICT pDstScanline)
+{
+    return AverageByteSSE2OrAVX2(nDstXWidth, nChunkXSize,
+                                 pSrcScanlineShiftedInOut,
+                                 pDstScanline);
+}
+
+/************************************************************************/
+/*                    GDALQuadraticMeanUInt16_AVX2()                    */
+/************************************************************************/
+
+int GDALQuadraticMeanUInt16_AVX2(int nDstXWidth,
+                                 int nChunkXSize,
+                                 const GUInt16*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                 GUInt16* CPL_RESTRICT pDstScanline)
+{
+    return QuadraticMeanUInt16SSE2(nDstXWidth, nChunkXSize,
+                                   pSrcScanlineShiftedInOut,
+                                   pDstScanline);
+}
+
+/************************************************************************/
+/*                     GDALQuadraticMeanFloat_AVX2()                    */
+/************************************************************************/
+
+int GDALQuadraticMeanFloat_AVX2(int nDstXWidth,
+                                int nChunkXSize,
+                                const float*& CPL_RESTRICT pSrcScanlineShiftedInOut,
+                                float* CPL_RESTRICT pDstScanline)
+{
+    return QuadraticMeanFloatSSE2(nDstXWidth, nChunkXSize,
+                                  pSrcScanlineShiftedInOut,
+                                  pDstScanline);
+}
+
+#endif
@@ -1261,12 +1261,14 @@ public:
 class OGRLayer;
 class swq_expr_node;
 class swq_custom_func_registrar;
+class OGRFeatureQueryProgram;
 
 class CPL_DLL OGRFeatureQuery
 {
   private:
     OGRFeatureDefn *poTargetDefn;
     void           *pSWQExpr;
+    OGRFeatureQueryProgram *poProgram;
 
     char      **FieldCollector( void *, char ** );
 
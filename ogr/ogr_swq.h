@@ -251,7 +251,8 @@ CPLErr CPL_UNSTABLE_API swq_expr_compile2( const char *where_clause,
 /*
 ** Evaluation related.
 */
-int CPL_UNSTABLE_API swq_test_like( const char *input, const char *pattern );
+int CPL_UNSTABLE_API swq_test_like( const char *input, const char *pattern,
+                                    char chEscape, bool insensitive );
 
 swq_expr_node CPL_UNSTABLE_API *SWQGeneralEvaluator( swq_expr_node *, swq_expr_node **);
 swq_field_type CPL_UNSTABLE_API SWQGeneralChecker( swq_expr_node *node, int bAllowMismatchTypeOnFieldComparison );
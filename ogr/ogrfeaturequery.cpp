@@ -32,12 +32,18 @@
 #include "ogr_feature.h"
 #include "ogr_swq.h"
 
+#include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <algorithm>
+#include <exception>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_safemaths.hpp"
 #include "cpl_string.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
@@ -56,13 +62,94 @@ const char *const SpecialFieldNames[SPECIAL_FIELD_COUNT] = {
 const swq_field_type SpecialFieldTypes[SPECIAL_FIELD_COUNT] = {
     SWQ_INTEGER, SWQ_STRING, SWQ_STRING, SWQ_STRING, SWQ_FLOAT};
 
+/************************************************************************/
+/*                        OGRFeatureQueryProgram                        */
+/*                                                                      */
+/*      Flat, typed lowering of a checked swq_expr_node tree.  Each     */
+/*      node of the tree is given a preallocated value slot, and the    */
+/*      instructions are laid out in the evaluation order of            */
+/*      swq_expr_node::Evaluate(), so that evaluating a feature does    */
+/*      not need to allocate a swq_expr_node per intermediate value.    */
+/*      Only the part of SWQGeneralEvaluator() whose semantics can be   */
+/*      reproduced exactly is supported. Other expressions go through   */
+/*      the tree interpreter.                                           */
+/************************************************************************/
+
+class OGRFeatureQueryProgram
+{
+    enum class Opcode
+    {
+        LOAD_INTEGER,       // GetFieldAsInteger()
+        LOAD_INTEGER64,     // GetFieldAsInteger64()
+        LOAD_REAL,          // GetFieldAsDouble()
+        LOAD_STRING,        // GetFieldAsString() of a OFTString field
+        TO_REAL,            // integer to floating point promotion, in place
+        IS_NULL,
+        AND_SHORTCUT,       // skip right operand of AND if left one is false
+        REAL_OP,
+        INTEGER_OP,
+        STRING_OP
+    };
+
+    struct Slot
+    {
+        GIntBig     nVal = 0;
+        double      dfVal = 0.0;
+        const char *pszVal = "";
+        bool        bNull = false;
+    };
+
+    struct Instr
+    {
+        Opcode          eOpcode = Opcode::LOAD_INTEGER;
+        int             nOperation = 0;
+        swq_field_type  eResultType = SWQ_BOOLEAN;
+        int             iDst = 0;
+        int             iField = 0;
+        int             iFirstArg = 0;
+        int             nArgs = 0;
+        size_t          nSkipTo = 0;
+    };
+
+    OGRFeatureDefn     *poDefn = nullptr;
+    std::vector<Instr>  aoInstrs{};
+    std::vector<int>    anArgs{};
+    std::vector<Slot>   aoSlots{};
+    CPLStringList       aosConstStrings{};
+    int                 iResultSlot = -1;
+    swq_field_type      eResultType = SWQ_OTHER;
+    bool                bLikeAsILike = false;
+
+    int                 NewSlot();
+    void                AddInstr( Instr& sInstr, const std::vector<int>& aiArgs );
+    bool                MayEmitError( const swq_expr_node *poNode ) const;
+    bool                Emit( const swq_expr_node *poNode, int nRecLevel,
+                              int &iSlot, swq_field_type &eType );
+    bool                EmitOperation( const swq_expr_node *poNode,
+                                       int nRecLevel,
+                                       int &iSlot, swq_field_type &eType );
+
+    bool                HasNullArg( const Instr& sInstr ) const;
+    void                EvaluateReal( const Instr& sInstr, Slot& sDst ) const;
+    void                EvaluateInteger( const Instr& sInstr, Slot& sDst ) const;
+    void                EvaluateString( const Instr& sInstr, Slot& sDst ) const;
+
+  public:
+    static OGRFeatureQueryProgram *Build( const swq_expr_node *poExpr,
+                                          OGRFeatureDefn *poDefnIn );
+
+    OGRFeatureDefn     *GetDefn() const { return poDefn; }
+    int                 Evaluate( OGRFeature *poFeature );
+};
+
 /************************************************************************/
 /*                          OGRFeatureQuery()                           */
 /************************************************************************/
 
 OGRFeatureQuery::OGRFeatureQuery() :
     poTargetDefn(nullptr),
-    pSWQExpr(nullptr)
+    pSWQExpr(nullptr),
+    poProgram(nullptr)
 {}
 
 /************************************************************************/
@@ -72,6 +159,7 @@ OGRFeatureQuery::OGRFeatureQuery() :
 OGRFeatureQuery::~OGRFeatureQuery()
 
 {
+    delete poProgram;
     delete static_cast<swq_expr_node *>(pSWQExpr);
 }
 
@@ -116,6 +204,8 @@ OGRFeatureQuery::Compile( OGRLayer *poLayer,
                           swq_custom_func_registrar *poCustomFuncRegistrar )
 {
     // Clear any existing expression.
+    delete poProgram;
+    poProgram = nullptr;
     if( pSWQExpr != nullptr )
     {
         delete static_cast<swq_expr_node *>(pSWQExpr);
@@ -241,6 +331,14 @@ OGRFeatureQuery::Compile( OGRLayer *poLayer,
         eErr = OGRERR_CORRUPT_DATA;
         pSWQExpr = nullptr;
     }
+    else if( bCheck &&
+             CPLTestBool(CPLGetConfigOption("OGR_SQL_COMPILE_EXPRESSIONS",
+                                            "YES")) )
+    {
+        // Field types of operation nodes are only resolved when checking.
+        poProgram = OGRFeatureQueryProgram::Build(
+            static_cast<swq_expr_node *>(pSWQExpr), poDefn);
+    }
 
     CPLFree(papszFieldNames);
     CPLFree(paeFieldTypes);
@@ -322,6 +420,678 @@ static swq_expr_node *OGRFeatureFetcher( swq_expr_node *op, void *pFeatureIn )
     return poRetNode;
 }
 
+/************************************************************************/
+/*                   OGRFeatureQueryProgram::NewSlot()                  */
+/************************************************************************/
+
+int OGRFeatureQueryProgram::NewSlot()
+{
+    aoSlots.emplace_back();
+    return static_cast<int>(aoSlots.size()) - 1;
+}
+
+/************************************************************************/
+/*                  OGRFeatureQueryProgram::AddInstr()                  */
+/************************************************************************/
+
+void OGRFeatureQueryProgram::AddInstr( Instr& sInstr,
+                                       const std::vector<int>& aiArgs )
+{
+    sInstr.iFirstArg = static_cast<int>(anArgs.size());
+    sInstr.nArgs = static_cast<int>(aiArgs.size());
+    anArgs.insert(anArgs.end(), aiArgs.begin(), aiArgs.end());
+    aoInstrs.push_back(sInstr);
+}
+
+/************************************************************************/
+/*                OGRFeatureQueryProgram::MayEmitError()                */
+/*                                                                      */
+/*      Whether evaluating the node may emit a CPLError(), in which     */
+/*      case its evaluation cannot be skipped.                          */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::MayEmitError( const swq_expr_node *poNode ) const
+{
+    if( poNode->eNodeType == SNT_COLUMN )
+    {
+        // e.g. GetFieldAsInteger() on a 64 bit FID.
+        return OGRFeatureFetcherFixFieldIndex(poDefn, poNode->field_index) >=
+               poDefn->GetFieldCount();
+    }
+    if( poNode->eNodeType != SNT_OPERATION )
+        return false;
+
+    // Integer overflow.
+    if( poNode->nOperation == SWQ_ADD ||
+        poNode->nOperation == SWQ_SUBTRACT ||
+        poNode->nOperation == SWQ_MULTIPLY ||
+        poNode->nOperation == SWQ_DIVIDE )
+        return true;
+
+    for( int i = 0; i < poNode->nSubExprCount; i++ )
+    {
+        if( MayEmitError(poNode->papoSubExpr[i]) )
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                    OGRFeatureQueryProgram::Emit()                    */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::Emit( const swq_expr_node *poNode,
+                                   int nRecLevel,
+                                   int &iSlot, swq_field_type &eType )
+{
+    // Let the interpreter report the error.
+    if( nRecLevel >= 32 )
+        return false;
+
+    if( poNode->eNodeType == SNT_CONSTANT )
+    {
+        if( poNode->is_null )
+            return false;
+
+        iSlot = NewSlot();
+        Slot &sSlot = aoSlots[iSlot];
+        switch( poNode->field_type )
+        {
+          case SWQ_INTEGER:
+          case SWQ_INTEGER64:
+          case SWQ_BOOLEAN:
+            sSlot.nVal = poNode->int_value;
+            break;
+
+          case SWQ_FLOAT:
+            sSlot.dfVal = poNode->float_value;
+            break;
+
+          case SWQ_STRING:
+            if( poNode->string_value == nullptr )
+                return false;
+            // The program must not depend on the lifetime of the tree.
+            aosConstStrings.AddString(poNode->string_value);
+            sSlot.pszVal = aosConstStrings[aosConstStrings.size() - 1];
+            break;
+
+          default:
+            return false;
+        }
+        eType = poNode->field_type;
+        return true;
+    }
+
+    if( poNode->eNodeType == SNT_COLUMN )
+    {
+        const int iField =
+            OGRFeatureFetcherFixFieldIndex(poDefn, poNode->field_index);
+        if( iField < 0 ||
+            iField >= poDefn->GetFieldCount() + SPECIAL_FIELD_COUNT )
+            return false;
+
+        // Same value types as OGRFeatureFetcher().
+        Instr sInstr;
+        switch( poNode->field_type )
+        {
+          case SWQ_INTEGER:
+          case SWQ_BOOLEAN:
+            sInstr.eOpcode = Opcode::LOAD_INTEGER;
+            eType = SWQ_INTEGER;
+            break;
+
+          case SWQ_INTEGER64:
+            sInstr.eOpcode = Opcode::LOAD_INTEGER64;
+            eType = SWQ_INTEGER64;
+            break;
+
+          case SWQ_FLOAT:
+            sInstr.eOpcode = Opcode::LOAD_REAL;
+            eType = SWQ_FLOAT;
+            break;
+
+          case SWQ_STRING:
+            // GetFieldAsString() returns a pointer to the feature data for
+            // OFTString fields only: other fields share a temporary buffer.
+            if( iField >= poDefn->GetFieldCount() ||
+                poDefn->GetFieldDefn(iField)->GetType() != OFTString )
+                return false;
+            sInstr.eOpcode = Opcode::LOAD_STRING;
+            eType = SWQ_STRING;
+            break;
+
+          default:
+            return false;
+        }
+        iSlot = NewSlot();
+        sInstr.iDst = iSlot;
+        sInstr.iField = iField;
+        AddInstr(sInstr, std::vector<int>());
+        return true;
+    }
+
+    if( poNode->eNodeType == SNT_OPERATION )
+        return EmitOperation(poNode, nRecLevel, iSlot, eType);
+
+    return false;
+}
+
+/************************************************************************/
+/*               OGRFeatureQueryProgram::EmitOperation()                */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::EmitOperation( const swq_expr_node *poNode,
+                                            int nRecLevel,
+                                            int &iSlot, swq_field_type &eType )
+{
+    const int nOp = poNode->nOperation;
+    const int nSub = poNode->nSubExprCount;
+
+    // Check arity and result type, as SWQGeneralChecker() should have
+    // established them.
+    bool bArithmetic = false;
+    switch( nOp )
+    {
+      case SWQ_AND:
+      case SWQ_OR:
+      case SWQ_EQ:
+      case SWQ_NE:
+      case SWQ_GT:
+      case SWQ_LT:
+      case SWQ_GE:
+      case SWQ_LE:
+        if( nSub != 2 )
+            return false;
+        break;
+
+      case SWQ_NOT:
+      case SWQ_ISNULL:
+        if( nSub != 1 )
+            return false;
+        break;
+
+      case SWQ_IN:
+        if( nSub < 2 )
+            return false;
+        break;
+
+      case SWQ_BETWEEN:
+        if( nSub != 3 )
+            return false;
+        break;
+
+      case SWQ_LIKE:
+      case SWQ_ILIKE:
+        if( nSub != 2 && nSub != 3 )
+            return false;
+        break;
+
+      case SWQ_ADD:
+      case SWQ_SUBTRACT:
+      case SWQ_MULTIPLY:
+      case SWQ_DIVIDE:
+      case SWQ_MODULUS:
+        if( nSub != 2 )
+            return false;
+        bArithmetic = true;
+        break;
+
+      default:
+        return false;
+    }
+    if( !bArithmetic && poNode->field_type != SWQ_BOOLEAN )
+        return false;
+
+    iSlot = NewSlot();
+    eType = poNode->field_type;
+
+    std::vector<int> aiArgs(nSub);
+    std::vector<swq_field_type> aeArgTypes(nSub);
+    bool bShortcut = false;
+    size_t iShortcut = 0;
+    for( int i = 0; i < nSub; i++ )
+    {
+        if( !Emit(poNode->papoSubExpr[i], nRecLevel + 1,
+                  aiArgs[i], aeArgTypes[i]) )
+            return false;
+
+        if( i == 0 && nOp == SWQ_AND &&
+            (SWQ_IS_INTEGER(aeArgTypes[0]) || aeArgTypes[0] == SWQ_BOOLEAN) &&
+            !MayEmitError(poNode->papoSubExpr[1]) )
+        {
+            bShortcut = true;
+            iShortcut = aoInstrs.size();
+            Instr sInstr;
+            sInstr.eOpcode = Opcode::AND_SHORTCUT;
+            sInstr.iDst = iSlot;
+            AddInstr(sInstr, std::vector<int>(1, aiArgs[0]));
+        }
+    }
+
+    Instr sInstr;
+    sInstr.nOperation = nOp;
+    sInstr.eResultType = poNode->field_type;
+    sInstr.iDst = iSlot;
+
+    // IS NULL only looks at the null flag, whatever the operand type.
+    if( nOp == SWQ_ISNULL )
+    {
+        sInstr.eOpcode = Opcode::IS_NULL;
+        AddInstr(sInstr, aiArgs);
+        return true;
+    }
+
+    // Same dispatching as SWQGeneralEvaluator().
+    if( aeArgTypes[0] == SWQ_FLOAT ||
+        (nSub > 1 && aeArgTypes[1] == SWQ_FLOAT) )
+    {
+        if( nOp == SWQ_AND || nOp == SWQ_OR || nOp == SWQ_NOT ||
+            nOp == SWQ_LIKE || nOp == SWQ_ILIKE ||
+            (bArithmetic && eType != SWQ_FLOAT) )
+            return false;
+
+        // Only the first two operands are promoted to floating point.
+        for( int i = 0; i < nSub; i++ )
+        {
+            if( aeArgTypes[i] == SWQ_FLOAT )
+                continue;
+            if( i >= 2 || !SWQ_IS_INTEGER(aeArgTypes[i]) )
+                return false;
+            if( poNode->papoSubExpr[i]->eNodeType == SNT_CONSTANT )
+            {
+                aoSlots[aiArgs[i]].dfVal =
+                    static_cast<double>(aoSlots[aiArgs[i]].nVal);
+            }
+            else
+            {
+                Instr sConvInstr;
+                sConvInstr.eOpcode = Opcode::TO_REAL;
+                sConvInstr.iDst = aiArgs[i];
+                AddInstr(sConvInstr, std::vector<int>());
+            }
+        }
+        sInstr.eOpcode = Opcode::REAL_OP;
+    }
+    else if( SWQ_IS_INTEGER(aeArgTypes[0]) || aeArgTypes[0] == SWQ_BOOLEAN )
+    {
+        if( nOp == SWQ_LIKE || nOp == SWQ_ILIKE ||
+            (bArithmetic && !SWQ_IS_INTEGER(eType)) )
+            return false;
+        for( int i = 1; i < nSub; i++ )
+        {
+            if( !SWQ_IS_INTEGER(aeArgTypes[i]) &&
+                aeArgTypes[i] != SWQ_BOOLEAN )
+                return false;
+        }
+        sInstr.eOpcode = Opcode::INTEGER_OP;
+    }
+    else if( aeArgTypes[0] == SWQ_STRING )
+    {
+        if( nOp == SWQ_AND || nOp == SWQ_OR || nOp == SWQ_NOT || bArithmetic )
+            return false;
+        for( int i = 1; i < nSub; i++ )
+        {
+            if( aeArgTypes[i] != SWQ_STRING )
+                return false;
+        }
+        sInstr.eOpcode = Opcode::STRING_OP;
+    }
+    else
+    {
+        return false;
+    }
+
+    AddInstr(sInstr, aiArgs);
+    if( bShortcut )
+        aoInstrs[iShortcut].nSkipTo = aoInstrs.size();
+    return true;
+}
+
+/************************************************************************/
+/*                   OGRFeatureQueryProgram::Build()                    */
+/*                                                                      */
+/*      Returns nullptr if the expression cannot be compiled.           */
+/************************************************************************/
+
+OGRFeatureQueryProgram *
+OGRFeatureQueryProgram::Build( const swq_expr_node *poExpr,
+                               OGRFeatureDefn *poDefnIn )
+{
+    if( poExpr == nullptr || poDefnIn == nullptr )
+        return nullptr;
+
+    std::unique_ptr<OGRFeatureQueryProgram> poProgram(
+        new OGRFeatureQueryProgram());
+    poProgram->poDefn = poDefnIn;
+    poProgram->bLikeAsILike =
+        CPLTestBool(CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE", "FALSE"));
+    if( !poProgram->Emit(poExpr, 0, poProgram->iResultSlot,
+                         poProgram->eResultType) )
+    {
+        CPLDebug("OGR", "Expression cannot be compiled, it will be "
+                 "evaluated with the interpreter");
+        return nullptr;
+    }
+    return poProgram.release();
+}
+
+/************************************************************************/
+/*                 OGRFeatureQueryProgram::HasNullArg()                 */
+/************************************************************************/
+
+bool OGRFeatureQueryProgram::HasNullArg( const Instr& sInstr ) const
+{
+    const int *panArgs = anArgs.data() + sInstr.iFirstArg;
+    for( int i = 0; i < sInstr.nArgs; i++ )
+    {
+        if( aoSlots[panArgs[i]].bNull )
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                OGRFeatureQueryProgram::EvaluateReal()                */
+/************************************************************************/
+
+void OGRFeatureQueryProgram::EvaluateReal( const Instr& sInstr,
+                                           Slot& sDst ) const
+{
+    const int *panArgs = anArgs.data() + sInstr.iFirstArg;
+    const double dfA = aoSlots[panArgs[0]].dfVal;
+    const double dfB = aoSlots[panArgs[1]].dfVal;
+
+    sDst.nVal = 0;
+    sDst.dfVal = 0;
+    switch( sInstr.nOperation )
+    {
+      case SWQ_EQ: sDst.nVal = dfA == dfB; break;
+      case SWQ_NE: sDst.nVal = dfA != dfB; break;
+      case SWQ_GT: sDst.nVal = dfA > dfB; break;
+      case SWQ_LT: sDst.nVal = dfA < dfB; break;
+      case SWQ_GE: sDst.nVal = dfA >= dfB; break;
+      case SWQ_LE: sDst.nVal = dfA <= dfB; break;
+
+      case SWQ_IN:
+        for( int i = 1; i < sInstr.nArgs; i++ )
+        {
+            if( dfA == aoSlots[panArgs[i]].dfVal )
+            {
+                sDst.nVal = 1;
+                break;
+            }
+        }
+        break;
+
+      case SWQ_BETWEEN:
+        sDst.nVal = dfA >= dfB && dfA <= aoSlots[panArgs[2]].dfVal;
+        break;
+
+      case SWQ_ADD: sDst.dfVal = dfA + dfB; break;
+      case SWQ_SUBTRACT: sDst.dfVal = dfA - dfB; break;
+      case SWQ_MULTIPLY: sDst.dfVal = dfA * dfB; break;
+
+      case SWQ_DIVIDE:
+        sDst.dfVal = dfB == 0 ? INT_MAX : dfA / dfB;
+        break;
+
+      case SWQ_MODULUS:
+        sDst.dfVal = dfB == 0 ? INT_MAX : fmod(dfA, dfB);
+        break;
+
+      default:
+        CPLAssert(false);
+        break;
+    }
+}
+
+/************************************************************************/
+/*              OGRFeatureQueryProgram::EvaluateInteger()               */
+/************************************************************************/
+
+void OGRFeatureQueryProgram::EvaluateInteger( const Instr& sInstr,
+                                              Slot& sDst ) const
+{
+    const int *panArgs = anArgs.data() + sInstr.iFirstArg;
+    const GIntBig nA = aoSlots[panArgs[0]].nVal;
+    const GIntBig nB = sInstr.nArgs > 1 ? aoSlots[panArgs[1]].nVal : 0;
+
+    sDst.nVal = 0;
+    switch( sInstr.nOperation )
+    {
+      case SWQ_AND: sDst.nVal = nA && nB; break;
+      case SWQ_OR: sDst.nVal = nA || nB; break;
+      case SWQ_NOT: sDst.nVal = !nA; break;
+      case SWQ_EQ: sDst.nVal = nA == nB; break;
+      case SWQ_NE: sDst.nVal = nA != nB; break;
+      case SWQ_GT: sDst.nVal = nA > nB; break;
+      case SWQ_LT: sDst.nVal = nA < nB; break;
+      case SWQ_GE: sDst.nVal = nA >= nB; break;
+      case SWQ_LE: sDst.nVal = nA <= nB; break;
+
+      case SWQ_IN:
+        for( int i = 1; i < sInstr.nArgs; i++ )
+        {
+            if( nA == aoSlots[panArgs[i]].nVal )
+            {
+                sDst.nVal = 1;
+                break;
+            }
+        }
+        break;
+
+      case SWQ_BETWEEN:
+        sDst.nVal = nA >= nB && nA <= aoSlots[panArgs[2]].nVal;
+        break;
+
+      case SWQ_ADD:
+      case SWQ_SUBTRACT:
+      case SWQ_MULTIPLY:
+      case SWQ_DIVIDE:
+        if( sInstr.nOperation == SWQ_DIVIDE && nB == 0 )
+        {
+            sDst.nVal = INT_MAX;
+            break;
+        }
+        try
+        {
+            switch( sInstr.nOperation )
+            {
+              case SWQ_ADD:
+                sDst.nVal = (CPLSM(nA) + CPLSM(nB)).v();
+                break;
+              case SWQ_SUBTRACT:
+                sDst.nVal = (CPLSM(nA) - CPLSM(nB)).v();
+                break;
+              case SWQ_MULTIPLY:
+                sDst.nVal = (CPLSM(nA) * CPLSM(nB)).v();
+                break;
+              default:
+                sDst.nVal = (CPLSM(nA) / CPLSM(nB)).v();
+                break;
+            }
+        }
+        catch( const std::exception& )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Int overflow");
+            sDst.bNull = true;
+        }
+        break;
+
+      case SWQ_MODULUS:
+        sDst.nVal = nB == 0 ? INT_MAX : nA % nB;
+        break;
+
+      default:
+        CPLAssert(false);
+        break;
+    }
+}
+
+/************************************************************************/
+/*                     OGRFeatureQueryStringEqual()                     */
+/************************************************************************/
+
+static bool OGRFeatureQueryStringEqual( const char *pszA, const char *pszB )
+{
+    // As in SWQGeneralEvaluator(), the +00 at the end of a timestamp might
+    // be discarded if the other member has no explicit timezone.
+    const size_t nLenA = strlen(pszA);
+    const size_t nLenB = strlen(pszB);
+    if( nLenA > 3 && nLenB > 3 )
+    {
+        if( strcmp(pszA + nLenA - 3, "+00") == 0 && pszB[nLenB - 3] == ':' )
+            return EQUALN(pszA, pszB, nLenB);
+        if( pszA[nLenA - 3] == ':' && strcmp(pszB + nLenB - 3, "+00") == 0 )
+            return EQUALN(pszA, pszB, nLenA);
+    }
+    return STRCASECMP(pszA, pszB) == 0;
+}
+
+/************************************************************************/
+/*               OGRFeatureQueryProgram::EvaluateString()               */
+/************************************************************************/
+
+void OGRFeatureQueryProgram::EvaluateString( const Instr& sInstr,
+                                             Slot& sDst ) const
+{
+    const int *panArgs = anArgs.data() + sInstr.iFirstArg;
+    const char *pszA = aoSlots[panArgs[0]].pszVal;
+    const char *pszB = aoSlots[panArgs[1]].pszVal;
+
+    sDst.nVal = 0;
+    switch( sInstr.nOperation )
+    {
+      case SWQ_EQ:
+        sDst.nVal = OGRFeatureQueryStringEqual(pszA, pszB);
+        break;
+      case SWQ_NE: sDst.nVal = STRCASECMP(pszA, pszB) != 0; break;
+      case SWQ_GT: sDst.nVal = STRCASECMP(pszA, pszB) > 0; break;
+      case SWQ_LT: sDst.nVal = STRCASECMP(pszA, pszB) < 0; break;
+      case SWQ_GE: sDst.nVal = STRCASECMP(pszA, pszB) >= 0; break;
+      case SWQ_LE: sDst.nVal = STRCASECMP(pszA, pszB) <= 0; break;
+
+      case SWQ_IN:
+        for( int i = 1; i < sInstr.nArgs; i++ )
+        {
+            if( STRCASECMP(pszA, aoSlots[panArgs[i]].pszVal) == 0 )
+            {
+                sDst.nVal = 1;
+                break;
+            }
+        }
+        break;
+
+      case SWQ_BETWEEN:
+        sDst.nVal = STRCASECMP(pszA, pszB) >= 0 &&
+                    STRCASECMP(pszA, aoSlots[panArgs[2]].pszVal) <= 0;
+        break;
+
+      case SWQ_LIKE:
+      case SWQ_ILIKE:
+      {
+          const char chEscape =
+              sInstr.nArgs == 3 ? aoSlots[panArgs[2]].pszVal[0] : '\0';
+          sDst.nVal = swq_test_like(pszA, pszB, chEscape,
+                                    sInstr.nOperation == SWQ_ILIKE ||
+                                    bLikeAsILike);
+          break;
+      }
+
+      default:
+        CPLAssert(false);
+        break;
+    }
+}
+
+/************************************************************************/
+/*                  OGRFeatureQueryProgram::Evaluate()                  */
+/************************************************************************/
+
+int OGRFeatureQueryProgram::Evaluate( OGRFeature *poFeature )
+{
+    const size_t nInstrs = aoInstrs.size();
+    for( size_t i = 0; i < nInstrs; i++ )
+    {
+        const Instr& sInstr = aoInstrs[i];
+        Slot& sDst = aoSlots[sInstr.iDst];
+        switch( sInstr.eOpcode )
+        {
+          case Opcode::LOAD_INTEGER:
+            sDst.nVal = poFeature->GetFieldAsInteger(sInstr.iField);
+            sDst.bNull = !poFeature->IsFieldSetAndNotNull(sInstr.iField);
+            break;
+
+          case Opcode::LOAD_INTEGER64:
+            sDst.nVal = poFeature->GetFieldAsInteger64(sInstr.iField);
+            sDst.bNull = !poFeature->IsFieldSetAndNotNull(sInstr.iField);
+            break;
+
+          case Opcode::LOAD_REAL:
+            sDst.dfVal = poFeature->GetFieldAsDouble(sInstr.iField);
+            sDst.bNull = !poFeature->IsFieldSetAndNotNull(sInstr.iField);
+            break;
+
+          case Opcode::LOAD_STRING:
+            sDst.pszVal = poFeature->GetFieldAsString(sInstr.iField);
+            sDst.bNull = !poFeature->IsFieldSetAndNotNull(sInstr.iField);
+            break;
+
+          case Opcode::TO_REAL:
+            sDst.dfVal = static_cast<double>(sDst.nVal);
+            break;
+
+          case Opcode::IS_NULL:
+            sDst.nVal = aoSlots[anArgs[sInstr.iFirstArg]].bNull;
+            sDst.bNull = false;
+            break;
+
+          case Opcode::AND_SHORTCUT:
+          {
+              const Slot& sLeft = aoSlots[anArgs[sInstr.iFirstArg]];
+              if( sLeft.bNull || sLeft.nVal == 0 )
+              {
+                  sDst.nVal = 0;
+                  sDst.bNull = false;
+                  i = sInstr.nSkipTo - 1;
+              }
+              break;
+          }
+
+          case Opcode::REAL_OP:
+          case Opcode::INTEGER_OP:
+          case Opcode::STRING_OP:
+          {
+              // Same as SWQGeneralEvaluator(): a NULL operand makes a
+              // logical result false, and other results NULL.
+              if( HasNullArg(sInstr) )
+              {
+                  sDst.nVal = 0;
+                  sDst.dfVal = 0;
+                  sDst.bNull = sInstr.eResultType != SWQ_BOOLEAN;
+                  break;
+              }
+              sDst.bNull = false;
+              if( sInstr.eOpcode == Opcode::REAL_OP )
+                  EvaluateReal(sInstr, sDst);
+              else if( sInstr.eOpcode == Opcode::INTEGER_OP )
+                  EvaluateInteger(sInstr, sDst);
+              else
+                  EvaluateString(sInstr, sDst);
+              break;
+          }
+        }
+    }
+
+    if( eResultType == SWQ_INTEGER ||
+        eResultType == SWQ_INTEGER64 ||
+        eResultType == SWQ_BOOLEAN )
+    {
+        return CPL_TO_BOOL(static_cast<int>(aoSlots[iResultSlot].nVal));
+    }
+    return FALSE;
+}
+
 /************************************************************************/
 /*                              Evaluate()                              */
 /************************************************************************/
@@ -332,6 +1102,9 @@ int OGRFeatureQuery::Evaluate( OGRFeature *poFeature )
     if( pSWQExpr == nullptr )
         return FALSE;
 
+    if( poProgram != nullptr && poFeature->GetDefnRef() == poProgram->GetDefn() )
+        return poProgram->Evaluate(poFeature);
+
     swq_expr_node *poResult =
         static_cast<swq_expr_node *>(pSWQExpr)->
             Evaluate(OGRFeatureFetcher, poFeature);
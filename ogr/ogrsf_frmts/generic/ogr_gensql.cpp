@@ -33,7 +33,13 @@
 #include "cpl_string.h"
 #include "ogr_api.h"
 #include "cpl_time.h"
+#include "ogr_attrind.h"
+
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 //! @cond Doxygen_Suppress
@@ -52,6 +58,384 @@ class OGRGenSQLGeomFieldDefn final: public OGRGeomFieldDefn
         int bForceGeomType;
 };
 
+/************************************************************************/
+/*                         OGRGenSQLJoinIndex                           */
+/*                                                                      */
+/*      In-memory hash of the secondary layer of a JOIN, keyed on the   */
+/*      secondary field of a "primary.field = secondary.field" join     */
+/*      expression. It avoids re-querying the secondary layer with an   */
+/*      attribute filter for each primary feature.                      */
+/************************************************************************/
+
+class OGRGenSQLJoinIndex
+{
+  public:
+    enum class Strategy
+    {
+        NESTED_LOOP,     // attribute filter on secondary layer per feature
+        HASH_FEATURES,   // key -> secondary feature held in memory
+        HASH_FIDS        // key -> FID of secondary feature, read on demand
+    };
+
+  private:
+    enum class KeyType { INTEGER, REAL, STRING };
+
+    Strategy m_eStrategy = Strategy::NESTED_LOOP;
+    KeyType  m_eKeyType = KeyType::INTEGER;
+    bool     m_bCaseSensitiveKeys = false;
+    int      m_iPrimaryField = -1;
+    int      m_iSecondaryField = -1;
+    OGRLayer *m_poJoinLayer = nullptr;
+
+    std::unordered_map<std::string, size_t> m_oMap{};
+    std::vector<std::unique_ptr<OGRFeature>> m_apoFeatures{};
+    std::vector<GIntBig> m_anFIDs{};
+
+    bool MakeKey( OGRFeature* poFeature, int iField, std::string& osKey ) const;
+    static size_t EstimateSize( OGRFeature* poFeature );
+    static bool IsAttributeFilterEvaluatedByOGRSQL( OGRLayer* poLayer,
+                                                    int iField );
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGenSQLJoinIndex)
+
+  public:
+    OGRGenSQLJoinIndex() = default;
+
+    void        Build( swq_join_def* psJoinInfo, OGRLayer* poSrcLayer,
+                       OGRLayer* poJoinLayer );
+    Strategy    GetStrategy() const { return m_eStrategy; }
+    OGRFeature *Lookup( OGRFeature* poSrcFeat, bool& bOwned );
+};
+
+/************************************************************************/
+/*                              MakeKey()                               */
+/************************************************************************/
+
+bool OGRGenSQLJoinIndex::MakeKey( OGRFeature* poFeature, int iField,
+                                  std::string& osKey ) const
+{
+    if( !poFeature->IsFieldSetAndNotNull(iField) )
+        return false;
+
+    switch( m_eKeyType )
+    {
+        case KeyType::INTEGER:
+        {
+            const GIntBig nVal = poFeature->GetFieldAsInteger64(iField);
+            osKey.assign(reinterpret_cast<const char*>(&nVal), sizeof(nVal));
+            break;
+        }
+
+        case KeyType::REAL:
+        {
+            double dfVal = poFeature->GetFieldAsDouble(iField);
+            if( std::isnan(dfVal) )
+                return false;
+            if( dfVal == 0.0 )
+                dfVal = 0.0; // -0 == 0
+            osKey.assign(reinterpret_cast<const char*>(&dfVal), sizeof(dfVal));
+            break;
+        }
+
+        case KeyType::STRING:
+        {
+            osKey = poFeature->GetFieldAsString(iField);
+            if( !m_bCaseSensitiveKeys )
+                osKey = CPLString(osKey).toupper();
+            break;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            EstimateSize()                            */
+/************************************************************************/
+
+size_t OGRGenSQLJoinIndex::EstimateSize( OGRFeature* poFeature )
+{
+    const OGRFeatureDefn* poFDefn = poFeature->GetDefnRef();
+    const int nFieldCount = poFDefn->GetFieldCount();
+    size_t nSize = sizeof(OGRFeature) + nFieldCount * sizeof(OGRField);
+    for( int iField = 0; iField < nFieldCount; iField++ )
+    {
+        if( !poFeature->IsFieldSetAndNotNull(iField) )
+            continue;
+        const OGRField* psField = poFeature->GetRawFieldRef(iField);
+        switch( poFDefn->GetFieldDefn(iField)->GetType() )
+        {
+            case OFTString:
+                nSize += strlen(psField->String) + 1;
+                break;
+            case OFTBinary:
+                nSize += psField->Binary.nCount;
+                break;
+            case OFTIntegerList:
+                nSize += psField->IntegerList.nCount * sizeof(int);
+                break;
+            case OFTInteger64List:
+                nSize += psField->Integer64List.nCount * sizeof(GIntBig);
+                break;
+            case OFTRealList:
+                nSize += psField->RealList.nCount * sizeof(double);
+                break;
+            case OFTStringList:
+                for( int i = 0; i < psField->StringList.nCount; i++ )
+                    nSize += sizeof(char*) + strlen(psField->StringList.paList[i]) + 1;
+                break;
+            default:
+                break;
+        }
+    }
+    for( int iGeom = 0; iGeom < poFeature->GetGeomFieldCount(); iGeom++ )
+    {
+        const OGRGeometry* poGeom = poFeature->GetGeomFieldRef(iGeom);
+        if( poGeom )
+            nSize += poGeom->WkbSize();
+    }
+    return nSize;
+}
+
+/************************************************************************/
+/*                  IsAttributeFilterEvaluatedByOGRSQL()                */
+/*                                                                      */
+/*      Whether an attribute filter on the field is evaluated by the    */
+/*      generic OGR SQL code, rather than natively by the driver.       */
+/************************************************************************/
+
+bool OGRGenSQLJoinIndex::IsAttributeFilterEvaluatedByOGRSQL(
+                                        OGRLayer* poLayer, int iField )
+{
+    const char* pszFieldName =
+        poLayer->GetLayerDefn()->GetFieldDefn(iField)->GetNameRef();
+    bool bRet = false;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandlerPusher(CPLQuietErrorHandler);
+        if( poLayer->SetAttributeFilter(
+                CPLSPrintf("\"%s\" = ''", pszFieldName)) == OGRERR_NONE )
+        {
+            bRet = poLayer->GetAttrQuery() != nullptr;
+        }
+    }
+    poLayer->SetAttributeFilter( nullptr );
+    return bRet;
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/*                                                                      */
+/*      Select the join strategy, and build the hash table if needed.   */
+/************************************************************************/
+
+void OGRGenSQLJoinIndex::Build( swq_join_def* psJoinInfo,
+                                OGRLayer* poSrcLayer,
+                                OGRLayer* poJoinLayer )
+{
+    m_poJoinLayer = poJoinLayer;
+    m_eStrategy = Strategy::NESTED_LOOP;
+
+    const char* pszStrategy =
+        CPLGetConfigOption("OGR_SQL_JOIN_STRATEGY", "AUTO");
+    // self joins would reset the reading of the primary layer
+    if( EQUAL(pszStrategy, "NESTED_LOOP") || poJoinLayer == poSrcLayer )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      Only "primary.field = secondary.field" expressions, on regular  */
+/*      fields of compatible types, can be hashed.                      */
+/* -------------------------------------------------------------------- */
+    const swq_expr_node* poExpr = psJoinInfo->poExpr;
+    if( poExpr->eNodeType != SNT_OPERATION ||
+        poExpr->nOperation != SWQ_EQ ||
+        poExpr->nSubExprCount != 2 ||
+        poExpr->papoSubExpr[0]->eNodeType != SNT_COLUMN ||
+        poExpr->papoSubExpr[1]->eNodeType != SNT_COLUMN )
+    {
+        return;
+    }
+    const swq_expr_node* poPrimary = poExpr->papoSubExpr[0];
+    const swq_expr_node* poSecondary = poExpr->papoSubExpr[1];
+    if( poPrimary->table_index != 0 )
+        std::swap(poPrimary, poSecondary);
+    if( poPrimary->table_index != 0 ||
+        poSecondary->table_index != psJoinInfo->secondary_table )
+    {
+        return;
+    }
+
+    OGRFeatureDefn* poSrcDefn = poSrcLayer->GetLayerDefn();
+    OGRFeatureDefn* poJoinDefn = poJoinLayer->GetLayerDefn();
+    if( poPrimary->field_index < 0 ||
+        poPrimary->field_index >= poSrcDefn->GetFieldCount() ||
+        poSecondary->field_index < 0 ||
+        poSecondary->field_index >= poJoinDefn->GetFieldCount() )
+    {
+        return;
+    }
+    m_iPrimaryField = poPrimary->field_index;
+    m_iSecondaryField = poSecondary->field_index;
+
+    const OGRFieldType ePrimaryType =
+        poSrcDefn->GetFieldDefn(m_iPrimaryField)->GetType();
+    const OGRFieldType eSecondaryType =
+        poJoinDefn->GetFieldDefn(m_iSecondaryField)->GetType();
+    const auto IsInteger = [](OGRFieldType eType)
+        { return eType == OFTInteger || eType == OFTInteger64; };
+    if( IsInteger(ePrimaryType) && IsInteger(eSecondaryType) )
+        m_eKeyType = KeyType::INTEGER;
+    else if( (ePrimaryType == OFTReal || IsInteger(ePrimaryType)) &&
+             (eSecondaryType == OFTReal || IsInteger(eSecondaryType)) )
+        m_eKeyType = KeyType::REAL;
+    else if( ePrimaryType == OFTString && eSecondaryType == OFTString )
+        m_eKeyType = KeyType::STRING;
+    else
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      OGR SQL compares strings in a case insensitive way, but drivers */
+/*      evaluating attribute filters natively (GPKG, SQLite, PG...) may */
+/*      not. Compare string keys as the attribute filter of the         */
+/*      NESTED_LOOP strategy would.                                     */
+/* -------------------------------------------------------------------- */
+    if( m_eKeyType == KeyType::STRING )
+    {
+        m_bCaseSensitiveKeys = !IsAttributeFilterEvaluatedByOGRSQL(
+            poJoinLayer, m_iSecondaryField);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      If the secondary layer has an attribute index on the key, and   */
+/*      the primary layer is much smaller, lookups are cheaper than     */
+/*      reading the whole secondary layer.                              */
+/* -------------------------------------------------------------------- */
+    if( EQUAL(pszStrategy, "AUTO") )
+    {
+        const GIntBig nPrimaryCount = poSrcLayer->GetFeatureCount(FALSE);
+        const GIntBig nSecondaryCount = poJoinLayer->GetFeatureCount(FALSE);
+        OGRLayerAttrIndex* poAttrIndex = poJoinLayer->GetIndex();
+        if( poAttrIndex != nullptr &&
+            poAttrIndex->GetFieldIndex(m_iSecondaryField) != nullptr &&
+            nPrimaryCount >= 0 && nSecondaryCount >= 0 &&
+            nPrimaryCount < nSecondaryCount / 16 )
+        {
+            return;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read the secondary layer. Only the first feature of a given     */
+/*      key is kept, as with the attribute filter. If the features do   */
+/*      not fit in the memory budget, only keep their FID if they can   */
+/*      be fetched efficiently, or give up.                             */
+/* -------------------------------------------------------------------- */
+    GIntBig nMaxMemory = 0;
+    const char* pszMaxMemory =
+        CPLGetConfigOption("OGR_SQL_JOIN_MAX_MEMORY", nullptr);
+    if( pszMaxMemory )
+        nMaxMemory = static_cast<GIntBig>(CPLAtof(pszMaxMemory) * 1024 * 1024);
+    else
+    {
+        nMaxMemory = CPLGetUsablePhysicalRAM() / 10;
+        if( nMaxMemory <= 0 )
+            nMaxMemory = static_cast<GIntBig>(256) * 1024 * 1024;
+    }
+    const bool bCanUseFIDs =
+        poJoinLayer->TestCapability(OLCRandomRead) != FALSE;
+
+    m_eStrategy = Strategy::HASH_FEATURES;
+    GIntBig nIndexMemory = 0;     // hash table, and FIDs
+    GIntBig nFeaturesMemory = 0;  // features held in memory
+    bool bTooLarge = false;
+    std::string osKey;
+    poJoinLayer->SetAttributeFilter( nullptr );
+    poJoinLayer->ResetReading();
+    while( true )
+    {
+        std::unique_ptr<OGRFeature> poFeature(poJoinLayer->GetNextFeature());
+        if( poFeature == nullptr )
+            break;
+        if( !MakeKey(poFeature.get(), m_iSecondaryField, osKey) ||
+            m_oMap.find(osKey) != m_oMap.end() )
+        {
+            continue;
+        }
+
+        // rough cost of a hash table entry
+        nIndexMemory += static_cast<GIntBig>(
+            osKey.size() + 4 * sizeof(void*) + sizeof(GIntBig));
+        if( m_eStrategy == Strategy::HASH_FEATURES )
+        {
+            nFeaturesMemory += static_cast<GIntBig>(EstimateSize(poFeature.get()));
+            if( nIndexMemory + nFeaturesMemory > nMaxMemory )
+            {
+                if( !bCanUseFIDs )
+                {
+                    bTooLarge = true;
+                    break;
+                }
+                CPLDebug("GenSQL",
+                         "Secondary layer %s too large to be held in memory. "
+                         "Only indexing its FIDs",
+                         poJoinLayer->GetName());
+                for( const auto& poKept: m_apoFeatures )
+                    m_anFIDs.push_back(poKept->GetFID());
+                m_apoFeatures.clear();
+                nFeaturesMemory = 0;
+                m_eStrategy = Strategy::HASH_FIDS;
+            }
+        }
+        if( m_eStrategy == Strategy::HASH_FIDS )
+        {
+            if( poFeature->GetFID() == OGRNullFID ||
+                nIndexMemory > nMaxMemory )
+            {
+                bTooLarge = true;
+                break;
+            }
+            m_oMap[osKey] = m_anFIDs.size();
+            m_anFIDs.push_back(poFeature->GetFID());
+        }
+        else
+        {
+            m_oMap[osKey] = m_apoFeatures.size();
+            m_apoFeatures.push_back(std::move(poFeature));
+        }
+    }
+    poJoinLayer->ResetReading();
+
+    if( bTooLarge )
+    {
+        CPLDebug("GenSQL",
+                 "Secondary layer %s too large to be hashed. "
+                 "Using attribute filter based join",
+                 poJoinLayer->GetName());
+        m_oMap.clear();
+        m_apoFeatures.clear();
+        m_anFIDs.clear();
+        m_eStrategy = Strategy::NESTED_LOOP;
+    }
+}
+
+/************************************************************************/
+/*                               Lookup()                               */
+/************************************************************************/
+
+OGRFeature* OGRGenSQLJoinIndex::Lookup( OGRFeature* poSrcFeat, bool& bOwned )
+{
+    bOwned = false;
+    std::string osKey;
+    if( !MakeKey(poSrcFeat, m_iPrimaryField, osKey) )
+        return nullptr;
+    const auto oIter = m_oMap.find(osKey);
+    if( oIter == m_oMap.end() )
+        return nullptr;
+    if( m_eStrategy == Strategy::HASH_FEATURES )
+        return m_apoFeatures[oIter->second].get();
+    bOwned = true;
+    return m_poJoinLayer->GetFeature(m_anFIDs[oIter->second]);
+}
+
 /************************************************************************/
 /*               OGRGenSQLResultsLayerHasSpecialField()                 */
 /************************************************************************/
@@ -105,7 +489,8 @@ OGRGenSQLResultsLayer::OGRGenSQLResultsLayer( GDALDataset *poSrcDSIn,
     nExtraDSCount(0),
     papoExtraDS(nullptr),
     nIteratedFeatures(-1),
-    m_oDistinctList{}
+    m_oDistinctList{},
+    m_apoJoinIndex{}
 {
     swq_select *psSelectInfo = static_cast<swq_select*>(pSelectInfoIn);
 
@@ -1278,6 +1663,7 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
 {
     swq_select *psSelectInfo = static_cast<swq_select*>(pSelectInfo);
     std::vector<OGRFeature*> apoFeatures;
+    std::vector<std::unique_ptr<OGRFeature>> apoOwnedJoinFeatures;
 
     if( poSrcFeat == nullptr )
         return nullptr;
@@ -1302,6 +1688,25 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
 
         OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
 
+        if( m_apoJoinIndex.empty() )
+            m_apoJoinIndex.resize(psSelectInfo->join_count);
+        if( m_apoJoinIndex[iJoin] == nullptr )
+        {
+            m_apoJoinIndex[iJoin].reset(new OGRGenSQLJoinIndex());
+            m_apoJoinIndex[iJoin]->Build(psJoinInfo, poSrcLayer, poJoinLayer);
+        }
+        if( m_apoJoinIndex[iJoin]->GetStrategy() !=
+                                OGRGenSQLJoinIndex::Strategy::NESTED_LOOP )
+        {
+            bool bOwned = false;
+            OGRFeature *poJoinFeature =
+                m_apoJoinIndex[iJoin]->Lookup(poSrcFeat, bOwned);
+            if( bOwned )
+                apoOwnedJoinFeatures.emplace_back(poJoinFeature);
+            apoFeatures.push_back( poJoinFeature );
+            continue;
+        }
+
         osFilter = GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
                                     psJoinInfo->secondary_table);
         //CPLDebug("OGR", "Filter = %s\n", osFilter.c_str());
@@ -1319,6 +1724,7 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
         if( poJoinLayer->SetAttributeFilter( osFilter.c_str() ) == OGRERR_NONE )
             poJoinFeature = poJoinLayer->GetNextFeature();
 
+        apoOwnedJoinFeatures.emplace_back( poJoinFeature );
         apoFeatures.push_back( poJoinFeature );
     }
 
@@ -1538,8 +1944,6 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
 
             iRegularField ++;
         }
-
-        delete poJoinFeature;
     }
 
     return poDstFeat;
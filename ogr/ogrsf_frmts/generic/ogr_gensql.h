@@ -36,10 +36,13 @@
 #include "cpl_hash_set.h"
 #include "cpl_string.h"
 
+#include <memory>
 #include <vector>
 
 /*! @cond Doxygen_Suppress */
 
+class OGRGenSQLJoinIndex;
+
 #define GEOM_FIELD_INDEX_TO_ALL_FIELD_INDEX(poFDefn, iGeom) \
     ((poFDefn)->GetFieldCount() + SPECIAL_FIELD_COUNT + (iGeom))
 
@@ -84,6 +87,9 @@ class OGRGenSQLResultsLayer final: public OGRLayer
     GIntBig     nIteratedFeatures;
     std::vector<CPLString> m_oDistinctList;
 
+    // one per JOIN, built on first use
+    std::vector<std::unique_ptr<OGRGenSQLJoinIndex>> m_apoJoinIndex;
+
     int         PrepareSummary();
 
     OGRFeature *TranslateFeature( OGRFeature * );
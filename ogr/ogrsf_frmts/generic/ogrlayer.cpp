@@ -36,10 +36,18 @@
 #include "ogr_recordbatch.h"
 #include "ograrrowarrayhelper.h"
 
+#include "cpl_error_internal.h"
+#include "cpl_quad_tree.h"
 #include "cpl_time.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
 #include <cassert>
 #include <limits>
+#include <memory>
 #include <set>
+#include <vector>
 
 
 struct OGRLayer::Private
@@ -2161,6 +2169,578 @@ static OGRGeometry* promote_to_multi(OGRGeometry* poGeom)
         return poGeom;
 }
 
+/************************************************************************/
+/*        spatial index based engine for layer overlay methods          */
+/************************************************************************/
+
+namespace {
+
+// What is computed from a feature x of the iterated layer and the features
+// of the indexed layer whose geometry intersects the one of x.
+enum class OverlayOp
+{
+    INTERSECTION,   // Intersection()
+    IDENTITY,       // Identity(), and first pass of Union()
+    DIFFERENCE,     // Erase(), Update(), SymDifference(), second pass of Union()
+    CLIP            // Clip()
+};
+
+struct OverlayParams
+{
+    OverlayOp eOp;
+    OGRFeatureDefn *poDefnResult = nullptr;
+    const int *mapX = nullptr;
+    const int *mapY = nullptr;
+    // spatial filter of the indexed layer, to be intersected with x
+    OGRGeometry *poFilterY = nullptr;
+    bool bSkipFailures = false;
+    bool bPromoteToMulti = false;
+    bool bUsePreparedGeometries = false;
+    bool bPretestContainment = false;
+    bool bKeepLowerDimGeom = false;
+    int nThreads = 1;
+
+    OverlayParams(OverlayOp eOpIn, OGRFeatureDefn *poDefnResultIn,
+                  const int *mapXIn, const int *mapYIn,
+                  OGRGeometry *poFilterYIn, CSLConstList papszOptions);
+
+    CPL_DISALLOW_COPY_ASSIGN(OverlayParams)
+};
+
+OverlayParams::OverlayParams(OverlayOp eOpIn, OGRFeatureDefn *poDefnResultIn,
+                             const int *mapXIn, const int *mapYIn,
+                             OGRGeometry *poFilterYIn,
+                             CSLConstList papszOptions):
+    eOp(eOpIn), poDefnResult(poDefnResultIn),
+    mapX(mapXIn), mapY(mapYIn), poFilterY(poFilterYIn)
+{
+    bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
+    bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
+    bUsePreparedGeometries = CPLTestBool(CSLFetchNameValueDef(papszOptions, "USE_PREPARED_GEOMETRIES", "YES")) &&
+                             OGRHasPreparedGeometrySupport();
+    bPretestContainment = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PRETEST_CONTAINMENT", "NO"));
+
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszThreads == nullptr)
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    nThreads = std::max(1, std::min(128,
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads)));
+}
+
+// In-memory copy of the features of a layer (honouring its current filters),
+// with a quad tree on the envelopes of their geometries.
+class OverlayIndex
+{
+    std::vector<OGRFeatureUniquePtr> m_apoFeatures{};
+    CPLQuadTree *m_hTree = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(OverlayIndex)
+
+  public:
+    OverlayIndex() = default;
+    ~OverlayIndex()
+    {
+        if (m_hTree)
+            CPLQuadTreeDestroy(m_hTree);
+    }
+
+    void Load(OGRLayer *poLayer);
+
+    size_t GetFeatureCount() const { return m_apoFeatures.size(); }
+    OGRFeature *GetFeature(size_t i) const { return m_apoFeatures[i].get(); }
+
+    void GetIntersecting(OGRGeometry *poGeom,
+                         std::vector<OGRFeature*> &apoFeatures) const;
+};
+
+void OverlayIndex::Load(OGRLayer *poLayer)
+{
+    std::vector<OGREnvelope> asEnvelopes;
+    OGREnvelope sExtent;
+    for (auto &&poFeature : poLayer) {
+        OGREnvelope sEnvelope;
+        const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+        if (poGeom && !poGeom->IsEmpty()) {
+            poGeom->getEnvelope(&sEnvelope);
+            sExtent.Merge(sEnvelope);
+        }
+        asEnvelopes.push_back(sEnvelope);
+        m_apoFeatures.push_back(std::move(poFeature));
+    }
+    if (!sExtent.IsInit())
+        return;
+
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = sExtent.MinX;
+    sGlobalBounds.miny = sExtent.MinY;
+    sGlobalBounds.maxx = sExtent.MaxX;
+    sGlobalBounds.maxy = sExtent.MaxY;
+    m_hTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+    CPLQuadTreeSetMaxDepth(m_hTree,
+        CPLQuadTreeGetAdvisedMaxDepth(static_cast<int>(
+            std::min<size_t>(asEnvelopes.size(), INT_MAX))));
+    for (size_t i = 0; i < asEnvelopes.size(); ++i) {
+        if (!asEnvelopes[i].IsInit())
+            continue;
+        CPLRectObj sBounds;
+        sBounds.minx = asEnvelopes[i].MinX;
+        sBounds.miny = asEnvelopes[i].MinY;
+        sBounds.maxx = asEnvelopes[i].MaxX;
+        sBounds.maxy = asEnvelopes[i].MaxY;
+        // store index + 1, as a null pointer cannot be inserted
+        CPLQuadTreeInsertWithBounds(m_hTree,
+            reinterpret_cast<void*>(static_cast<uintptr_t>(i + 1)), &sBounds);
+    }
+}
+
+// Returns, in the order of the layer, the features whose geometry
+// intersects poGeom, i.e. those that would have been returned by the layer
+// with poGeom as spatial filter.
+void OverlayIndex::GetIntersecting(OGRGeometry *poGeom,
+                                   std::vector<OGRFeature*> &apoFeatures) const
+{
+    apoFeatures.clear();
+    if (!m_hTree)
+        return;
+
+    OGREnvelope sEnvelope;
+    poGeom->getEnvelope(&sEnvelope);
+    CPLRectObj sAoi;
+    sAoi.minx = sEnvelope.MinX;
+    sAoi.miny = sEnvelope.MinY;
+    sAoi.maxx = sEnvelope.MaxX;
+    sAoi.maxy = sEnvelope.MaxY;
+    int nCount = 0;
+    void **pahRet = CPLQuadTreeSearch(m_hTree, &sAoi, &nCount);
+    if (nCount == 0) {
+        CPLFree(pahRet);
+        return;
+    }
+    std::vector<size_t> anIdx;
+    anIdx.reserve(nCount);
+    for (int i = 0; i < nCount; ++i)
+        anIdx.push_back(static_cast<size_t>(reinterpret_cast<uintptr_t>(pahRet[i])) - 1);
+    CPLFree(pahRet);
+    std::sort(anIdx.begin(), anIdx.end());
+
+    OGRPreparedGeometryUniquePtr poPreparedGeom;
+    if (anIdx.size() > 1 && OGRHasPreparedGeometrySupport())
+        poPreparedGeom.reset(OGRCreatePreparedGeometry(OGRGeometry::ToHandle(poGeom)));
+    for (size_t i : anIdx) {
+        OGRFeature *poFeature = m_apoFeatures[i].get();
+        OGRGeometry *poOther = poFeature->GetGeometryRef();
+        const bool bIntersects = poPreparedGeom ?
+            CPL_TO_BOOL(OGRPreparedGeometryIntersects(poPreparedGeom.get(), OGRGeometry::ToHandle(poOther))) :
+            CPL_TO_BOOL(poGeom->Intersects(poOther));
+        if (bIntersects)
+            apoFeatures.push_back(poFeature);
+    }
+}
+
+// The functions below compute the result features of x, in the same way
+// as the loops over the method layer of the sequential implementations.
+// They return false when the processing must be stopped.
+
+static bool overlay_intersection(const OverlayParams &p, OGRFeature *x,
+                                 OGRGeometry *x_geom,
+                                 const std::vector<OGRFeature*> &apoY,
+                                 std::vector<OGRFeatureUniquePtr> &apoResults)
+{
+    OGRPreparedGeometryUniquePtr x_prepared_geom;
+    if (p.bUsePreparedGeometries) {
+        x_prepared_geom.reset(OGRCreatePreparedGeometry(OGRGeometry::ToHandle(x_geom)));
+        if (!x_prepared_geom) {
+            return false;
+        }
+    }
+
+    for (OGRFeature *y : apoY) {
+        OGRGeometry *y_geom = y->GetGeometryRef();
+        OGRGeometryUniquePtr z_geom;
+
+        if (x_prepared_geom) {
+            CPLErrorReset();
+            if (p.bPretestContainment && OGRPreparedGeometryContains(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom)))
+            {
+                if (CPLGetLastErrorType() == CE_None)
+                    z_geom.reset(y_geom->clone());
+            }
+            else if (!(OGRPreparedGeometryIntersects(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom))))
+            {
+                if (CPLGetLastErrorType() == CE_None) {
+                    continue;
+                }
+            }
+            if (CPLGetLastErrorType() != CE_None) {
+                if (!p.bSkipFailures) {
+                    return false;
+                }
+                CPLErrorReset();
+                continue;
+            }
+        }
+        if (!z_geom) {
+            CPLErrorReset();
+            z_geom.reset(x_geom->Intersection(y_geom));
+            if (CPLGetLastErrorType() != CE_None || z_geom == nullptr) {
+                if (!p.bSkipFailures) {
+                    return false;
+                }
+                CPLErrorReset();
+                continue;
+            }
+            if (z_geom->IsEmpty() ||
+                (!p.bKeepLowerDimGeom &&
+                 (x_geom->getDimension() == y_geom->getDimension() &&
+                  z_geom->getDimension() < x_geom->getDimension())))
+            {
+                continue;
+            }
+        }
+        OGRFeatureUniquePtr z(new OGRFeature(p.poDefnResult));
+        z->SetFieldsFrom(x, p.mapX);
+        z->SetFieldsFrom(y, p.mapY);
+        if (p.bPromoteToMulti)
+            z_geom.reset(promote_to_multi(z_geom.release()));
+        z->SetGeometryDirectly(z_geom.release());
+        apoResults.push_back(std::move(z));
+    }
+    return true;
+}
+
+static bool overlay_identity(const OverlayParams &p, OGRFeature *x,
+                             OGRGeometry *x_geom,
+                             const std::vector<OGRFeature*> &apoY,
+                             std::vector<OGRFeatureUniquePtr> &apoResults)
+{
+    OGRPreparedGeometryUniquePtr x_prepared_geom;
+    if (p.bUsePreparedGeometries) {
+        x_prepared_geom.reset(OGRCreatePreparedGeometry(OGRGeometry::ToHandle(x_geom)));
+        if (!x_prepared_geom) {
+            return false;
+        }
+    }
+
+    OGRGeometryUniquePtr x_geom_diff(x_geom->clone()); // this will be the geometry of the last result feature
+    for (OGRFeature *y : apoY) {
+        OGRGeometry *y_geom = y->GetGeometryRef();
+
+        CPLErrorReset();
+        if (x_prepared_geom && !(OGRPreparedGeometryIntersects(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom)))) {
+            if (CPLGetLastErrorType() == CE_None) {
+                continue;
+            }
+        }
+        if (CPLGetLastErrorType() != CE_None) {
+            if (!p.bSkipFailures) {
+                return false;
+            }
+            CPLErrorReset();
+        }
+
+        CPLErrorReset();
+        OGRGeometryUniquePtr poIntersection(x_geom->Intersection(y_geom));
+        if (CPLGetLastErrorType() != CE_None || poIntersection == nullptr) {
+            if (!p.bSkipFailures) {
+                return false;
+            }
+            CPLErrorReset();
+            continue;
+        }
+        if (poIntersection->IsEmpty() ||
+            (!p.bKeepLowerDimGeom &&
+             (x_geom->getDimension() == y_geom->getDimension() &&
+              poIntersection->getDimension() < x_geom->getDimension())))
+        {
+            continue;
+        }
+
+        OGRFeatureUniquePtr z(new OGRFeature(p.poDefnResult));
+        z->SetFieldsFrom(x, p.mapX);
+        z->SetFieldsFrom(y, p.mapY);
+        if (p.bPromoteToMulti)
+            poIntersection.reset(promote_to_multi(poIntersection.release()));
+        z->SetGeometryDirectly(poIntersection.release());
+
+        if (x_geom_diff) {
+            CPLErrorReset();
+            OGRGeometryUniquePtr x_geom_diff_new(x_geom_diff->Difference(y_geom));
+            if (CPLGetLastErrorType() != CE_None || x_geom_diff_new == nullptr) {
+                if (!p.bSkipFailures) {
+                    return false;
+                }
+                CPLErrorReset();
+            } else {
+                x_geom_diff.swap(x_geom_diff_new);
+            }
+        }
+        apoResults.push_back(std::move(z));
+    }
+    x_prepared_geom.reset();
+
+    if (x_geom_diff && !x_geom_diff->IsEmpty()) {
+        OGRFeatureUniquePtr z(new OGRFeature(p.poDefnResult));
+        z->SetFieldsFrom(x, p.mapX);
+        if (p.bPromoteToMulti)
+            x_geom_diff.reset(promote_to_multi(x_geom_diff.release()));
+        z->SetGeometryDirectly(x_geom_diff.release());
+        apoResults.push_back(std::move(z));
+    }
+    return true;
+}
+
+static bool overlay_difference(const OverlayParams &p, OGRFeature *x,
+                               OGRGeometry *x_geom,
+                               const std::vector<OGRFeature*> &apoY,
+                               std::vector<OGRFeatureUniquePtr> &apoResults)
+{
+    OGRGeometryUniquePtr geom(x_geom->clone()); // this will be the geometry of the result feature
+    for (OGRFeature *y : apoY) {
+        CPLErrorReset();
+        OGRGeometryUniquePtr geom_new(geom->Difference(y->GetGeometryRef()));
+        if (CPLGetLastErrorType() != CE_None || geom_new == nullptr) {
+            if (!p.bSkipFailures) {
+                return false;
+            }
+            CPLErrorReset();
+        } else {
+            geom.swap(geom_new);
+            if (geom->IsEmpty())
+                break;
+        }
+    }
+
+    if (!geom->IsEmpty()) {
+        OGRFeatureUniquePtr z(new OGRFeature(p.poDefnResult));
+        z->SetFieldsFrom(x, p.mapX);
+        if (p.bPromoteToMulti)
+            geom.reset(promote_to_multi(geom.release()));
+        z->SetGeometryDirectly(geom.release());
+        apoResults.push_back(std::move(z));
+    }
+    return true;
+}
+
+static bool overlay_clip(const OverlayParams &p, OGRFeature *x,
+                         OGRGeometry *x_geom,
+                         const std::vector<OGRFeature*> &apoY,
+                         std::vector<OGRFeatureUniquePtr> &apoResults)
+{
+    OGRGeometryUniquePtr geom; // union of the geometries of y
+    for (OGRFeature *y : apoY) {
+        OGRGeometry *y_geom = y->GetGeometryRef();
+        if (!geom) {
+            geom.reset(y_geom->clone());
+        } else {
+            CPLErrorReset();
+            OGRGeometryUniquePtr geom_new(geom->Union(y_geom));
+            if (CPLGetLastErrorType() != CE_None || geom_new == nullptr) {
+                if (!p.bSkipFailures) {
+                    return false;
+                }
+                CPLErrorReset();
+            } else {
+                geom.swap(geom_new);
+            }
+        }
+    }
+    if (!geom)
+        return true;
+
+    CPLErrorReset();
+    OGRGeometryUniquePtr poIntersection(x_geom->Intersection(geom.get()));
+    if (CPLGetLastErrorType() != CE_None || poIntersection == nullptr) {
+        if (!p.bSkipFailures) {
+            return false;
+        }
+        CPLErrorReset();
+    } else if (!poIntersection->IsEmpty()) {
+        OGRFeatureUniquePtr z(new OGRFeature(p.poDefnResult));
+        z->SetFieldsFrom(x, p.mapX);
+        if (p.bPromoteToMulti)
+            poIntersection.reset(promote_to_multi(poIntersection.release()));
+        z->SetGeometryDirectly(poIntersection.release());
+        apoResults.push_back(std::move(z));
+    }
+    return true;
+}
+
+static bool overlay_process(const OverlayParams &p, const OverlayIndex &oIndex,
+                            OGRFeature *x,
+                            std::vector<OGRFeatureUniquePtr> &apoResults)
+{
+    OGRGeometry *x_geom = x->GetGeometryRef();
+    if (!x_geom)
+        return true;
+
+    // Same as set_filter_from(), but for the indexed layer
+    CPLErrorReset();
+    OGRGeometry *poFilter = x_geom;
+    OGRGeometryUniquePtr poFilterIntersection;
+    if (p.poFilterY) {
+        if (!x_geom->Intersects(p.poFilterY)) {
+            poFilter = nullptr;
+        } else {
+            poFilterIntersection.reset(x_geom->Intersection(p.poFilterY));
+            poFilter = poFilterIntersection.get();
+        }
+    }
+    if (CPLGetLastErrorType() != CE_None) {
+        if (!p.bSkipFailures) {
+            return false;
+        }
+        CPLErrorReset();
+    }
+    if (!poFilter)
+        return true;
+
+    std::vector<OGRFeature*> apoY;
+    oIndex.GetIntersecting(poFilter, apoY);
+    poFilterIntersection.reset();
+
+    switch (p.eOp) {
+        case OverlayOp::INTERSECTION:
+            return overlay_intersection(p, x, x_geom, apoY, apoResults);
+        case OverlayOp::IDENTITY:
+            return overlay_identity(p, x, x_geom, apoY, apoResults);
+        case OverlayOp::DIFFERENCE:
+            return overlay_difference(p, x, x_geom, apoY, apoResults);
+        case OverlayOp::CLIP:
+            return overlay_clip(p, x, x_geom, apoY, apoResults);
+    }
+    return false;
+}
+
+struct OverlayItem
+{
+    OGRFeatureUniquePtr poOwnedX{};
+    OGRFeature *poX = nullptr;
+    bool bOK = true;
+    std::vector<OGRFeatureUniquePtr> apoResults{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+
+struct OverlayJob
+{
+    const OverlayParams *psParams;
+    const OverlayIndex *poIndex;
+    OverlayItem *pasItems;
+    size_t nItems;
+};
+
+static void overlay_job(void *pData)
+{
+    const OverlayJob *psJob = static_cast<const OverlayJob*>(pData);
+    for (size_t i = 0; i < psJob->nItems; ++i) {
+        OverlayItem &oItem = psJob->pasItems[i];
+        // errors are emitted by the calling thread, in the order of the features
+        CPLInstallErrorHandlerAccumulator(oItem.aoErrors);
+        oItem.bOK = overlay_process(*psJob->psParams, *psJob->poIndex,
+                                    oItem.poX, oItem.apoResults);
+        CPLUninstallErrorHandlerAccumulator();
+    }
+}
+
+// Computes the result features of the features of poLayerX (or of poIndexX
+// if poLayerX is null) against the features of oIndex, and writes them to
+// pLayerResult, in the order of the features of the iterated layer.
+// Features are read and results written by the calling thread, by batches
+// when several threads are used.
+static OGRErr overlay_run(const OverlayParams &p, const OverlayIndex &oIndex,
+                          OGRLayer *poLayerX, const OverlayIndex *poIndexX,
+                          OGRLayer *pLayerResult,
+                          GDALProgressFunc pfnProgress, void *pProgressArg,
+                          double &progress_counter, double progress_max)
+{
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (p.nThreads > 1) {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(p.nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+    const size_t nBatchSize = poJobQueue ? static_cast<size_t>(64) * p.nThreads : 1;
+
+    if (poLayerX)
+        poLayerX->ResetReading();
+    size_t iNextX = 0;
+    std::vector<OverlayItem> aoItems;
+    std::vector<OverlayJob> asJobs;
+    while (true) {
+        aoItems.clear();
+        while (aoItems.size() < nBatchSize) {
+            OverlayItem oItem;
+            if (poLayerX) {
+                oItem.poOwnedX.reset(poLayerX->GetNextFeature());
+                oItem.poX = oItem.poOwnedX.get();
+            } else if (iNextX < poIndexX->GetFeatureCount()) {
+                oItem.poX = poIndexX->GetFeature(iNextX++);
+            }
+            if (!oItem.poX)
+                break;
+            aoItems.push_back(std::move(oItem));
+        }
+        if (aoItems.empty())
+            break;
+
+        if (poJobQueue && aoItems.size() > 1) {
+            // several jobs per thread, as the cost of features varies a lot
+            const size_t nPerJob = std::max<size_t>(1,
+                aoItems.size() / (4 * static_cast<size_t>(p.nThreads)));
+            asJobs.clear();
+            for (size_t i = 0; i < aoItems.size(); i += nPerJob) {
+                OverlayJob sJob;
+                sJob.psParams = &p;
+                sJob.poIndex = &oIndex;
+                sJob.pasItems = &aoItems[i];
+                sJob.nItems = std::min(nPerJob, aoItems.size() - i);
+                asJobs.push_back(sJob);
+            }
+            for (auto &sJob : asJobs)
+                poJobQueue->SubmitJob(overlay_job, &sJob);
+            poJobQueue->WaitCompletion();
+        } else {
+            for (auto &oItem : aoItems)
+                oItem.bOK = overlay_process(p, oIndex, oItem.poX, oItem.apoResults);
+        }
+
+        for (auto &oItem : aoItems) {
+            if (pfnProgress) {
+                double dfProgress = progress_counter / progress_max;
+                if (dfProgress > 0 && !pfnProgress(dfProgress, "", pProgressArg)) {
+                    CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                    return OGRERR_FAILURE;
+                }
+                progress_counter += 1.0;
+            }
+
+            for (const auto &oError : oItem.aoErrors)
+                CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            if (!oItem.bOK)
+                return OGRERR_FAILURE;
+            if (!oItem.aoErrors.empty())
+                CPLErrorReset();
+
+            for (auto &z : oItem.apoResults) {
+                OGRErr ret = pLayerResult->CreateFeature(z.get());
+                if (ret != OGRERR_NONE) {
+                    if (!p.bSkipFailures) {
+                        return ret;
+                    }
+                    CPLErrorReset();
+                }
+            }
+        }
+    }
+    return OGRERR_NONE;
+}
+
+} // namespace
+
+static bool use_spatial_index(CSLConstList papszOptions)
+{
+    return CPLTestBool(CSLFetchNameValueDef(papszOptions, "USE_SPATIAL_INDEX", "YES"));
+}
+
 /************************************************************************/
 /*                          Intersection()                              */
 /************************************************************************/
@@ -2206,6 +2786,15 @@ static OGRGeometry* promote_to_multi(OGRGeometry* poGeom)
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Intersection().
@@ -2280,6 +2869,21 @@ OGRErr OGRLayer::Intersection( OGRLayer *pLayerMethod,
         }
     }
 
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndex;
+        oIndex.Load(pLayerMethod);
+        OverlayParams sParams(OverlayOp::INTERSECTION, poDefnResult, mapInput, mapMethod,
+                              pGeometryMethodFilter, papszOptions);
+        sParams.bKeepLowerDimGeom = CPL_TO_BOOL(bKeepLowerDimGeom);
+        ret = overlay_run(sParams, oIndex, this, nullptr, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        if (ret == OGRERR_NONE && pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            ret = OGRERR_FAILURE;
+        }
+        goto done;
+    }
+
     for( auto&& x: this ) {
 
         if (pfnProgress) {
@@ -2463,6 +3067,15 @@ done:
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Intersection().
@@ -2552,6 +3165,15 @@ OGRErr OGR_L_Intersection( OGRLayerH pLayerInput,
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Union().
@@ -2625,6 +3247,31 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
         }
     }
 
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndexInput;
+        oIndexInput.Load(this);
+        OverlayIndex oIndexMethod;
+        oIndexMethod.Load(pLayerMethod);
+        // features of input layer, split by the ones of method layer
+        OverlayParams sParams(OverlayOp::IDENTITY, poDefnResult, mapInput, mapMethod,
+                              pGeometryMethodFilter, papszOptions);
+        sParams.bKeepLowerDimGeom = CPL_TO_BOOL(bKeepLowerDimGeom);
+        ret = overlay_run(sParams, oIndexMethod, nullptr, &oIndexInput, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        // features of method layer, minus the ones of input layer
+        if (ret == OGRERR_NONE) {
+            OverlayParams sParamsMethod(OverlayOp::DIFFERENCE, poDefnResult, mapMethod, nullptr,
+                                        pGeometryInputFilter, papszOptions);
+            ret = overlay_run(sParamsMethod, oIndexInput, nullptr, &oIndexMethod, pLayerResult,
+                              pfnProgress, pProgressArg, progress_counter, progress_max);
+        }
+        if (ret == OGRERR_NONE && pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            ret = OGRERR_FAILURE;
+        }
+        goto done;
+    }
+
     // add features based on input layer
     for( auto&& x: this ) {
 
@@ -2900,6 +3547,15 @@ done:
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Union().
@@ -2982,6 +3638,15 @@ OGRErr OGR_L_Union( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_SymDifference().
@@ -3045,6 +3710,28 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
 
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndexInput;
+        oIndexInput.Load(this);
+        OverlayIndex oIndexMethod;
+        oIndexMethod.Load(pLayerMethod);
+        OverlayParams sParams(OverlayOp::DIFFERENCE, poDefnResult, mapInput, nullptr,
+                              pGeometryMethodFilter, papszOptions);
+        ret = overlay_run(sParams, oIndexMethod, nullptr, &oIndexInput, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        if (ret == OGRERR_NONE) {
+            OverlayParams sParamsMethod(OverlayOp::DIFFERENCE, poDefnResult, mapMethod, nullptr,
+                                        pGeometryInputFilter, papszOptions);
+            ret = overlay_run(sParamsMethod, oIndexInput, nullptr, &oIndexMethod, pLayerResult,
+                              pfnProgress, pProgressArg, progress_counter, progress_max);
+        }
+        if (ret == OGRERR_NONE && pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            ret = OGRERR_FAILURE;
+        }
+        goto done;
+    }
+
     // add features based on input layer
     for( auto&& x: this ) {
 
@@ -3240,6 +3927,15 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::SymDifference().
@@ -3327,6 +4023,15 @@ OGRErr OGR_L_SymDifference( OGRLayerH pLayerInput,
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Identity().
@@ -3397,6 +4102,21 @@ OGRErr OGRLayer::Identity( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
 
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndex;
+        oIndex.Load(pLayerMethod);
+        OverlayParams sParams(OverlayOp::IDENTITY, poDefnResult, mapInput, mapMethod,
+                              pGeometryMethodFilter, papszOptions);
+        sParams.bKeepLowerDimGeom = CPL_TO_BOOL(bKeepLowerDimGeom);
+        ret = overlay_run(sParams, oIndex, this, nullptr, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        if (ret == OGRERR_NONE && pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            ret = OGRERR_FAILURE;
+        }
+        goto done;
+    }
+
     // split the features in input layer to the result layer
     for( auto&& x: this ) {
 
@@ -3590,6 +4310,15 @@ done:
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Identity().
@@ -3672,6 +4401,15 @@ OGRErr OGR_L_Identity( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Update().
@@ -3732,6 +4470,17 @@ OGRErr OGRLayer::Update( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
 
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndex;
+        oIndex.Load(pLayerMethod);
+        OverlayParams sParams(OverlayOp::DIFFERENCE, poDefnResult, mapInput, nullptr,
+                              pGeometryMethodFilter, papszOptions);
+        ret = overlay_run(sParams, oIndex, this, nullptr, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        if (ret != OGRERR_NONE) goto done;
+        goto add_update_features;
+    }
+
     // add clipped features from the input layer
     for( auto&& x: this ) {
 
@@ -3808,6 +4557,7 @@ OGRErr OGRLayer::Update( OGRLayer *pLayerMethod,
     }
 
     // restore the original filter and add features from the update layer
+add_update_features:
     pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
     for( auto&& y: pLayerMethod ) {
 
@@ -3889,6 +4639,15 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Update().
@@ -3964,6 +4723,15 @@ OGRErr OGR_L_Update( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Clip().
@@ -4019,6 +4787,20 @@ OGRErr OGRLayer::Clip( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
 
     poDefnResult = pLayerResult->GetLayerDefn();
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndex;
+        oIndex.Load(pLayerMethod);
+        OverlayParams sParams(OverlayOp::CLIP, poDefnResult, mapInput, nullptr,
+                              pGeometryMethodFilter, papszOptions);
+        ret = overlay_run(sParams, oIndex, this, nullptr, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        if (ret == OGRERR_NONE && pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            ret = OGRERR_FAILURE;
+        }
+        goto done;
+    }
+
     for( auto&& x: this ) {
 
         if (pfnProgress) {
@@ -4148,6 +4930,15 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Clip().
@@ -4223,6 +5014,15 @@ OGRErr OGR_L_Clip( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of this layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Erase().
@@ -4279,6 +5079,20 @@ OGRErr OGRLayer::Erase( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
 
+    if (use_spatial_index(papszOptions)) {
+        OverlayIndex oIndex;
+        oIndex.Load(pLayerMethod);
+        OverlayParams sParams(OverlayOp::DIFFERENCE, poDefnResult, mapInput, nullptr,
+                              pGeometryMethodFilter, papszOptions);
+        ret = overlay_run(sParams, oIndex, this, nullptr, pLayerResult,
+                          pfnProgress, pProgressArg, progress_counter, progress_max);
+        if (ret == OGRERR_NONE && pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            ret = OGRERR_FAILURE;
+        }
+        goto done;
+    }
+
     for( auto&& x: this ) {
 
         if (pfnProgress) {
@@ -4394,6 +5208,15 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO. (GDAL >= 3.7) Set to NO to set a spatial
+ *     filter on the method layer for each feature of the input layer, instead of
+ *     loading the features of the method layer in memory with a spatial
+ *     index on their envelopes. Defaults to YES.
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS. (GDAL >= 3.7) Number of
+ *     threads used to compute the result features when the spatial index
+ *     is used. Features are still written in the same order as with a
+ *     single thread. Defaults to the value of the GDAL_NUM_THREADS
+ *     configuration option, or 1.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Erase().
@@ -284,6 +284,7 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     OGRLayerAttrIndex   *GetIndex() { return m_poAttrIndex; }
     int                 GetGeomFieldFilter() const { return m_iGeomFieldFilter; }
     const char          *GetAttrQueryString() const { return m_pszAttrQueryString; }
+    OGRFeatureQuery     *GetAttrQuery() const { return m_poAttrQuery; }
 //! @endcond
 
     /** Convert a OGRLayer* to a OGRLayerH.
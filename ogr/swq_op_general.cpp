@@ -52,8 +52,8 @@
 /*      Does input match pattern?                                       */
 /************************************************************************/
 
-static int swq_test_like( const char *input, const char *pattern,
-                          char chEscape, bool insensitive )
+int swq_test_like( const char *input, const char *pattern,
+                   char chEscape, bool insensitive )
 
 {
     if( input == nullptr || pattern == nullptr )
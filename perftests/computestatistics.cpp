@@ -0,0 +1,205 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Benchmark of GDALRasterBand::ComputeStatistics(),
+ *           ComputeRasterMinMax() and GetHistogram()
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("Usage: computestatistics [-iter N] [-size xsize ysize]\n");
+    printf("                         [-blocksize xsize ysize] [-nodata value]\n");
+    printf("                         [-ot type]* [--config GDAL_NUM_THREADS N]\n");
+    printf("\n");
+    printf("Time ComputeStatistics(), ComputeRasterMinMax() and GetHistogram()\n");
+    printf("on an in-memory raster (MEM, or GTiff on /vsimem/ when -blocksize\n");
+    printf("is specified). Defaults to 500 iterations on a 10000x1000 raster\n");
+    printf("of Byte, UInt16, Int16, Float32 and Float64 data types.\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                              Bench()                                 */
+/************************************************************************/
+
+template<class Func> static double Bench(int nIters, Func func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < nIters; ++i )
+        func();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if( argc < 1 )
+        exit(-argc);
+
+    int nIters = 500;
+    int nXSize = 10000;
+    int nYSize = 1000;
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    const char* pszNoData = nullptr;
+    std::vector<GDALDataType> aeTypes;
+    for( int iArg = 1; iArg < argc; ++iArg )
+    {
+        if( iArg + 1 < argc && strcmp(argv[iArg], "-iter") == 0 )
+        {
+            nIters = atoi(argv[iArg+1]);
+            ++iArg;
+        }
+        else if( iArg + 2 < argc && strcmp(argv[iArg], "-size") == 0 )
+        {
+            nXSize = atoi(argv[iArg+1]);
+            nYSize = atoi(argv[iArg+2]);
+            iArg += 2;
+        }
+        else if( iArg + 2 < argc && strcmp(argv[iArg], "-blocksize") == 0 )
+        {
+            nBlockXSize = atoi(argv[iArg+1]);
+            nBlockYSize = atoi(argv[iArg+2]);
+            iArg += 2;
+        }
+        else if( iArg + 1 < argc && strcmp(argv[iArg], "-nodata") == 0 )
+        {
+            pszNoData = argv[iArg+1];
+            ++iArg;
+        }
+        else if( iArg + 1 < argc && strcmp(argv[iArg], "-ot") == 0 )
+        {
+            const GDALDataType eDT = GDALGetDataTypeByName(argv[iArg+1]);
+            if( eDT == GDT_Unknown )
+                Usage();
+            aeTypes.push_back(eDT);
+            ++iArg;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if( nIters <= 0 || nXSize <= 0 || nYSize <= 0 )
+        Usage();
+    if( aeTypes.empty() )
+    {
+        aeTypes = { GDT_Byte, GDT_UInt16, GDT_Int16, GDT_Float32, GDT_Float64 };
+    }
+
+    GDALAllRegister();
+
+    printf("Using %s thread(s)\n", CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+
+    for( const GDALDataType eDT: aeTypes )
+    {
+        std::unique_ptr<GDALDataset> poDS;
+        if( nBlockXSize > 0 && nBlockYSize > 0 )
+        {
+            auto poDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+            if( poDriver == nullptr )
+            {
+                fprintf(stderr, "GTiff driver not available\n");
+                exit(1);
+            }
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("TILED", "YES");
+            aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", nBlockXSize));
+            aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", nBlockYSize));
+            poDS.reset(poDriver->Create("/vsimem/computestatistics.tif",
+                                        nXSize, nYSize, 1, eDT,
+                                        aosOptions.List()));
+        }
+        else
+        {
+            auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+            poDS.reset(poDriver->Create("", nXSize, nYSize, 1, eDT, nullptr));
+        }
+        if( poDS == nullptr )
+            exit(1);
+        GDALRasterBand* poBand = poDS->GetRasterBand(1);
+
+        // A ramp of values, so that all histogram buckets get hit.
+        std::vector<double> adfLine(nXSize);
+        for( int iX = 0; iX < nXSize; ++iX )
+            adfLine[iX] = iX % 256;
+        for( int iY = 0; iY < nYSize; ++iY )
+        {
+            if( poBand->RasterIO(GF_Write, 0, iY, nXSize, 1, adfLine.data(),
+                                 nXSize, 1, GDT_Float64, 0, 0,
+                                 nullptr) != CE_None )
+                exit(1);
+        }
+        if( pszNoData )
+            poBand->SetNoDataValue(CPLAtof(pszNoData));
+
+        const double dfStats = Bench(nIters, [poBand]() {
+            double dfMin, dfMax, dfMean, dfStdDev;
+            poBand->ComputeStatistics(false, &dfMin, &dfMax, &dfMean,
+                                      &dfStdDev, nullptr, nullptr);
+        });
+        const double dfMinMax = Bench(nIters, [poBand]() {
+            double adfMinMax[2];
+            poBand->ComputeRasterMinMax(false, adfMinMax);
+        });
+        const double dfHistogram = Bench(nIters, [poBand]() {
+            GUIntBig anHistogram[256];
+            poBand->GetHistogram(-0.5, 255.5, 256, anHistogram, false, false,
+                                 nullptr, nullptr);
+        });
+
+        printf("test%s(): ComputeStatistics: %.3f, ComputeRasterMinMax: %.3f, "
+               "GetHistogram: %.3f\n",
+               GDALGetDataTypeName(eDT), dfStats, dfMinMax, dfHistogram);
+
+        poDS.reset();
+        VSIUnlink("/vsimem/computestatistics.tif");
+    }
+
+    CSLDestroy(argv);
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2026 GDAL contributors
+
+# Measures the effect of VSIVirtualHandle::AdviseRead() on /vsicurl/, by
+# reading a pixel-interleaved and a band-interleaved tiled GeoTIFF served by a
+# local HTTP server that adds a fixed latency to each request.
+
+import http.server
+import os
+import re
+import shutil
+import socketserver
+import sys
+import tempfile
+import threading
+import time
+
+from osgeo import gdal
+
+LATENCY = float(sys.argv[1]) if len(sys.argv) > 1 else 0.05
+
+tmpdir = tempfile.mkdtemp()
+
+
+class RangeHTTPRequestHandler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def log_message(self, format, *args):
+        pass
+
+    def do_HEAD(self):
+        self.send(False)
+
+    def do_GET(self):
+        self.send(True)
+
+    def send(self, with_body):
+        time.sleep(LATENCY)
+        filename = os.path.join(tmpdir, os.path.basename(self.path))
+        if not os.path.exists(filename):
+            self.send_response(404)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return
+        with open(filename, "rb") as f:
+            data = f.read()
+        rng = self.headers.get("Range")
+        if rng:
+            m = re.match(r"bytes=(\d+)-(\d+)", rng)
+            start = int(m.group(1))
+            end = min(int(m.group(2)), len(data) - 1)
+            self.send_response(206)
+            self.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, len(data))
+            )
+            data = data[start : end + 1]
+        else:
+            self.send_response(200)
+        self.send_header("Content-Length", str(len(data)))
+        self.send_header("Accept-Ranges", "bytes")
+        self.end_headers()
+        if with_body:
+            self.wfile.write(data)
+
+
+class ThreadingHTTPServer(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+    # Avoid SYN retransmission delays when many parallel connections are opened
+    request_queue_size = 128
+
+
+server = ThreadingHTTPServer(("127.0.0.1", 0), RangeHTTPRequestHandler)
+port = server.server_address[1]
+threading.Thread(target=server.serve_forever, daemon=True).start()
+
+for interleave in ("PIXEL", "BAND"):
+    ds = gdal.GetDriverByName("GTiff").Create(
+        os.path.join(tmpdir, "test_%s.tif" % interleave),
+        2048,
+        2048,
+        4,
+        options=["TILED=YES", "INTERLEAVE=" + interleave],
+    )
+    for i in range(4):
+        ds.GetRasterBand(i + 1).Fill(i + 1)
+    ds = None
+
+
+def doit(interleave, advise_read):
+
+    gdal.VSICurlClearCache()
+    filename = "/vsicurl/http://127.0.0.1:%d/test_%s.tif" % (port, interleave)
+    gdal.SetConfigOption("GDAL_HTTP_ENABLE_ADVISE_READ", advise_read)
+    gdal.SetConfigOption("GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR")
+    start = time.time()
+    ds = gdal.Open(filename)
+    ds.ReadRaster(0, 0, 1024, 1024)
+    ds = None
+    end = time.time()
+    gdal.SetConfigOption("GDAL_HTTP_ENABLE_ADVISE_READ", None)
+    gdal.SetConfigOption("GDAL_DISABLE_READDIR_ON_OPEN", None)
+    print(
+        "INTERLEAVE=%s, GDAL_HTTP_ENABLE_ADVISE_READ=%s: %.2f"
+        % (interleave, advise_read, end - start)
+    )
+
+
+for interleave in ("PIXEL", "BAND"):
+    doit(interleave, "NO")
+    doit(interleave, "YES")
+
+server.shutdown()
+shutil.rmtree(tmpdir)
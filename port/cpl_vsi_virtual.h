@@ -73,6 +73,9 @@ class CPL_DLL VSIVirtualHandle {
                                           { return VSI_RANGE_STATUS_UNKNOWN; }
     virtual bool      HasPRead() const;
     virtual size_t    PRead( void* pBuffer, size_t nSize, vsi_l_offset nOffset ) const;
+    virtual void      AdviseRead( int nRanges,
+                                  const vsi_l_offset* panOffsets,
+                                  const size_t* panSizes );
 
     // NOTE: when adding new methods, besides the "actual" implementations,
     // also consider the VSICachedFile one.
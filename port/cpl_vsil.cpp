@@ -3168,3 +3168,28 @@ size_t VSIVirtualHandle::PRead( CPL_UNUSED void* pBuffer,
 {
     return 0;
 }
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+/** Declare file ranges that are going to be read soon.
+ *
+ * This is a hint that implementations may use to start fetching those
+ * ranges in the background, typically in parallel, so that subsequent
+ * Read() calls on them are served from a cache. This is mostly useful for
+ * network file systems where the latency of each request dominates.
+ *
+ * This method returns immediately. The current file offset is not affected.
+ * Ranges do not need to be sorted. The default implementation does nothing.
+ *
+ * @param nRanges     number of ranges.
+ * @param panOffsets  array of nRanges file offsets.
+ * @param panSizes    array of nRanges range sizes, in bytes.
+ * @since GDAL 3.7
+ */
+void VSIVirtualHandle::AdviseRead( CPL_UNUSED int nRanges,
+                                   CPL_UNUSED const vsi_l_offset* panOffsets,
+                                   CPL_UNUSED const size_t* panSizes )
+{
+}
@@ -455,6 +455,8 @@ VSICurlHandle::VSICurlHandle( VSICurlFilesystemHandlerBase* poFSIn,
 
 VSICurlHandle::~VSICurlHandle()
 {
+    StopAdviseRead();
+
     if( !m_bCached )
     {
         poFS->InvalidateCachedData(m_pszURL);
@@ -2021,6 +2023,10 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
                 (iterOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
         std::string osRegion;
         std::shared_ptr<std::string> psRegion = poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        if( psRegion == nullptr && WaitForAdvisedRange(nOffsetToDownload) )
+        {
+            psRegion = poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        }
         if( psRegion != nullptr )
         {
             osRegion = *psRegion;
@@ -2059,9 +2065,10 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const nSize,
             // this should not cause bugs. Just missed optimization.
             for( int i = 1; i < nBlocksToDownload; i++ )
             {
-                if( poFS->GetRegion(
-                        m_pszURL,
-                        nOffsetToDownload + i * knDOWNLOAD_CHUNK_SIZE) != nullptr )
+                const vsi_l_offset nNextOffset =
+                    nOffsetToDownload + i * knDOWNLOAD_CHUNK_SIZE;
+                if( poFS->GetRegion(m_pszURL, nNextOffset) != nullptr ||
+                    IsAdvisedRangePending(nNextOffset) )
                 {
                     nBlocksToDownload = i;
                     break;
@@ -2135,6 +2142,14 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
     NetworkStatisticsFile oContextFile(m_osFilename);
     NetworkStatisticsAction oContextAction("ReadMultiRange");
 
+    // Ranges passed to AdviseRead() are, or will soon be, in the region
+    // cache: read them through Read() rather than issuing new requests.
+    if( AreAdvisedRanges(nRanges, panOffsets, panSizes) )
+    {
+        return VSIVirtualHandle::ReadMultiRange(
+                                    nRanges, ppData, panOffsets, panSizes);
+    }
+
     const char* pszMultiRangeStrategy =
         CPLGetConfigOption("GDAL_HTTP_MULTIRANGE", "");
     if( EQUAL(pszMultiRangeStrategy, "SINGLE_GET") )
@@ -2898,6 +2913,510 @@ size_t VSICurlHandle::PRead( void* pBuffer, size_t nSize, vsi_l_offset nOffset )
     return nRet;
 }
 
+/************************************************************************/
+/*                          AdviseReadRequest                           */
+/************************************************************************/
+
+struct VSICurlHandle::AdviseReadRequest
+{
+    vsi_l_offset    nStartOffset = 0;
+    size_t          nSize = 0;
+    bool            bEndsAtEOF = false;
+    bool            bDone = false;  // protected by m_oMutexAdviseRead
+
+    CURL               *hCurlHandle = nullptr;
+    struct curl_slist  *psHeaders = nullptr;
+    WriteFuncStruct     sWriteFuncData{};
+    WriteFuncStruct     sWriteFuncHeaderData{};
+    std::array<char, CURL_ERROR_SIZE + 1> szCurlErrBuf{};
+};
+
+/************************************************************************/
+/*                          AdviseReadDownload                          */
+/************************************************************************/
+
+struct VSICurlHandle::AdviseReadDownload
+{
+    // Only accessed by the download thread once it is started, except
+    // for the offsets, sizes and bDone members of the requests.
+    std::vector<std::shared_ptr<AdviseReadRequest>> apoRequests{};
+    std::string         osURL{};
+    CURLM              *hMultiHandle = nullptr;
+
+    std::thread         oThread{};
+    std::atomic<bool>   bStop{false};
+    std::atomic<bool>   bFinished{false};
+};
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSICurlHandle::AdviseRead( int nRanges,
+                                const vsi_l_offset* panOffsets,
+                                const size_t* panSizes )
+{
+    if( !CPLTestBool(CPLGetConfigOption("GDAL_HTTP_ENABLE_ADVISE_READ",
+                                        "TRUE")) )
+        return;
+
+    // The read callback must be called from the thread that reads.
+    if( pfnReadCbk != nullptr || (bInterrupted && bStopOnInterruptUntilUninstall) )
+        return;
+
+    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    if( oFileProp.eExists == EXIST_NO )
+        return;
+
+    // Only one set of advised ranges is downloaded at a time. The previous
+    // download is stopped, but not waited for, so that this method returns
+    // immediately.
+    PruneAdviseRead();
+    if( m_poAdviseRead )
+    {
+        m_poAdviseRead->bStop = true;
+        m_apoStoppedAdviseReads.push_back(std::move(m_poAdviseRead));
+    }
+    m_apoAdviseReadRequests.clear();
+
+    // Align ranges on the chunks of the region cache.
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> aoIntervals;
+    for( int i = 0; i < nRanges; ++i )
+    {
+        if( panSizes[i] == 0 )
+            continue;
+        const vsi_l_offset nStart =
+            (panOffsets[i] / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+        const vsi_l_offset nEnd =
+            ((panOffsets[i] + panSizes[i] + knDOWNLOAD_CHUNK_SIZE - 1) /
+                knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+        aoIntervals.emplace_back(nStart, nEnd);
+    }
+    std::sort(aoIntervals.begin(), aoIntervals.end());
+
+    // Do not prefetch more than what the region cache can hold, otherwise
+    // the first chunks would be evicted before being read.
+    const vsi_l_offset nMaxTotalSize = std::min(
+        static_cast<vsi_l_offset>(std::max(static_cast<GIntBig>(0),
+            CPLAtoGIntBig(CPLGetConfigOption(
+                "CPL_VSIL_CURL_ADVISE_READ_TOTAL_BYTES_LIMIT", "104857600")))),
+        static_cast<vsi_l_offset>(GetMaxRegions() / 2) * knDOWNLOAD_CHUNK_SIZE);
+
+    // Collect the missing chunks, merging consecutive ones.
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> aoRequests;
+    vsi_l_offset nTotalSize = 0;
+    vsi_l_offset nNextOffset = 0;
+    for( const auto& oInterval : aoIntervals )
+    {
+        vsi_l_offset nOffset = std::max(oInterval.first, nNextOffset);
+        for( ; nOffset < oInterval.second && nTotalSize < nMaxTotalSize;
+               nOffset += knDOWNLOAD_CHUNK_SIZE )
+        {
+            if( oFileProp.bHasComputedFileSize &&
+                nOffset >= oFileProp.fileSize )
+                break;
+            if( poFS->GetRegion(m_pszURL, nOffset) != nullptr )
+                continue;
+            if( !aoRequests.empty() && aoRequests.back().second == nOffset )
+                aoRequests.back().second += knDOWNLOAD_CHUNK_SIZE;
+            else
+                aoRequests.emplace_back(nOffset,
+                                        nOffset + knDOWNLOAD_CHUNK_SIZE);
+            nTotalSize += knDOWNLOAD_CHUNK_SIZE;
+        }
+        nNextOffset = std::max(nNextOffset, nOffset);
+    }
+    if( aoRequests.empty() )
+        return;
+
+    NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix());
+    NetworkStatisticsFile oContextFile(m_osFilename);
+    NetworkStatisticsAction oContextAction("AdviseRead");
+
+    std::string osURL;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        ManagePlanetaryComputerSigning();
+        bool bHasExpired = false;
+        osURL = GetRedirectURLIfValid(bHasExpired);
+    }
+
+    // Everything that depends on the state of the handle, or on thread
+    // local configuration options, is set up here, so that the download
+    // thread only has to run the transfers.
+    std::unique_ptr<AdviseReadDownload> poDownload(new AdviseReadDownload());
+    poDownload->hMultiHandle = curl_multi_init();
+#ifdef CURLPIPE_MULTIPLEX
+    if( CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")) )
+    {
+        curl_multi_setopt(poDownload->hMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+#endif
+
+    for( const auto& oRange : aoRequests )
+    {
+        auto poRequest = std::make_shared<AdviseReadRequest>();
+        poRequest->nStartOffset = oRange.first;
+        vsi_l_offset nEnd = oRange.second;
+        if( oFileProp.bHasComputedFileSize && nEnd >= oFileProp.fileSize )
+        {
+            nEnd = oFileProp.fileSize;
+            poRequest->bEndsAtEOF = true;
+        }
+        poRequest->nSize = static_cast<size_t>(nEnd - oRange.first);
+
+        CURL* hCurlHandle = curl_easy_init();
+        poRequest->hCurlHandle = hCurlHandle;
+
+        struct curl_slist* headers =
+            VSICurlSetOptions(hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
+
+        VSICURLInitWriteFuncStruct(&poRequest->sWriteFuncData,
+                                   nullptr, nullptr, nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                                   &poRequest->sWriteFuncData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                                   VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&poRequest->sWriteFuncHeaderData,
+                                   nullptr, nullptr, nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                                   &poRequest->sWriteFuncHeaderData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                                   VSICurlHandleWriteFunc);
+        poRequest->sWriteFuncHeaderData.bIsHTTP = STARTS_WITH(m_pszURL, "http");
+        poRequest->sWriteFuncHeaderData.nStartOffset = poRequest->nStartOffset;
+        poRequest->sWriteFuncHeaderData.nEndOffset =
+            poRequest->nStartOffset + poRequest->nSize - 1;
+
+        char rangeStr[512] = {};
+        snprintf(rangeStr, sizeof(rangeStr),
+                 CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 poRequest->sWriteFuncHeaderData.nStartOffset,
+                 poRequest->sWriteFuncHeaderData.nEndOffset);
+
+        if( ENABLE_DEBUG )
+            CPLDebug(poFS->GetDebugKey(),
+                     "AdviseRead(): downloading %s (%s)...",
+                     rangeStr, osURL.c_str());
+
+        if( poRequest->sWriteFuncHeaderData.bIsHTTP )
+        {
+            CPLString osHeaderRange;
+            osHeaderRange.Printf("Range: bytes=%s", rangeStr);
+            // So it gets included in Azure signature
+            headers = curl_slist_append(headers, osHeaderRange.c_str());
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+        }
+        else
+        {
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, rangeStr);
+        }
+
+        poRequest->szCurlErrBuf[0] = '\0';
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER,
+                                   &poRequest->szCurlErrBuf[0]);
+
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            headers = VSICurlMergeHeaders(headers,
+                                          GetCurlHeaders("GET", headers));
+        }
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+        poRequest->psHeaders = headers;
+
+        curl_multi_add_handle(poDownload->hMultiHandle, hCurlHandle);
+        poDownload->apoRequests.push_back(poRequest);
+        m_apoAdviseReadRequests.push_back(std::move(poRequest));
+    }
+
+    // The URL may be changed by SetURL() while the thread runs.
+    poDownload->osURL = m_pszURL;
+    AdviseReadDownload* poDownloadPtr = poDownload.get();
+    poDownload->oThread = std::thread(
+        [this, poDownloadPtr]() { AdviseReadThread(*poDownloadPtr); });
+    m_poAdviseRead = std::move(poDownload);
+}
+
+/************************************************************************/
+/*                          AdviseReadThread()                          */
+/************************************************************************/
+
+void VSICurlHandle::AdviseReadThread( AdviseReadDownload& oDownload )
+{
+    NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix());
+    NetworkStatisticsFile oContextFile(m_osFilename);
+    NetworkStatisticsAction oContextAction("AdviseRead");
+
+    // Requests are processed as soon as they complete, so that readers
+    // waiting on the first ones can proceed.
+    size_t nRemaining = oDownload.apoRequests.size();
+    int repeats = 0;
+    while( nRemaining > 0 && !oDownload.bStop )
+    {
+        int still_running = 0;
+        while( curl_multi_perform(oDownload.hMultiHandle, &still_running) ==
+                                        CURLM_CALL_MULTI_PERFORM )
+        {
+            // loop
+        }
+
+        CURLMsg *psMsg = nullptr;
+        int nMsgInQueue = 0;
+        while( (psMsg = curl_multi_info_read(oDownload.hMultiHandle,
+                                             &nMsgInQueue)) != nullptr )
+        {
+            if( psMsg->msg != CURLMSG_DONE )
+                continue;
+            for( auto& poRequest : oDownload.apoRequests )
+            {
+                if( poRequest->hCurlHandle == psMsg->easy_handle )
+                {
+                    AdviseReadProcessRequest(oDownload, *poRequest);
+                    --nRemaining;
+                    break;
+                }
+            }
+        }
+
+        if( !still_running )
+            break;
+        if( nRemaining > 0 )
+            CPLMultiPerformWait(oDownload.hMultiHandle, repeats);
+    }
+
+    for( auto& poRequest : oDownload.apoRequests )
+    {
+        curl_multi_remove_handle(oDownload.hMultiHandle,
+                                 poRequest->hCurlHandle);
+        VSICURLResetHeaderAndWriterFunctions(poRequest->hCurlHandle);
+        curl_easy_cleanup(poRequest->hCurlHandle);
+        poRequest->hCurlHandle = nullptr;
+        CPLFree(poRequest->sWriteFuncData.pBuffer);
+        poRequest->sWriteFuncData.pBuffer = nullptr;
+        CPLFree(poRequest->sWriteFuncHeaderData.pBuffer);
+        poRequest->sWriteFuncHeaderData.pBuffer = nullptr;
+        curl_slist_free_all(poRequest->psHeaders);
+        poRequest->psHeaders = nullptr;
+    }
+    curl_multi_cleanup(oDownload.hMultiHandle);
+    oDownload.hMultiHandle = nullptr;
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+        for( auto& poRequest : oDownload.apoRequests )
+            poRequest->bDone = true;
+    }
+    m_oCondAdviseRead.notify_all();
+    oDownload.bFinished = true;
+}
+
+/************************************************************************/
+/*                      AdviseReadProcessRequest()                      */
+/************************************************************************/
+
+void VSICurlHandle::AdviseReadProcessRequest(
+                        const AdviseReadDownload& oDownload,
+                        AdviseReadRequest& oRequest )
+{
+    long response_code = 0;
+    curl_easy_getinfo(oRequest.hCurlHandle, CURLINFO_HTTP_CODE, &response_code);
+
+    if( response_code == 206 || response_code == 225 )
+    {
+        const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+        size_t nSize = std::min(oRequest.sWriteFuncData.nSize, oRequest.nSize);
+        // A truncated last chunk would be taken as the end of file, unless
+        // it actually is.
+        if( nSize < oRequest.nSize || !oRequest.bEndsAtEOF )
+            nSize = (nSize / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+
+        vsi_l_offset nOffset = oRequest.nStartOffset;
+        const char* pBuffer = oRequest.sWriteFuncData.pBuffer;
+        while( nSize > 0 )
+        {
+            const size_t nChunkSize =
+                std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
+            poFS->AddRegion(oDownload.osURL.c_str(), nOffset,
+                            nChunkSize, pBuffer);
+            nOffset += nChunkSize;
+            pBuffer += nChunkSize;
+            nSize -= nChunkSize;
+        }
+    }
+    else if( ENABLE_DEBUG )
+    {
+        CPLDebug(poFS->GetDebugKey(),
+                 "AdviseRead(): request at offset " CPL_FRMT_GUIB
+                 " failed with response_code=%d, msg=%s",
+                 oRequest.nStartOffset,
+                 static_cast<int>(response_code),
+                 &oRequest.szCurlErrBuf[0]);
+    }
+
+    NetworkStatisticsLogger::LogGET(oRequest.sWriteFuncData.nSize);
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+        oRequest.bDone = true;
+    }
+    m_oCondAdviseRead.notify_all();
+}
+
+/************************************************************************/
+/*                     IsAdvisedRangePendingLocked()                    */
+/************************************************************************/
+
+bool VSICurlHandle::IsAdvisedRangePendingLocked( vsi_l_offset nOffset ) const
+{
+    for( const auto& poRequest : m_apoAdviseReadRequests )
+    {
+        if( !poRequest->bDone &&
+            nOffset >= poRequest->nStartOffset &&
+            nOffset < poRequest->nStartOffset + poRequest->nSize )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        IsAdvisedRangePending()                       */
+/************************************************************************/
+
+bool VSICurlHandle::IsAdvisedRangePending( vsi_l_offset nOffset )
+{
+    // m_apoAdviseReadRequests is only resized by the thread of the handle.
+    if( m_apoAdviseReadRequests.empty() )
+        return false;
+    std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+    return IsAdvisedRangePendingLocked(nOffset);
+}
+
+/************************************************************************/
+/*                         WaitForAdvisedRange()                        */
+/*                                                                      */
+/*      Wait until the chunk at nOffset, if it is being downloaded in   */
+/*      the background, is available. Returns whether we waited.        */
+/************************************************************************/
+
+bool VSICurlHandle::WaitForAdvisedRange( vsi_l_offset nOffset )
+{
+    if( m_apoAdviseReadRequests.empty() )
+        return false;
+    std::unique_lock<std::mutex> oLock(m_oMutexAdviseRead);
+    bool bWaited = false;
+    while( IsAdvisedRangePendingLocked(nOffset) )
+    {
+        m_oCondAdviseRead.wait(oLock);
+        bWaited = true;
+    }
+    return bWaited;
+}
+
+/************************************************************************/
+/*                          AreAdvisedRanges()                          */
+/*                                                                      */
+/*      Whether the ranges are being downloaded by AdviseRead(), or     */
+/*      are already in the region cache.                                */
+/************************************************************************/
+
+bool VSICurlHandle::AreAdvisedRanges( int nRanges,
+                                      const vsi_l_offset* panOffsets,
+                                      const size_t* panSizes )
+{
+    if( !m_poAdviseRead )
+        return false;
+    PruneAdviseRead();
+
+    // The offsets and sizes of the requests are not modified by the
+    // download thread, so no locking is needed.
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const auto IsAdvised = [this, knDOWNLOAD_CHUNK_SIZE](vsi_l_offset nOffset)
+    {
+        for( const auto& poRequest : m_apoAdviseReadRequests )
+        {
+            if( nOffset >= poRequest->nStartOffset &&
+                nOffset < poRequest->nStartOffset + poRequest->nSize )
+                return true;
+        }
+        return poFS->GetRegion(m_pszURL,
+            (nOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE) != nullptr;
+    };
+    for( int i = 0; i < nRanges; ++i )
+    {
+        if( panSizes[i] == 0 )
+            continue;
+        if( !IsAdvised(panOffsets[i]) ||
+            !IsAdvised(panOffsets[i] + panSizes[i] - 1) )
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          PruneAdviseRead()                           */
+/*                                                                      */
+/*      Drop the requests that are done, and release the downloads      */
+/*      whose thread has finished.                                      */
+/************************************************************************/
+
+void VSICurlHandle::PruneAdviseRead()
+{
+    if( !m_apoAdviseReadRequests.empty() )
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexAdviseRead);
+        m_apoAdviseReadRequests.erase(
+            std::remove_if(m_apoAdviseReadRequests.begin(),
+                           m_apoAdviseReadRequests.end(),
+                           [](const std::shared_ptr<AdviseReadRequest>& poRequest)
+                           { return poRequest->bDone; }),
+            m_apoAdviseReadRequests.end());
+    }
+
+    // Joining only waits for the thread to return at this point.
+    if( m_poAdviseRead && m_poAdviseRead->bFinished &&
+        m_poAdviseRead->oThread.joinable() )
+    {
+        m_poAdviseRead->oThread.join();
+    }
+    for( auto oIter = m_apoStoppedAdviseReads.begin();
+              oIter != m_apoStoppedAdviseReads.end(); )
+    {
+        if( (*oIter)->bFinished )
+        {
+            (*oIter)->oThread.join();
+            oIter = m_apoStoppedAdviseReads.erase(oIter);
+        }
+        else
+        {
+            ++oIter;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           StopAdviseRead()                           */
+/************************************************************************/
+
+void VSICurlHandle::StopAdviseRead()
+{
+    if( m_poAdviseRead )
+        m_apoStoppedAdviseReads.push_back(std::move(m_poAdviseRead));
+    for( auto& poDownload : m_apoStoppedAdviseReads )
+        poDownload->bStop = true;
+    for( auto& poDownload : m_apoStoppedAdviseReads )
+    {
+        if( poDownload->oThread.joinable() )
+            poDownload->oThread.join();
+    }
+    m_apoStoppedAdviseReads.clear();
+    m_apoAdviseReadRequests.clear();
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
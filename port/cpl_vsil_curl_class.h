@@ -42,10 +42,13 @@
 #include "cpl_curl_priv.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <set>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 //! @cond Doxygen_Suppress
 
@@ -394,6 +397,29 @@ class VSICurlHandle : public VSIVirtualHandle
     void         UpdateRedirectInfo( CURL* hCurlHandle,
                                      const WriteFuncStruct& sWriteFuncHeaderData );
 
+    // Background download of the ranges passed to AdviseRead()
+    struct AdviseReadRequest;
+    struct AdviseReadDownload;
+    // Latest download, and superseded ones that are being stopped
+    std::unique_ptr<AdviseReadDownload> m_poAdviseRead{};
+    std::vector<std::unique_ptr<AdviseReadDownload>> m_apoStoppedAdviseReads{};
+    // Requests of the latest download that were not done at last check
+    std::vector<std::shared_ptr<AdviseReadRequest>> m_apoAdviseReadRequests{};
+    std::mutex              m_oMutexAdviseRead{};
+    std::condition_variable m_oCondAdviseRead{};
+
+    void         AdviseReadThread( AdviseReadDownload& oDownload );
+    void         AdviseReadProcessRequest( const AdviseReadDownload& oDownload,
+                                           AdviseReadRequest& oRequest );
+    bool         IsAdvisedRangePendingLocked( vsi_l_offset nOffset ) const;
+    bool         IsAdvisedRangePending( vsi_l_offset nOffset );
+    bool         WaitForAdvisedRange( vsi_l_offset nOffset );
+    bool         AreAdvisedRanges( int nRanges,
+                                   const vsi_l_offset* panOffsets,
+                                   const size_t* panSizes );
+    void         PruneAdviseRead();
+    void         StopAdviseRead();
+
   protected:
     virtual struct curl_slist* GetCurlHeaders( const CPLString& /*osVerb*/,
                                 const struct curl_slist* /* psExistingHeaders */)
@@ -426,6 +452,8 @@ class VSICurlHandle : public VSIVirtualHandle
 
     bool      HasPRead() const override { return true; }
     size_t    PRead( void* pBuffer, size_t nSize, vsi_l_offset nOffset ) const override;
+    void      AdviseRead( int nRanges, const vsi_l_offset* panOffsets,
+                          const size_t* panSizes ) override;
 
     bool IsKnownFileSize() const { return oFileProp.bHasComputedFileSize; }
     vsi_l_offset         GetFileSizeOrHeaders(bool bSetError, bool bGetHeaders);
@@ -424,6 +424,26 @@ void CPLWorkerThreadPool::WaitEvent()
     }
 }
 
+/************************************************************************/
+/*                        IsCurrentThreadWorker()                       */
+/************************************************************************/
+
+/** Return whether the calling thread is one of the worker threads of this
+ * pool.
+ *
+ * A job that waits for the completion of other jobs submitted to the pool it
+ * runs on may deadlock, once all worker threads are busy with such jobs.
+ * Code that may be called from a job, and that would submit jobs to this pool
+ * and wait for them, should check this method and process its work
+ * sequentially instead.
+ *
+ * @since GDAL 3.7
+ */
+bool CPLWorkerThreadPool::IsCurrentThreadWorker() const
+{
+    return threadLocalCurrentThreadPool == this;
+}
+
 /************************************************************************/
 /*                                Setup()                               */
 /************************************************************************/